@@ -0,0 +1,389 @@
+#include "AccuracyReport.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "Ball.h"
+#include "Cue.h"
+#include "FastMath.h"
+#include "Table.h"
+#include "TableLayout.h"
+#include "TableState.h"
+
+namespace
+{
+	using clock = std::chrono::steady_clock;
+
+	constexpr char MAGIC[8]{ 'G', 'E', 'O', 'A', 'A', 'C', 'C', '1' };
+	constexpr float STEP_SECONDS{ 1.f / 240.f };
+	const Rectf PLAY_AREA{ 50.f, 50.f, 840.f, 420.f };
+
+	struct CannedShot
+	{
+		Motor shot;
+		std::unique_ptr<TableState> pBefore;
+		std::unique_ptr<TableState> pAfter;
+	};
+
+	struct Reference
+	{
+		std::vector<CannedShot> shots;
+		// the exact build playing the shots, from the same start states as the single shots of the fast build
+		uint64_t numSteps;
+		double simulationSeconds;
+	};
+
+	struct FunctionError
+	{
+		double maxError;
+		double approxNanoseconds;
+		double exactNanoseconds;
+	};
+
+	// error is called with the approximation and the exact value of every sample, the largest error is kept
+	template <typename Approx, typename Exact, typename Error>
+	FunctionError MeasureFunction(const std::vector<float>& samples, Approx approx, Exact exact, Error error)
+	{
+		FunctionError result{};
+		for (float sample : samples)
+		{
+			result.maxError = std::max(result.maxError, error(double(approx(sample)), exact(double(sample))));
+		}
+
+		// summed so the calls can't be left out
+		volatile float sink{};
+		const auto time{ [&](auto function)
+			{
+				const clock::time_point start{ clock::now() };
+				float sum{};
+				for (int repeat{}; repeat < 20; ++repeat)
+				{
+					for (float sample : samples)
+					{
+						sum += function(sample);
+					}
+				}
+				sink = sum;
+				return 1e9 * std::chrono::duration<double>(clock::now() - start).count() / (20.0 * samples.size());
+			} };
+		result.approxNanoseconds = time(approx);
+		result.exactNanoseconds = time([&](float sample) { return float(exact(sample)); });
+		return result;
+	}
+
+	std::vector<float> CreateSamples(float min, float max, bool isLogarithmic)
+	{
+		const int numSamples{ 100000 };
+		std::vector<float> samples(numSamples);
+		for (int idx{}; idx < numSamples; ++idx)
+		{
+			const float t{ float(idx) / (numSamples - 1) };
+			samples[idx] = isLogarithmic ? min * std::pow(max / min, t) : min + (max - min) * t;
+		}
+		return samples;
+	}
+
+	void PrintFunction(const char* name, const char* range, const char* errorKind, const FunctionError& error)
+	{
+		std::cout << "  " << name << " on " << range << ": max " << errorKind << " error " << error.maxError << ", " << error.approxNanoseconds
+			<< " ns per call, std " << error.exactNanoseconds << " ns\n";
+	}
+
+	double RelativeError(double approx, double exact)
+	{
+		return std::fabs(approx - exact) / std::max(std::fabs(exact), 1e-30);
+	}
+
+	double AbsoluteError(double approx, double exact)
+	{
+		return std::fabs(approx - exact);
+	}
+
+	// plays the shot until the balls stop, returns the steps it took
+	uint64_t PlayShot(Table& table, const Motor& shot)
+	{
+		const uint64_t maxSteps{ uint64_t(AccuracyReport::MAX_SHOT_SECONDS / STEP_SECONDS) };
+		table.ApplyShot(shot);
+		uint64_t numSteps{};
+		while (table.AreBallsRolling() && numSteps < maxSteps)
+		{
+			table.Update(STEP_SECONDS);
+			++numSteps;
+		}
+		return numSteps;
+	}
+
+	void WriteState(std::ostream& file, const TableState& state)
+	{
+		const int32_t header[4]{ state.numRedBalls, state.points, state.whiteBallFouls, state.noBallHitFouls };
+		const uint8_t flags[3]{ state.ballsRolling, state.isFirstShot, state.hasHitBall };
+		file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(flags), sizeof(flags));
+		file.write(reinterpret_cast<const char*>(state.whiteBall), sizeof(Ball));
+		file.write(reinterpret_cast<const char*>(state.redBalls), std::streamsize(state.numRedBalls) * sizeof(Ball));
+	}
+
+	bool ReadState(std::istream& file, TableState& state)
+	{
+		int32_t header[4]{};
+		uint8_t flags[3]{};
+		file.read(reinterpret_cast<char*>(header), sizeof(header));
+		file.read(reinterpret_cast<char*>(flags), sizeof(flags));
+		if (!file || header[0] < 0 || header[0] > TableState::MAX_BALLS) return false;
+
+		state.numRedBalls = header[0];
+		state.points = header[1];
+		state.whiteBallFouls = header[2];
+		state.noBallHitFouls = header[3];
+		state.ballsRolling = flags[0] != 0;
+		state.isFirstShot = flags[1] != 0;
+		state.hasHitBall = flags[2] != 0;
+		file.read(reinterpret_cast<char*>(state.whiteBall), sizeof(Ball));
+		file.read(reinterpret_cast<char*>(state.redBalls), std::streamsize(state.numRedBalls) * sizeof(Ball));
+		return bool(file);
+	}
+
+	bool ReadReference(const std::string& path, Reference& reference)
+	{
+		std::ifstream file{ path, std::ios::binary };
+		if (!file)
+		{
+			std::cerr << "AccuracyReport::CompareWithReference( ), unable to open " << path << ", run the exact build first to write it\n";
+			return false;
+		}
+
+		char magic[sizeof(MAGIC)]{};
+		uint32_t ballSize{};
+		uint32_t numShots{};
+		file.read(magic, sizeof(magic));
+		file.read(reinterpret_cast<char*>(&ballSize), sizeof(ballSize));
+		file.read(reinterpret_cast<char*>(&numShots), sizeof(numShots));
+		file.read(reinterpret_cast<char*>(&reference.numSteps), sizeof(reference.numSteps));
+		file.read(reinterpret_cast<char*>(&reference.simulationSeconds), sizeof(reference.simulationSeconds));
+		if (!file || !std::equal(std::begin(magic), std::end(magic), std::begin(MAGIC)) || ballSize != sizeof(Ball))
+		{
+			std::cerr << "AccuracyReport::CompareWithReference( ), " << path << " isn't a reference file of this version\n";
+			return false;
+		}
+
+		for (uint32_t idx{}; idx < numShots; ++idx)
+		{
+			CannedShot shot{ Motor{}, std::make_unique<TableState>(), std::make_unique<TableState>() };
+			file.read(reinterpret_cast<char*>(&shot.shot), sizeof(Motor));
+			if (!ReadState(file, *shot.pBefore) || !ReadState(file, *shot.pAfter))
+			{
+				std::cerr << "AccuracyReport::CompareWithReference( ), " << path << " ends in shot " << idx << '\n';
+				return false;
+			}
+			reference.shots.push_back(std::move(shot));
+		}
+		return true;
+	}
+}
+
+bool AccuracyReport::Run(const std::string& referencePath)
+{
+	PrintFunctionErrors();
+	return FastMath::IsEnabled() ? CompareWithReference(referencePath) : WriteReference(referencePath);
+}
+
+Motor AccuracyReport::CreateCannedShot(const Table& table, int shotIdx)
+{
+	const ThreeBlade& whitePos{ table.GetWhiteBall().GetPos() };
+	const std::vector<Ball>& redBalls{ table.GetRedBalls() };
+	float angle{ 0.7f * shotIdx };
+	if (!redBalls.empty())
+	{
+		const ThreeBlade& target{ redBalls[(shotIdx * 5) % redBalls.size()].GetPos() };
+		angle = std::atan2(target[1] / target[3] - whitePos[1] / whitePos[3], target[0] / target[3] - whitePos[0] / whitePos[3]);
+	}
+	angle += 0.01f * ((shotIdx * 37) % 11 - 5);
+	const float force{ Cue::MAX_FORCE * (0.35f + 0.65f * ((shotIdx * 3) % 8) / 7.f) };
+	return Cue::CreateShot(angle, force);
+}
+
+float AccuracyReport::GetMaxPositionError(const Table& table, const Table& reference, bool& isSameBalls)
+{
+	const auto distance{ [](const Ball& first, const Ball& second)
+		{
+			const ThreeBlade& firstPos{ first.GetPos() };
+			const ThreeBlade& secondPos{ second.GetPos() };
+			const float dx{ firstPos[0] / firstPos[3] - secondPos[0] / secondPos[3] };
+			const float dy{ firstPos[1] / firstPos[3] - secondPos[1] / secondPos[3] };
+			return std::sqrt(dx * dx + dy * dy);
+		} };
+
+	float maxError{ distance(table.GetWhiteBall(), reference.GetWhiteBall()) };
+	const std::vector<Ball>& redBalls{ table.GetRedBalls() };
+	const std::vector<Ball>& referenceBalls{ reference.GetRedBalls() };
+	isSameBalls = redBalls.size() == referenceBalls.size();
+
+	// both lists keep the order of the ids, so they can be merged
+	size_t idx{};
+	size_t referenceIdx{};
+	while (idx < redBalls.size() && referenceIdx < referenceBalls.size())
+	{
+		const uint32_t id{ redBalls[idx].GetId() };
+		const uint32_t referenceId{ referenceBalls[referenceIdx].GetId() };
+		if (id == referenceId)
+		{
+			maxError = std::max(maxError, distance(redBalls[idx++], referenceBalls[referenceIdx++]));
+			continue;
+		}
+
+		isSameBalls = false;
+		if (id < referenceId) ++idx;
+		else ++referenceIdx;
+	}
+	return maxError;
+}
+
+void AccuracyReport::PrintFunctionErrors()
+{
+	std::cout << "FastMath approximations against the std functions (" << (FastMath::IsEnabled() ? "used by this build" : "not used by this build") << ")\n";
+
+	const std::vector<float> positive{ CreateSamples(1e-4f, 1e8f, true) };
+	PrintFunction("InvSqrt", "[1e-4, 1e8]", "relative", MeasureFunction(positive, FastMath::ApproxInvSqrt,
+		[](double x) { return 1.0 / std::sqrt(x); }, RelativeError));
+	PrintFunction("Sqrt", "[1e-4, 1e8]", "relative", MeasureFunction(positive, FastMath::ApproxSqrt,
+		[](double x) { return std::sqrt(x); }, RelativeError));
+
+	const std::vector<float> angles{ CreateSamples(-100.f, 100.f, false) };
+	PrintFunction("Sin", "[-100, 100]", "absolute", MeasureFunction(angles, FastMath::ApproxSin,
+		[](double x) { return std::sin(x); }, AbsoluteError));
+	PrintFunction("Cos", "[-100, 100]", "absolute", MeasureFunction(angles, FastMath::ApproxCos,
+		[](double x) { return std::cos(x); }, AbsoluteError));
+
+	const std::vector<float> exponents{ CreateSamples(-30.f, 30.f, false) };
+	PrintFunction("Exp2", "[-30, 30]", "relative", MeasureFunction(exponents, FastMath::ApproxExp2,
+		[](double x) { return std::exp2(x); }, RelativeError));
+	PrintFunction("Log2", "[1e-4, 1e8]", "absolute", MeasureFunction(positive, FastMath::ApproxLog2,
+		[](double x) { return std::log2(x); }, AbsoluteError));
+
+	// the friction decay: a fixed base to the power of the elapsed time
+	const std::vector<float> times{ CreateSamples(0.f, 60.f, false) };
+	const float friction{ 0.6f };
+	PrintFunction("Pow(0.6, t)", "t in [0, 60]", "relative", MeasureFunction(times, [friction](float t) { return FastMath::ApproxPow(friction, t); },
+		[friction](double t) { return std::pow(double(friction), t); }, RelativeError));
+}
+
+bool AccuracyReport::WriteReference(const std::string& path)
+{
+	// the shots depend on where the balls are, so they are chosen while playing them as one game
+	Table table{ TableLayout::CreateDefault(PLAY_AREA) };
+	std::vector<CannedShot> shots{};
+	uint64_t numSteps{};
+	double simulationSeconds{};
+	// the game ends when the last red ball is pocketed, shots on the empty table would only roll the white ball
+	for (int shotIdx{}; shotIdx < NUM_CANNED_SHOTS && !table.GetRedBalls().empty(); ++shotIdx)
+	{
+		CannedShot shot{ CreateCannedShot(table, shotIdx), std::make_unique<TableState>(), std::make_unique<TableState>() };
+		if (!table.Snapshot(*shot.pBefore))
+		{
+			std::cerr << "AccuracyReport::WriteReference( ), the table has more than " << TableState::MAX_BALLS << " red balls\n";
+			return false;
+		}
+
+		const clock::time_point start{ clock::now() };
+		numSteps += PlayShot(table, shot.shot);
+		simulationSeconds += std::chrono::duration<double>(clock::now() - start).count();
+
+		table.Snapshot(*shot.pAfter);
+		shots.push_back(std::move(shot));
+	}
+
+	std::ofstream file{ path, std::ios::binary };
+	const uint32_t ballSize{ sizeof(Ball) };
+	const uint32_t numShots{ uint32_t(shots.size()) };
+	file.write(MAGIC, sizeof(MAGIC));
+	file.write(reinterpret_cast<const char*>(&ballSize), sizeof(ballSize));
+	file.write(reinterpret_cast<const char*>(&numShots), sizeof(numShots));
+	file.write(reinterpret_cast<const char*>(&numSteps), sizeof(numSteps));
+	file.write(reinterpret_cast<const char*>(&simulationSeconds), sizeof(simulationSeconds));
+	for (const CannedShot& shot : shots)
+	{
+		file.write(reinterpret_cast<const char*>(&shot.shot), sizeof(Motor));
+		WriteState(file, *shot.pBefore);
+		WriteState(file, *shot.pAfter);
+	}
+	if (!file)
+	{
+		std::cerr << "AccuracyReport::WriteReference( ), unable to write " << path << '\n';
+		return false;
+	}
+
+	std::cout << "Exact build: played " << shots.size() << " canned shots in " << numSteps << " steps (" << numSteps / std::max(simulationSeconds, 1e-9)
+		<< " steps/s), " << table.GetPoints() << " points, wrote the reference to " << path << "\n"
+		<< "build with GEOA_FAST_MATH and run --accuracy " << path << " again to compare\n";
+	return true;
+}
+
+bool AccuracyReport::CompareWithReference(const std::string& path)
+{
+	Reference reference{};
+	if (!ReadReference(path, reference)) return false;
+	if (reference.shots.empty()) return true;
+
+	Table table{ TableLayout::CreateDefault(PLAY_AREA) };
+	Table referenceTable{ TableLayout::CreateDefault(PLAY_AREA) };
+
+	std::cout << "Fast build against the exact build on " << reference.shots.size() << " canned shots, largest ball distance in units\n"
+		<< "  shot  from the exact start  in one game\n";
+
+	// every shot on its own from the exact start state, so the errors don't add up,
+	// and the simulation plays the same tables as the exact build did, so their speed can be compared
+	std::vector<float> shotErrors{};
+	int numDifferentShots{};
+	int pointsDifference{};
+	uint64_t numSteps{};
+	double simulationSeconds{};
+	for (const CannedShot& shot : reference.shots)
+	{
+		table.Restore(*shot.pBefore);
+		const clock::time_point start{ clock::now() };
+		numSteps += PlayShot(table, shot.shot);
+		simulationSeconds += std::chrono::duration<double>(clock::now() - start).count();
+		referenceTable.Restore(*shot.pAfter);
+
+		bool isSameBalls{};
+		shotErrors.push_back(GetMaxPositionError(table, referenceTable, isSameBalls));
+		numDifferentShots += isSameBalls ? 0 : 1;
+		pointsDifference += std::abs((table.GetPoints() - shot.pBefore->points) - (shot.pAfter->points - shot.pBefore->points));
+	}
+
+	// all shots as one game, the way the errors add up while playing
+	table.Restore(*reference.shots.front().pBefore);
+	int firstDifferentShot{ -1 };
+	float gameError{};
+	for (size_t idx{}; idx < reference.shots.size(); ++idx)
+	{
+		PlayShot(table, reference.shots[idx].shot);
+
+		referenceTable.Restore(*reference.shots[idx].pAfter);
+		bool isSameBalls{};
+		gameError = GetMaxPositionError(table, referenceTable, isSameBalls);
+		if (!isSameBalls && firstDifferentShot < 0) firstDifferentShot = int(idx);
+
+		std::cout << "  " << idx << "  " << shotErrors[idx] << "  " << gameError << (isSameBalls ? "\n" : "  other balls pocketed\n");
+	}
+
+	const float maxShotError{ *std::max_element(shotErrors.begin(), shotErrors.end()) };
+	float meanShotError{};
+	for (float error : shotErrors)
+	{
+		meanShotError += error / shotErrors.size();
+	}
+
+	std::cout << "single shots: mean " << meanShotError << ", max " << maxShotError << ", " << numDifferentShots << " pocketed other balls, "
+		<< pointsDifference << " points different in total\n"
+		<< "one game: " << table.GetPoints() << " points (exact " << reference.shots.back().pAfter->points << "), "
+		<< (firstDifferentShot < 0 ? std::string{ "the same balls pocketed" } : "other balls pocketed from shot " + std::to_string(firstDifferentShot)) << '\n'
+		<< "single shots simulation: " << numSteps / std::max(simulationSeconds, 1e-9) << " steps/s, exact build " << reference.numSteps / std::max(reference.simulationSeconds, 1e-9)
+		<< " steps/s (" << numSteps << " steps, exact " << reference.numSteps << ")\n";
+	return true;
+}
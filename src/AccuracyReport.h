@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+
+class Motor;
+class Table;
+
+// Measures what the GEOA_FAST_MATH build gives up for its speed (see FastMath.h).
+// First the error and cost of every approximation against its std function, which works in any build.
+// Then the physics: a fixed list of canned shots is played on the default table, and the exact build writes where
+// every ball ended up and how long the simulation took to a reference file. The fast build plays the same shots,
+// each one from the exact start state and all of them as one game, and reports how far the balls end up from the reference.
+namespace AccuracyReport
+{
+	// at most, the canned game stops early when it pockets the last red ball
+	constexpr int NUM_CANNED_SHOTS{ 24 };
+	// a shot is cut off after this long, like the batch runner does
+	constexpr float MAX_SHOT_SECONDS{ 60.f };
+
+	// the exact build writes the reference file, the fast build compares against it, returns false on an error
+	bool Run(const std::string& referencePath);
+
+	void PrintFunctionErrors();
+	bool WriteReference(const std::string& path);
+	bool CompareWithReference(const std::string& path);
+
+	// the k-th canned shot for the table as it is: at one of the red balls, a little off, with a force that goes around the whole range
+	Motor CreateCannedShot(const Table& table, int shotIdx);
+	// largest distance between the same balls on both tables, isSameBalls is false when they don't have the same balls left
+	float GetMaxPositionError(const Table& table, const Table& reference, bool& isSameBalls);
+}
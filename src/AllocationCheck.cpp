@@ -0,0 +1,134 @@
+#include "AllocationCheck.h"
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include "AllocationTracker.h"
+#include "Ball.h"
+#include "GameSimulation.h"
+#include "TableLayout.h"
+
+namespace
+{
+	using clock = std::chrono::steady_clock;
+
+	// what the mouse does in the scripted session
+	enum class ScriptState
+	{
+		Aiming,
+		Shooting,
+		Rolling
+	};
+
+	void PrintCounts(const char* title)
+	{
+		std::cout << title;
+		for (int phase{}; phase < int(AllocationTracker::Phase::Count); ++phase)
+		{
+			const AllocationTracker::Counts counts{ AllocationTracker::GetCounts(AllocationTracker::Phase(phase)) };
+			std::cout << ' ' << AllocationTracker::GetPhaseName(AllocationTracker::Phase(phase)) << ' ' << counts.allocations
+				<< " (" << counts.bytes << " B)";
+		}
+		std::cout << '\n';
+	}
+}
+
+bool AllocationCheck::Run(int numFrames)
+{
+	if constexpr (!AllocationTracker::IsEnabled())
+	{
+		std::cerr << "AllocationCheck::Run( ), built without GEOA_TRACK_ALLOCATIONS, allocations can't be counted\n";
+		return false;
+	}
+
+	const float stepSeconds{ 1.f / 240.f };
+	const auto stepDuration{ std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(stepSeconds)) };
+
+	// the game's own simulation, fed through its input queue, one step and one snapshot per frame like the simulation thread
+	auto pSimulation{ std::make_unique<GameSimulation>(TableLayout::CreateDefault(Rectf{ 50.f, 50.f, 840.f, 420.f }), ShotPlanner::Settings{}) };
+	const Table& table{ pSimulation->GetTable() };
+
+	ScriptState state{ ScriptState::Aiming };
+	int stateFrames{};
+	int numShots{};
+	// the first shot goes straight at the rack, every next one a bit further around
+	float shotAngle{};
+	float aimAngle{};
+	Point2f mousePos{};
+	clock::time_point time{ clock::now() };
+
+	uint64_t allocatingFrames{};
+	int scoreLength{};
+	for (int frame{}; frame < numFrames; ++frame)
+	{
+		if (frame == WARM_UP_FRAMES) AllocationTracker::Reset();
+		const uint64_t allocationsBefore{ AllocationTracker::GetTotalCounts().allocations };
+		time += stepDuration;
+
+		{
+			// the event loop, one mouse sample per frame
+			AllocationTracker::ScopedPhase inputPhase{ AllocationTracker::Phase::Input };
+			const ThreeBlade& ballPos{ table.GetWhiteBall().GetPos() };
+			bool isLeftButtonDown{ false };
+			switch (state)
+			{
+			case ScriptState::Aiming:
+				// swing around the white ball towards the shot angle, then push through it
+				aimAngle = shotAngle - 0.005f * (240 - stateFrames);
+				mousePos = Point2f{ ballPos[0] + 150.f * std::cos(aimAngle), ballPos[1] + 150.f * std::sin(aimAngle) };
+				if (++stateFrames == 240)
+				{
+					state = ScriptState::Shooting;
+					stateFrames = 0;
+				}
+				break;
+			case ScriptState::Shooting:
+				mousePos = Point2f{ mousePos.x - 12.f * std::cos(aimAngle), mousePos.y - 12.f * std::sin(aimAngle) };
+				isLeftButtonDown = true;
+				break;
+			case ScriptState::Rolling:
+				break;
+			}
+			pSimulation->PushInput(InputEvent{ InputEvent::Type::MouseMotion, 0, mousePos, isLeftButtonDown, time });
+		}
+
+		pSimulation->Step(stepSeconds, time);
+		pSimulation->PublishSnapshot();
+
+		// the cue hit the ball in this step, or the balls came to rest
+		if (state == ScriptState::Shooting && table.AreBallsRolling())
+		{
+			state = ScriptState::Rolling;
+			++numShots;
+		}
+		else if (state == ScriptState::Rolling && !table.AreBallsRolling())
+		{
+			state = ScriptState::Aiming;
+			shotAngle += 0.9f;
+		}
+
+		{
+			// everything the renderer does besides the OpenGL calls, the opt-in latency and stats overlays are left out
+			AllocationTracker::ScopedPhase renderPhase{ AllocationTracker::Phase::Render };
+			const GameSnapshot& snapshot{ pSimulation->TakeLatestSnapshot() };
+			char text[16]{};
+			scoreLength = int(std::to_chars(std::begin(text), std::end(text), snapshot.points).ptr - text);
+		}
+
+		if (frame >= WARM_UP_FRAMES && AllocationTracker::GetTotalCounts().allocations != allocationsBefore) ++allocatingFrames;
+	}
+
+	std::cout << "allocation check: " << numFrames << " frames (" << WARM_UP_FRAMES << " warm-up), " << numShots << " shots, "
+		<< table.GetRedBalls().size() << " red balls left, score " << table.GetPoints() << " (" << scoreLength << " characters)\n";
+	PrintCounts("  allocations after warm-up:");
+
+	if (allocatingFrames != 0)
+	{
+		std::cout << "  FAILED: " << allocatingFrames << " frames allocated\n";
+		return false;
+	}
+	std::cout << "  OK: no frame allocated\n";
+	return true;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+// Plays a scripted session headlessly through the game's own GameSimulation: mouse samples through its input queue
+// (aiming, shooting, waiting for the balls), its steps and snapshots, and the renderer taking the snapshot and formatting
+// the score, and checks that a steady-state frame doesn't allocate. The OpenGL calls and the opt-in latency and stats
+// overlays, which create text textures twice per second, are not part of it. Needs a GEOA_TRACK_ALLOCATIONS build to count anything.
+namespace AllocationCheck
+{
+	// frames played before counting, so containers can reach their final capacity
+	constexpr int WARM_UP_FRAMES{ 600 };
+
+	// returns true when no frame after the warm-up allocated
+	bool Run(int numFrames);
+}
@@ -0,0 +1,122 @@
+#include "AllocationTracker.h"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	constexpr size_t NUM_PHASES{ size_t(AllocationTracker::Phase::Count) };
+
+	std::array<std::atomic<uint64_t>, NUM_PHASES> g_Allocations{};
+	std::array<std::atomic<uint64_t>, NUM_PHASES> g_Bytes{};
+
+	thread_local AllocationTracker::Phase t_Phase{ AllocationTracker::Phase::Other };
+}
+
+void AllocationTracker::OnAllocation(size_t size)
+{
+	const size_t phase{ size_t(t_Phase) };
+	g_Allocations[phase].fetch_add(1, std::memory_order_relaxed);
+	g_Bytes[phase].fetch_add(size, std::memory_order_relaxed);
+}
+
+AllocationTracker::Counts AllocationTracker::GetCounts(Phase phase)
+{
+	const size_t idx{ size_t(phase) };
+	return Counts{ g_Allocations[idx].load(std::memory_order_relaxed), g_Bytes[idx].load(std::memory_order_relaxed) };
+}
+
+AllocationTracker::Counts AllocationTracker::GetTotalCounts()
+{
+	Counts total{};
+	for (size_t idx{}; idx < NUM_PHASES; ++idx)
+	{
+		const Counts counts{ GetCounts(Phase(idx)) };
+		total.allocations += counts.allocations;
+		total.bytes += counts.bytes;
+	}
+	return total;
+}
+
+void AllocationTracker::Reset()
+{
+	for (size_t idx{}; idx < NUM_PHASES; ++idx)
+	{
+		g_Allocations[idx].store(0, std::memory_order_relaxed);
+		g_Bytes[idx].store(0, std::memory_order_relaxed);
+	}
+}
+
+const char* AllocationTracker::GetPhaseName(Phase phase)
+{
+	switch (phase)
+	{
+	case Phase::Input: return "input";
+	case Phase::Simulation: return "simulation";
+	case Phase::Snapshot: return "snapshot";
+	case Phase::Render: return "render";
+	default: return "other";
+	}
+}
+
+AllocationTracker::ScopedPhase::ScopedPhase(Phase phase)
+	: m_previousPhase{ t_Phase }
+{
+	t_Phase = phase;
+}
+
+AllocationTracker::ScopedPhase::~ScopedPhase()
+{
+	t_Phase = m_previousPhase;
+}
+
+#ifdef GEOA_TRACK_ALLOCATIONS
+// Replacements of the global allocation functions, they only count and forward to malloc
+namespace
+{
+	void* Allocate(size_t size)
+	{
+		AllocationTracker::OnAllocation(size);
+		if (void* pMemory{ std::malloc(size != 0 ? size : 1) }) return pMemory;
+		throw std::bad_alloc{};
+	}
+
+	void* AllocateAligned(size_t size, std::align_val_t alignment)
+	{
+		AllocationTracker::OnAllocation(size);
+		const size_t align{ size_t(alignment) };
+#ifdef _WIN32
+		void* pMemory{ _aligned_malloc(size != 0 ? size : 1, align) };
+#else
+		// aligned_alloc wants the size to be a multiple of the alignment
+		void* pMemory{ std::aligned_alloc(align, (size + align - 1) / align * align) };
+#endif
+		if (pMemory) return pMemory;
+		throw std::bad_alloc{};
+	}
+
+	void FreeAligned(void* pMemory)
+	{
+#ifdef _WIN32
+		_aligned_free(pMemory);
+#else
+		std::free(pMemory);
+#endif
+	}
+}
+
+void* operator new(size_t size) { return Allocate(size); }
+void* operator new[](size_t size) { return Allocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+
+void operator delete(void* pMemory) noexcept { std::free(pMemory); }
+void operator delete[](void* pMemory) noexcept { std::free(pMemory); }
+void operator delete(void* pMemory, size_t) noexcept { std::free(pMemory); }
+void operator delete[](void* pMemory, size_t) noexcept { std::free(pMemory); }
+void operator delete(void* pMemory, std::align_val_t) noexcept { FreeAligned(pMemory); }
+void operator delete[](void* pMemory, std::align_val_t) noexcept { FreeAligned(pMemory); }
+void operator delete(void* pMemory, size_t, std::align_val_t) noexcept { FreeAligned(pMemory); }
+void operator delete[](void* pMemory, size_t, std::align_val_t) noexcept { FreeAligned(pMemory); }
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Counts heap allocations per phase of a frame.
+// Only active when the game is built with GEOA_TRACK_ALLOCATIONS (cmake -DGEOA_TRACK_ALLOCATIONS=ON),
+// which replaces the global operator new, otherwise every count stays 0.
+namespace AllocationTracker
+{
+	enum class Phase : uint8_t
+	{
+		Other,
+		Input,
+		Simulation,
+		Snapshot,
+		Render,
+		Count
+	};
+
+	struct Counts
+	{
+		uint64_t allocations;
+		uint64_t bytes;
+	};
+
+	constexpr bool IsEnabled()
+	{
+#ifdef GEOA_TRACK_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	// called by operator new, adds the allocation to the phase of the calling thread
+	void OnAllocation(size_t size);
+
+	Counts GetCounts(Phase phase);
+	// all phases together
+	Counts GetTotalCounts();
+	void Reset();
+	const char* GetPhaseName(Phase phase);
+
+	// allocations on this thread count towards the given phase until the scope ends
+	class ScopedPhase final
+	{
+	public:
+		explicit ScopedPhase(Phase phase);
+		ScopedPhase(const ScopedPhase& other) = delete;
+		ScopedPhase& operator=(const ScopedPhase& other) = delete;
+		~ScopedPhase();
+
+	private:
+		Phase m_previousPhase;
+	};
+}
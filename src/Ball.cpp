@@ -1,12 +1,17 @@
 #include "Ball.h"
+#include "FastMath.h"
 #include "utils.h"
 #include <iostream>
-#include "BoundingBox.h"
+#include <SDL_opengl.h>
+#include "CushionSet.h"
+#include "FrameArena.h"
 #include "GAUtils.h"
 #include <algorithm>
+#include <array>
+#include <cmath>
 
 Ball::Ball(const ThreeBlade& pos, const Motor& velocity, bool isWhite)
-	:m_pos{ pos }, m_velocity{ velocity }, m_isWhiteBall{ isWhite }
+	:m_pos{ pos }, m_velocity{ velocity }, m_isWhiteBall{ isWhite }, m_id{ 0 }
 {
 	m_pos[2] = float(TOT_LIVES);
 	//m_pos[2] = 1.f;
@@ -16,25 +21,88 @@ void Ball::Draw() const
 {
 	const Ellipsef shape{ m_pos[0] / m_pos[3], m_pos[1] / m_pos[3], SIZE / 2, SIZE / 2};
 
-	if (m_isWhiteBall)
+	utils::SetColor(GetColor());
+	utils::FillEllipse(shape);
+
+	utils::SetColor(Color4f{ 1.f, 1.f, 1.f, 1.f });
+	//utils::DrawEllipse(shape);
+}
+
+void Ball::DrawBatch(const Ball* pBalls, int numBalls, float pixelsPerUnit)
+{
+	struct Vertex
+	{
+		float x;
+		float y;
+		uint8_t color[4];
+	};
+
+	if (numBalls <= 0) return;
+
+	// as many segments as Draw uses for the size the balls have on screen
+	const float radius{ SIZE / 2 };
+	const float screenRadius{ radius * pixelsPerUnit };
+	const bool isPoint{ screenRadius < 1.5f };
+	const int numSegments{ std::clamp(int(2 * screenRadius), 6, MAX_BATCH_SEGMENTS) };
+	std::array<Point2f, MAX_BATCH_SEGMENTS + 1> circle{};
+	for (int idx{}; idx <= numSegments; ++idx)
 	{
-		utils::SetColor(Color4f{ 1.f, 1.f, 1.f, 1.f });
+		const float angle{ 2.f * utils::g_Pi * idx / numSegments };
+		circle[idx] = Point2f{ radius * FastMath::Cos(angle), radius * FastMath::Sin(angle) };
 	}
-	else
+
+	ArenaVector<Vertex> vertices{ ArenaAllocator<Vertex>{ FrameArena::GetThreadArena() } };
+	vertices.reserve(size_t(numBalls) * (isPoint ? 1 : 3 * numSegments));
+	for (int ballIdx{}; ballIdx < numBalls; ++ballIdx)
 	{
-		const float healthValue{ m_pos[2] / m_pos[3] / TOT_LIVES };
-		utils::SetColor(Color4f{ healthValue * 0.6f + 0.4f, (1.f - healthValue) * 0.4f, (1.f - healthValue) * 0.2f, 1.f });
+		const Ball& ball{ pBalls[ballIdx] };
+		const float x{ ball.m_pos[0] / ball.m_pos[3] };
+		const float y{ ball.m_pos[1] / ball.m_pos[3] };
+		const Color4f color{ ball.GetColor() };
+		const Vertex center{ x, y, { uint8_t(color.r * 255), uint8_t(color.g * 255), uint8_t(color.b * 255), uint8_t(color.a * 255) } };
+		if (isPoint)
+		{
+			vertices.push_back(center);
+			continue;
+		}
+
+		for (int idx{}; idx < numSegments; ++idx)
+		{
+			Vertex edge{ center };
+			vertices.push_back(center);
+			edge.x = x + circle[idx].x;
+			edge.y = y + circle[idx].y;
+			vertices.push_back(edge);
+			edge.x = x + circle[idx + 1].x;
+			edge.y = y + circle[idx + 1].y;
+			vertices.push_back(edge);
+		}
 	}
-	utils::FillEllipse(shape);
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &vertices[0].x);
+	glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), &vertices[0].color);
+	if (isPoint) glPointSize(std::max(1.f, 2 * screenRadius));
+	glDrawArrays(isPoint ? GL_POINTS : GL_TRIANGLES, 0, GLsizei(vertices.size()));
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
 
 	utils::SetColor(Color4f{ 1.f, 1.f, 1.f, 1.f });
-	//utils::DrawEllipse(shape);
 }
 
-void Ball::Update(float elapsedSec, const BoundingBox* boundingBox, bool isFirstShot)
+Color4f Ball::GetColor() const
+{
+	if (m_isWhiteBall) return Color4f{ 1.f, 1.f, 1.f, 1.f };
+
+	const float healthValue{ m_pos[2] / m_pos[3] / TOT_LIVES };
+	return Color4f{ healthValue * 0.6f + 0.4f, (1.f - healthValue) * 0.4f, (1.f - healthValue) * 0.2f, 1.f };
+}
+
+void Ball::Update(float elapsedSec, const CushionSet* pCushions, bool isFirstShot, Integrator integrator)
 {
-	Move(elapsedSec);
-	CheckBoundingBoxCollision(boundingBox);
+	Move(elapsedSec, integrator);
+	CheckCushionCollision(pCushions, integrator);
 
 	// these values were slowly becoming invalid numbers, so set them back at their right values every frame
 	// (otherwise there would be energy losses after a while)
@@ -46,84 +114,6 @@ void Ball::Update(float elapsedSec, const BoundingBox* boundingBox, bool isFirst
 	m_pos[2] = std::clamp(m_pos[2], 1.f, FLT_MAX);
 }
 
-bool Ball::CheckParticleCollision(Ball& other, bool isFirstShot)
-{
-	// ignore the z-axis:
-	const ThreeBlade thisPos2D{ m_pos[0], m_pos[1], 0, 1 };
-	const ThreeBlade otherPos2D{ other.m_pos[0], other.m_pos[1], 0, 1 };
-
-	const TwoBlade rawJoinLine{ otherPos2D & thisPos2D };
-	const float distance{ rawJoinLine.Norm() };
-	const TwoBlade joinLine{ rawJoinLine.Normalized() };
-
-	// check if there is a collision
-	if (distance < SIZE)
-	{
-		//// calculate energy for debugging
-		//const float beforeEnergy1{ std::powf(m_velocity.VNorm() * 2, 2) };
-		//const float beforeEnergy2{ std::powf(other.m_velocity.VNorm() * 2, 2) };
-
-		// Calculate the new velocities
-		// ============================
-
-		// project velocity to be in the direction of the joinline (=> vanishing line is perpendicular to the line)
-		// reverse because the scalar value is negative
-		const Motor projectedVelocity{ -GAUtils::Reject(m_velocity, joinLine) };
-		const Motor projectedOtherVelocity{ -GAUtils::Reject(other.m_velocity, joinLine) };
-
-		// Add the inverted force of the other ball and the force of this ball to the current velocity
-		other.m_velocity = projectedVelocity * GAUtils::Scale(projectedOtherVelocity, -1.f) * other.m_velocity;
-		m_velocity = projectedOtherVelocity * GAUtils::Scale(projectedVelocity, -1.f) * m_velocity;
-
-		// Place the particles outside of eachother again
-		// ==========================================
-		
-		// Calculate the vector to offset the balls by taking the dot between the joinLine and the origin
-		// The result of this is an origin plane with a normal orthogonal to the line
-		// Multiplied by 2 to make it normalized
-		OneBlade offsetVector{ (joinLine | ThreeBlade{0, 0, 0, 1}) * 2 };
-		offsetVector = offsetVector / 2;
-
-		// calculate translation (add a small offset to avoid bouncing two times)
-		const float translationAmount{ (SIZE - distance) / 2 + 0.01f };
-
-		// Create offset motor and translate the particles
-		const Motor thisOffset{ GAUtils::TranslationFromOneBlade(translationAmount * offsetVector)};
-		m_pos = (thisOffset * m_pos * ~thisOffset).Grade3();
-
-		const Motor otherOffset{ GAUtils::TranslationFromOneBlade(-translationAmount * offsetVector)};
-		other.m_pos = (otherOffset * other.m_pos * ~otherOffset).Grade3();
-
-		//// calculate energy after (debug)
-		//const float afterEnergy1{ std::powf(m_velocity.VNorm() * 2, 2) };
-		//const float afterEnergy2{ std::powf(other.m_velocity.VNorm() * 2, 2) };
-		//const float energyDifference{ (afterEnergy1 + afterEnergy2) - (beforeEnergy1 + beforeEnergy2) };
-		//if (energyDifference > 10.f || energyDifference < -10.f)
-		//{
-		//	std::cout << "Energy difference! (" << energyDifference << " units)\n";
-		//}
-
-		// Remove 1 live for collisions with a red ball, and 3 for collisions with the white ball
-		// ============================
-		if (!isFirstShot)
-		{
-			if (m_isWhiteBall) other.m_pos[2] -= 3.f;
-			else
-			{
-				if (other.m_isWhiteBall) m_pos[2] -= 3.f;
-				else
-				{
-					m_pos[2] -= 1.f;
-					other.m_pos[2] -= 1.f;
-				}
-			}
-		}
-
-		return true;
-	}
-	return false;
-}
-
 void Ball::ApplyForce(const Motor& translationMotor)
 {
 	m_velocity = translationMotor * m_velocity;
@@ -134,6 +124,16 @@ bool Ball::IsMoving() const
 	return m_velocity.VNorm() > MIN_SPEED;
 }
 
+const ThreeBlade& Ball::GetPos() const
+{
+	return m_pos;
+}
+
+const Motor& Ball::GetVelocity() const
+{
+	return m_velocity;
+}
+
 ThreeBlade Ball::GetFlatPos() const
 {
 	return ThreeBlade{ m_pos[0], m_pos[1], 0, 1 };
@@ -144,18 +144,107 @@ int Ball::GetPoints() const
 	return int(m_pos[2]);
 }
 
-void Ball::Move(float elapsedSec)
+bool Ball::IsWhiteBall() const
+{
+	return m_isWhiteBall;
+}
+
+ThreeBlade Ball::PositionAt(float t) const
+{
+	if (!IsMoving()) return m_pos;
+
+	// the velocity decays as FRICTION^t, so the distance covered is its integral (FRICTION^t - 1) / ln(FRICTION)
+	const float time{ std::clamp(t, 0.f, GetStopTime()) };
+	const float distanceScale{ (FastMath::Pow(FRICTION, time) - 1.f) / std::log(FRICTION) };
+
+	// a single translation motor covers the whole path, like Move does for one frame
+	const Motor totMotor{ Motor::Exp(m_velocity.Grade2() * distanceScale) };
+	return totMotor.Sandwich(m_pos);
+}
+
+Motor Ball::VelocityAt(float t) const
+{
+	if (t >= GetStopTime()) return Motor{ 1, 0, 0, 0, 0, 0, 0, 0 };
+	return GAUtils::Scale(m_velocity, FastMath::Pow(FRICTION, std::max(t, 0.f)));
+}
+
+float Ball::GetStopTime() const
+{
+	if (!IsMoving()) return 0.f;
+	// solve |v| * FRICTION^t = MIN_SPEED
+	return std::log(MIN_SPEED / m_velocity.VNorm()) / std::log(FRICTION);
+}
+
+void Ball::LoseLives(int amount)
+{
+	m_pos[2] -= float(amount);
+}
+
+uint32_t Ball::GetId() const
+{
+	return m_id;
+}
+
+void Ball::SetId(uint32_t id)
+{
+	m_id = id;
+}
+
+Point2f Ball::GetLinearVelocity() const
+{
+	// a translation motor 1 + a*e01 + b*e02 moves a point by -2a along x and -2b along y
+	return Point2f{ -2.f * m_velocity[1], -2.f * m_velocity[2] };
+}
+
+void Ball::SetLinearVelocity(const Point2f& velocity)
 {
+	m_velocity = Motor{ 1, -velocity.x / 2, -velocity.y / 2, 0, 0, 0, 0, 0 };
+}
+
+void Ball::Translate(float x, float y)
+{
+	const Motor translation{ 1, -x / 2, -y / 2, 0, 0, 0, 0, 0 };
+	m_pos = translation.Sandwich(m_pos);
+}
+
+void Ball::SetState(const ThreeBlade& pos, const Motor& velocity)
+{
+	m_pos = pos;
+	m_velocity = velocity;
+}
+
+void Ball::Move(float elapsedSec, Integrator integrator)
+{
+	const float decay{ FastMath::Pow(FRICTION, elapsedSec) };
+
+	// how many seconds of the velocity at the start of the step the ball moves
+	float moveSeconds{ elapsedSec };
+	switch (integrator)
+	{
+	case Integrator::Euler:
+		break;
+	case Integrator::Midpoint:
+		moveSeconds = elapsedSec * std::sqrt(decay);
+		break;
+	case Integrator::ExactDecay:
+	{
+		// the integral of FRICTION^t over the step, or only until the ball stops when it drops below MIN_SPEED during it
+		const float moveTime{ m_velocity.VNorm() * decay < MIN_SPEED ? std::min(elapsedSec, GetStopTime()) : elapsedSec };
+		moveSeconds = std::expm1(moveTime * LOG_FRICTION) / LOG_FRICTION;
+		break;
+	}
+	}
+
 	// Calculate movement
 	// =================
-	Motor totMotor{ m_velocity * elapsedSec };
+	Motor totMotor{ m_velocity * moveSeconds };
 	totMotor[0] = 1.f; // manually set the norm back to one (so only the translation part is multiplied by elapsedSec)
 
 	// translate the particle with the velocity
-	m_pos = (totMotor * m_pos * ~totMotor).Grade3();
+	m_pos = totMotor.Sandwich(m_pos);
 
 	// Add friction by multiplying by elapsedSec and resetting the norm
-	m_velocity = GAUtils::Scale(m_velocity, std::powf(FRICTION, elapsedSec));
+	m_velocity = GAUtils::Scale(m_velocity, decay);
 
 	if (m_velocity.VNorm() < MIN_SPEED)
 	{
@@ -163,21 +252,36 @@ void Ball::Move(float elapsedSec)
 	}
 }
 
-void Ball::CheckBoundingBoxCollision(const BoundingBox* boundingBox, bool isFirstShot)
+void Ball::CheckCushionCollision(const CushionSet* pCushions, Integrator integrator, bool isFirstShot)
 {
-	OneBlade collisionPlane;
-	// check whether the ball collides and save the plane it hit when it did
-	if (boundingBox->Collides(m_pos, collisionPlane, SIZE / 2))
+	// a ball in a corner or against a pocket jaw touches several cushions at once
+	std::array<CushionSet::Contact, CushionSet::MAX_CONTACTS> contacts;
+	const int numContacts{ pCushions->FindContacts(m_pos, SIZE / 2, contacts.data(), int(contacts.size())) };
+
+	for (int idx{}; idx < numContacts; ++idx)
 	{
-		// project the position onto the plane
-		m_pos = GAUtils::Project(m_pos, collisionPlane);
-		// offset the ball with its radius
-		Motor offset{ GAUtils::TranslationFromOneBlade(-(SIZE / 2) * collisionPlane) };
-		m_pos = (offset * m_pos * ~offset).Grade3();
+		const OneBlade& collisionPlane{ contacts[idx].plane };
+
+		// only mirror the velocity when the ball moves into the cushion, so two cushions facing the same way don't undo each other
+		const Point2f velocity{ GetLinearVelocity() };
+		const bool isMovingIn{ velocity.x * collisionPlane[1] + velocity.y * collisionPlane[2] < 0.f };
+
+		// an earlier contact may already have pushed the ball out of this one
+		const float distance{ m_pos & collisionPlane };
+		if (distance < SIZE / 2)
+		{
+			// project the position onto the plane
+			m_pos = GAUtils::Project(m_pos, collisionPlane);
+			// offset the ball with its radius, or as far out as it went in when it bounces and the integrator keeps the distance
+			const float offsetDistance{ isMovingIn && integrator != Integrator::Euler ? SIZE - distance : SIZE / 2 };
+			Motor offset{ GAUtils::TranslationFromOneBlade(-offsetDistance * collisionPlane) };
+			m_pos = offset.Sandwich(m_pos);
+		}
+
+		if (!isMovingIn) continue;
 
 		// miror the velocity
-		MultiVector transformedVelocity{ collisionPlane * m_velocity * ~collisionPlane };
-		m_velocity = transformedVelocity.ToMotor();
+		m_velocity = collisionPlane.Sandwich(m_velocity);
 
 		// Remove a life when bouncing against a wall
 		if (!m_isWhiteBall && !isFirstShot) m_pos[2] -= 1.f;
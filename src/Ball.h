@@ -1,36 +1,85 @@
 #pragma once
 #include "FlyFish.h"
 #include "structs.h"
+#include <cstdint>
 #include <vector>
 
-class BoundingBox;
+class CushionSet;
 
 class Ball
 {
 public:
+	// how a step moves the ball while friction slows it down, chosen per simulation (see Table::SetIntegrator)
+	enum class Integrator : uint8_t
+	{
+		// moves with the velocity at the start of the step, the distance is only right for small steps.
+		// What the game has always done, so recorded shots replay the same
+		Euler,
+		// moves with the velocity halfway through the step, second order.
+		// This one and ExactDecay also bounce a ball that went into a cushion during the step back out as far as it went in,
+		// instead of leaving it against the cushion, so large steps don't lose distance at every bounce.
+		// Table splits a step for both so no ball moves more than its radius at a time (see Table::Update)
+		Midpoint,
+		// moves the distance the decaying velocity covers in closed form and stops where the ball drops below MIN_SPEED,
+		// the same path as PositionAt for any step as long as the ball hits nothing
+		ExactDecay
+	};
+
 	Ball(const ThreeBlade& pos, const Motor& velocity, bool isWhite = false);
 
 	void Draw() const;
-	void Update(float elapsedSec, const BoundingBox* boundingBox, bool isFirstShot = false);
-	bool CheckParticleCollision(Ball& other, bool isFirstShot = false);
+	// draws all balls with one draw call, pixelsPerUnit is the zoom of the view,
+	// balls smaller than about three pixels on screen are drawn as points. The vertices live in the FrameArena of the calling thread
+	static void DrawBatch(const Ball* pBalls, int numBalls, float pixelsPerUnit);
+	Color4f GetColor() const;
+	void Update(float elapsedSec, const CushionSet* pCushions, bool isFirstShot = false, Integrator integrator = Integrator::Euler);
 
 	void ApplyForce(const Motor& translationMotor);
 	bool IsMoving() const;
-	//ThreeBlade GetPos() const;
+	// the z coordinate of the position holds the lives of the ball
+	const ThreeBlade& GetPos() const;
+	const Motor& GetVelocity() const;
 	ThreeBlade GetFlatPos() const;
 	int GetPoints() const;
+	bool IsWhiteBall() const;
+	void LoseLives(int amount);
 
-	static constexpr float SIZE{ 30.f };
+	// stable identity of the ball on its table, used to recognize the same contact over several steps
+	uint32_t GetId() const;
+	void SetId(uint32_t id);
 
-private:
+	// the velocity motor as a plain 2D velocity in units per second, and back
+	Point2f GetLinearVelocity() const;
+	void SetLinearVelocity(const Point2f& velocity);
+	// move the ball without changing its velocity or lives
+	void Translate(float x, float y);
+
+	// where the ball will be / how fast it will go after t seconds if it doesn't hit anything,
+	// evaluated in closed form from the friction decay instead of stepping Update
+	ThreeBlade PositionAt(float t) const;
+	Motor VelocityAt(float t) const;
+	// time until the ball drops below MIN_SPEED and stops, 0 if it isn't moving
+	float GetStopTime() const;
+
+	// overwrite the raw state, e.g. when restoring a recorded table
+	void SetState(const ThreeBlade& pos, const Motor& velocity);
+
+	static constexpr float SIZE{ 30.f };
 	static constexpr int TOT_LIVES{ 20 };
+	// part of the velocity left after a second of rolling
 	static constexpr float FRICTION{ 0.6f };
+
+private:
+	// ln(FRICTION)
+	static constexpr float LOG_FRICTION{ -0.51082562f };
+	static constexpr int MAX_BATCH_SEGMENTS{ 32 };
 	static constexpr float MIN_SPEED{ 2.f };
 
 	ThreeBlade m_pos;
 	Motor m_velocity;
 	bool m_isWhiteBall;
+	uint32_t m_id;
 
-	void Move(float elapsedSec);
-	void CheckBoundingBoxCollision(const BoundingBox* boundingBox, bool isFirstShot = false);
+	void Move(float elapsedSec, Integrator integrator);
+	void CheckCushionCollision(const CushionSet* pCushions, Integrator integrator, bool isFirstShot = false);
 };
@@ -0,0 +1,248 @@
+#include "BatchRunner.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "Ball.h"
+#include "Log.h"
+
+namespace
+{
+	// quotes the text when it would break a CSV line
+	void WriteCsvText(std::ostream& output, const std::string& text)
+	{
+		if (text.find_first_of(",\"\n") == std::string::npos)
+		{
+			output << text;
+			return;
+		}
+
+		output << '"';
+		for (char character : text)
+		{
+			if (character == '"') output << '"';
+			output << character;
+		}
+		output << '"';
+	}
+
+	void WriteJsonText(std::ostream& output, const std::string& text)
+	{
+		output << '"';
+		for (char character : text)
+		{
+			if (character == '"' || character == '\\') output << '\\' << character;
+			else if (character == '\n') output << "\\n";
+			else output << character;
+		}
+		output << '"';
+	}
+}
+
+BatchRunner::BatchRunner(const std::string& directory)
+	: BatchRunner{ directory, Settings{ STEP_SECONDS, Ball::Integrator::Euler } }
+{
+}
+
+BatchRunner::BatchRunner(const std::string& directory, const Settings& settings)
+	: m_isLoaded{ false }
+	, m_settings{ settings }
+	, m_paths{}
+{
+	std::error_code error{};
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator{ directory, error })
+	{
+		if (entry.is_regular_file()) m_paths.push_back(entry.path().string());
+	}
+	if (error)
+	{
+		Log::Error("BatchRunner::BatchRunner( ), unable to read directory ", directory, ": ", error.message());
+		return;
+	}
+
+	std::sort(m_paths.begin(), m_paths.end());
+	m_isLoaded = true;
+}
+
+bool BatchRunner::IsLoaded() const
+{
+	return m_isLoaded;
+}
+
+int BatchRunner::GetNumScenarios() const
+{
+	return int(m_paths.size());
+}
+
+int BatchRunner::Run(std::ostream& output, Format format, int numThreads) const
+{
+	if (numThreads <= 0) numThreads = std::max(1, int(std::thread::hardware_concurrency()));
+	numThreads = std::min(numThreads, std::max(1, GetNumScenarios()));
+
+	WriteHeader(output, format);
+
+	// every worker takes the next scenario until there are none left, so slow scenarios don't hold up the others
+	std::atomic<size_t> nextScenario{ 0 };
+	std::atomic<int> numFailed{ 0 };
+	std::mutex outputMutex{};
+	const auto work{ [&]()
+		{
+			Scenario scenario{};
+			for (size_t idx{ nextScenario++ }; idx < m_paths.size(); idx = nextScenario++)
+			{
+				const std::string& path{ m_paths[idx] };
+				Result result{};
+				scenario.shots.clear();
+				if (LoadScenario(path, scenario))
+				{
+					result = RunScenario(scenario, m_settings);
+				}
+				else
+				{
+					++numFailed;
+				}
+				result.name = std::filesystem::path{ path }.filename().string();
+
+				// results are written in the order they finish, flushed so a long sweep can be followed while it runs
+				const std::lock_guard<std::mutex> lock{ outputMutex };
+				WriteResult(output, format, result);
+				output.flush();
+			}
+		} };
+
+	const auto startTime{ std::chrono::steady_clock::now() };
+	std::vector<std::thread> workers{};
+	for (int idx{ 1 }; idx < numThreads; ++idx)
+	{
+		workers.emplace_back(work);
+	}
+	work();
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+
+	const double wallSeconds{ std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() };
+	std::cerr << "ran " << m_paths.size() << " scenarios on " << numThreads << " threads in " << wallSeconds << " s ("
+		<< m_paths.size() / std::max(wallSeconds, 1e-9) << " scenarios/s), " << numFailed << " could not be loaded\n";
+	return numFailed;
+}
+
+bool BatchRunner::LoadScenario(const std::string& path, Scenario& scenario)
+{
+	std::ifstream file{ path };
+	if (!file)
+	{
+		Log::Error("BatchRunner::LoadScenario( ), unable to open ", path);
+		return false;
+	}
+
+	// the shot lines are taken out and everything else is a table layout,
+	// they are replaced by empty lines so the layout errors still point to the right line
+	std::string layoutText{};
+	std::string line{};
+	while (std::getline(file, line))
+	{
+		std::istringstream lineStream{ line };
+		std::string keyword{};
+		if (lineStream >> keyword && keyword == "shot")
+		{
+			Point2f shot{};
+			if (!(lineStream >> shot.x >> shot.y))
+			{
+				Log::Error("BatchRunner::LoadScenario( ), ", path, ": shot needs x and y");
+				return false;
+			}
+			scenario.shots.push_back(shot);
+			line.clear();
+		}
+		layoutText += line;
+		layoutText += '\n';
+	}
+
+	std::istringstream layoutStream{ layoutText };
+	std::vector<TableLayout> layouts{};
+	if (!TableLayout::ReadText(layoutStream, layouts)) return false;
+	if (layouts.size() != 1)
+	{
+		Log::Error("BatchRunner::LoadScenario( ), ", path, " has ", layouts.size(), " tables instead of one");
+		return false;
+	}
+
+	scenario.layout = std::move(layouts.front());
+	return true;
+}
+
+BatchRunner::Result BatchRunner::RunScenario(const Scenario& scenario, const Settings& settings)
+{
+	const auto startTime{ std::chrono::steady_clock::now() };
+	const uint64_t maxShotSteps{ uint64_t(MAX_SHOT_SECONDS / settings.stepSeconds) };
+
+	Result result{};
+	result.isLoaded = true;
+	result.hasSettled = true;
+
+	Table table{ scenario.layout };
+	table.SetIntegrator(settings.integrator);
+	const auto settle{ [&]()
+		{
+			uint64_t numSteps{};
+			while (table.AreBallsRolling() && numSteps < maxShotSteps)
+			{
+				table.Update(settings.stepSeconds);
+				++numSteps;
+			}
+			result.numSteps += numSteps;
+			result.hasSettled &= !table.AreBallsRolling();
+		} };
+
+	// a layout can start with rolling balls
+	settle();
+	for (const Point2f& shot : scenario.shots)
+	{
+		if (!result.hasSettled) break;
+
+		// a translation motor that gives a resting ball this velocity, like the cue hits it
+		table.ApplyShot(Motor{ 1, -shot.x / 2, -shot.y / 2, 0, 0, 0, 0, 0 });
+		++result.numShots;
+		settle();
+	}
+
+	result.points = table.GetPoints();
+	result.fouls = table.GetFouls();
+	result.numRedBallsLeft = int(table.GetRedBalls().size());
+	result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	return result;
+}
+
+void BatchRunner::WriteHeader(std::ostream& output, Format format)
+{
+	if (format == Format::Csv)
+	{
+		output << "scenario,loaded,points,white_ball_fouls,no_ball_hit_fouls,shots,steps,red_balls_left,settled,wall_ms\n";
+	}
+}
+
+void BatchRunner::WriteResult(std::ostream& output, Format format, const Result& result)
+{
+	const double wallMilliseconds{ result.wallSeconds * 1000.0 };
+	if (format == Format::Csv)
+	{
+		WriteCsvText(output, result.name);
+		output << ',' << result.isLoaded << ',' << result.points << ',' << result.fouls.whiteBallPocketed << ',' << result.fouls.noBallHit
+			<< ',' << result.numShots << ',' << result.numSteps << ',' << result.numRedBallsLeft << ',' << result.hasSettled << ',' << wallMilliseconds << '\n';
+		return;
+	}
+
+	output << "{\"scenario\":";
+	WriteJsonText(output, result.name);
+	output << std::boolalpha << ",\"loaded\":" << result.isLoaded << ",\"points\":" << result.points
+		<< ",\"white_ball_fouls\":" << result.fouls.whiteBallPocketed << ",\"no_ball_hit_fouls\":" << result.fouls.noBallHit
+		<< ",\"shots\":" << result.numShots << ",\"steps\":" << result.numSteps << ",\"red_balls_left\":" << result.numRedBallsLeft
+		<< ",\"settled\":" << result.hasSettled << ",\"wall_ms\":" << wallMilliseconds << std::noboolalpha << "}\n";
+}
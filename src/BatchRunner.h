@@ -0,0 +1,76 @@
+#pragma once
+#include "structs.h"
+#include "Table.h"
+#include "TableLayout.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Simulates every scenario file in a directory headlessly on all cores, and streams one result per scenario as soon as it is done.
+// A scenario file is a table layout with a single table (see TableLayout.h) plus the shots to play on it:
+//   shot <x> <y>    the velocity the white ball gets, in pixels per second, played once every ball has stopped
+class BatchRunner final
+{
+public:
+	enum class Format
+	{
+		Csv,
+		// one JSON object per line
+		JsonLines
+	};
+
+	struct Scenario
+	{
+		TableLayout layout;
+		std::vector<Point2f> shots;
+	};
+
+	struct Result
+	{
+		std::string name;
+		// false when the file isn't a valid scenario, the other values are then 0
+		bool isLoaded;
+		int points;
+		Table::Fouls fouls;
+		int numShots;
+		uint64_t numSteps;
+		int numRedBallsLeft;
+		// false when the balls were still rolling MAX_SHOT_SECONDS after a shot
+		bool hasSettled;
+		double wallSeconds;
+	};
+
+	// the same fixed step the game simulates with
+	static constexpr float STEP_SECONDS{ 1.f / 240.f };
+	static constexpr float MAX_SHOT_SECONDS{ 60.f };
+
+	// how every scenario is simulated, the game's own way by default.
+	// Ball::Integrator::ExactDecay keeps a rolling ball on its path with larger steps, but which balls collide and fall still
+	// changes with the step, so the points differ from the game's step (--benchmark timesteps shows how often)
+	struct Settings
+	{
+		float stepSeconds;
+		Ball::Integrator integrator;
+	};
+
+	explicit BatchRunner(const std::string& directory);
+	BatchRunner(const std::string& directory, const Settings& settings);
+
+	bool IsLoaded() const;
+	int GetNumScenarios() const;
+	// runs all scenarios on numThreads threads (0 uses every core), returns how many couldn't be loaded
+	int Run(std::ostream& output, Format format, int numThreads) const;
+
+	static bool LoadScenario(const std::string& path, Scenario& scenario);
+	static Result RunScenario(const Scenario& scenario, const Settings& settings);
+
+private:
+	bool m_isLoaded;
+	Settings m_settings;
+	// sorted, so the results of two runs can be compared
+	std::vector<std::string> m_paths;
+
+	static void WriteHeader(std::ostream& output, Format format);
+	static void WriteResult(std::ostream& output, Format format, const Result& result);
+};
@@ -0,0 +1,1403 @@
+#include "Benchmarks.h"
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "AccuracyReport.h"
+#include "Ball.h"
+#include "ContactSolver.h"
+#include "Cue.h"
+#include "CushionSet.h"
+#include "FlyFish.h"
+#include "FrameArena.h"
+#include "GAUtils.h"
+#include "ShotCache.h"
+#include "ShotPlanner.h"
+#include "Table.h"
+#include "TableLayout.h"
+#include "TablePack.h"
+#include "TableState.h"
+#include "TelemetryRecorder.h"
+#include "TrajectoryCodec.h"
+
+namespace
+{
+	using clock = std::chrono::steady_clock;
+
+	// runs the function in batches until the minimum time has passed, returns the calls per second
+	template <typename Function>
+	double MeasureRate(Function function, double minSeconds = 0.5)
+	{
+		const int batchSize{ 256 };
+		uint64_t calls{};
+		const clock::time_point start{ clock::now() };
+		double elapsed{};
+		do
+		{
+			for (int idx{}; idx < batchSize; ++idx)
+			{
+				function();
+			}
+			calls += batchSize;
+			elapsed = std::chrono::duration<double>(clock::now() - start).count();
+		} while (elapsed < minSeconds);
+
+		return calls / elapsed;
+	}
+
+	// element with the copy operations FlyFish used to have, to compare against
+	template <int DataSize>
+	class LegacyElement
+	{
+	public:
+		LegacyElement() noexcept
+		{
+		}
+		LegacyElement(const LegacyElement& other) noexcept
+		{
+			data = other.data;
+		}
+		LegacyElement& operator=(const LegacyElement& other) noexcept
+		{
+			if (this != &other)
+			{
+				data = other.data;
+			}
+			return *this;
+		}
+
+	private:
+		std::array<float, DataSize> data{};
+	};
+
+	// copies a large vector of elements over and over, returns the throughput in GB/s
+	template <typename Element>
+	double MeasureCopyThroughput()
+	{
+		const size_t numElements{ 1 << 16 };
+		const std::vector<Element> source(numElements);
+		std::vector<Element> destination(numElements);
+
+		const double copyRate{ MeasureRate([&]()
+			{
+				destination = source;
+			}, 0.25) };
+		return copyRate * numElements * sizeof(Element) / 1e9;
+	}
+
+	template <typename Element, int DataSize>
+	void PrintCopyThroughput(const char* name)
+	{
+		const double legacy{ MeasureCopyThroughput<LegacyElement<DataSize>>() };
+		const double current{ MeasureCopyThroughput<Element>() };
+		std::cout << "  " << name << ": " << legacy << " GB/s with hand-written copies, " << current << " GB/s trivially copyable ("
+			<< current / legacy << "x)\n";
+	}
+
+	// a table with the given amount of balls laid out in a grid
+	void FillTable(Table& table, int numBalls)
+	{
+		const Rectf& playArea{ table.GetPlayArea() };
+		const int numColumns{ int(playArea.width / Ball::SIZE) };
+
+		std::vector<Ball> redBalls{};
+		redBalls.reserve(numBalls - 1);
+		for (int idx{}; idx < numBalls - 1; ++idx)
+		{
+			const float x{ playArea.left + Ball::SIZE * (0.5f + idx % numColumns) };
+			const float y{ playArea.bottom + Ball::SIZE * (0.5f + idx / numColumns) * 0.1f };
+			redBalls.push_back(Ball{ ThreeBlade{ x, y, 0.f, 1.f }, Motor{ 1, 0, 0, 0, 0, 0, 0, 0 } });
+		}
+		table.SetState(redBalls, table.GetWhiteBall(), 0, false, false, false);
+	}
+
+	// a block of touching balls in hexagonal packing in front of the white ball
+	void FillCluster(Table& table, int numBalls)
+	{
+		const Rectf& playArea{ table.GetPlayArea() };
+		const int numRows{ 8 };
+		const float rowDistance{ Ball::SIZE * std::sqrt(3.f) / 2 };
+
+		std::vector<Ball> redBalls{};
+		redBalls.reserve(numBalls - 1);
+		for (int idx{}; idx < numBalls - 1; ++idx)
+		{
+			const int column{ idx / numRows };
+			const int row{ idx % numRows };
+			const float x{ playArea.left + playArea.width / 2 - column * rowDistance };
+			const float y{ playArea.bottom + playArea.height / 2 + (row - numRows / 2 + 0.5f * (column % 2)) * Ball::SIZE };
+			redBalls.push_back(Ball{ ThreeBlade{ x, y, 0.f, 1.f }, Motor{ 1, 0, 0, 0, 0, 0, 0, 0 } });
+		}
+		table.SetState(redBalls, table.GetWhiteBall(), 0, false, false, false);
+	}
+
+	// kinetic energy and momentum of all balls on the table, every ball weighs the same, and where the white ball is
+	struct Motion
+	{
+		double energy;
+		double momentumX;
+		double momentumY;
+		double whiteX;
+		double whiteY;
+	};
+
+	Motion GetMotion(const Table& table)
+	{
+		Motion motion{};
+		const auto add{ [&motion](const Ball& ball)
+			{
+				const Point2f velocity{ ball.GetLinearVelocity() };
+				motion.energy += 0.5 * (double(velocity.x) * velocity.x + double(velocity.y) * velocity.y);
+				motion.momentumX += velocity.x;
+				motion.momentumY += velocity.y;
+			} };
+		add(table.GetWhiteBall());
+		for (const Ball& ball : table.GetRedBalls())
+		{
+			add(ball);
+		}
+		const ThreeBlade whitePos{ table.GetWhiteBall().GetPos() };
+		motion.whiteX = whitePos[0];
+		motion.whiteY = whitePos[1];
+		return motion;
+	}
+
+	// one canned shot played at one time step with one integrator
+	struct ShotRun
+	{
+		// the motion every 1/SAMPLES_PER_SECOND of a second, until the balls stop
+		std::vector<Motion> motions;
+		uint64_t numSteps;
+		double updateSeconds;
+		// largest difference of the energy to E0 * FRICTION^(2t) while the white ball is on the table, relative to E0.
+		// cushions and ball collisions are elastic, so only the integration (and a ball falling into a pocket) changes it
+		double energyDrift;
+		// largest change in total momentum over the contact solve of a step with touching balls, relative to the shot
+		double momentumDrift;
+		int numContactSteps;
+		// how every shot ended, the points and red balls a batch run reports
+		std::vector<int> shotPoints;
+		std::vector<int> shotRedBallsLeft;
+	};
+
+	// divides every step rate the benchmarks use, 1/48 s included
+	constexpr int SAMPLES_PER_SECOND{ 6 };
+
+	// plays the shot from the start state until the balls stop, the table is left as the shot ends
+	ShotRun PlayCannedShot(Table& table, const TableState& start, const Motor& shot, int stepsPerSecond, Ball::Integrator integrator)
+	{
+		const float stepSeconds{ 1.f / stepsPerSecond };
+		const int stepsPerSample{ stepsPerSecond / SAMPLES_PER_SECOND };
+		const uint64_t maxSteps{ uint64_t(AccuracyReport::MAX_SHOT_SECONDS * stepsPerSecond) };
+
+		ShotRun run{};
+		table.SetIntegrator(integrator);
+		table.Restore(start);
+		table.ApplyShot(shot);
+		run.motions.push_back(GetMotion(table));
+		const Motion& startMotion{ run.motions.front() };
+		const double startEnergy{ std::max(startMotion.energy, 1e-9) };
+		const double startMomentum{ std::max(std::hypot(startMotion.momentumX, startMotion.momentumY), 1e-9) };
+		const int startWhitePocketed{ table.GetFouls().whiteBallPocketed };
+		const auto addEnergyDrift{ [&]()
+			{
+				if (table.GetFouls().whiteBallPocketed != startWhitePocketed) return;
+				const double expectedEnergy{ startEnergy * std::pow(double(Ball::FRICTION), 2.0 * run.numSteps / stepsPerSecond) };
+				run.energyDrift = std::max(run.energyDrift, std::abs(run.motions.back().energy - expectedEnergy) / startEnergy);
+			} };
+
+		const clock::time_point updateStart{ clock::now() };
+		while (table.AreBallsRolling() && run.numSteps < maxSteps)
+		{
+			table.Update(stepSeconds);
+			++run.numSteps;
+			const ContactSolver::Stats& contactStats{ table.GetContactStats() };
+			if (contactStats.numContacts > 0)
+			{
+				run.momentumDrift = std::max(run.momentumDrift, contactStats.momentumChange / startMomentum);
+				++run.numContactSteps;
+			}
+			if (run.numSteps % stepsPerSample == 0)
+			{
+				run.motions.push_back(GetMotion(table));
+				addEnergyDrift();
+			}
+		}
+		// the balls rest from here on, so where they stopped is where they are at the next sample
+		if (run.numSteps % stepsPerSample != 0)
+		{
+			run.motions.push_back(GetMotion(table));
+			addEnergyDrift();
+		}
+		run.updateSeconds = std::chrono::duration<double>(clock::now() - updateStart).count();
+		return run;
+	}
+}
+
+bool Benchmarks::Run(const std::string& name)
+{
+	const bool all{ name == "all" };
+	bool found{ all };
+
+	if (all || name == "tablestate")
+	{
+		RunTableState();
+		found = true;
+	}
+
+	if (all || name == "elementcopy")
+	{
+		RunElementCopy();
+		found = true;
+	}
+
+	if (all || name == "batch")
+	{
+		RunBatch();
+		found = true;
+	}
+
+	if (all || name == "products")
+	{
+		RunProducts();
+		found = true;
+	}
+
+	if (all || name == "trajectory")
+	{
+		RunTrajectory();
+		found = true;
+	}
+
+	if (all || name == "aimpreview")
+	{
+		RunAimPreview();
+		found = true;
+	}
+
+	if (all || name == "arena")
+	{
+		RunFrameArena();
+		found = true;
+	}
+
+	if (all || name == "contacts")
+	{
+		RunContacts();
+		found = true;
+	}
+
+	if (all || name == "cushions")
+	{
+		RunCushions();
+		found = true;
+	}
+
+	if (all || name == "tablepack")
+	{
+		RunTablePack();
+		found = true;
+	}
+
+	if (all || name == "sandbox")
+	{
+		RunSandbox();
+		found = true;
+	}
+
+	if (all || name == "planner")
+	{
+		RunPlanner();
+		found = true;
+	}
+
+	if (all || name == "shotcache")
+	{
+		RunShotCache();
+		found = true;
+	}
+
+	if (all || name == "telemetry")
+	{
+		RunTelemetry();
+		found = true;
+	}
+
+	if (all || name == "codec")
+	{
+		RunTrajectoryCodec();
+		found = true;
+	}
+
+	if (all || name == "timesteps")
+	{
+		RunTimesteps();
+		found = true;
+	}
+
+	if (!found)
+	{
+		std::cerr << "Benchmarks::Run( ), unknown benchmark " << name << '\n';
+	}
+	return found;
+}
+
+void Benchmarks::RunTableState()
+{
+	std::cout << "TableState snapshot / restore (" << sizeof(TableState) << " byte state)\n";
+
+	for (int numBalls : { 15, 1000 })
+	{
+		Table table{ Rectf{ 50.f, 50.f, 840.f, 420.f } };
+		FillTable(table, numBalls);
+
+		auto pState{ std::make_unique<TableState>() };
+		table.Snapshot(*pState);
+
+		const double snapshotRate{ MeasureRate([&]() { table.Snapshot(*pState); }) };
+		const double restoreRate{ MeasureRate([&]() { table.Restore(*pState); }) };
+
+		std::cout << "  " << numBalls << " balls: " << snapshotRate / 1e6 << " M snapshots/s, "
+			<< restoreRate / 1e6 << " M restores/s, " << snapshotRate * (pState->numRedBalls + 1) * sizeof(Ball) / 1e9 << " GB/s\n";
+	}
+}
+
+void Benchmarks::RunElementCopy()
+{
+	std::cout << "FlyFish bulk copy (vector assignment of " << (1 << 16) << " elements)\n";
+
+	PrintCopyThroughput<OneBlade, 4>("OneBlade");
+	PrintCopyThroughput<ThreeBlade, 4>("ThreeBlade");
+	PrintCopyThroughput<Motor, 8>("Motor");
+	PrintCopyThroughput<MultiVector, 16>("MultiVector");
+
+	// remove_if on the balls, like pocketing does every step
+	std::vector<Ball> balls{};
+	for (int idx{}; idx < 4096; ++idx)
+	{
+		balls.push_back(Ball{ ThreeBlade{ float(idx), 0.f, 0.f, 1.f }, Motor{ 1, 0, 0, 0, 0, 0, 0, 0 } });
+	}
+	std::vector<Ball> work{ balls };
+	const double removeRate{ MeasureRate([&]()
+		{
+			work = balls;
+			work.erase(std::remove_if(work.begin(), work.end(), [](const Ball& ball) { return int(ball.GetPos()[0]) % 7 == 0; }), work.end());
+		}, 0.25) };
+	std::cout << "  copy + remove_if of " << balls.size() << " balls: " << removeRate / 1e3 << " k/s\n";
+}
+
+void Benchmarks::RunBatch()
+{
+	const int numPoints{ 4096 };
+	std::cout << "FlyFish batch operations on " << numPoints << " points, per point operators vs GABatch\n";
+
+	std::vector<ThreeBlade> points{};
+	for (int idx{}; idx < numPoints; ++idx)
+	{
+		points.push_back(ThreeBlade{ float(idx % 64) * 13.f, float(idx / 64) * 7.f, float(idx % 5), 1.f });
+	}
+	const Motor motor{ Motor::Rotation(30.f, TwoBlade{ 0, 0, 0, 0, 0, 1 }) * Motor{ 1, -20.f, 35.f, 0, 0, 0, 0, 0 } };
+	const ThreeBlade origin{ 400.f, 200.f, 0.f, 1.f };
+	const OneBlade plane{ OneBlade{ -300.f, 0.6f, 0.8f, 0.f } };
+
+	// every result is kept, so the compiler can't leave out the work
+	std::vector<ThreeBlade> transformed(numPoints);
+	std::vector<ThreeBlade> batchTransformed(numPoints);
+	std::vector<TwoBlade> lines(numPoints);
+	std::vector<TwoBlade> batchLines(numPoints);
+	std::vector<float> distances(numPoints);
+	std::vector<float> batchDistances(numPoints);
+	const auto print{ [&](const char* name, double rate, double batchRate, float maxError)
+		{
+			std::cout << "  " << name << ": " << rate * numPoints / 1e6 << " M/s per point, " << batchRate * numPoints / 1e6
+				<< " M/s batched, largest difference " << maxError << '\n';
+		} };
+
+	const double transformRate{ MeasureRate([&]()
+		{
+			for (int idx{}; idx < numPoints; ++idx)
+			{
+				transformed[idx] = motor.Sandwich(points[idx]);
+			}
+		}, 0.25) };
+	const double batchTransformRate{ MeasureRate([&]() { GABatch::Transform(motor, points, batchTransformed); }, 0.25) };
+	float maxError{};
+	for (int idx{}; idx < numPoints; ++idx)
+	{
+		for (int component{}; component < 4; ++component)
+		{
+			maxError = std::max(maxError, std::fabs(transformed[idx][component] - batchTransformed[idx][component]));
+		}
+	}
+	print("transform", transformRate, batchTransformRate, maxError);
+
+	const double joinRate{ MeasureRate([&]()
+		{
+			for (int idx{}; idx < numPoints; ++idx)
+			{
+				lines[idx] = origin & points[idx];
+			}
+		}, 0.25) };
+	const double batchJoinRate{ MeasureRate([&]() { GABatch::Join(origin, points, batchLines); }, 0.25) };
+	maxError = 0.f;
+	for (int idx{}; idx < numPoints; ++idx)
+	{
+		for (int component{}; component < 6; ++component)
+		{
+			maxError = std::max(maxError, std::fabs(lines[idx][component] - batchLines[idx][component]));
+		}
+	}
+	print("join", joinRate, batchJoinRate, maxError);
+
+	// the distance as the length of the joining line, like the game code computes it
+	const double distanceRate{ MeasureRate([&]()
+		{
+			for (int idx{}; idx < numPoints; ++idx)
+			{
+				distances[idx] = (origin.Normalized() & points[idx].Normalized()).Norm();
+			}
+		}, 0.25) };
+	const double batchDistanceRate{ MeasureRate([&]() { GABatch::Distance(origin, points, batchDistances); }, 0.25) };
+	maxError = 0.f;
+	for (int idx{}; idx < numPoints; ++idx)
+	{
+		maxError = std::max(maxError, std::fabs(distances[idx] - batchDistances[idx]));
+	}
+	print("distance to a point", distanceRate, batchDistanceRate, maxError);
+
+	const double planeRate{ MeasureRate([&]()
+		{
+			for (int idx{}; idx < numPoints; ++idx)
+			{
+				distances[idx] = (points[idx].Normalized() & plane.Normalized());
+			}
+		}, 0.25) };
+	const double batchPlaneRate{ MeasureRate([&]() { GABatch::Distance(plane, points, batchDistances); }, 0.25) };
+	maxError = 0.f;
+	for (int idx{}; idx < numPoints; ++idx)
+	{
+		maxError = std::max(maxError, std::fabs(distances[idx] - batchDistances[idx]));
+	}
+	print("distance to a plane", planeRate, batchPlaneRate, maxError);
+}
+
+void Benchmarks::RunProducts()
+{
+	const int numElements{ 4096 };
+	std::cout << "FlyFish products on " << numElements << " elements, through MultiVector vs the tight result types\n";
+
+	std::vector<ThreeBlade> points{};
+	std::vector<TwoBlade> lines{};
+	std::vector<Motor> velocities{};
+	for (int idx{}; idx < numElements; ++idx)
+	{
+		points.push_back(ThreeBlade{ float(idx % 64) * 13.f, float(idx / 64) * 7.f, float(idx % 5), 1.f });
+		lines.push_back(TwoBlade{ float(idx % 7), float(idx % 11), 0.f, 0.f, 0.f, 1.f });
+		velocities.push_back(Motor{ 1, float(idx % 13) - 6.f, float(idx % 17) - 8.f, 0, 0, 0, 0, 0 });
+	}
+	const Motor motor{ Motor::Rotation(30.f, TwoBlade{ 0, 0, 0, 0, 0, 1 }) * Motor{ 1, -20.f, 35.f, 0, 0, 0, 0, 0 } };
+	const OneBlade plane{ OneBlade{ -300.f, 0.6f, 0.8f, 0.f } };
+
+	// the generic way: every operand widened to 16 floats, so every product is the full 16 x 16 one
+	const auto widen{ [](const auto& element)
+		{
+			MultiVector multiVector{};
+			multiVector = element;
+			return multiVector;
+		} };
+	const MultiVector wideMotor{ widen(motor) };
+	const MultiVector wideMotorInverse{ widen(~motor) };
+	const MultiVector widePlane{ widen(plane) };
+	const MultiVector widePlaneInverse{ widen(~plane) };
+
+	std::vector<ThreeBlade> pointResults(numElements);
+	std::vector<ThreeBlade> tightPointResults(numElements);
+	std::vector<TwoBlade> lineResults(numElements);
+	std::vector<TwoBlade> tightLineResults(numElements);
+	std::vector<Motor> motorResults(numElements);
+	std::vector<Motor> tightMotorResults(numElements);
+	const auto print{ [&](const char* name, double rate, double tightRate, float maxError)
+		{
+			std::cout << "  " << name << ": " << rate * numElements / 1e6 << " M/s through MultiVector, " << tightRate * numElements / 1e6
+				<< " M/s tight, largest difference " << maxError << '\n';
+		} };
+	const auto largestDifference{ [](const auto& first, const auto& second)
+		{
+			float maxError{};
+			for (size_t idx{}; idx < first.size(); ++idx)
+			{
+				auto pSecond{ second[idx].begin() };
+				for (const float value : first[idx])
+				{
+					maxError = std::max(maxError, std::fabs(value - *pSecond++));
+				}
+			}
+			return maxError;
+		} };
+
+	const double pointRate{ MeasureRate([&]()
+		{
+			for (int idx{}; idx < numElements; ++idx)
+			{
+				pointResults[idx] = (wideMotor * widen(points[idx]) * wideMotorInverse).Grade3();
+			}
+		}, 0.25) };
+	const double tightPointRate{ MeasureRate([&]()
+		{
+			for (int idx{}; idx < numElements; ++idx)
+			{
+				tightPointResults[idx] = motor.Sandwich(points[idx]);
+			}
+		}, 0.25) };
+	print("motor on a point", pointRate, tightPointRate, largestDifference(pointResults, tightPointResults));
+
+	const double lineRate{ MeasureRate([&]()
+		{
+			for (int idx{}; idx < numElements; ++idx)
+			{
+				lineResults[idx] = (wideMotor * widen(lines[idx]) * wideMotorInverse).Grade2();
+			}
+		}, 0.25) };
+	const double tightLineRate{ MeasureRate([&]()
+		{
+			for (int idx{}; idx < numElements; ++idx)
+			{
+				tightLineResults[idx] = motor.Sandwich(lines[idx]);
+			}
+		}, 0.25) };
+	print("motor on a line", lineRate, tightLineRate, largestDifference(lineResults, tightLineResults));
+
+	// what a ball does to its velocity when it bounces off a cushion
+	const double reflectRate{ MeasureRate([&]()
+		{
+			for (int idx{}; idx < numElements; ++idx)
+			{
+				motorResults[idx] = (widePlane * widen(velocities[idx]) * widePlaneInverse).ToMotor();
+			}
+		}, 0.25) };
+	const double tightReflectRate{ MeasureRate([&]()
+		{
+			for (int idx{}; idx < numElements; ++idx)
+			{
+				tightMotorResults[idx] = plane.Sandwich(velocities[idx]);
+			}
+		}, 0.25) };
+	print("plane on a motor", reflectRate, tightReflectRate, largestDifference(motorResults, tightMotorResults));
+
+	const double projectRate{ MeasureRate([&]()
+		{
+			for (int idx{}; idx < numElements; ++idx)
+			{
+				pointResults[idx] = (widen(points[idx] | plane) * widePlane).Grade3();
+			}
+		}, 0.25) };
+	const double tightProjectRate{ MeasureRate([&]()
+		{
+			for (int idx{}; idx < numElements; ++idx)
+			{
+				tightPointResults[idx] = GAUtils::Project(points[idx], plane);
+			}
+		}, 0.25) };
+	print("point onto a plane", projectRate, tightProjectRate, largestDifference(pointResults, tightPointResults));
+}
+
+void Benchmarks::RunTrajectory()
+{
+	std::cout << "Free ball trajectory, closed form vs stepping at 240 Hz\n";
+
+	// big enough that the ball never reaches a cushion
+	const CushionSet cushions{ CushionSet::CreateRectangle(Rectf{ -1e5f, -1e5f, 2e5f, 2e5f }) };
+	Ball ball{ ThreeBlade{ 100.f, 100.f, 0.f, 1.f }, Motor{ 1, 0, 0, 0, 0, 0, 0, 0 } };
+	ball.ApplyForce(Motor{ 1, -200.f, 120.f, 0, 0, 0, 0, 0 });
+
+	const float stepSeconds{ 1.f / 240 };
+	for (float time : { 0.5f, 2.f, ball.GetStopTime() })
+	{
+		const int numSteps{ int(time / stepSeconds) };
+		ThreeBlade stepped{};
+		const double stepRate{ MeasureRate([&]()
+			{
+				Ball moving{ ball };
+				for (int step{}; step < numSteps; ++step)
+				{
+					moving.Update(stepSeconds, &cushions);
+				}
+				stepped = moving.GetPos();
+			}, 0.25) };
+
+		ThreeBlade closed{};
+		const float queryTime{ numSteps * stepSeconds };
+		const double closedRate{ MeasureRate([&]()
+			{
+				closed = ball.PositionAt(queryTime);
+			}, 0.25) };
+
+		const float error{ std::sqrt((closed[0] - stepped[0]) * (closed[0] - stepped[0]) + (closed[1] - stepped[1]) * (closed[1] - stepped[1])) };
+		std::cout << "  t = " << queryTime << " s (" << numSteps << " steps): " << stepRate / 1e3 << " k stepped/s, "
+			<< closedRate / 1e6 << " M closed form/s, distance between them " << error << '\n';
+	}
+}
+
+void Benchmarks::RunAimPreview()
+{
+	std::cout << "Aim preview, recomputed for every mouse move vs reused\n";
+
+	for (int numBalls : { 15, 1000 })
+	{
+		Table table{ Rectf{ 50.f, 50.f, 840.f, 420.f } };
+		FillTable(table, numBalls);
+		Cue cue{ table.GetWhiteBallPtr() };
+
+		// circle the mouse around the white ball, far enough each call to pass the aim threshold
+		const ThreeBlade& ballPos{ table.GetWhiteBall().GetPos() };
+		int moveIdx{};
+		const auto moveMouse{ [&]()
+			{
+				const float angle{ 0.01f * (moveIdx++ % 628) };
+				cue.Update(Point2f{ ballPos[0] + 150.f * std::cos(angle), ballPos[1] + 150.f * std::sin(angle) }, false, clock::now());
+			} };
+
+		const double moveRate{ MeasureRate([&]()
+			{
+				moveMouse();
+				cue.UpdatePreview(table);
+			}, 0.25) };
+
+		const uint64_t computeCount{ cue.GetPreviewComputeCount() };
+		const double stillRate{ MeasureRate([&]() { cue.UpdatePreview(table); }, 0.25) };
+
+		std::cout << "  " << numBalls << " balls: " << 1e6 / moveRate << " us per moved preview, " << 1e6 / stillRate << " us per reused preview ("
+			<< cue.GetPreviewComputeCount() - computeCount << " recomputes while still)\n";
+	}
+}
+
+void Benchmarks::RunFrameArena()
+{
+	std::cout << "Per step scratch lists, std::vector vs FrameArena\n";
+
+	// a contact pair, like a broad phase would collect
+	struct Pair
+	{
+		int first;
+		int second;
+	};
+
+	FrameArena arena{};
+	for (int numPairs : { 16, 256, 4096 })
+	{
+		// a few lists of different sizes per step, built from scratch every step
+		const auto fillList{ [numPairs](auto& list)
+			{
+				for (int idx{}; idx < numPairs; ++idx)
+				{
+					list.push_back(Pair{ idx, idx + 1 });
+				}
+			} };
+
+		// keeps the lists from being optimized away
+		volatile int lastPair{};
+		const double vectorRate{ MeasureRate([&]()
+			{
+				std::vector<Pair> contacts{};
+				std::vector<Pair> candidates{};
+				fillList(contacts);
+				fillList(candidates);
+				lastPair = contacts.back().second + candidates.back().first;
+			}, 0.25) };
+
+		const double arenaRate{ MeasureRate([&]()
+			{
+				arena.Reset();
+				ArenaVector<Pair> contacts{ ArenaAllocator<Pair>{ arena } };
+				ArenaVector<Pair> candidates{ ArenaAllocator<Pair>{ arena } };
+				fillList(contacts);
+				fillList(candidates);
+				lastPair = contacts.back().second + candidates.back().first;
+			}, 0.25) };
+
+		std::cout << "  2 lists of " << numPairs << " pairs: " << vectorRate / 1e3 << " k steps/s with std::vector, " << arenaRate / 1e3
+			<< " k steps/s with the arena (" << arenaRate / vectorRate << "x, peak " << arena.GetPeak() / 1024 << " KiB, " << arena.GetOverflowCount()
+			<< " overflows)\n";
+	}
+}
+
+void Benchmarks::RunContacts()
+{
+	std::cout << "Contact solver, 2 s after the white ball hits a rack or a cluster at 1000 px/s\n";
+
+	const float stepSeconds{ 1.f / 240 };
+	const int numSteps{ 480 };
+	for (int scenario{}; scenario < 2; ++scenario)
+	{
+		const bool isRack{ scenario == 0 };
+		std::cout << (isRack ? "  rack of 15 balls\n" : "  cluster of 120 balls\n");
+
+		for (ContactSolver::Method method : { ContactSolver::Method::GaussSeidel, ContactSolver::Method::Jacobi })
+		{
+			for (int numIterations : { 1, 2, 4, 8 })
+			{
+				for (bool isWarmStarting : { false, true })
+				{
+					Table table{ Rectf{ 50.f, 50.f, 840.f, 420.f } };
+					if (!isRack) FillCluster(table, 121);
+					table.SetSolverSettings(ContactSolver::Settings{ method, numIterations, isWarmStarting, 1.f });
+					table.ApplyShot(Motor{ 1, 500.f, 10.f, 0, 0, 0, 0, 0 });
+
+					// residual overlap and approach speed after solving, averaged over the steps with contacts
+					double totalOverlap{};
+					double totalApproachSpeed{};
+					float maxOverlap{};
+					int numContactSteps{};
+					int numWarmStarted{};
+					double solveSeconds{};
+					for (int step{}; step < numSteps; ++step)
+					{
+						const clock::time_point start{ clock::now() };
+						table.Update(stepSeconds);
+						solveSeconds += std::chrono::duration<double>(clock::now() - start).count();
+
+						const ContactSolver::Stats& stats{ table.GetContactStats() };
+						if (stats.numContacts == 0) continue;
+						totalOverlap += stats.maxOverlap;
+						totalApproachSpeed += stats.maxApproachSpeed;
+						maxOverlap = std::max(maxOverlap, stats.maxOverlap);
+						numWarmStarted += stats.numWarmStarted;
+						++numContactSteps;
+					}
+
+					const int numAverageSteps{ std::max(numContactSteps, 1) };
+					std::cout << "    " << (method == ContactSolver::Method::GaussSeidel ? "Gauss-Seidel" : "Jacobi") << ", " << numIterations
+						<< " iterations, warm start " << (isWarmStarting ? "on: " : "off: ") << 1e6 * solveSeconds / numSteps << " us per step, overlap "
+						<< totalOverlap / numAverageSteps << " average " << maxOverlap << " max, approach speed " << totalApproachSpeed / numAverageSteps
+						<< " average, " << numWarmStarted << " warm started contacts\n";
+				}
+			}
+		}
+	}
+}
+
+void Benchmarks::RunCushions()
+{
+	std::cout << "Ball against cushion queries, CushionSet tree vs testing every segment\n";
+
+	const Point2f center{ 500.f, 500.f };
+	const float tableRadius{ 400.f };
+	const float ballRadius{ Ball::SIZE / 2 };
+	for (int numSegments : { 4, 64, 1024, 16384 })
+	{
+		// a round table, counterclockwise so the play side is inside
+		CushionSet::Outline outline{ {}, true };
+		for (int idx{}; idx < numSegments; ++idx)
+		{
+			const float angle{ 6.2831853f * idx / numSegments };
+			outline.points.push_back(Point2f{ center.x + tableRadius * std::cos(angle), center.y + tableRadius * std::sin(angle) });
+		}
+		const CushionSet cushions{ { outline } };
+
+		// balls along the rim, half of them touching it
+		std::vector<ThreeBlade> queries{};
+		for (int idx{}; idx < 256; ++idx)
+		{
+			const float angle{ 0.0245f * idx };
+			const float distance{ tableRadius - ballRadius * (idx % 2 == 0 ? 0.5f : 4.f) };
+			queries.push_back(ThreeBlade{ center.x + distance * std::cos(angle), center.y + distance * std::sin(angle), 0.f, 1.f });
+		}
+
+		std::array<CushionSet::Contact, CushionSet::MAX_CONTACTS> contacts{};
+		int queryIdx{};
+		// keeps the queries from being optimized away
+		volatile int numContacts{};
+		const double treeRate{ MeasureRate([&]()
+			{
+				numContacts = cushions.FindContacts(queries[queryIdx++ % queries.size()], ballRadius, contacts.data(), int(contacts.size()));
+			}, 0.25) };
+
+		const double linearRate{ MeasureRate([&]()
+			{
+				const ThreeBlade& query{ queries[queryIdx++ % queries.size()] };
+				int found{};
+				for (int idx{}; idx < numSegments; ++idx)
+				{
+					const Point2f& start{ outline.points[idx] };
+					const Point2f& end{ outline.points[(idx + 1) % numSegments] };
+					const float segmentX{ end.x - start.x };
+					const float segmentY{ end.y - start.y };
+					const float along{ std::clamp(((query[0] - start.x) * segmentX + (query[1] - start.y) * segmentY) / (segmentX * segmentX + segmentY * segmentY), 0.f, 1.f) };
+					const float deltaX{ query[0] - start.x - along * segmentX };
+					const float deltaY{ query[1] - start.y - along * segmentY };
+					if (deltaX * deltaX + deltaY * deltaY < ballRadius * ballRadius) ++found;
+				}
+				numContacts = found;
+			}, 0.25) };
+
+		std::cout << "  " << numSegments << " segments (" << cushions.GetNumNodes() << " nodes): " << 1e9 / treeRate << " ns per query with the tree, "
+			<< 1e9 / linearRate << " ns testing every segment (" << treeRate / linearRate << "x)\n";
+	}
+}
+
+void Benchmarks::RunTablePack()
+{
+	const int numTables{ 20000 };
+	std::cout << "Loading " << numTables << " table layouts, text vs memory-mapped table pack\n";
+
+	// the default table with the balls moved a little differently every time
+	std::vector<TableLayout> layouts{};
+	layouts.reserve(numTables);
+	for (int idx{}; idx < numTables; ++idx)
+	{
+		TableLayout layout{ TableLayout::CreateDefault(Rectf{ 50.f, 50.f, 840.f, 420.f }) };
+		layout.name = "scenario" + std::to_string(idx);
+		for (size_t ballIdx{}; ballIdx < layout.balls.size(); ++ballIdx)
+		{
+			layout.balls[ballIdx].pos.x += float((idx * 7 + ballIdx * 13) % 11) - 5.f;
+		}
+		layouts.push_back(std::move(layout));
+	}
+
+	const std::filesystem::path directory{ std::filesystem::temp_directory_path() };
+	const std::string textPath{ (directory / "geoa_tables.txt").string() };
+	const std::string packPath{ (directory / "geoa_tables.pack").string() };
+	{
+		std::ofstream textFile{ textPath };
+		for (const TableLayout& layout : layouts)
+		{
+			layout.WriteText(textFile);
+		}
+	}
+	TablePack::Write(packPath, layouts);
+
+	const auto measureSeconds{ [](auto function)
+		{
+			const clock::time_point start{ clock::now() };
+			function();
+			return std::chrono::duration<double>(clock::now() - start).count();
+		} };
+
+	std::vector<TableLayout> textLayouts{};
+	const double textSeconds{ measureSeconds([&]() { TableLayout::Load(textPath, textLayouts); }) };
+
+	// the pack only has to be mapped, every table is then read in place when it is needed
+	int numRedBalls{};
+	TableLayout packLayout{};
+	const double packSeconds{ measureSeconds([&]()
+		{
+			const TablePack pack{ packPath };
+			for (int idx{}; idx < pack.GetNumTables(); ++idx)
+			{
+				pack.GetLayout(idx, packLayout);
+				numRedBalls += int(packLayout.balls.size()) - 1;
+			}
+		}) };
+
+	const double tableSeconds{ measureSeconds([&]()
+		{
+			for (const TableLayout& layout : textLayouts)
+			{
+				const Table table{ layout };
+				numRedBalls += int(table.GetRedBalls().size());
+			}
+		}) };
+
+	std::cout << "  text: " << textSeconds * 1e3 << " ms (" << numTables / textSeconds / 1e3 << " k tables/s, " << std::filesystem::file_size(textPath) / 1024
+		<< " KiB)\n";
+	std::cout << "  pack: " << packSeconds * 1e3 << " ms (" << numTables / packSeconds / 1e3 << " k tables/s, " << std::filesystem::file_size(packPath) / 1024
+		<< " KiB, " << textSeconds / packSeconds << "x)\n";
+	std::cout << "  building a Table from each layout: " << tableSeconds * 1e3 << " ms (" << numTables / tableSeconds / 1e3 << " k tables/s, "
+		<< numRedBalls << " red balls in total)\n";
+
+	std::filesystem::remove(textPath);
+	std::filesystem::remove(packPath);
+}
+
+void Benchmarks::RunSandbox()
+{
+	std::cout << "Sandbox, the first second of simulation (or as much of it as fits in 2 s of wall time)\n";
+
+	const float stepSeconds{ 1.f / 240 };
+	for (int numBalls : { 100, 1000, 10000, TableLayout::MAX_SANDBOX_BALLS })
+	{
+		Table table{ TableLayout::CreateSandbox(Rectf{ 50.f, 50.f, 840.f, 420.f }, numBalls, 1) };
+
+		uint64_t numContacts{};
+		uint64_t numNewContacts{};
+		int numSteps{};
+		double updateSeconds{};
+		while (numSteps < 240 && updateSeconds < 2.0)
+		{
+			const clock::time_point start{ clock::now() };
+			table.Update(stepSeconds);
+			updateSeconds += std::chrono::duration<double>(clock::now() - start).count();
+			++numSteps;
+
+			const ContactSolver::Stats& stats{ table.GetContactStats() };
+			numContacts += stats.numContacts;
+			numNewContacts += stats.numNewContacts;
+		}
+
+		std::cout << "  " << numBalls << " balls: " << 1000.0 * updateSeconds / numSteps << " ms per step (" << 1e9 * updateSeconds / numSteps / numBalls
+			<< " ns per ball), " << double(numContacts) / numSteps << " contacts and " << double(numNewContacts) / numSteps << " collisions per step over "
+			<< numSteps << " steps\n";
+	}
+}
+
+void Benchmarks::RunPlanner()
+{
+	const int numShots{ 4 };
+	std::cout << "Shot planner, points after " << numShots << " planned shots on the default table (deadline 0 plays an untried candidate)\n";
+
+	const float stepSeconds{ 1.f / 240 };
+	const int numCores{ std::max(1, int(std::thread::hardware_concurrency())) };
+	for (int numThreads : { 1, numCores })
+	{
+		for (int deadline : { 0, 100, 500 })
+		{
+			Table table{ Rectf{ 50.f, 50.f, 840.f, 420.f } };
+			ShotPlanner::Settings settings{};
+			settings.deadline = std::chrono::milliseconds{ deadline };
+			settings.numThreads = numThreads;
+			ShotPlanner planner{ table, settings };
+
+			int numIterations{};
+			int numSimulatedShots{};
+			int numCachedShots{};
+			double planSeconds{};
+			for (int shot{}; shot < numShots; ++shot)
+			{
+				const clock::time_point start{ clock::now() };
+				const ShotPlanner::Result result{ planner.Plan(table) };
+				planSeconds += std::chrono::duration<double>(clock::now() - start).count();
+				numIterations += result.numIterations;
+				numSimulatedShots += result.numSimulatedShots;
+				numCachedShots += result.numCachedShots;
+
+				// play the shot in the game's own time step
+				table.ApplyShot(result.shot);
+				while (table.AreBallsRolling())
+				{
+					table.Update(stepSeconds);
+				}
+			}
+
+			std::cout << "  " << numThreads << (numThreads == 1 ? " thread, " : " threads, ") << deadline << " ms: " << table.GetPoints() << " points, "
+				<< table.GetRedBalls().size() << " red balls left, " << numIterations / numShots << " searches per plan, " << numSimulatedShots / std::max(planSeconds, 1e-9)
+				<< " simulated shots/s and " << numCachedShots / std::max(planSeconds, 1e-9) << " from the cache, " << 1000.0 * planSeconds / numShots << " ms per plan\n";
+		}
+		if (numCores == 1) break;
+	}
+}
+
+void Benchmarks::RunShotCache()
+{
+	std::cout << "Shot cache, the same shot against the same table\n";
+
+	const float stepSeconds{ 1.f / 240 };
+	const int numRepeats{ 20 };
+	Table table{ Rectf{ 50.f, 50.f, 840.f, 420.f } };
+	const std::unique_ptr<TableState> pStart{ std::make_unique<TableState>() };
+	const std::unique_ptr<TableState> pScratch{ std::make_unique<TableState>() };
+	table.Snapshot(*pStart);
+
+	// the first query misses and stores the simulated outcome, the others find it
+	ShotCache cache{};
+	const Motor shot{ Cue::CreateShot(0.1f, Cue::MAX_FORCE) };
+	double simulateSeconds{};
+	double cachedSeconds{};
+	for (int repeat{}; repeat < numRepeats; ++repeat)
+	{
+		table.Restore(*pStart);
+		const clock::time_point simulateStart{ clock::now() };
+		table.ApplyShot(shot);
+		while (table.AreBallsRolling())
+		{
+			table.Update(stepSeconds);
+		}
+		simulateSeconds += std::chrono::duration<double>(clock::now() - simulateStart).count();
+		const int points{ table.GetPoints() };
+		const std::shared_ptr<const ShotCache::Outcome> pSimulated{ ShotCache::CreateOutcome(table, pStart->points,
+			Table::Fouls{ pStart->whiteBallFouls, pStart->noBallHitFouls }) };
+
+		// what a query costs: hash the table, look up the shot and put the balls where they ended
+		table.Restore(*pStart);
+		const clock::time_point cachedStart{ clock::now() };
+		const ShotCache::Key key{ ShotCache::MakeKey(ShotCache::HashState(table), shot) };
+		const std::shared_ptr<const ShotCache::Outcome> pOutcome{ cache.Find(key) };
+		if (pOutcome) ShotCache::ApplyOutcome(*pOutcome, table, *pScratch);
+		cachedSeconds += std::chrono::duration<double>(clock::now() - cachedStart).count();
+
+		if (!pOutcome) cache.Insert(key, pSimulated);
+		else if (table.GetPoints() != points) std::cout << "  the cached outcome scores " << table.GetPoints() << " instead of " << points << '\n';
+	}
+
+	const ShotCache::Stats stats{ cache.GetStats() };
+	std::cout << "  simulated: " << 1000.0 * simulateSeconds / numRepeats << " ms per shot, cached: " << 1e6 * cachedSeconds / numRepeats
+		<< " us per shot, " << 100.f * stats.GetHitRate() << "% hits\n";
+
+	const int numShots{ 4 };
+	std::cout << "Shot planner with and without the cache, " << numShots << " planned shots with a 500 ms deadline\n";
+	for (size_t cacheCapacity : { ShotCache::DEFAULT_CAPACITY, size_t(0) })
+	{
+		Table plannerTable{ Rectf{ 50.f, 50.f, 840.f, 420.f } };
+		ShotPlanner::Settings settings{};
+		settings.deadline = std::chrono::milliseconds{ 500 };
+		settings.cacheCapacity = cacheCapacity;
+		ShotPlanner planner{ plannerTable, settings };
+
+		int numIterations{};
+		int numSimulatedShots{};
+		int numCachedShots{};
+		for (int shotIdx{}; shotIdx < numShots; ++shotIdx)
+		{
+			const ShotPlanner::Result result{ planner.Plan(plannerTable) };
+			numIterations += result.numIterations;
+			numSimulatedShots += result.numSimulatedShots;
+			numCachedShots += result.numCachedShots;
+
+			plannerTable.ApplyShot(result.shot);
+			while (plannerTable.AreBallsRolling())
+			{
+				plannerTable.Update(stepSeconds);
+			}
+		}
+
+		const ShotCache::Stats plannerStats{ planner.GetCacheStats() };
+		std::cout << "  " << (cacheCapacity > 0 ? "cache:    " : "no cache: ") << plannerTable.GetPoints() << " points, " << numIterations / numShots
+			<< " searches per plan, " << numSimulatedShots / numShots << " simulated and " << numCachedShots / numShots << " cached shots per plan, "
+			<< 100.f * plannerStats.GetHitRate() << "% hits, " << plannerStats.numEvictions << " evictions\n";
+	}
+}
+
+void Benchmarks::RunTelemetry()
+{
+	std::cout << "Telemetry, recording every ball after a step into a memory-mapped ring file\n";
+
+	const float stepSeconds{ 1.f / 240 };
+	const std::string path{ (std::filesystem::temp_directory_path() / "geoa_telemetry.bin").string() };
+	for (int numBalls : { 16, 1000, 10000 })
+	{
+		Table table{ TableLayout::CreateSandbox(Rectf{ 50.f, 50.f, 840.f, 420.f }, numBalls, 1) };
+
+		// the cost of the steps while the balls are still moving fast
+		const int numSteps{ 60 };
+		const clock::time_point start{ clock::now() };
+		for (int step{}; step < numSteps; ++step)
+		{
+			table.Update(stepSeconds);
+		}
+		const double stepMicroseconds{ 1e6 * std::chrono::duration<double>(clock::now() - start).count() / numSteps };
+
+		double recordRate{};
+		size_t recordSize{};
+		{
+			TelemetryRecorder recorder{ path, table };
+			if (!recorder.IsOk()) return;
+			recordRate = MeasureRate([&]() { recorder.RecordStep(table, stepSeconds); }, 0.25);
+			recordSize = sizeof(TelemetryLog::RecordHeader) + (table.GetRedBalls().size() + 1) * sizeof(TelemetryLog::BallState);
+		}
+
+		std::cout << "  " << table.GetRedBalls().size() + 1 << " balls: record " << 1e6 / recordRate << " us, step " << stepMicroseconds << " us ("
+			<< 100.0 * 1e6 / recordRate / stepMicroseconds << "% extra), " << recordRate * recordSize / 1e9 << " GB/s into the mapping\n";
+	}
+	std::filesystem::remove(path);
+}
+
+void Benchmarks::RunTrajectoryCodec()
+{
+	const size_t ballStateSize{ sizeof(ThreeBlade) + sizeof(Motor) };
+	std::cout << "Trajectory codec, every ball after every step compared to " << sizeof(TrajectoryCodec::Sample) << " bytes per ball as in a telemetry record ("
+		<< ballStateSize << " bytes of ThreeBlade and Motor)\n";
+
+	const float stepSeconds{ 1.f / 240 };
+	const Rectf playArea{ 50.f, 50.f, 840.f, 420.f };
+	for (int numBalls : { 0, 1000 })
+	{
+		// a few shots on the default table including the time the balls rest, or the sandbox breaking up
+		Table table{ numBalls == 0 ? TableLayout::CreateDefault(playArea) : TableLayout::CreateSandbox(playArea, numBalls, 1) };
+		const int numShots{ numBalls == 0 ? 6 : 1 };
+		const int numShotSteps{ numBalls == 0 ? 4000 : 1200 };
+
+		std::vector<TrajectoryCodec::Sample> samples{};
+		std::vector<size_t> stepStarts{ 0 };
+		const auto addSample{ [&](const Ball& ball)
+			{
+				const ThreeBlade& pos{ ball.GetPos() };
+				const Point2f velocity{ ball.GetLinearVelocity() };
+				samples.push_back(TrajectoryCodec::Sample{ ball.GetId(), pos[0], pos[1], pos[2], velocity.x, velocity.y });
+			} };
+		for (int shotIdx{}; shotIdx < numShots; ++shotIdx)
+		{
+			table.ApplyShot(Cue::CreateShot(0.7f * shotIdx, 0.8f * Cue::MAX_FORCE));
+			for (int step{}; step < numShotSteps; ++step)
+			{
+				table.Update(stepSeconds);
+				addSample(table.GetWhiteBall());
+				for (const Ball& ball : table.GetRedBalls())
+				{
+					addSample(ball);
+				}
+				stepStarts.push_back(samples.size());
+			}
+		}
+		const size_t numSteps{ stepStarts.size() - 1 };
+		const size_t rawBytes{ samples.size() * sizeof(TrajectoryCodec::Sample) };
+
+		std::string encoded{};
+		const clock::time_point encodeStart{ clock::now() };
+		{
+			std::ostringstream stream{};
+			TrajectoryEncoder encoder{ stream, playArea };
+			for (size_t step{}; step < numSteps; ++step)
+			{
+				encoder.AddStep(samples.data() + stepStarts[step], stepStarts[step + 1] - stepStarts[step]);
+			}
+			encoder.Finish();
+			encoded = stream.str();
+		}
+		const double encodeSeconds{ std::chrono::duration<double>(clock::now() - encodeStart).count() };
+
+		TrajectoryDecoder decoder{ reinterpret_cast<const uint8_t*>(encoded.data()), encoded.size() };
+		std::vector<TrajectoryCodec::Sample> decoded{};
+		float maxPositionError{};
+		float maxVelocityError{};
+		size_t numDecodedSteps{};
+		bool isSameBalls{ decoder.IsOk() };
+		const clock::time_point decodeStart{ clock::now() };
+		while (isSameBalls && decoder.NextStep(decoded))
+		{
+			const size_t start{ stepStarts[numDecodedSteps] };
+			isSameBalls = decoded.size() == stepStarts[numDecodedSteps + 1] - start;
+			for (size_t idx{}; isSameBalls && idx < decoded.size(); ++idx)
+			{
+				const TrajectoryCodec::Sample& original{ samples[start + idx] };
+				isSameBalls = original.id == decoded[idx].id && original.lives == decoded[idx].lives;
+				maxPositionError = std::max({ maxPositionError, std::abs(original.x - decoded[idx].x), std::abs(original.y - decoded[idx].y) });
+				maxVelocityError = std::max({ maxVelocityError, std::abs(original.velocityX - decoded[idx].velocityX),
+					std::abs(original.velocityY - decoded[idx].velocityY) });
+			}
+			++numDecodedSteps;
+		}
+		// the comparison is part of the time, it is small next to decoding
+		const double decodeSeconds{ std::chrono::duration<double>(clock::now() - decodeStart).count() };
+		isSameBalls &= numDecodedSteps == numSteps;
+
+		// random access, decoding from the keyframe before the step
+		const int numSeeks{ 200 };
+		std::mt19937 random{ 5 };
+		const clock::time_point seekStart{ clock::now() };
+		for (int seekIdx{}; isSameBalls && seekIdx < numSeeks; ++seekIdx)
+		{
+			const uint64_t step{ random() % numSteps };
+			isSameBalls = decoder.Seek(step) && decoder.NextStep(decoded) && decoded.size() == stepStarts[step + 1] - stepStarts[step]
+				&& decoded.back().id == samples[stepStarts[step + 1] - 1].id;
+		}
+		const double seekSeconds{ std::chrono::duration<double>(clock::now() - seekStart).count() };
+
+		if (!isSameBalls)
+		{
+			std::cout << "  " << numSteps << " steps: the decoded balls don't match the encoded ones\n";
+			continue;
+		}
+		std::cout << "  " << table.GetRedBalls().size() + 1 << " balls left, " << numSteps << " steps: " << rawBytes / 1e6 << " MB to " << encoded.size() / 1e6
+			<< " MB (" << double(rawBytes) / encoded.size() << "x, " << double(samples.size() * ballStateSize) / encoded.size() << "x of the ball state), encode " << rawBytes / 1e6 / encodeSeconds << " MB/s, decode " << rawBytes / 1e6 / decodeSeconds
+			<< " MB/s, largest error " << maxPositionError << " position and " << maxVelocityError << " velocity, seek " << 1e6 * seekSeconds / numSeeks << " us\n";
+	}
+}
+
+void Benchmarks::RunTimesteps()
+{
+	// steps per second, each one a divisor of the reference so the runs can be compared at the same times
+	const int referenceStepsPerSecond{ 7680 };
+	const std::array<int, 7> stepsPerSecondList{ 960, 480, 240, 120, 60, 48, 30 };
+	const Rectf playArea{ 50.f, 50.f, 840.f, 420.f };
+	const std::array<Ball::Integrator, 3> integrators{ Ball::Integrator::Euler, Ball::Integrator::Midpoint, Ball::Integrator::ExactDecay };
+	const auto getName{ [](Ball::Integrator integrator)
+		{
+			switch (integrator)
+			{
+			case Ball::Integrator::Midpoint: return "midpoint";
+			case Ball::Integrator::ExactDecay: return "exact";
+			default: return "euler";
+			}
+		} };
+
+	// the start state of every shot, while playing them as one game in the game's own time step
+	struct CannedShot
+	{
+		Motor shot;
+		std::unique_ptr<TableState> pStart;
+		std::unique_ptr<TableState> pAloneStart;
+		std::unique_ptr<TableState> pReferenceEnd;
+		std::unique_ptr<TableState> pAloneReferenceEnd;
+		ShotRun aloneReference;
+	};
+	std::vector<CannedShot> shots{};
+	Table table{ TableLayout::CreateDefault(playArea) };
+	// like AccuracyReport, the game ends with the last red ball
+	for (int shotIdx{}; shotIdx < AccuracyReport::NUM_CANNED_SHOTS && !table.GetRedBalls().empty(); ++shotIdx)
+	{
+		CannedShot shot{ AccuracyReport::CreateCannedShot(table, shotIdx), std::make_unique<TableState>(), std::make_unique<TableState>(),
+			std::make_unique<TableState>(), std::make_unique<TableState>(), ShotRun{} };
+		table.Snapshot(*shot.pStart);
+		PlayCannedShot(table, *shot.pStart, shot.shot, 240, Ball::Integrator::Euler);
+		shots.push_back(std::move(shot));
+	}
+
+	std::cout << "Time steps and integrators, " << shots.size() << " canned shots against a 1/" << referenceStepsPerSecond
+		<< " s reference with the exact decay, errors in units (a ball is " << Ball::SIZE << ")\n"
+		<< "  alone: the white ball of every shot without the red balls, where only the integration adds up\n"
+		<< "  path: largest distance of the lone white ball to the reference while rolling\n"
+		<< "  energy: largest difference of the lone white ball's energy to E0 * " << Ball::FRICTION << "^(2t), relative to E0\n"
+		<< "  ms per sim s: CPU time of the lone white ball, the same runs the alone errors and the Pareto front (*) come from\n"
+		<< "  table: the whole shot, the first collisions amplify any difference so far that the final positions mostly show how chaotic billiards is\n"
+		<< "  momentum: largest change in total momentum over a contact solve, which it conserves, relative to the shot\n";
+
+	Table referenceTable{ TableLayout::CreateDefault(playArea) };
+	for (CannedShot& shot : shots)
+	{
+		referenceTable.Restore(*shot.pStart);
+		referenceTable.SetState(std::vector<Ball>{}, referenceTable.GetWhiteBall(), 0, false, false, false);
+		referenceTable.Snapshot(*shot.pAloneStart);
+
+		PlayCannedShot(referenceTable, *shot.pStart, shot.shot, referenceStepsPerSecond, Ball::Integrator::ExactDecay);
+		referenceTable.Snapshot(*shot.pReferenceEnd);
+		shot.aloneReference = PlayCannedShot(referenceTable, *shot.pAloneStart, shot.shot, referenceStepsPerSecond, Ball::Integrator::ExactDecay);
+		referenceTable.Snapshot(*shot.pAloneReferenceEnd);
+	}
+
+	// how far the white ball strays from the reference along the way, it rests where the run ended
+	const auto getPathError{ [](const ShotRun& run, const ShotRun& reference)
+		{
+			double pathError{};
+			for (size_t idx{}; idx < std::max(run.motions.size(), reference.motions.size()); ++idx)
+			{
+				const Motion& motion{ run.motions[std::min(idx, run.motions.size() - 1)] };
+				const Motion& referenceMotion{ reference.motions[std::min(idx, reference.motions.size() - 1)] };
+				pathError = std::max(pathError, std::hypot(motion.whiteX - referenceMotion.whiteX, motion.whiteY - referenceMotion.whiteY));
+			}
+			return pathError;
+		} };
+
+	struct Row
+	{
+		Ball::Integrator integrator;
+		int stepsPerSecond;
+		// CPU time of the lone white ball per simulated second
+		double milliseconds;
+		double aloneError;
+		double alonePathError;
+		double energyDrift;
+		// CPU time of the whole table per simulated second
+		double tableMilliseconds;
+		double tableError;
+		int numDifferentShots;
+		double momentumDrift;
+		int numContactSteps;
+		// how every shot ended, the points and red balls a batch run reports
+		std::vector<int> shotPoints;
+		std::vector<int> shotRedBallsLeft;
+	};
+	// the lone ball takes too little time per run to measure once
+	const int numAloneRuns{ 20 };
+	std::vector<Row> rows{};
+	for (Ball::Integrator integrator : integrators)
+	{
+		for (int stepsPerSecond : stepsPerSecondList)
+		{
+			Row row{ integrator, stepsPerSecond, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0.0, 0, {}, {} };
+			uint64_t numAloneSteps{};
+			double aloneSeconds{};
+			uint64_t numSteps{};
+			double updateSeconds{};
+			bool isSameBalls{};
+			for (const CannedShot& shot : shots)
+			{
+				// averaged over the shots
+				const double weight{ 1.0 / shots.size() };
+
+				ShotRun alone{};
+				for (int runIdx{}; runIdx < numAloneRuns; ++runIdx)
+				{
+					alone = PlayCannedShot(table, *shot.pAloneStart, shot.shot, stepsPerSecond, integrator);
+					numAloneSteps += alone.numSteps;
+					aloneSeconds += alone.updateSeconds;
+				}
+				referenceTable.Restore(*shot.pAloneReferenceEnd);
+				row.aloneError += weight * AccuracyReport::GetMaxPositionError(table, referenceTable, isSameBalls);
+				row.alonePathError += weight * getPathError(alone, shot.aloneReference);
+				row.energyDrift = std::max(row.energyDrift, alone.energyDrift);
+
+				const ShotRun run{ PlayCannedShot(table, *shot.pStart, shot.shot, stepsPerSecond, integrator) };
+				numSteps += run.numSteps;
+				updateSeconds += run.updateSeconds;
+				referenceTable.Restore(*shot.pReferenceEnd);
+				row.tableError += weight * AccuracyReport::GetMaxPositionError(table, referenceTable, isSameBalls);
+				row.numDifferentShots += isSameBalls ? 0 : 1;
+				row.momentumDrift = std::max(row.momentumDrift, run.momentumDrift);
+				row.numContactSteps += run.numContactSteps;
+				row.shotPoints.push_back(table.GetPoints());
+				row.shotRedBallsLeft.push_back(int(table.GetRedBalls().size()));
+			}
+			row.milliseconds = 1000.0 * aloneSeconds / std::max(double(numAloneSteps) / stepsPerSecond, 1e-9);
+			row.tableMilliseconds = 1000.0 * updateSeconds / std::max(double(numSteps) / stepsPerSecond, 1e-9);
+			rows.push_back(row);
+		}
+	}
+
+	// cheapest first, a row is on the Pareto front (*) when its ball alone is more accurate than in every cheaper row
+	std::sort(rows.begin(), rows.end(), [](const Row& first, const Row& second) { return first.milliseconds < second.milliseconds; });
+	std::cout << "                                     alone                                        table\n"
+		<< "     integrator   step  ms per sim s    error     path      energy  ms per sim s    error  other balls  momentum (contact steps)\n"
+		<< std::fixed;
+	double bestError{ DBL_MAX };
+	for (const Row& row : rows)
+	{
+		const bool isPareto{ row.aloneError < bestError };
+		bestError = std::min(bestError, row.aloneError);
+		std::cout << (isPareto ? "  * " : "    ") << std::setw(11) << getName(row.integrator) << std::setw(7) << ("1/" + std::to_string(row.stepsPerSecond)) << std::setprecision(3)
+			<< std::setw(14) << row.milliseconds << std::setw(9) << row.aloneError << std::setw(9) << row.alonePathError
+			<< std::setprecision(6) << std::setw(11) << 100.0 * row.energyDrift << '%' << std::setprecision(3)
+			<< std::setw(14) << row.tableMilliseconds << std::setw(9) << row.tableError << std::setw(13) << row.numDifferentShots
+			<< std::setprecision(6) << std::setw(9) << 100.0 * row.momentumDrift << "% (" << row.numContactSteps << ")\n";
+	}
+	std::cout << std::defaultfloat;
+
+	// larger steps for --batch: how often the exact decay ends a shot like it does at the game's step, next to how often
+	// halving the game's step does, which is as close as the chaos of the collisions lets two step sizes get
+	const auto findRow{ [&rows](Ball::Integrator integrator, int stepsPerSecond)
+		{
+			return std::find_if(rows.begin(), rows.end(), [=](const Row& row) { return row.integrator == integrator && row.stepsPerSecond == stepsPerSecond; });
+		} };
+	const Row& gameRow{ *findRow(Ball::Integrator::ExactDecay, 240) };
+	std::cout << "  exact shots ending like exact at 1/240 s (same points and red balls left), mean points difference:\n";
+	for (int stepsPerSecond : { 480, 60, 48, 30 })
+	{
+		const Row& row{ *findRow(Ball::Integrator::ExactDecay, stepsPerSecond) };
+		int numSameShots{};
+		double pointsDifference{};
+		for (size_t idx{}; idx < shots.size(); ++idx)
+		{
+			numSameShots += row.shotPoints[idx] == gameRow.shotPoints[idx] && row.shotRedBallsLeft[idx] == gameRow.shotRedBallsLeft[idx] ? 1 : 0;
+			pointsDifference += std::abs(row.shotPoints[idx] - gameRow.shotPoints[idx]) / double(shots.size());
+		}
+		std::cout << "    1/" << stepsPerSecond << " s: " << numSameShots << " of " << shots.size() << " shots, " << pointsDifference << " points\n";
+	}
+
+	// the cheapest integrator and step that meet an accuracy bar on the ball alone
+	for (double bar : { 0.1, 1.0, 5.0 })
+	{
+		const auto found{ std::find_if(rows.begin(), rows.end(), [bar](const Row& row) { return row.aloneError <= bar; }) };
+		std::cout << "  alone error <= " << bar << ": ";
+		if (found == rows.end()) std::cout << "no step\n";
+		else std::cout << getName(found->integrator) << " at 1/" << found->stepsPerSecond << " s, " << found->milliseconds << " ms per simulated second\n";
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+
+// Micro benchmarks that run without a window, started with --benchmark <name>
+namespace Benchmarks
+{
+	// runs the benchmark with the given name ("all" runs every benchmark), returns false for an unknown name
+	bool Run(const std::string& name);
+
+	// Table::Snapshot / Table::Restore throughput at 15 and 1000 balls
+	void RunTableState();
+	// bulk copy throughput of FlyFish elements, compared to the old hand-written copy operations
+	void RunElementCopy();
+	// GABatch transform, join and distance over thousands of points compared to one operator call per point, and the largest difference
+	void RunBatch();
+	// motor and plane sandwiches and a projection through MultiVector products compared to the tight result types, and the largest difference
+	void RunProducts();
+	// Ball::PositionAt in closed form compared to stepping Ball::Update until the same time
+	void RunTrajectory();
+	// Cue::UpdatePreview cost when the aim moves every call compared to when it is reused, at 15 and 1000 balls
+	void RunAimPreview();
+	// building per step scratch lists in a std::vector compared to a FrameArena
+	void RunFrameArena();
+	// ContactSolver residual overlap and cost per step for both methods, different iteration counts and with or without warm starting
+	void RunContacts();
+	// CushionSet::FindContacts cost on round tables made of more and more segments, compared to testing every segment
+	void RunCushions();
+	// reading thousands of table layouts from text compared to a memory-mapped TablePack
+	void RunTablePack();
+	// Table::Update cost, contacts and collisions per step in the sandbox from 100 to 100000 balls
+	void RunSandbox();
+	// points the ShotPlanner scores in a few shots on the default table with different deadlines and thread counts
+	void RunPlanner();
+	// answering the same shot against an unchanged table from the ShotCache compared to simulating it, and the planner with and without the cache
+	void RunShotCache();
+	// TelemetryRecorder::RecordStep cost into a memory-mapped ring file compared to the simulation step it records, at 16 to 10000 balls
+	void RunTelemetry();
+	// TrajectoryEncoder / TrajectoryDecoder throughput, size compared to plain telemetry records, largest error and seek cost
+	void RunTrajectoryCodec();
+	// the canned shots at several time steps against a small-step reference: final and path position error, energy and momentum drift
+	// and cost per simulated second, as a Pareto table
+	void RunTimesteps();
+}
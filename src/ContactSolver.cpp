@@ -0,0 +1,353 @@
+#include "ContactSolver.h"
+#include <algorithm>
+#include <cmath>
+#include "Ball.h"
+
+ContactSolver::ContactSolver()
+	: ContactSolver{ Settings{} }
+{
+}
+
+ContactSolver::ContactSolver(const Settings& settings)
+	: m_settings{ settings }
+	, m_stats{}
+	, m_cache{}
+	, m_nextCache{}
+{
+}
+
+const ContactSolver::Settings& ContactSolver::GetSettings() const
+{
+	return m_settings;
+}
+
+void ContactSolver::SetSettings(const Settings& settings)
+{
+	m_settings = settings;
+}
+
+void ContactSolver::ClearCache()
+{
+	m_cache.clear();
+}
+
+void ContactSolver::Solve(Ball* const* pBalls, int numBalls, float elapsedSec, ArenaVector<ContactEvent>& events)
+{
+	// scratch data lives in the same arena as the events
+	FrameArena& arena{ *events.get_allocator().GetArena() };
+
+	ArenaVector<Body> bodies{ ArenaAllocator<Body>{ arena } };
+	bodies.reserve(numBalls);
+	for (int idx{}; idx < numBalls; ++idx)
+	{
+		const ThreeBlade& pos{ pBalls[idx]->GetPos() };
+		const Point2f velocity{ pBalls[idx]->GetLinearVelocity() };
+		bodies.push_back(Body{ pos[0] / pos[3], pos[1] / pos[3], velocity.x, velocity.y, 0 });
+	}
+	const ArenaVector<Body> startBodies{ bodies };
+
+	ArenaVector<Contact> contacts{ ArenaAllocator<Contact>{ arena } };
+	FindContacts(bodies, elapsedSec, contacts);
+
+	m_stats = Stats{};
+	m_stats.numContacts = int(contacts.size());
+
+	// start from the impulses of the previous step, bounces aren't part of them
+	for (Contact& contact : contacts)
+	{
+		contact.key = uint64_t(std::min(pBalls[contact.first]->GetId(), pBalls[contact.second]->GetId())) << 32
+			| std::max(pBalls[contact.first]->GetId(), pBalls[contact.second]->GetId());
+
+		const CachedContact* pCached{ FindCached(contact.key) };
+		if (m_settings.isWarmStarting && pCached && pCached->impulse > 0.f)
+		{
+			contact.impulse = pCached->impulse;
+			ApplyImpulse(bodies[contact.first], bodies[contact.second], contact, contact.impulse);
+			++m_stats.numWarmStarted;
+		}
+	}
+
+	SolveVelocities(bodies, contacts, elapsedSec);
+	SolvePositions(bodies, contacts);
+
+	// report the pairs that weren't touching in the previous step, and remember this step for the next one
+	m_nextCache.clear();
+	for (const Contact& contact : contacts)
+	{
+		const Body& first{ bodies[contact.first] };
+		const Body& second{ bodies[contact.second] };
+		const bool isTouching{ contact.gap < 0.f || contact.impulse > 0.f || contact.isBouncing };
+
+		const CachedContact* pCached{ FindCached(contact.key) };
+		if (isTouching && (!pCached || !pCached->isTouching))
+		{
+			events.push_back(ContactEvent{ contact.first, contact.second });
+			++m_stats.numNewContacts;
+		}
+		m_nextCache.push_back(CachedContact{ contact.key, contact.impulse, isTouching });
+
+		m_stats.maxOverlap = std::max(m_stats.maxOverlap, -GetGap(first, second));
+		if (GetGap(first, second) <= 0.f)
+		{
+			m_stats.maxApproachSpeed = std::max(m_stats.maxApproachSpeed, -GetNormalSpeed(first, second, contact));
+		}
+	}
+	std::sort(m_nextCache.begin(), m_nextCache.end(), [](const CachedContact& a, const CachedContact& b) { return a.key < b.key; });
+	m_cache.swap(m_nextCache);
+
+	// only the balls that had a contact changed
+	float momentumChangeX{};
+	float momentumChangeY{};
+	for (int idx{}; idx < numBalls; ++idx)
+	{
+		const Body& body{ bodies[idx] };
+		if (body.numContacts == 0) continue;
+
+		pBalls[idx]->Translate(body.x - startBodies[idx].x, body.y - startBodies[idx].y);
+		pBalls[idx]->SetLinearVelocity(Point2f{ body.velocityX, body.velocityY });
+		momentumChangeX += body.velocityX - startBodies[idx].velocityX;
+		momentumChangeY += body.velocityY - startBodies[idx].velocityY;
+	}
+	m_stats.momentumChange = std::hypot(momentumChangeX, momentumChangeY);
+}
+
+const ContactSolver::Stats& ContactSolver::GetStats() const
+{
+	return m_stats;
+}
+
+void ContactSolver::FindContacts(ArenaVector<Body>& bodies, float elapsedSec, ArenaVector<Contact>& contacts) const
+{
+	const float range{ Ball::SIZE + CONTACT_MARGIN };
+	const auto addContact{ [&bodies, &contacts, elapsedSec, range](int idx1, int idx2)
+		{
+			Body& first{ bodies[idx1] };
+			Body& second{ bodies[idx2] };
+
+			const float deltaX{ second.x - first.x };
+			const float deltaY{ second.y - first.y };
+			const float distanceSquared{ deltaX * deltaX + deltaY * deltaY };
+			if (distanceSquared >= range * range) return;
+
+			Contact contact{};
+			contact.first = idx1;
+			contact.second = idx2;
+
+			// balls exactly on top of each other get pushed apart along x
+			const float distance{ std::sqrt(distanceSquared) };
+			contact.normalX = distance > 0.f ? deltaX / distance : 1.f;
+			contact.normalY = distance > 0.f ? deltaY / distance : 0.f;
+			contact.gap = distance - Ball::SIZE;
+
+			// the balls may close the gap but not overlap, SolveVelocities adds a bounce when they hit each other
+			contact.targetSpeed = contact.gap > 0.f ? -contact.gap / elapsedSec : 0.f;
+			contact.isBouncing = false;
+
+			++first.numContacts;
+			++second.numContacts;
+			contacts.push_back(contact);
+		} };
+
+	const int numBodies{ int(bodies.size()) };
+	if (numBodies < GRID_MIN_BALLS)
+	{
+		for (int idx1{}; idx1 < numBodies; ++idx1)
+		{
+			for (int idx2{ idx1 + 1 }; idx2 < numBodies; ++idx2)
+			{
+				addContact(idx1, idx2);
+			}
+		}
+		return;
+	}
+
+	// Grid with cells as large as the contact range, so a ball only has to test the balls in the 3x3 cells around it.
+	// The cells are hashed into a power of two number of buckets, and the balls are counting sorted by bucket.
+	// Cells that share a bucket only cost extra distance tests.
+	FrameArena& arena{ *contacts.get_allocator().GetArena() };
+	uint32_t numBuckets{ 1 };
+	while (numBuckets < 2 * uint32_t(numBodies)) numBuckets *= 2;
+
+	const auto getCell{ [range](float coordinate) { return int32_t(std::floor(coordinate / range)); } };
+	const auto getBucket{ [numBuckets](int32_t cellX, int32_t cellY)
+		{
+			return ((uint32_t(cellX) * 73856093u) ^ (uint32_t(cellY) * 19349663u)) & (numBuckets - 1);
+		} };
+
+	ArenaVector<uint32_t> bodyBuckets{ ArenaAllocator<uint32_t>{ arena } };
+	bodyBuckets.resize(numBodies);
+	ArenaVector<int> bucketStarts{ ArenaAllocator<int>{ arena } };
+	bucketStarts.assign(numBuckets + 1, 0);
+	for (int idx{}; idx < numBodies; ++idx)
+	{
+		bodyBuckets[idx] = getBucket(getCell(bodies[idx].x), getCell(bodies[idx].y));
+		++bucketStarts[bodyBuckets[idx] + 1];
+	}
+	for (uint32_t bucket{}; bucket < numBuckets; ++bucket)
+	{
+		bucketStarts[bucket + 1] += bucketStarts[bucket];
+	}
+
+	ArenaVector<int> bucketBodies{ ArenaAllocator<int>{ arena } };
+	bucketBodies.resize(numBodies);
+	ArenaVector<int> bucketEnds{ bucketStarts.begin(), bucketStarts.end() - 1, ArenaAllocator<int>{ arena } };
+	for (int idx{}; idx < numBodies; ++idx)
+	{
+		bucketBodies[bucketEnds[bodyBuckets[idx]]++] = idx;
+	}
+
+	for (int idx1{}; idx1 < numBodies; ++idx1)
+	{
+		const int32_t cellX{ getCell(bodies[idx1].x) };
+		const int32_t cellY{ getCell(bodies[idx1].y) };
+
+		// neighbouring cells can share a bucket, every bucket is only visited once so no pair is added twice
+		uint32_t visited[9]{};
+		int numVisited{};
+		for (int32_t offsetY{ -1 }; offsetY <= 1; ++offsetY)
+		{
+			for (int32_t offsetX{ -1 }; offsetX <= 1; ++offsetX)
+			{
+				const uint32_t bucket{ getBucket(cellX + offsetX, cellY + offsetY) };
+				if (std::find(visited, visited + numVisited, bucket) != visited + numVisited) continue;
+				visited[numVisited++] = bucket;
+
+				for (int bucketIdx{ bucketStarts[bucket] }; bucketIdx < bucketStarts[bucket + 1]; ++bucketIdx)
+				{
+					const int idx2{ bucketBodies[bucketIdx] };
+					if (idx2 > idx1) addContact(idx1, idx2);
+				}
+			}
+		}
+	}
+
+	// the same order as testing every pair, so the Gauss-Seidel result doesn't depend on the broad-phase
+	std::sort(contacts.begin(), contacts.end(), [](const Contact& a, const Contact& b)
+		{
+			return a.first != b.first ? a.first < b.first : a.second < b.second;
+		});
+}
+
+const ContactSolver::CachedContact* ContactSolver::FindCached(uint64_t key) const
+{
+	const auto it{ std::lower_bound(m_cache.begin(), m_cache.end(), key, [](const CachedContact& cached, uint64_t key) { return cached.key < key; }) };
+	return (it != m_cache.end() && it->key == key) ? &*it : nullptr;
+}
+
+void ContactSolver::SolveVelocities(ArenaVector<Body>& bodies, ArenaVector<Contact>& contacts, float elapsedSec) const
+{
+	// returns the impulse to apply to the contact in this iteration, scaled down for Jacobi iterations
+	const float restitution{ m_settings.restitution };
+	const auto solveContact{ [&bodies, elapsedSec, restitution](Contact& contact, float scale)
+		{
+			const float normalSpeed{ GetNormalSpeed(bodies[contact.first], bodies[contact.second], contact) };
+
+			// the first time the balls hit each other during this step they bounce once, with the speed they hit at.
+			// This is decided here instead of up front, so a hit travels through a row of touching balls like in a Newton's cradle,
+			// and it isn't part of the accumulated impulse, so later iterations don't pull the balls back together
+			if (!contact.isBouncing && normalSpeed < -BOUNCE_THRESHOLD && contact.gap + normalSpeed * elapsedSec < 0.f)
+			{
+				contact.isBouncing = true;
+				return scale * (1.f + restitution) * -normalSpeed / 2;
+			}
+
+			// both balls have the same mass, so half of the missing speed goes to each of them,
+			// and the total impulse of a contact can only push
+			const float missingSpeed{ contact.targetSpeed - normalSpeed };
+			const float impulse{ std::max(contact.impulse + scale * missingSpeed / 2, 0.f) - contact.impulse };
+			contact.impulse += impulse;
+			return impulse;
+		} };
+
+	ArenaVector<float> impulses{ ArenaAllocator<float>{ *contacts.get_allocator().GetArena() } };
+	if (m_settings.method == Method::Jacobi) impulses.resize(contacts.size());
+
+	for (int iteration{}; iteration < m_settings.numIterations; ++iteration)
+	{
+		if (m_settings.method == Method::GaussSeidel)
+		{
+			for (Contact& contact : contacts)
+			{
+				ApplyImpulse(bodies[contact.first], bodies[contact.second], contact, solveContact(contact, 1.f));
+			}
+		}
+		else
+		{
+			// every contact is solved against the same velocities, then all of them are applied together,
+			// scaled down by the number of contacts of the busiest ball so clusters don't overshoot
+			for (size_t idx{}; idx < contacts.size(); ++idx)
+			{
+				Contact& contact{ contacts[idx] };
+				impulses[idx] = solveContact(contact, 1.f / std::max(bodies[contact.first].numContacts, bodies[contact.second].numContacts));
+			}
+			for (size_t idx{}; idx < contacts.size(); ++idx)
+			{
+				ApplyImpulse(bodies[contacts[idx].first], bodies[contacts[idx].second], contacts[idx], impulses[idx]);
+			}
+		}
+	}
+}
+
+void ContactSolver::SolvePositions(ArenaVector<Body>& bodies, const ArenaVector<Contact>& contacts) const
+{
+	// push overlapping balls apart along the line through their centers, half each
+	const auto getCorrection{ [&bodies](const Contact& contact)
+		{
+			return std::max(-GetGap(bodies[contact.first], bodies[contact.second]), 0.f) / 2;
+		} };
+	const auto applyCorrection{ [&bodies](const Contact& contact, float correction)
+		{
+			Body& first{ bodies[contact.first] };
+			Body& second{ bodies[contact.second] };
+			first.x -= contact.normalX * correction;
+			first.y -= contact.normalY * correction;
+			second.x += contact.normalX * correction;
+			second.y += contact.normalY * correction;
+		} };
+
+	ArenaVector<float> corrections{ ArenaAllocator<float>{ *contacts.get_allocator().GetArena() } };
+	if (m_settings.method == Method::Jacobi) corrections.resize(contacts.size());
+
+	for (int iteration{}; iteration < m_settings.numIterations; ++iteration)
+	{
+		if (m_settings.method == Method::GaussSeidel)
+		{
+			for (const Contact& contact : contacts)
+			{
+				applyCorrection(contact, getCorrection(contact));
+			}
+		}
+		else
+		{
+			for (size_t idx{}; idx < contacts.size(); ++idx)
+			{
+				const Contact& contact{ contacts[idx] };
+				corrections[idx] = getCorrection(contact) / std::max(bodies[contact.first].numContacts, bodies[contact.second].numContacts);
+			}
+			for (size_t idx{}; idx < contacts.size(); ++idx)
+			{
+				applyCorrection(contacts[idx], corrections[idx]);
+			}
+		}
+	}
+}
+
+void ContactSolver::ApplyImpulse(Body& first, Body& second, const Contact& contact, float impulse)
+{
+	first.velocityX -= contact.normalX * impulse;
+	first.velocityY -= contact.normalY * impulse;
+	second.velocityX += contact.normalX * impulse;
+	second.velocityY += contact.normalY * impulse;
+}
+
+float ContactSolver::GetNormalSpeed(const Body& first, const Body& second, const Contact& contact)
+{
+	return (second.velocityX - first.velocityX) * contact.normalX + (second.velocityY - first.velocityY) * contact.normalY;
+}
+
+float ContactSolver::GetGap(const Body& first, const Body& second)
+{
+	const float deltaX{ second.x - first.x };
+	const float deltaY{ second.y - first.y };
+	return std::sqrt(deltaX * deltaX + deltaY * deltaY) - Ball::SIZE;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "FrameArena.h"
+
+class Ball;
+
+// Resolves the collisions between balls for one step.
+// It collects every pair that touches (or will touch during the step), then runs a number of
+// Gauss-Seidel or Jacobi iterations over that list, first on the velocities and then on the overlaps.
+// The impulses of resting contacts are remembered per pair of ball ids, so a rack or cluster
+// starts the next step from the previous solution instead of from zero.
+class ContactSolver final
+{
+public:
+	enum class Method : uint8_t
+	{
+		// every contact sees the result of the contacts before it, converges fast but depends on the order
+		GaussSeidel,
+		// every contact sees the state at the start of the iteration, independent of the order
+		Jacobi
+	};
+
+	struct Settings
+	{
+		Method method{ Method::GaussSeidel };
+		int numIterations{ 4 };
+		bool isWarmStarting{ true };
+		// 1 keeps the old fully elastic collisions
+		float restitution{ 1.f };
+	};
+
+	// two balls (indices into the array given to Solve) that started touching during the step
+	struct ContactEvent
+	{
+		int first;
+		int second;
+	};
+
+	struct Stats
+	{
+		int numContacts;
+		// pairs that started touching during the step, the ones reported as events
+		int numNewContacts;
+		int numWarmStarted;
+		// largest overlap and approaching speed left after the last iteration
+		float maxOverlap;
+		float maxApproachSpeed;
+		// length of the change in total momentum of the touching balls, the impulses come in equal and opposite pairs so only rounding shows
+		float momentumChange;
+	};
+
+	// pairs closer than this are already in the contact list, so resting contacts keep their cached impulse
+	static constexpr float CONTACT_MARGIN{ 1.f };
+	// slower impacts than this don't bounce, so resting balls don't jitter
+	static constexpr float BOUNCE_THRESHOLD{ 4.f };
+	// from this many balls on the pairs are found with a grid instead of testing every pair
+	static constexpr int GRID_MIN_BALLS{ 64 };
+
+	ContactSolver();
+	explicit ContactSolver(const Settings& settings);
+
+	const Settings& GetSettings() const;
+	void SetSettings(const Settings& settings);
+	// forget the cached impulses, needed when the balls were replaced (restoring a state)
+	void ClearCache();
+
+	// moves the balls apart and changes their velocities in place
+	void Solve(Ball* const* pBalls, int numBalls, float elapsedSec, ArenaVector<ContactEvent>& events);
+
+	const Stats& GetStats() const;
+
+private:
+	struct Body
+	{
+		float x;
+		float y;
+		float velocityX;
+		float velocityY;
+		int numContacts;
+	};
+
+	struct Contact
+	{
+		int first;
+		int second;
+		uint64_t key;
+		// from the first ball to the second one
+		float normalX;
+		float normalY;
+		// distance between the surfaces, negative when they overlap
+		float gap;
+		// relative normal speed the contact has to reach, positive pushes the balls apart
+		float targetSpeed;
+		// accumulated impulse that keeps the balls from overlapping, without the bounce
+		float impulse;
+		// the balls already bounced off each other during this step
+		bool isBouncing;
+	};
+
+	struct CachedContact
+	{
+		uint64_t key;
+		float impulse;
+		bool isTouching;
+	};
+
+	Settings m_settings;
+	Stats m_stats;
+
+	// sorted by key, the contacts of the previous step and the ones being built for the next step
+	std::vector<CachedContact> m_cache;
+	std::vector<CachedContact> m_nextCache;
+
+	void FindContacts(ArenaVector<Body>& bodies, float elapsedSec, ArenaVector<Contact>& contacts) const;
+	const CachedContact* FindCached(uint64_t key) const;
+
+	void SolveVelocities(ArenaVector<Body>& bodies, ArenaVector<Contact>& contacts, float elapsedSec) const;
+	void SolvePositions(ArenaVector<Body>& bodies, const ArenaVector<Contact>& contacts) const;
+
+	static void ApplyImpulse(Body& first, Body& second, const Contact& contact, float impulse);
+	static float GetNormalSpeed(const Body& first, const Body& second, const Contact& contact);
+	static float GetGap(const Body& first, const Body& second);
+};
@@ -1,31 +1,52 @@
 #include "Cue.h"
 #include "SDL_mouse.h"
 #include "Ball.h"
+#include "CushionSet.h"
 #include "utils.h"
 #include "GAUtils.h"
+#include "Hole.h"
+#include "Log.h"
+#include "Table.h"
 #include <algorithm>
-#include <iostream>
+#include <cmath>
+#include <limits>
 
 Cue::Cue(Ball* pWhiteBall)
 	:m_pWhiteBall{ pWhiteBall }
 	, m_cuePos{ 0, 0, 0, 1 }
 	, m_prevCuePos{ 0, 0, 0, 1 }
+	, m_history{}
+	, m_historyCount{ 0 }
 	, m_isShooting{ false }
 	, m_shootOffset{ 0.f }
+	, m_hasTableGeometry{ false }
+	, m_pCushions{ nullptr }
+	, m_pockets{}
+	, m_preview{}
+	, m_hasPreview{ false }
+	, m_previewAim{}
+	, m_previewRevision{ 0 }
+	, m_previewComputeCount{ 0 }
 {
 }
 
-void Cue::Draw() const
+Cue::Snapshot Cue::GetSnapshot() const
+{
+	return Snapshot{ m_cuePos, m_pWhiteBall->GetFlatPos(), m_isShooting, m_preview };
+}
+
+void Cue::Draw(const Snapshot& snapshot)
 {
 	const float tipAngle{ 2.f }; // not actually the angle but proportional to it
 	const float cueLength{ 200.f };
 
-	const TwoBlade ballToCueLine{ (m_pWhiteBall->GetFlatPos() & m_cuePos) };
+	const ThreeBlade& cuePos{ snapshot.cuePos };
+	const TwoBlade ballToCueLine{ (snapshot.ballPos & cuePos) };
 	
-	const ThreeBlade cueBack1{ MovePointAlongLine(m_cuePos, cueLength, ballToCueLine, tipAngle) };
-	const ThreeBlade cueBack2{ MovePointAlongLine(m_cuePos, cueLength, ballToCueLine, -tipAngle) };
+	const ThreeBlade cueBack1{ MovePointAlongLine(cuePos, cueLength, ballToCueLine, tipAngle) };
+	const ThreeBlade cueBack2{ MovePointAlongLine(cuePos, cueLength, ballToCueLine, -tipAngle) };
 	
-	if (m_isShooting)
+	if (snapshot.isShooting)
 	{
 		utils::SetColor(Color4f{ 0.8, 0.4f, 0, 1 });
 	}
@@ -33,10 +54,36 @@ void Cue::Draw() const
 	{
 		utils::SetColor(Color4f{ 0.18f, 0.1f, 0, 1 });
 	}
-	utils::FillTriangle(Point2f{ m_cuePos[0], m_cuePos[1] }, Point2f{ cueBack1[0], cueBack1[1] }, Point2f{ cueBack2[0], cueBack2[1] });
+	utils::FillTriangle(Point2f{ cuePos[0], cuePos[1] }, Point2f{ cueBack1[0], cueBack1[1] }, Point2f{ cueBack2[0], cueBack2[1] });
+
+	// draw the aim preview
+	const AimPreview& preview{ snapshot.preview };
+	if (preview.numPathPoints < 2) return;
+
+	utils::SetColor(Color4f{ 1.f, 1.f, 1.f, 0.5f });
+	for (int idx{ 1 }; idx < preview.numPathPoints; ++idx)
+	{
+		utils::DrawLine(preview.path[idx - 1], preview.path[idx]);
+	}
+
+	if (preview.hasContact)
+	{
+		// outline of the white ball where it touches the red ball
+		utils::DrawEllipse(preview.contactPos, Ball::SIZE / 2, Ball::SIZE / 2);
+		utils::DrawLine(preview.contactPos, preview.whiteBallEnd);
+
+		utils::SetColor(Color4f{ 1.f, 0.6f, 0.4f, 0.7f });
+		utils::DrawLine(preview.objectBallPos, preview.objectBallEnd);
+	}
+
+	if (preview.hasPocket)
+	{
+		utils::SetColor(Color4f{ 1.f, 1.f, 0.3f, 0.8f });
+		utils::DrawEllipse(preview.pocketPos, Ball::SIZE / 2 + 3.f, Ball::SIZE / 2 + 3.f, 2.f);
+	}
 }
 
-void Cue::Update(const Point2f& mousePosPt, bool isShooting)
+void Cue::Update(const Point2f& mousePosPt, bool isShooting, std::chrono::steady_clock::time_point timestamp)
 {
 	m_isShooting = isShooting;
 
@@ -77,9 +124,49 @@ void Cue::Update(const Point2f& mousePosPt, bool isShooting)
 	}
 
 	m_cuePos = MovePointAlongLine(cueMiddlePos, moveDst, offsetLine);
+
+	m_history[m_historyCount % HISTORY_SIZE] = Sample{ m_cuePos, timestamp };
+	++m_historyCount;
 }
 
-bool Cue::CheckHitBall()
+void Cue::UpdatePreview(const Table& table)
+{
+	if (!m_hasTableGeometry) CacheTableGeometry(table);
+
+	// the white ball is shot away from the cue
+	const ThreeBlade ballPos3D{ m_pWhiteBall->GetFlatPos() };
+	const Point2f ballPos{ ballPos3D[0], ballPos3D[1] };
+	const Point2f aimVector{ ballPos.x - m_cuePos[0] / m_cuePos[3], ballPos.y - m_cuePos[1] / m_cuePos[3] };
+	const float aimLength{ std::sqrt(aimVector.x * aimVector.x + aimVector.y * aimVector.y) };
+	if (aimLength <= 0.f) return;
+	const Point2f aim{ aimVector.x / aimLength, aimVector.y / aimLength };
+
+	// keep the previous result while nothing moved and the aim only jittered
+	if (m_hasPreview && m_previewRevision == table.GetRevision()
+		&& std::abs(aim.x - m_previewAim.x) + std::abs(aim.y - m_previewAim.y) < AIM_THRESHOLD)
+	{
+		return;
+	}
+
+	ComputePreview(table, ballPos, aim);
+
+	m_hasPreview = true;
+	m_previewAim = aim;
+	m_previewRevision = table.GetRevision();
+	++m_previewComputeCount;
+}
+
+const Cue::AimPreview& Cue::GetPreview() const
+{
+	return m_preview;
+}
+
+uint64_t Cue::GetPreviewComputeCount() const
+{
+	return m_previewComputeCount;
+}
+
+bool Cue::CheckHitBall(Motor& shot)
 {
 	// check if the cue intersects the ball
 	const TwoBlade lineToBall{ (m_cuePos & m_pWhiteBall->GetFlatPos()) };
@@ -92,40 +179,207 @@ bool Cue::CheckHitBall()
 	if (cueIntersectsBall || movedThroughBall)
 	{
 		const float forceMultiplier{ 20.f };
-		const float maxForce{ 1500.f };
+
+		// measure the velocity of the cue over the real time between the samples instead of over one frame
+		const Sample& reference{ GetVelocityReference() };
+		const auto sampleDuration{ std::max<std::chrono::steady_clock::duration>(m_history[(m_historyCount - 1) % HISTORY_SIZE].timestamp - reference.timestamp, VELOCITY_WINDOW) };
+		const float timeScale{ REFERENCE_FRAME_TIME / std::chrono::duration<float>(sampleDuration).count() };
 
 		// get the line on which the cue is moving
-		const TwoBlade moveLine{ m_prevCuePos & m_cuePos };
+		const TwoBlade moveLine{ reference.pos & m_cuePos };
 		// get a plane perpendicular to the line through the point, counting as a translation vector
 		const OneBlade moveVector{ moveLine | m_pWhiteBall->GetFlatPos() };
 		// get the final translation with this vector oneblade
-		Motor translation{ GAUtils::TranslationFromOneBlade(moveVector) * forceMultiplier };
+		Motor translation{ GAUtils::TranslationFromOneBlade(moveVector * timeScale) * forceMultiplier };
 
 		// clamp the force to maxForce
 		const float force{ translation.VNorm() };
-		if (force > maxForce)
+		if (force > MAX_FORCE)
 		{
-			std::cout << force << std::endl;
-			translation *= (maxForce / force);
+			Log::Debug("Cue::CheckHitBall( ), force ", force, " clamped to ", MAX_FORCE);
+			translation *= (MAX_FORCE / force);
 		}
 
-		m_pWhiteBall->ApplyForce(translation);
+		shot = translation;
 
 		return true;
 	}
 	return false;
 }
 
+Motor Cue::CreateShot(float angle, float force)
+{
+	// a translation motor 1 + a*e01 + b*e02 moves the ball along -(a, b)
+	force = std::clamp(force, 0.f, MAX_FORCE);
+	return Motor{ 1, -force * std::cos(angle), -force * std::sin(angle), 0, 0, 0, 0, 0 };
+}
+
+const Cue::Sample& Cue::GetVelocityReference() const
+{
+	// walk back from the newest sample until the samples span the velocity window
+	const size_t newestIdx{ m_historyCount - 1 };
+	const size_t oldestIdx{ m_historyCount > HISTORY_SIZE ? m_historyCount - HISTORY_SIZE : 0 };
+	const auto newestTime{ m_history[newestIdx % HISTORY_SIZE].timestamp };
+
+	size_t idx{ newestIdx };
+	while (idx > oldestIdx && newestTime - m_history[idx % HISTORY_SIZE].timestamp < VELOCITY_WINDOW)
+	{
+		--idx;
+	}
+	return m_history[idx % HISTORY_SIZE];
+}
+
+void Cue::CacheTableGeometry(const Table& table)
+{
+	m_pCushions = &table.GetCushions();
+
+	m_pockets.clear();
+	for (const Hole& hole : table.GetHoles())
+	{
+		const ThreeBlade& pos{ hole.GetPos() };
+		m_pockets.push_back(Point2f{ pos[0] / pos[3], pos[1] / pos[3] });
+	}
+
+	m_hasTableGeometry = true;
+}
+
+void Cue::ComputePreview(const Table& table, const Point2f& ballPos, const Point2f& aim)
+{
+	const std::vector<Ball>& redBalls{ table.GetRedBalls() };
+	// two balls touch when their centers are a diameter apart
+	const float contactDistanceSquared{ Ball::SIZE * Ball::SIZE };
+
+	AimPreview& preview{ m_preview };
+	preview.numPathPoints = 1;
+	preview.path[0] = ballPos;
+	preview.hasContact = false;
+	preview.hasPocket = false;
+
+	Point2f start{ ballPos };
+	Point2f direction{ aim };
+	while (preview.numPathPoints < AimPreview::MAX_PATH_POINTS)
+	{
+		Point2f cushionNormal{};
+		float travelDistance{ DistanceToCushion(start, direction, cushionNormal) };
+
+		// first red ball that is touched along this segment
+		const Ball* pContactBall{ nullptr };
+		for (const Ball& ball : redBalls)
+		{
+			const ThreeBlade& pos{ ball.GetPos() };
+			const float toBallX{ pos[0] / pos[3] - start.x };
+			const float toBallY{ pos[1] / pos[3] - start.y };
+			const float alongRay{ toBallX * direction.x + toBallY * direction.y };
+			if (alongRay <= 0.f) continue;
+
+			const float offRaySquared{ toBallX * toBallX + toBallY * toBallY - alongRay * alongRay };
+			if (offRaySquared >= contactDistanceSquared) continue;
+
+			const float distance{ alongRay - std::sqrt(contactDistanceSquared - offRaySquared) };
+			if (distance >= 0.f && distance < travelDistance)
+			{
+				travelDistance = distance;
+				pContactBall = &ball;
+			}
+		}
+
+		Point2f pocketPos{};
+		const float pocketDistance{ DistanceToPocket(start, direction, travelDistance, pocketPos) };
+
+		const Point2f end{ start.x + direction.x * travelDistance, start.y + direction.y * travelDistance };
+		if (pocketDistance >= 0.f)
+		{
+			// the white ball falls in before it reaches anything else
+			preview.path[preview.numPathPoints++] = Point2f{ start.x + direction.x * pocketDistance, start.y + direction.y * pocketDistance };
+			preview.hasPocket = true;
+			preview.pocketPos = pocketPos;
+			return;
+		}
+
+		preview.path[preview.numPathPoints++] = end;
+
+		if (pContactBall)
+		{
+			const ThreeBlade& objectPos{ pContactBall->GetPos() };
+			preview.hasContact = true;
+			preview.contactPos = end;
+			preview.objectBallPos = Point2f{ objectPos[0] / objectPos[3], objectPos[1] / objectPos[3] };
+
+			// the red ball leaves along the line through both centers
+			const Point2f objectDirection{ (preview.objectBallPos.x - end.x) / Ball::SIZE, (preview.objectBallPos.y - end.y) / Ball::SIZE };
+			Point2f objectCushionNormal{};
+			const float objectDistance{ DistanceToCushion(preview.objectBallPos, objectDirection, objectCushionNormal) };
+			const float objectPocketDistance{ DistanceToPocket(preview.objectBallPos, objectDirection, objectDistance, pocketPos) };
+			if (objectPocketDistance >= 0.f)
+			{
+				preview.hasPocket = true;
+				preview.pocketPos = pocketPos;
+			}
+			const float objectLength{ objectPocketDistance >= 0.f ? objectPocketDistance : objectDistance };
+			preview.objectBallEnd = Point2f{ preview.objectBallPos.x + objectDirection.x * objectLength, preview.objectBallPos.y + objectDirection.y * objectLength };
+
+			// the white ball keeps the part of its direction perpendicular to that line, so a thin cut keeps more of its speed
+			const float alongObject{ direction.x * objectDirection.x + direction.y * objectDirection.y };
+			const Point2f whiteDirection{ direction.x - alongObject * objectDirection.x, direction.y - alongObject * objectDirection.y };
+			preview.whiteBallEnd = Point2f{ end.x + whiteDirection.x * DEFLECTION_LENGTH, end.y + whiteDirection.y * DEFLECTION_LENGTH };
+			return;
+		}
+
+		// bounce off the cushion, like the ball mirrors its velocity in the cushion plane
+		const float alongNormal{ direction.x * cushionNormal.x + direction.y * cushionNormal.y };
+		direction.x -= 2 * alongNormal * cushionNormal.x;
+		direction.y -= 2 * alongNormal * cushionNormal.y;
+		start = end;
+	}
+}
+
+float Cue::DistanceToCushion(const Point2f& start, const Point2f& direction, Point2f& cushionNormal) const
+{
+	CushionSet::RayHit hit{};
+	if (!m_pCushions->CastCircle(start, direction, Ball::SIZE / 2, MAX_TRAVEL_DISTANCE, hit))
+	{
+		cushionNormal = Point2f{ 0.f, 0.f };
+		return MAX_TRAVEL_DISTANCE;
+	}
+
+	cushionNormal = hit.normal;
+	return hit.distance;
+}
+
+float Cue::DistanceToPocket(const Point2f& start, const Point2f& direction, float maxDistance, Point2f& pocketPos) const
+{
+	// a ball falls in when its center comes within a radius of the pocket center
+	const float radiusSquared{ Ball::SIZE * Ball::SIZE / 4 };
+
+	float closest{ -1.f };
+	for (const Point2f& pocket : m_pockets)
+	{
+		const float toPocketX{ pocket.x - start.x };
+		const float toPocketY{ pocket.y - start.y };
+		const float alongRay{ toPocketX * direction.x + toPocketY * direction.y };
+		const float offRaySquared{ toPocketX * toPocketX + toPocketY * toPocketY - alongRay * alongRay };
+		if (offRaySquared >= radiusSquared) continue;
+
+		const float distance{ std::max(alongRay - std::sqrt(radiusSquared - offRaySquared), 0.f) };
+		if (alongRay > 0.f && distance <= maxDistance && (closest < 0.f || distance < closest))
+		{
+			closest = distance;
+			pocketPos = pocket;
+		}
+	}
+	return closest;
+}
+
 ThreeBlade Cue::MovePointAlongLine(const ThreeBlade& point, float distance, const TwoBlade& referenceLine, float angle)
 {
 	// rotate the line by the angle
 	const Motor rotator{ Motor::Rotation(angle, TwoBlade{0, 0, 0, 0, 0, 1}) };
-	const TwoBlade rotatedLine{ (rotator * referenceLine * ~rotator).Grade2() };
+	const TwoBlade rotatedLine{ rotator.Sandwich(referenceLine) };
 
 	// get a plane perpendicular to the line, used later as a vector to translate with
 	const OneBlade offsetDirectionVector{ (rotatedLine | ThreeBlade{0, 0, 0, 1}).Normalized()};
 
 	// get the translation to translation the point
 	const Motor translation{ GAUtils::TranslationFromOneBlade(offsetDirectionVector * distance) };
-	return (translation * point * ~translation).Grade3();
+	return translation.Sandwich(point);
 }
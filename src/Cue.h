@@ -1,26 +1,119 @@
 #pragma once
 #include "FlyFish.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <vector>
 #include "utils.h"
 
 class Ball;
+class CushionSet;
+class Table;
 
 class Cue
 {
 public:
 	explicit Cue(Ball* whiteBall);
 
-	void Draw() const;
-	void Update(const Point2f& mousePos, bool isShooting);
-	bool CheckHitBall();
+	// where the white ball goes when it is shot along the current aim line
+	struct AimPreview
+	{
+		static constexpr int MAX_PATH_POINTS{ 4 };
+
+		// the white ball path, bouncing off the cushions until it touches a red ball or falls in a pocket
+		std::array<Point2f, MAX_PATH_POINTS> path;
+		int numPathPoints;
+
+		// first red ball it touches: the white ball position at that moment and the lines both balls leave on
+		bool hasContact;
+		Point2f contactPos;
+		Point2f objectBallPos;
+		Point2f objectBallEnd;
+		Point2f whiteBallEnd;
+
+		// pocket the red ball (or the white ball, without a contact) is heading for
+		bool hasPocket;
+		Point2f pocketPos;
+	};
+
+	// everything needed to draw the cue, so it can be drawn without touching the live white ball
+	struct Snapshot
+	{
+		ThreeBlade cuePos;
+		ThreeBlade ballPos;
+		bool isShooting;
+		AimPreview preview;
+	};
+
+	Snapshot GetSnapshot() const;
+	static void Draw(const Snapshot& snapshot);
+	// move the cue to a mouse sample that was taken at the given time
+	void Update(const Point2f& mousePos, bool isShooting, std::chrono::steady_clock::time_point timestamp);
+	// bring the aim preview up to date with the cue and the table,
+	// only recomputed when the aim moved more than AIM_THRESHOLD or a ball moved
+	void UpdatePreview(const Table& table);
+	const AimPreview& GetPreview() const;
+	// how often the preview was actually recomputed
+	uint64_t GetPreviewComputeCount() const;
+	// returns true and gives the shot to apply to the white ball when the cue hits it
+	bool CheckHitBall(Motor& shot);
+	// the shot CheckHitBall gives for a cue moving along the angle (in radians, 0 along x) with the force, clamped to MAX_FORCE,
+	// so a computer player can shoot the same way as the mouse
+	static Motor CreateShot(float angle, float force);
+
+	// size of the translation part of the strongest shot, the white ball then leaves at twice this speed in pixels per second
+	static constexpr float MAX_FORCE{ 1500.f };
 private:
+	// a cue position and the time of the mouse sample it came from
+	struct Sample
+	{
+		ThreeBlade pos;
+		std::chrono::steady_clock::time_point timestamp;
+	};
+
+	// the shot velocity is measured over at least this much time, so samples that arrive in bursts don't cause spikes
+	static constexpr std::chrono::microseconds VELOCITY_WINDOW{ 8000 };
+	// the shot force used to be the cue movement of one frame at 60 fps, keep the same feel
+	static constexpr float REFERENCE_FRAME_TIME{ 1.f / 60.f };
+	static constexpr size_t HISTORY_SIZE{ 32 };
+	// difference between unit aim directions (about radians) below which the old preview is kept
+	static constexpr float AIM_THRESHOLD{ 0.0005f };
+	static constexpr float DEFLECTION_LENGTH{ 120.f };
+	// how far the preview follows a ball that doesn't reach a cushion, further than across any table
+	static constexpr float MAX_TRAVEL_DISTANCE{ 5000.f };
+
 	Ball* m_pWhiteBall;
 
 	ThreeBlade m_prevCuePos;
 	ThreeBlade m_cuePos;
 
+	// ring buffer of the most recent cue positions
+	std::array<Sample, HISTORY_SIZE> m_history;
+	size_t m_historyCount;
+
 	bool m_isShooting;
 	float m_shootOffset;
 
+	// the cushions and pockets never move, so they are only read from the table once
+	bool m_hasTableGeometry;
+	const CushionSet* m_pCushions;
+	std::vector<Point2f> m_pockets;
+
+	// the preview and the aim and table revision it was computed for
+	AimPreview m_preview;
+	bool m_hasPreview;
+	Point2f m_previewAim;
+	uint32_t m_previewRevision;
+	uint64_t m_previewComputeCount;
+
+	const Sample& GetVelocityReference() const;
+	void CacheTableGeometry(const Table& table);
+	void ComputePreview(const Table& table, const Point2f& ballPos, const Point2f& aim);
+	// distance a ball rolling along the ray goes until it touches a cushion, and the normal of that cushion
+	float DistanceToCushion(const Point2f& start, const Point2f& direction, Point2f& cushionNormal) const;
+	// distance along the ray until it comes within radius of a pocket, returns -1 when it misses all of them
+	float DistanceToPocket(const Point2f& start, const Point2f& direction, float maxDistance, Point2f& pocketPos) const;
+
 	static ThreeBlade MovePointAlongLine(const ThreeBlade& point, float distance, const TwoBlade& referenceLine, float angle = 0.f);
 };
\ No newline at end of file
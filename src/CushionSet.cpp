@@ -0,0 +1,326 @@
+#include "CushionSet.h"
+#include "Log.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+CushionSet::CushionSet(const std::vector<Outline>& outlines)
+	: m_outlines{ outlines }
+	, m_segments{}
+	, m_corners{}
+	, m_primitives{}
+	, m_nodes{}
+{
+	for (const Outline& outline : outlines)
+	{
+		AddOutline(outline);
+	}
+
+	m_primitives.reserve(m_segments.size() + m_corners.size());
+	for (int idx{}; idx < int(m_segments.size()); ++idx)
+	{
+		const Segment& segment{ m_segments[idx] };
+		const Point2f end{ segment.start.x + segment.direction.x * segment.length, segment.start.y + segment.direction.y * segment.length };
+		m_primitives.push_back(Primitive{ idx, false,
+			std::min(segment.start.x, end.x), std::min(segment.start.y, end.y), std::max(segment.start.x, end.x), std::max(segment.start.y, end.y) });
+	}
+	for (int idx{}; idx < int(m_corners.size()); ++idx)
+	{
+		const Point2f& corner{ m_corners[idx] };
+		m_primitives.push_back(Primitive{ idx, true, corner.x, corner.y, corner.x, corner.y });
+	}
+
+	if (m_primitives.empty())
+	{
+		Log::Error("CushionSet::CushionSet( ), the table has no cushions");
+		return;
+	}
+
+	// every leaf holds at least one primitive, so there are less than twice as many nodes as primitives
+	m_nodes.reserve(2 * m_primitives.size());
+	BuildNode(0, int(m_primitives.size()));
+}
+
+CushionSet CushionSet::CreateRectangle(const Rectf& playArea)
+{
+	const float right{ playArea.left + playArea.width };
+	const float top{ playArea.bottom + playArea.height };
+	return CushionSet{ { Outline{ { Point2f{ playArea.left, playArea.bottom }, Point2f{ right, playArea.bottom }, Point2f{ right, top }, Point2f{ playArea.left, top } }, true } } };
+}
+
+int CushionSet::FindContacts(const ThreeBlade& center, float radius, Contact* pContacts, int maxContacts) const
+{
+	const float x{ center[0] / center[3] };
+	const float y{ center[1] / center[3] };
+
+	int numContacts{};
+	ForEachOverlapping(x - radius, y - radius, x + radius, y + radius, [&](const Primitive& primitive)
+		{
+			if (numContacts >= maxContacts) return;
+
+			if (primitive.isCorner)
+			{
+				// the corner pushes the ball away from it, along the line through the corner and the center
+				const Point2f& corner{ m_corners[primitive.index] };
+				const float deltaX{ x - corner.x };
+				const float deltaY{ y - corner.y };
+				const float distance{ std::sqrt(deltaX * deltaX + deltaY * deltaY) };
+				if (distance >= radius || distance <= 0.f) return;
+
+				const float normalX{ deltaX / distance };
+				const float normalY{ deltaY / distance };
+				pContacts[numContacts++] = Contact{ OneBlade{ -(normalX * corner.x + normalY * corner.y), normalX, normalY, 0 }, radius - distance };
+				return;
+			}
+
+			// only the part of the line next to the segment counts, the corners take care of the ends
+			const Segment& segment{ m_segments[primitive.index] };
+			const float alongSegment{ (x - segment.start.x) * segment.direction.x + (y - segment.start.y) * segment.direction.y };
+			if (alongSegment < 0.f || alongSegment > segment.length) return;
+
+			// a ball that went less than a radius through the cushion in one step is still pushed back to the play side
+			const float distance{ center & segment.plane };
+			if (distance >= radius || distance <= -radius) return;
+
+			pContacts[numContacts++] = Contact{ segment.plane, radius - distance };
+		});
+
+	return numContacts;
+}
+
+bool CushionSet::CastCircle(const Point2f& start, const Point2f& direction, float radius, float maxDistance, RayHit& hit) const
+{
+	if (m_nodes.empty()) return false;
+
+	// slab test of the ray against a node box grown by the radius, returns the distance where the ray enters it
+	// an axis aligned ray gets a huge instead of an infinite inverse, so the slab test doesn't produce NaN
+	const float inverseX{ 1.f / (direction.x != 0.f ? direction.x : 1e-30f) };
+	const float inverseY{ 1.f / (direction.y != 0.f ? direction.y : 1e-30f) };
+	const auto enterDistance{ [&](const Node& node)
+		{
+			const float x1{ (node.minX - radius - start.x) * inverseX };
+			const float x2{ (node.maxX + radius - start.x) * inverseX };
+			const float y1{ (node.minY - radius - start.y) * inverseY };
+			const float y2{ (node.maxY + radius - start.y) * inverseY };
+			const float enter{ std::max(std::min(x1, x2), std::min(y1, y2)) };
+			const float exit{ std::min(std::max(x1, x2), std::max(y1, y2)) };
+			return (enter <= exit && exit >= 0.f) ? std::max(enter, 0.f) : std::numeric_limits<float>::infinity();
+		} };
+
+	bool isHit{ false };
+	float closest{ maxDistance };
+	const auto testPrimitive{ [&](const Primitive& primitive)
+		{
+			if (primitive.isCorner)
+			{
+				// ray against a circle with the radius around the corner
+				const Point2f& corner{ m_corners[primitive.index] };
+				const float toCornerX{ corner.x - start.x };
+				const float toCornerY{ corner.y - start.y };
+				const float alongRay{ toCornerX * direction.x + toCornerY * direction.y };
+				if (alongRay <= 0.f) return;
+
+				const float offRaySquared{ toCornerX * toCornerX + toCornerY * toCornerY - alongRay * alongRay };
+				if (offRaySquared >= radius * radius) return;
+
+				const float distance{ std::max(alongRay - std::sqrt(radius * radius - offRaySquared), 0.f) };
+				if (distance >= closest) return;
+
+				const float hitX{ start.x + direction.x * distance };
+				const float hitY{ start.y + direction.y * distance };
+				closest = distance;
+				hit = RayHit{ distance, Point2f{ (hitX - corner.x) / radius, (hitY - corner.y) / radius } };
+				isHit = true;
+				return;
+			}
+
+			// ray against the line moved a radius to the play side, only when moving towards the cushion
+			const Segment& segment{ m_segments[primitive.index] };
+			const float normalX{ segment.plane[1] };
+			const float normalY{ segment.plane[2] };
+			const float speedTowards{ direction.x * normalX + direction.y * normalY };
+			if (speedTowards >= 0.f) return;
+
+			const float startDistance{ segment.plane[0] + normalX * start.x + normalY * start.y };
+			if (startDistance <= -radius) return;
+
+			const float distance{ std::max((radius - startDistance) / speedTowards, 0.f) };
+			if (distance >= closest) return;
+
+			const float alongSegment{ (start.x + direction.x * distance - segment.start.x) * segment.direction.x
+				+ (start.y + direction.y * distance - segment.start.y) * segment.direction.y };
+			if (alongSegment < 0.f || alongSegment > segment.length) return;
+
+			closest = distance;
+			hit = RayHit{ distance, Point2f{ normalX, normalY } };
+			isHit = true;
+		} };
+
+	std::array<int, MAX_DEPTH> stack;
+	int stackSize{};
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const Node& node{ m_nodes[stack[--stackSize]] };
+		if (enterDistance(node) >= closest) continue;
+
+		if (node.count > 0)
+		{
+			for (int idx{ node.first }; idx < node.first + node.count; ++idx)
+			{
+				testPrimitive(m_primitives[idx]);
+			}
+			continue;
+		}
+
+		// visit the nearer child first, so the farther one can often be skipped
+		const int nodeIdx{ int(&node - m_nodes.data()) };
+		int nearIdx{ nodeIdx + 1 };
+		int farIdx{ node.first };
+		if (enterDistance(m_nodes[farIdx]) < enterDistance(m_nodes[nearIdx])) std::swap(nearIdx, farIdx);
+		stack[stackSize++] = farIdx;
+		stack[stackSize++] = nearIdx;
+	}
+
+	return isHit;
+}
+
+void CushionSet::Draw() const
+{
+	utils::SetColor(Color4f{ 0.35f, 0.2f, 0.1f, 1.f });
+	for (const Segment& segment : m_segments)
+	{
+		const Point2f end{ segment.start.x + segment.direction.x * segment.length, segment.start.y + segment.direction.y * segment.length };
+		utils::DrawLine(segment.start, end, 3.f);
+	}
+}
+
+const std::vector<CushionSet::Outline>& CushionSet::GetOutlines() const
+{
+	return m_outlines;
+}
+
+int CushionSet::GetNumSegments() const
+{
+	return int(m_segments.size());
+}
+
+int CushionSet::GetNumCorners() const
+{
+	return int(m_corners.size());
+}
+
+int CushionSet::GetNumNodes() const
+{
+	return int(m_nodes.size());
+}
+
+void CushionSet::AddOutline(const Outline& outline)
+{
+	const std::vector<Point2f>& points{ outline.points };
+	const int numPoints{ int(points.size()) };
+	const int numSegments{ outline.isClosed ? numPoints : numPoints - 1 };
+	if (numPoints < 2) return;
+
+	const int firstSegment{ int(m_segments.size()) };
+	for (int idx{}; idx < numSegments; ++idx)
+	{
+		const Point2f& start{ points[idx] };
+		const Point2f& end{ points[(idx + 1) % numPoints] };
+		const float length{ std::sqrt((end.x - start.x) * (end.x - start.x) + (end.y - start.y) * (end.y - start.y)) };
+		if (length <= 0.f) continue;
+
+		// the play side is on the left of the direction
+		const Point2f direction{ (end.x - start.x) / length, (end.y - start.y) / length };
+		const Point2f normal{ -direction.y, direction.x };
+		m_segments.push_back(Segment{ start, direction, length, OneBlade{ -(normal.x * start.x + normal.y * start.y), normal.x, normal.y, 0 } });
+	}
+
+	// a ball can only hit a corner that sticks out into the play area (the outline turns right there),
+	// the loose ends of an open outline stick out as well
+	const int lastSegment{ int(m_segments.size()) - 1 };
+	if (lastSegment < firstSegment) return;
+
+	if (!outline.isClosed) m_corners.push_back(m_segments[firstSegment].start);
+	for (int idx{ firstSegment }; idx <= lastSegment; ++idx)
+	{
+		const bool hasNext{ idx < lastSegment || outline.isClosed };
+		if (!hasNext) break;
+
+		const Segment& segment{ m_segments[idx] };
+		const Segment& next{ m_segments[idx < lastSegment ? idx + 1 : firstSegment] };
+		const float turn{ segment.direction.x * next.direction.y - segment.direction.y * next.direction.x };
+		if (turn < 0.f) m_corners.push_back(next.start);
+	}
+	if (!outline.isClosed)
+	{
+		const Segment& segment{ m_segments[lastSegment] };
+		m_corners.push_back(Point2f{ segment.start.x + segment.direction.x * segment.length, segment.start.y + segment.direction.y * segment.length });
+	}
+}
+
+void CushionSet::BuildNode(int first, int count)
+{
+	const int nodeIdx{ int(m_nodes.size()) };
+	m_nodes.push_back(Node{ m_primitives[first].minX, m_primitives[first].minY, m_primitives[first].maxX, m_primitives[first].maxY, first, count });
+	for (int idx{ first + 1 }; idx < first + count; ++idx)
+	{
+		const Primitive& primitive{ m_primitives[idx] };
+		Node& node{ m_nodes[nodeIdx] };
+		node.minX = std::min(node.minX, primitive.minX);
+		node.minY = std::min(node.minY, primitive.minY);
+		node.maxX = std::max(node.maxX, primitive.maxX);
+		node.maxY = std::max(node.maxY, primitive.maxY);
+	}
+	if (count <= MAX_LEAF_SIZE) return;
+
+	// split at the median of the box centers along the longest side
+	const Node& node{ m_nodes[nodeIdx] };
+	const bool isSplitX{ node.maxX - node.minX >= node.maxY - node.minY };
+	const int half{ count / 2 };
+	std::nth_element(m_primitives.begin() + first, m_primitives.begin() + first + half, m_primitives.begin() + first + count,
+		[isSplitX](const Primitive& a, const Primitive& b)
+		{
+			return isSplitX ? a.minX + a.maxX < b.minX + b.maxX : a.minY + a.maxY < b.minY + b.maxY;
+		});
+
+	BuildNode(first, half);
+	const int rightIdx{ int(m_nodes.size()) };
+	BuildNode(first + half, count - half);
+
+	// an inner node points to its right child instead of to primitives
+	m_nodes[nodeIdx].first = rightIdx;
+	m_nodes[nodeIdx].count = 0;
+}
+
+template <typename Function>
+void CushionSet::ForEachOverlapping(float minX, float minY, float maxX, float maxY, Function function) const
+{
+	if (m_nodes.empty()) return;
+
+	std::array<int, MAX_DEPTH> stack;
+	int stackSize{};
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const int nodeIdx{ stack[--stackSize] };
+		const Node& node{ m_nodes[nodeIdx] };
+		if (node.maxX < minX || node.minX > maxX || node.maxY < minY || node.minY > maxY) continue;
+
+		if (node.count > 0)
+		{
+			for (int idx{ node.first }; idx < node.first + node.count; ++idx)
+			{
+				const Primitive& primitive{ m_primitives[idx] };
+				if (primitive.maxX < minX || primitive.minX > maxX || primitive.maxY < minY || primitive.minY > maxY) continue;
+				function(primitive);
+			}
+			continue;
+		}
+
+		stack[stackSize++] = node.first;
+		stack[stackSize++] = nodeIdx + 1;
+	}
+}
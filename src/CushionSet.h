@@ -0,0 +1,107 @@
+#pragma once
+#include "structs.h"
+#include "FlyFish.h"
+#include <cstdint>
+#include <vector>
+
+// The cushions of a table: straight segments and the corners between them that stick out into the play area.
+// Every outline is a list of points with the play side on the left going from one point to the next,
+// so the edge of the table goes counterclockwise and an obstacle inside it goes clockwise.
+// The cushions are stored in a bounding volume hierarchy, so a ball only tests the few cushions near it.
+class CushionSet final
+{
+public:
+	struct Outline
+	{
+		std::vector<Point2f> points;
+		// connect the last point back to the first one
+		bool isClosed;
+	};
+
+	// a cushion a ball touches: the plane to bounce off, facing the ball, and how far the ball is pushed into it
+	struct Contact
+	{
+		OneBlade plane;
+		float depth;
+	};
+
+	// where a moving circle touches a cushion
+	struct RayHit
+	{
+		float distance;
+		// unit normal of the cushion at the hit, pointing to the circle
+		Point2f normal;
+	};
+
+	// a ball can't touch more cushions than this at once
+	static constexpr int MAX_CONTACTS{ 8 };
+
+	explicit CushionSet(const std::vector<Outline>& outlines);
+	// the four straight cushions around a rectangular play area
+	static CushionSet CreateRectangle(const Rectf& playArea);
+
+	// every cushion closer than radius to the center, up to maxContacts, returns how many were written
+	int FindContacts(const ThreeBlade& center, float radius, Contact* pContacts, int maxContacts) const;
+	// how far a circle moving from start along the unit direction gets before it touches a cushion,
+	// returns false if it doesn't touch one within maxDistance
+	bool CastCircle(const Point2f& start, const Point2f& direction, float radius, float maxDistance, RayHit& hit) const;
+
+	void Draw() const;
+
+	// the outlines the cushions were built from
+	const std::vector<Outline>& GetOutlines() const;
+
+	int GetNumSegments() const;
+	int GetNumCorners() const;
+	int GetNumNodes() const;
+
+private:
+	struct Segment
+	{
+		Point2f start;
+		// unit vector from start to end
+		Point2f direction;
+		float length;
+		// the line through the segment, positive on the play side
+		OneBlade plane;
+	};
+
+	struct Primitive
+	{
+		// index into m_segments, or into m_corners for a corner
+		int index;
+		bool isCorner;
+		float minX;
+		float minY;
+		float maxX;
+		float maxY;
+	};
+
+	struct Node
+	{
+		float minX;
+		float minY;
+		float maxX;
+		float maxY;
+		// a leaf holds count primitives from first, an inner node has its children at its own index + 1 and at first
+		int first;
+		int count;
+	};
+
+	static constexpr int MAX_LEAF_SIZE{ 4 };
+	// enough for a tree over millions of cushions, the tree is split at the median so it stays balanced
+	static constexpr int MAX_DEPTH{ 64 };
+
+	std::vector<Outline> m_outlines;
+	std::vector<Segment> m_segments;
+	std::vector<Point2f> m_corners;
+	std::vector<Primitive> m_primitives;
+	std::vector<Node> m_nodes;
+
+	void AddOutline(const Outline& outline);
+	void BuildNode(int first, int count);
+
+	// calls function(primitive) for every primitive whose bounds overlap the box
+	template <typename Function>
+	void ForEachOverlapping(float minX, float minY, float maxX, float maxY, Function function) const;
+};
@@ -0,0 +1,150 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define GEOA_FAST_MATH_SSE
+#endif
+
+// The math functions of the hot paths (norms, friction, rotations, circles).
+// They are the std functions, unless the game is built with GEOA_FAST_MATH (cmake -DGEOA_FAST_MATH=ON):
+// then they are approximations with a bounded error that skip the exact rounding, the special cases and the divisions.
+// The approximations are always compiled, so the accuracy report (see AccuracyReport.h) can measure them in any build.
+namespace FastMath
+{
+	constexpr bool IsEnabled()
+	{
+#ifdef GEOA_FAST_MATH
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	constexpr float PI{ 3.14159265f };
+
+	// 1 / sqrt(x) for x > 0, a hardware estimate (or the bit trick) refined with one Newton step:
+	// relative error below 5e-6 (SSE) or 2e-3 (bit trick)
+	inline float ApproxInvSqrt(float x)
+	{
+#ifdef GEOA_FAST_MATH_SSE
+		const float estimate{ _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x))) };
+#else
+		uint32_t bits{};
+		std::memcpy(&bits, &x, sizeof(bits));
+		bits = 0x5f375a86u - (bits >> 1);
+		float estimate{};
+		std::memcpy(&estimate, &bits, sizeof(estimate));
+#endif
+		return estimate * (1.5f - 0.5f * x * estimate * estimate);
+	}
+
+	// sqrt(x) as x / sqrt(x), 0 for x <= 0.
+	// Only here for the report: it is no faster than the hardware square root, so the hot paths keep std::sqrt
+	inline float ApproxSqrt(float x)
+	{
+		return x > 0.f ? x * ApproxInvSqrt(x) : 0.f;
+	}
+
+	// reduced to [-pi/2, pi/2] and evaluated as x * P(x^2) with a degree 4 fit,
+	// absolute error below 1e-5 for |x| < 100 (the reduction loses precision further out)
+	inline float ApproxSin(float x)
+	{
+		// to [-pi, pi] by rounding half turns away from zero, then mirrored around +-pi/2
+		const float turns{ x * (0.5f / PI) };
+		x -= 2.f * PI * float(int32_t(turns + (turns < 0.f ? -0.5f : 0.5f)));
+		if (x > 0.5f * PI) x = PI - x;
+		else if (x < -0.5f * PI) x = -PI - x;
+
+		const float x2{ x * x };
+		return x * (0.99999999572f + x2 * (-0.16666657970f + x2 * (0.00833305062f + x2 * (-0.000198090463f + x2 * 2.60516618e-6f))));
+	}
+
+	inline float ApproxCos(float x)
+	{
+		return ApproxSin(x + 0.5f * PI);
+	}
+
+	// 2^x: the integer part goes into the exponent bits, the fraction through a degree 5 fit,
+	// relative error below 2e-7 for -126 < x < 128
+	inline float ApproxExp2(float x)
+	{
+		x = x > 127.99f ? 127.99f : (x < -125.99f ? -125.99f : x);
+		// truncation rounds negative values up, step down to the floor
+		float whole{ float(int32_t(x)) };
+		if (whole > x) whole -= 1.f;
+		const float fraction{ x - whole };
+		const float fractionPower{ 0.99999989576f + fraction * (0.69315461998f + fraction * (0.24014077029f
+			+ fraction * (0.05586328210f + fraction * (0.00894621530f + fraction * 0.00189510704f)))) };
+
+		const uint32_t bits{ uint32_t(int32_t(whole) + 127) << 23 };
+		float wholePower{};
+		std::memcpy(&wholePower, &bits, sizeof(wholePower));
+		return wholePower * fractionPower;
+	}
+
+	// log2(x) for x > 0: the exponent bits plus log2 of the mantissa in [sqrt(1/2), sqrt(2)) from the atanh series,
+	// absolute error below 2e-6
+	inline float ApproxLog2(float x)
+	{
+		uint32_t bits{};
+		std::memcpy(&bits, &x, sizeof(bits));
+		int exponent{ int((bits >> 23) & 0xffu) - 127 };
+		bits = (bits & 0x007fffffu) | 0x3f800000u;
+		float mantissa{};
+		std::memcpy(&mantissa, &bits, sizeof(mantissa));
+		if (mantissa > 1.41421356f)
+		{
+			mantissa *= 0.5f;
+			++exponent;
+		}
+
+		const float s{ (mantissa - 1.f) / (mantissa + 1.f) };
+		const float s2{ s * s };
+		// 2 / ln(2)
+		return float(exponent) + 2.88539008f * s * (1.f + s2 * (1.f / 3.f + s2 * (1.f / 5.f + s2 * (1.f / 7.f))));
+	}
+
+	// base^exponent for base > 0 as 2^(exponent * log2(base)), 0 for base <= 0
+	inline float ApproxPow(float base, float exponent)
+	{
+		return base > 0.f ? ApproxExp2(exponent * ApproxLog2(base)) : 0.f;
+	}
+
+	// what the hot paths call, the std function or its approximation depending on the build.
+	// There is no Sqrt: norms use std::sqrt in both builds, only normalizing goes through InvSqrt
+
+	inline float InvSqrt(float x)
+	{
+		if constexpr (IsEnabled()) return ApproxInvSqrt(x);
+		else return 1.f / std::sqrt(x);
+	}
+
+	inline float Sin(float x)
+	{
+		if constexpr (IsEnabled()) return ApproxSin(x);
+		else return std::sin(x);
+	}
+
+	inline float Cos(float x)
+	{
+		if constexpr (IsEnabled()) return ApproxCos(x);
+		else return std::cos(x);
+	}
+
+	inline float Pow(float base, float exponent)
+	{
+		if constexpr (IsEnabled()) return ApproxPow(base, exponent);
+		else return std::pow(base, exponent);
+	}
+
+	// numerator / denominator, as a multiplication with the reciprocal in the fast build,
+	// so dividing several values by the same denominator costs one division
+	inline float Divide(float numerator, float denominator)
+	{
+		if constexpr (IsEnabled()) return numerator * (1.f / denominator);
+		else return numerator / denominator;
+	}
+}
@@ -1,5 +1,10 @@
 #include "FlyFish.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define FLYFISH_SSE
+#include <xmmintrin.h>
+#endif
+
 // Type conversions
 
 [[nodiscard]] TwoBlade Motor::Grade2() const
@@ -51,6 +56,28 @@
     };
 }
 
+[[nodiscard]] Flector MultiVector::ToFlector() const
+{
+    return Flector{
+        data[1],
+        data[2],
+        data[3],
+        data[4],
+        data[11],
+        data[12],
+        data[13],
+        data[14]
+    };
+}
+[[nodiscard]] OneBlade Flector::Grade1() const
+{
+    return OneBlade{ data[0], data[1], data[2], data[3] };
+}
+[[nodiscard]] ThreeBlade Flector::Grade3() const
+{
+    return ThreeBlade{ data[4], data[5], data[6], data[7] };
+}
+
 // Copy/move assignments
 
 MultiVector& MultiVector::operator=(const ThreeBlade& b)
@@ -138,6 +165,94 @@ MultiVector& MultiVector::operator=(Motor&& b) noexcept
     return *this;
 };
 
+MultiVector& MultiVector::operator=(const Flector& b)
+{
+    data.fill(0);
+    data[1] = b[0];
+    data[2] = b[1];
+    data[3] = b[2];
+    data[4] = b[3];
+    data[11] = b[4];
+    data[12] = b[5];
+    data[13] = b[6];
+    data[14] = b[7];
+    return *this;
+}
+MultiVector& MultiVector::operator=(Flector&& b) noexcept
+{
+    data.fill(0);
+    data[1] = b[0];
+    data[2] = b[1];
+    data[3] = b[2];
+    data[4] = b[3];
+    data[11] = b[4];
+    data[12] = b[5];
+    data[13] = b[6];
+    data[14] = b[7];
+    return *this;
+};
+
+// Exponential and logarithm
+
+[[nodiscard]] Motor Motor::Exp(const TwoBlade& bivector)
+{
+    // squared length of the euclidean (rotation) part, B_E^2 = -angleSquared
+    const float angleSquared{ bivector[3] * bivector[3] + bivector[4] * bivector[4] + bivector[5] * bivector[5] };
+    if (angleSquared < 1e-12f)
+    {
+        // ideal bivectors square to zero, so the series stops after the linear term
+        return Motor{ 1, bivector[0], bivector[1], bivector[2], 0, 0, 0, 0 };
+    }
+
+    // B ^ B / 2, the pitch of the screw motion
+    const float pitch{ bivector[0] * bivector[3] + bivector[1] * bivector[4] + bivector[2] * bivector[5] };
+
+    const float angle{ std::sqrt(angleSquared) };
+    const float cosAngle{ FastMath::Cos(angle) };
+    const float sinc{ FastMath::Sin(angle) / angle };
+    const float screw{ pitch / angleSquared * (cosAngle - sinc) };
+
+    return Motor{
+        cosAngle,
+        sinc * bivector[0] + screw * bivector[3],
+        sinc * bivector[1] + screw * bivector[4],
+        sinc * bivector[2] + screw * bivector[5],
+        sinc * bivector[3],
+        sinc * bivector[4],
+        sinc * bivector[5],
+        sinc * pitch
+    };
+}
+
+[[nodiscard]] TwoBlade Motor::Log() const
+{
+    const float rotationNorm{ std::sqrt(data[4] * data[4] + data[5] * data[5] + data[6] * data[6]) };
+    if (rotationNorm < 1e-6f)
+    {
+        // pure translation
+        return TwoBlade{ data[1] / data[0], data[2] / data[0], data[3] / data[0], 0, 0, 0 };
+    }
+
+    const float angle{ std::atan2(rotationNorm, data[0]) };
+    const float sinc{ rotationNorm / angle };
+
+    // undo Exp: first the rotation part, then the pitch, then the translation part
+    const float bivector23{ data[4] / sinc };
+    const float bivector31{ data[5] / sinc };
+    const float bivector12{ data[6] / sinc };
+    const float pitch{ data[7] / sinc };
+    const float screw{ pitch / (angle * angle) * (std::cos(angle) - sinc) };
+
+    return TwoBlade{
+        (data[1] - screw * bivector23) / sinc,
+        (data[2] - screw * bivector31) / sinc,
+        (data[3] - screw * bivector12) / sinc,
+        bivector23,
+        bivector31,
+        bivector12
+    };
+}
+
 // Geometric Product
 
 // MultiVector
@@ -244,6 +359,27 @@ MultiVector& MultiVector::operator=(Motor&& b) noexcept
     res[15] = b[7] * data[0] + b[4] * data[5] + b[5] * data[6] + b[6] * data[7] + b[3] * data[10] + b[2] * data[9] + b[1] * data[8] + b[0] * data[15];
     return res;
 }
+[[nodiscard]] MultiVector MultiVector::operator* (const Flector& b) const
+{
+    MultiVector res{};
+    res[0] = data[2] * b[1] + data[3] * b[2] + data[4] * b[3] - data[14] * b[7];
+    res[1] = data[0] * b[0] + data[5] * b[1] + data[6] * b[2] + data[7] * b[3] + data[8] * b[4] + data[9] * b[5] + data[10] * b[6] - data[15] * b[7];
+    res[2] = data[0] * b[1] - data[8] * b[7] - data[9] * b[3] + data[10] * b[2];
+    res[3] = data[0] * b[2] + data[8] * b[3] - data[9] * b[7] - data[10] * b[1];
+    res[4] = data[0] * b[3] - data[8] * b[2] + data[9] * b[1] - data[10] * b[7];
+    res[5] = data[1] * b[1] - data[2] * b[0] - data[3] * b[6] + data[4] * b[5] + data[11] * b[7] + data[12] * b[3] - data[13] * b[2] - data[14] * b[4];
+    res[6] = data[1] * b[2] + data[2] * b[6] - data[3] * b[0] - data[4] * b[4] - data[11] * b[3] + data[12] * b[7] + data[13] * b[1] - data[14] * b[5];
+    res[7] = data[1] * b[3] - data[2] * b[5] + data[3] * b[4] - data[4] * b[0] + data[11] * b[2] - data[12] * b[1] + data[13] * b[7] - data[14] * b[6];
+    res[8] = data[2] * b[7] + data[3] * b[3] - data[4] * b[2] + data[14] * b[1];
+    res[9] = -data[2] * b[3] + data[3] * b[7] + data[4] * b[1] + data[14] * b[2];
+    res[10] = data[2] * b[2] - data[3] * b[1] + data[4] * b[7] + data[14] * b[3];
+    res[11] = data[0] * b[4] - data[5] * b[7] - data[6] * b[3] + data[7] * b[2] - data[8] * b[0] - data[9] * b[6] + data[10] * b[5] - data[15] * b[1];
+    res[12] = data[0] * b[5] + data[5] * b[3] - data[6] * b[7] - data[7] * b[1] + data[8] * b[6] - data[9] * b[0] - data[10] * b[4] - data[15] * b[2];
+    res[13] = data[0] * b[6] - data[5] * b[2] + data[6] * b[1] - data[7] * b[7] - data[8] * b[5] + data[9] * b[4] - data[10] * b[0] - data[15] * b[3];
+    res[14] = data[0] * b[7] + data[8] * b[1] + data[9] * b[2] + data[10] * b[3];
+    res[15] = data[1] * b[7] + data[2] * b[4] + data[3] * b[5] + data[4] * b[6] - data[11] * b[1] - data[12] * b[2] - data[13] * b[3] - data[14] * b[0];
+    return res;
+}
 // ThreeBlade
 [[nodiscard]] MultiVector ThreeBlade::operator* (const MultiVector& b) const
 {
@@ -279,26 +415,18 @@ MultiVector& MultiVector::operator=(Motor&& b) noexcept
     res[7] = 0;
     return res;
 }
-[[nodiscard]] MultiVector ThreeBlade::operator* (const TwoBlade& b) const {
-    MultiVector res{};
-    res[0] = 0;
-    res[1] = b[5] * data[2] + b[4] * data[1] + b[3] * data[0];
-    res[2] = -b[3] * data[3];
-    res[3] = -b[4] * data[3];
-    res[4] = -b[5] * data[3];
-    res[5] = 0;
-    res[6] = 0;
-    res[7] = 0;
-    res[8] = 0;
-    res[9] = 0;
-    res[10] = 0;
-    res[11] = b[4] * data[2] - b[5] * data[1] + b[1] * data[3];
-    res[12] = -b[3] * data[2] + b[5] * data[0] + b[1] * data[3];
-    res[13] = b[3] * data[1] - b[4] * data[0] + b[2] * data[3];
-    res[14] = 0;
-    res[15] = 0;
+[[nodiscard]] Flector ThreeBlade::operator* (const TwoBlade& b) const
+{
+    Flector res{};
+    res[0] = data[0] * b[3] + data[1] * b[4] + data[2] * b[5];
+    res[1] = -data[3] * b[3];
+    res[2] = -data[3] * b[4];
+    res[3] = -data[3] * b[5];
+    res[4] = -data[1] * b[5] + data[2] * b[4] + data[3] * b[0];
+    res[5] = data[0] * b[5] - data[2] * b[3] + data[3] * b[1];
+    res[6] = -data[0] * b[4] + data[1] * b[3] + data[3] * b[2];
     return res;
-};
+}
 [[nodiscard]] Motor ThreeBlade::operator* (const OneBlade& b) const
 {
     Motor res{};
@@ -312,24 +440,30 @@ MultiVector& MultiVector::operator=(Motor&& b) noexcept
     res[7] = -b[3] * data[2] - b[2] * data[1] - b[1] * data[0] - b[0] * data[3];
     return res;
 }
-[[nodiscard]] MultiVector ThreeBlade::operator* (const Motor& b) const
+[[nodiscard]] Flector ThreeBlade::operator* (const Motor& b) const
 {
-    MultiVector res{};
-    res[0] = 0;
-    res[1] = b[6] * data[2] + b[5] * data[1] + b[4] * data[0] + b[7] * data[3];
-    res[2] = -b[4] * data[3];
-    res[3] = -b[5] * data[3];
-    res[4] = -b[6] * data[3];
-    res[6] = 0;
-    res[7] = 0;
-    res[8] = 0;
-    res[9] = 0;
-    res[10] = 0;
-    res[11] = b[5] * data[2] - b[6] * data[1] + b[0] * data[0] + b[1] * data[3];
-    res[12] = -b[4] * data[2] + b[0] * data[1] + b[6] * data[0] + b[2] * data[3];
-    res[13] = b[0] * data[2] + b[4] * data[1] - b[5] * data[0] + b[3] * data[3];
-    res[14] = b[0] * data[3];
-    res[15] = 0;
+    Flector res{};
+    res[0] = data[0] * b[4] + data[1] * b[5] + data[2] * b[6] + data[3] * b[7];
+    res[1] = -data[3] * b[4];
+    res[2] = -data[3] * b[5];
+    res[3] = -data[3] * b[6];
+    res[4] = data[0] * b[0] - data[1] * b[6] + data[2] * b[5] + data[3] * b[1];
+    res[5] = data[0] * b[6] + data[1] * b[0] - data[2] * b[4] + data[3] * b[2];
+    res[6] = -data[0] * b[5] + data[1] * b[4] + data[2] * b[0] + data[3] * b[3];
+    res[7] = data[3] * b[0];
+    return res;
+}
+[[nodiscard]] Motor ThreeBlade::operator* (const Flector& b) const
+{
+    Motor res{};
+    res[0] = -data[3] * b[7];
+    res[1] = data[0] * b[7] + data[1] * b[3] - data[2] * b[2] - data[3] * b[4];
+    res[2] = -data[0] * b[3] + data[1] * b[7] + data[2] * b[1] - data[3] * b[5];
+    res[3] = data[0] * b[2] - data[1] * b[1] + data[2] * b[7] - data[3] * b[6];
+    res[4] = data[3] * b[1];
+    res[5] = data[3] * b[2];
+    res[6] = data[3] * b[3];
+    res[7] = -data[0] * b[1] - data[1] * b[2] - data[2] * b[3] - data[3] * b[0];
     return res;
 }
 // TwoBlade
@@ -353,26 +487,18 @@ MultiVector& MultiVector::operator=(Motor&& b) noexcept
     res[15] = b[8] * data[0] + b[9] * data[1] + b[10] * data[2] + b[7] * data[5] + b[6] * data[4] + b[5] * data[3];
     return res;
 };
-[[nodiscard]] MultiVector TwoBlade::operator* (const ThreeBlade& b) const {
-    MultiVector res{};
-    res[0] = 0;
-    res[1] = b[2] * data[5] + b[1] * data[4] + b[0] * data[3];
-    res[2] = - b[3] * data[3];
-    res[3] = - b[3] * data[4];
-    res[4] = -b[3] * data[5];
-    res[5] = 0;
-    res[6] = 0;
-    res[7] = 0;
-    res[8] = 0;
-    res[9] = 0;
-    res[10] = 0;
-    res[11] = -b[3] * data[0] + b[1] * data[5] - b[2] * data[4];
-    res[12] = - b[3] * data[1] - b[0] * data[5] + b[2] * data[3];
-    res[13] = - b[3] * data[2] + b[0] * data[4] - b[1] * data[3];
-    res[14] = 0;
-    res[15] = 0;
+[[nodiscard]] Flector TwoBlade::operator* (const ThreeBlade& b) const
+{
+    Flector res{};
+    res[0] = data[3] * b[0] + data[4] * b[1] + data[5] * b[2];
+    res[1] = -data[3] * b[3];
+    res[2] = -data[4] * b[3];
+    res[3] = -data[5] * b[3];
+    res[4] = -data[0] * b[3] - data[4] * b[2] + data[5] * b[1];
+    res[5] = -data[1] * b[3] + data[3] * b[2] - data[5] * b[0];
+    res[6] = -data[2] * b[3] - data[3] * b[1] + data[4] * b[0];
     return res;
-};
+}
 [[nodiscard]] Motor TwoBlade::operator* (const TwoBlade& b) const {
     Motor res{};
     res[0] = -b[5] * data[5] - b[4] * data[4] - b[3] * data[3];
@@ -385,18 +511,19 @@ MultiVector& MultiVector::operator=(Motor&& b) noexcept
     res[7] = b[3] * data[0] + b[4] * data[1] + b[5] * data[2] + b[2] * data[5] + b[1] * data[4] + b[0] * data[3];
     return res;
 };
-[[nodiscard]] MultiVector TwoBlade::operator* (const OneBlade& b) const {
-    MultiVector res{};
-    res[1] = b[1] * data[0] + b[2] * data[1] + b[3] * data[2];
-    res[2] = b[2] * data[5] - b[3] * data[4];
-    res[3] = -b[1] * data[5] + b[3] * data[3];
-    res[4] = b[1] * data[4] - b[2] * data[3];
-    res[11] = - b[3] * data[1] + b[2] * data[2] - b[0] * data[3];
-    res[12] = b[3] * data[0] - b[1] * data[2] - b[0] * data[4];
-    res[13] = -b[2] * data[0] + b[1] * data[1] - b[0] * data[5];
-    res[14] = b[3] * data[5] + b[2] * data[4] + b[1] * data[3];
+[[nodiscard]] Flector TwoBlade::operator* (const OneBlade& b) const
+{
+    Flector res{};
+    res[0] = data[0] * b[1] + data[1] * b[2] + data[2] * b[3];
+    res[1] = -data[4] * b[3] + data[5] * b[2];
+    res[2] = data[3] * b[3] - data[5] * b[1];
+    res[3] = -data[3] * b[2] + data[4] * b[1];
+    res[4] = -data[1] * b[3] + data[2] * b[2] - data[3] * b[0];
+    res[5] = data[0] * b[3] - data[2] * b[1] - data[4] * b[0];
+    res[6] = -data[0] * b[2] + data[1] * b[1] - data[5] * b[0];
+    res[7] = data[3] * b[1] + data[4] * b[2] + data[5] * b[3];
     return res;
-};
+}
 [[nodiscard]] Motor TwoBlade::operator* (const Motor& b) const {
     Motor res{};
     res[0] = -b[6] * data[5] - b[5] * data[4] - b[4] * data[3];
@@ -409,6 +536,19 @@ MultiVector& MultiVector::operator=(Motor&& b) noexcept
     res[7] = b[4] * data[0] + b[5] * data[1] + b[6] * data[2] + b[3] * data[5] + b[2] * data[4] + b[1] * data[3];
     return res;
 };
+[[nodiscard]] Flector TwoBlade::operator* (const Flector& b) const
+{
+    Flector res{};
+    res[0] = data[0] * b[1] + data[1] * b[2] + data[2] * b[3] + data[3] * b[4] + data[4] * b[5] + data[5] * b[6];
+    res[1] = -data[3] * b[7] - data[4] * b[3] + data[5] * b[2];
+    res[2] = data[3] * b[3] - data[4] * b[7] - data[5] * b[1];
+    res[3] = -data[3] * b[2] + data[4] * b[1] - data[5] * b[7];
+    res[4] = -data[0] * b[7] - data[1] * b[3] + data[2] * b[2] - data[3] * b[0] - data[4] * b[6] + data[5] * b[5];
+    res[5] = data[0] * b[3] - data[1] * b[7] - data[2] * b[1] + data[3] * b[6] - data[4] * b[0] - data[5] * b[4];
+    res[6] = -data[0] * b[2] + data[1] * b[1] - data[2] * b[7] - data[3] * b[5] + data[4] * b[4] - data[5] * b[0];
+    res[7] = data[3] * b[1] + data[4] * b[2] + data[5] * b[3];
+    return res;
+}
 // OneBlade
 [[nodiscard]] MultiVector OneBlade::operator* (const MultiVector& b) const
 {
@@ -444,18 +584,19 @@ MultiVector& MultiVector::operator=(Motor&& b) noexcept
     res[7] = data[3] * b[2] + data[2] * b[1] + data[1] * b[0] + data[0] * b[3];
     return res;
 }
-[[nodiscard]] MultiVector OneBlade::operator* (const TwoBlade& b) const {
-MultiVector res{};
-res[1] = -b[0] * data[1] - b[1] * data[2] - b[2] * data[3];
-res[2] = -b[5] * data[2] + b[4] * data[3];
-res[3] = b[5] * data[1] - b[3] * data[3];
-res[4] = -b[4] * data[1] + b[3] * data[2];
-res[11] = -b[3] * data[0] + b[2] * data[2] - b[1] * data[3];
-res[12] = -b[4] * data[0] - b[2] * data[1] + b[0] * data[3];
-res[13] = -b[5] * data[0] + b[1] * data[1] - b[0] * data[2];
-res[14] = b[3] * data[1] + b[4] * data[2] + b[5] * data[3];
-return res;
-};
+[[nodiscard]] Flector OneBlade::operator* (const TwoBlade& b) const
+{
+    Flector res{};
+    res[0] = -data[1] * b[0] - data[2] * b[1] - data[3] * b[2];
+    res[1] = -data[2] * b[5] + data[3] * b[4];
+    res[2] = data[1] * b[5] - data[3] * b[3];
+    res[3] = -data[1] * b[4] + data[2] * b[3];
+    res[4] = -data[0] * b[3] + data[2] * b[2] - data[3] * b[1];
+    res[5] = -data[0] * b[4] - data[1] * b[2] + data[3] * b[0];
+    res[6] = -data[0] * b[5] + data[1] * b[1] - data[2] * b[0];
+    res[7] = data[1] * b[3] + data[2] * b[4] + data[3] * b[5];
+    return res;
+}
 [[nodiscard]] Motor OneBlade::operator* (const OneBlade& b) const
 {
     Motor res{};
@@ -469,17 +610,30 @@ return res;
     res[7] = 0;
     return res;
 }
-[[nodiscard]] MultiVector OneBlade::operator* (const Motor& b) const
+[[nodiscard]] Flector OneBlade::operator* (const Motor& b) const
 {
-    MultiVector res{};
-    res[1] = b[0] * data[0] - b[1] * data[1] - b[2] * data[2] - b[3] * data[3];
-    res[2] = b[0] * data[1] - b[6] * data[2] + b[5] * data[3];
-    res[3] = b[6] * data[1] + b[0] * data[2] - b[4] * data[3];
-    res[4] = -b[5] * data[1] + b[4] * data[2] + b[0] * data[3];
-    res[11] = -b[4] * data[0] + b[7] * data[1] + b[3] * data[2] - b[2] * data[3];
-    res[12] = -b[5] * data[0] - b[3] * data[1] + b[7] * data[2] + b[1] * data[3];
-    res[13] = -b[6] * data[0] + b[2] * data[1] - b[1] * data[2] + b[7] * data[3];
-    res[14] = b[4] * data[1] + b[5] * data[2] + b[6] * data[3];
+    Flector res{};
+    res[0] = data[0] * b[0] - data[1] * b[1] - data[2] * b[2] - data[3] * b[3];
+    res[1] = data[1] * b[0] - data[2] * b[6] + data[3] * b[5];
+    res[2] = data[1] * b[6] + data[2] * b[0] - data[3] * b[4];
+    res[3] = -data[1] * b[5] + data[2] * b[4] + data[3] * b[0];
+    res[4] = -data[0] * b[4] + data[1] * b[7] + data[2] * b[3] - data[3] * b[2];
+    res[5] = -data[0] * b[5] - data[1] * b[3] + data[2] * b[7] + data[3] * b[1];
+    res[6] = -data[0] * b[6] + data[1] * b[2] - data[2] * b[1] + data[3] * b[7];
+    res[7] = data[1] * b[4] + data[2] * b[5] + data[3] * b[6];
+    return res;
+}
+[[nodiscard]] Motor OneBlade::operator* (const Flector& b) const
+{
+    Motor res{};
+    res[0] = data[1] * b[1] + data[2] * b[2] + data[3] * b[3];
+    res[1] = data[0] * b[1] - data[1] * b[0] - data[2] * b[6] + data[3] * b[5];
+    res[2] = data[0] * b[2] + data[1] * b[6] - data[2] * b[0] - data[3] * b[4];
+    res[3] = data[0] * b[3] - data[1] * b[5] + data[2] * b[4] - data[3] * b[0];
+    res[4] = data[1] * b[7] + data[2] * b[3] - data[3] * b[2];
+    res[5] = -data[1] * b[3] + data[2] * b[7] + data[3] * b[1];
+    res[6] = data[1] * b[2] - data[2] * b[1] + data[3] * b[7];
+    res[7] = data[0] * b[7] + data[1] * b[4] + data[2] * b[5] + data[3] * b[6];
     return res;
 }
 // Motor
@@ -504,25 +658,17 @@ return res;
     res[15] = b[15] * data[0] + b[8] * data[1] + b[9] * data[2] + b[10] * data[3] + b[7] * data[6] + b[6] * data[5] + b[5] * data[4] + b[0] * data[7];
     return res;
 }
-[[nodiscard]] MultiVector Motor::operator* (const ThreeBlade& b) const
+[[nodiscard]] Flector Motor::operator* (const ThreeBlade& b) const
 {
-    MultiVector res{};
-    res[0] = 0;
-    res[1] = b[2] * data[6] + b[1] * data[5] + b[0] * data[4] - b[3] * data[7];
-    res[2] = - data[4] * b[3];
-    res[3] = - data[5] * b[3];
-    res[4] = - data[6] * b[3];
-    res[5] = 0;
-    res[6] = 0;
-    res[7] = 0;
-    res[8] = 0;
-    res[9] = 0;
-    res[10] = 0;
-    res[11] = b[0] * data[0] - b[3] * data[1] + b[1] * data[6] - b[2] * data[5];
-    res[12] = b[1] * data[0] - b[3] * data[2] - b[0] * data[6] + b[2] * data[4];
-    res[13] = b[2] * data[0] - b[3] * data[3] + b[0] * data[5] - b[1] * data[4];
-    res[14] = data[0] * b[3];
-    res[15] = 0;
+    Flector res{};
+    res[0] = data[4] * b[0] + data[5] * b[1] + data[6] * b[2] - data[7] * b[3];
+    res[1] = -data[4] * b[3];
+    res[2] = -data[5] * b[3];
+    res[3] = -data[6] * b[3];
+    res[4] = data[0] * b[0] - data[1] * b[3] - data[5] * b[2] + data[6] * b[1];
+    res[5] = data[0] * b[1] - data[2] * b[3] + data[4] * b[2] - data[6] * b[0];
+    res[6] = data[0] * b[2] - data[3] * b[3] - data[4] * b[1] + data[5] * b[0];
+    res[7] = data[0] * b[3];
     return res;
 }
 [[nodiscard]] Motor Motor::operator* (const TwoBlade& b) const {
@@ -537,17 +683,17 @@ return res;
     res[7] = b[3] * data[1] + b[4] * data[2] + b[5] * data[3] + b[2] * data[6] + b[1] * data[5] + b[0] * data[4];
     return res;
 };
-[[nodiscard]] MultiVector Motor::operator* (const OneBlade& b) const
+[[nodiscard]] Flector Motor::operator* (const OneBlade& b) const
 {
-    MultiVector res{};
-    res[1] = b[0] * data[0] + b[1] * data[1] + b[2] * data[2] + b[3] * data[3];
-    res[2] = b[1] * data[0] + b[2] * data[6] - b[3] * data[5];
-    res[3] = b[2] * data[0] - b[1] * data[6] + b[3] * data[4];
-    res[4] = b[3] * data[0] + b[1] * data[5] - b[2] * data[4];
-    res[11] = - b[3] * data[2] + b[2] * data[3] - b[0] * data[4] - b[1] * data[7];
-    res[12] = b[3] * data[1] - b[1] * data[3] - b[0] * data[5] - b[2] * data[7];
-    res[13] = - b[2] * data[1] + b[1] * data[2] - b[0] * data[6] - b[3] * data[7];
-    res[14] = b[3] * data[6] + b[2] * data[5] + b[1] * data[4];
+    Flector res{};
+    res[0] = data[0] * b[0] + data[1] * b[1] + data[2] * b[2] + data[3] * b[3];
+    res[1] = data[0] * b[1] - data[5] * b[3] + data[6] * b[2];
+    res[2] = data[0] * b[2] + data[4] * b[3] - data[6] * b[1];
+    res[3] = data[0] * b[3] - data[4] * b[2] + data[5] * b[1];
+    res[4] = -data[2] * b[3] + data[3] * b[2] - data[4] * b[0] - data[7] * b[1];
+    res[5] = data[1] * b[3] - data[3] * b[1] - data[5] * b[0] - data[7] * b[2];
+    res[6] = -data[1] * b[2] + data[2] * b[1] - data[6] * b[0] - data[7] * b[3];
+    res[7] = data[4] * b[1] + data[5] * b[2] + data[6] * b[3];
     return res;
 }
 [[nodiscard]] Motor Motor::operator* (const Motor& b) const {
@@ -562,6 +708,106 @@ return res;
     res[7] = b[7] * data[0] + b[4] * data[1] + b[5] * data[2] + b[6] * data[3] + b[3] * data[6] + b[2] * data[5] + b[1] * data[4] + b[0] * data[7];
     return res;
 };
+[[nodiscard]] Flector Motor::operator* (const Flector& b) const
+{
+    Flector res{};
+    res[0] = data[0] * b[0] + data[1] * b[1] + data[2] * b[2] + data[3] * b[3] + data[4] * b[4] + data[5] * b[5] + data[6] * b[6] - data[7] * b[7];
+    res[1] = data[0] * b[1] - data[4] * b[7] - data[5] * b[3] + data[6] * b[2];
+    res[2] = data[0] * b[2] + data[4] * b[3] - data[5] * b[7] - data[6] * b[1];
+    res[3] = data[0] * b[3] - data[4] * b[2] + data[5] * b[1] - data[6] * b[7];
+    res[4] = data[0] * b[4] - data[1] * b[7] - data[2] * b[3] + data[3] * b[2] - data[4] * b[0] - data[5] * b[6] + data[6] * b[5] - data[7] * b[1];
+    res[5] = data[0] * b[5] + data[1] * b[3] - data[2] * b[7] - data[3] * b[1] + data[4] * b[6] - data[5] * b[0] - data[6] * b[4] - data[7] * b[2];
+    res[6] = data[0] * b[6] - data[1] * b[2] + data[2] * b[1] - data[3] * b[7] - data[4] * b[5] + data[5] * b[4] - data[6] * b[0] - data[7] * b[3];
+    res[7] = data[0] * b[7] + data[4] * b[1] + data[5] * b[2] + data[6] * b[3];
+    return res;
+}
+// Flector
+[[nodiscard]] MultiVector Flector::operator* (const MultiVector& b) const
+{
+    MultiVector res{};
+    res[0] = data[1] * b[2] + data[2] * b[3] + data[3] * b[4] - data[7] * b[14];
+    res[1] = data[0] * b[0] - data[1] * b[5] - data[2] * b[6] - data[3] * b[7] + data[4] * b[8] + data[5] * b[9] + data[6] * b[10] + data[7] * b[15];
+    res[2] = data[1] * b[0] - data[2] * b[10] + data[3] * b[9] - data[7] * b[8];
+    res[3] = data[1] * b[10] + data[2] * b[0] - data[3] * b[8] - data[7] * b[9];
+    res[4] = -data[1] * b[9] + data[2] * b[8] + data[3] * b[0] - data[7] * b[10];
+    res[5] = data[0] * b[2] - data[1] * b[1] - data[2] * b[13] + data[3] * b[12] + data[4] * b[14] + data[5] * b[4] - data[6] * b[3] - data[7] * b[11];
+    res[6] = data[0] * b[3] + data[1] * b[13] - data[2] * b[1] - data[3] * b[11] - data[4] * b[4] + data[5] * b[14] + data[6] * b[2] - data[7] * b[12];
+    res[7] = data[0] * b[4] - data[1] * b[12] + data[2] * b[11] - data[3] * b[1] + data[4] * b[3] - data[5] * b[2] + data[6] * b[14] - data[7] * b[13];
+    res[8] = data[1] * b[14] + data[2] * b[4] - data[3] * b[3] + data[7] * b[2];
+    res[9] = -data[1] * b[4] + data[2] * b[14] + data[3] * b[2] + data[7] * b[3];
+    res[10] = data[1] * b[3] - data[2] * b[2] + data[3] * b[14] + data[7] * b[4];
+    res[11] = -data[0] * b[8] + data[1] * b[15] + data[2] * b[7] - data[3] * b[6] + data[4] * b[0] - data[5] * b[10] + data[6] * b[9] + data[7] * b[5];
+    res[12] = -data[0] * b[9] - data[1] * b[7] + data[2] * b[15] + data[3] * b[5] + data[4] * b[10] + data[5] * b[0] - data[6] * b[8] + data[7] * b[6];
+    res[13] = -data[0] * b[10] + data[1] * b[6] - data[2] * b[5] + data[3] * b[15] - data[4] * b[9] + data[5] * b[8] + data[6] * b[0] + data[7] * b[7];
+    res[14] = data[1] * b[8] + data[2] * b[9] + data[3] * b[10] + data[7] * b[0];
+    res[15] = data[0] * b[14] + data[1] * b[11] + data[2] * b[12] + data[3] * b[13] - data[4] * b[2] - data[5] * b[3] - data[6] * b[4] - data[7] * b[1];
+    return res;
+}
+[[nodiscard]] Motor Flector::operator* (const ThreeBlade& b) const
+{
+    Motor res{};
+    res[0] = -data[7] * b[3];
+    res[1] = -data[2] * b[2] + data[3] * b[1] + data[4] * b[3] - data[7] * b[0];
+    res[2] = data[1] * b[2] - data[3] * b[0] + data[5] * b[3] - data[7] * b[1];
+    res[3] = -data[1] * b[1] + data[2] * b[0] + data[6] * b[3] - data[7] * b[2];
+    res[4] = data[1] * b[3];
+    res[5] = data[2] * b[3];
+    res[6] = data[3] * b[3];
+    res[7] = data[0] * b[3] + data[1] * b[0] + data[2] * b[1] + data[3] * b[2];
+    return res;
+}
+[[nodiscard]] Flector Flector::operator* (const TwoBlade& b) const
+{
+    Flector res{};
+    res[0] = -data[1] * b[0] - data[2] * b[1] - data[3] * b[2] + data[4] * b[3] + data[5] * b[4] + data[6] * b[5];
+    res[1] = -data[2] * b[5] + data[3] * b[4] - data[7] * b[3];
+    res[2] = data[1] * b[5] - data[3] * b[3] - data[7] * b[4];
+    res[3] = -data[1] * b[4] + data[2] * b[3] - data[7] * b[5];
+    res[4] = -data[0] * b[3] + data[2] * b[2] - data[3] * b[1] - data[5] * b[5] + data[6] * b[4] + data[7] * b[0];
+    res[5] = -data[0] * b[4] - data[1] * b[2] + data[3] * b[0] + data[4] * b[5] - data[6] * b[3] + data[7] * b[1];
+    res[6] = -data[0] * b[5] + data[1] * b[1] - data[2] * b[0] - data[4] * b[4] + data[5] * b[3] + data[7] * b[2];
+    res[7] = data[1] * b[3] + data[2] * b[4] + data[3] * b[5];
+    return res;
+}
+[[nodiscard]] Motor Flector::operator* (const OneBlade& b) const
+{
+    Motor res{};
+    res[0] = data[1] * b[1] + data[2] * b[2] + data[3] * b[3];
+    res[1] = data[0] * b[1] - data[1] * b[0] + data[5] * b[3] - data[6] * b[2];
+    res[2] = data[0] * b[2] - data[2] * b[0] - data[4] * b[3] + data[6] * b[1];
+    res[3] = data[0] * b[3] - data[3] * b[0] + data[4] * b[2] - data[5] * b[1];
+    res[4] = data[2] * b[3] - data[3] * b[2] + data[7] * b[1];
+    res[5] = -data[1] * b[3] + data[3] * b[1] + data[7] * b[2];
+    res[6] = data[1] * b[2] - data[2] * b[1] + data[7] * b[3];
+    res[7] = -data[4] * b[1] - data[5] * b[2] - data[6] * b[3] - data[7] * b[0];
+    return res;
+}
+[[nodiscard]] Flector Flector::operator* (const Motor& b) const
+{
+    Flector res{};
+    res[0] = data[0] * b[0] - data[1] * b[1] - data[2] * b[2] - data[3] * b[3] + data[4] * b[4] + data[5] * b[5] + data[6] * b[6] + data[7] * b[7];
+    res[1] = data[1] * b[0] - data[2] * b[6] + data[3] * b[5] - data[7] * b[4];
+    res[2] = data[1] * b[6] + data[2] * b[0] - data[3] * b[4] - data[7] * b[5];
+    res[3] = -data[1] * b[5] + data[2] * b[4] + data[3] * b[0] - data[7] * b[6];
+    res[4] = -data[0] * b[4] + data[1] * b[7] + data[2] * b[3] - data[3] * b[2] + data[4] * b[0] - data[5] * b[6] + data[6] * b[5] + data[7] * b[1];
+    res[5] = -data[0] * b[5] - data[1] * b[3] + data[2] * b[7] + data[3] * b[1] + data[4] * b[6] + data[5] * b[0] - data[6] * b[4] + data[7] * b[2];
+    res[6] = -data[0] * b[6] + data[1] * b[2] - data[2] * b[1] + data[3] * b[7] - data[4] * b[5] + data[5] * b[4] + data[6] * b[0] + data[7] * b[3];
+    res[7] = data[1] * b[4] + data[2] * b[5] + data[3] * b[6] + data[7] * b[0];
+    return res;
+}
+[[nodiscard]] Motor Flector::operator* (const Flector& b) const
+{
+    Motor res{};
+    res[0] = data[1] * b[1] + data[2] * b[2] + data[3] * b[3] - data[7] * b[7];
+    res[1] = data[0] * b[1] - data[1] * b[0] - data[2] * b[6] + data[3] * b[5] + data[4] * b[7] + data[5] * b[3] - data[6] * b[2] - data[7] * b[4];
+    res[2] = data[0] * b[2] + data[1] * b[6] - data[2] * b[0] - data[3] * b[4] - data[4] * b[3] + data[5] * b[7] + data[6] * b[1] - data[7] * b[5];
+    res[3] = data[0] * b[3] - data[1] * b[5] + data[2] * b[4] - data[3] * b[0] + data[4] * b[2] - data[5] * b[1] + data[6] * b[7] - data[7] * b[6];
+    res[4] = data[1] * b[7] + data[2] * b[3] - data[3] * b[2] + data[7] * b[1];
+    res[5] = -data[1] * b[3] + data[2] * b[7] + data[3] * b[1] + data[7] * b[2];
+    res[6] = data[1] * b[2] - data[2] * b[1] + data[3] * b[7] + data[7] * b[3];
+    res[7] = data[0] * b[7] + data[1] * b[4] + data[2] * b[5] + data[3] * b[6] - data[4] * b[1] - data[5] * b[2] - data[6] * b[3] - data[7] * b[0];
+    return res;
+}
 
 // Inner
 
@@ -671,6 +917,26 @@ return res;
     res[15] = b[0] * data[15];
     return res;
 };
+[[nodiscard]] MultiVector MultiVector::operator| (const Flector& b) const
+{
+    MultiVector res{};
+    res[0] = data[2] * b[1] + data[3] * b[2] + data[4] * b[3] - data[14] * b[7];
+    res[1] = data[0] * b[0] + data[5] * b[1] + data[6] * b[2] + data[7] * b[3] + data[8] * b[4] + data[9] * b[5] + data[10] * b[6] - data[15] * b[7];
+    res[2] = data[0] * b[1] - data[8] * b[7] - data[9] * b[3] + data[10] * b[2];
+    res[3] = data[0] * b[2] + data[8] * b[3] - data[9] * b[7] - data[10] * b[1];
+    res[4] = data[0] * b[3] - data[8] * b[2] + data[9] * b[1] - data[10] * b[7];
+    res[5] = -data[3] * b[6] + data[4] * b[5] + data[12] * b[3] - data[13] * b[2];
+    res[6] = data[2] * b[6] - data[4] * b[4] - data[11] * b[3] + data[13] * b[1];
+    res[7] = -data[2] * b[5] + data[3] * b[4] + data[11] * b[2] - data[12] * b[1];
+    res[8] = data[2] * b[7] + data[14] * b[1];
+    res[9] = data[3] * b[7] + data[14] * b[2];
+    res[10] = data[4] * b[7] + data[14] * b[3];
+    res[11] = data[0] * b[4] - data[15] * b[1];
+    res[12] = data[0] * b[5] - data[15] * b[2];
+    res[13] = data[0] * b[6] - data[15] * b[3];
+    res[14] = data[0] * b[7];
+    return res;
+}
 // ThreeBlade
 [[nodiscard]] MultiVector ThreeBlade::operator| (const MultiVector& b) const
 {
@@ -717,15 +983,31 @@ return res;
     res[5] = data[3] * b[3];
     return res;
 };
-[[nodiscard]] OneBlade ThreeBlade::operator| (const Motor& b) const
+[[nodiscard]] Flector ThreeBlade::operator| (const Motor& b) const
 {
-    OneBlade res{};
-    res[0] = data[2] * b[6] + data[1] * b[5] + data[0] * b[4] - data[3] * b[7];
+    Flector res{};
+    res[0] = data[0] * b[4] + data[1] * b[5] + data[2] * b[6] + data[3] * b[7];
     res[1] = -data[3] * b[4];
     res[2] = -data[3] * b[5];
     res[3] = -data[3] * b[6];
+    res[4] = data[0] * b[0];
+    res[5] = data[1] * b[0];
+    res[6] = data[2] * b[0];
+    res[7] = data[3] * b[0];
     return res;
-};
+}
+[[nodiscard]] Motor ThreeBlade::operator| (const Flector& b) const
+{
+    Motor res{};
+    res[0] = -data[3] * b[7];
+    res[1] = data[1] * b[3] - data[2] * b[2];
+    res[2] = -data[0] * b[3] + data[2] * b[1];
+    res[3] = data[0] * b[2] - data[1] * b[1];
+    res[4] = data[3] * b[1];
+    res[5] = data[3] * b[2];
+    res[6] = data[3] * b[3];
+    return res;
+}
 // TwoBlade
 [[nodiscard]] MultiVector TwoBlade::operator| (const MultiVector& b) const
 {
@@ -782,6 +1064,15 @@ return res;
     res[4] = data[3] * b[0];
     return res;
 };
+[[nodiscard]] OneBlade TwoBlade::operator| (const Flector& b) const
+{
+    OneBlade res{};
+    res[0] = data[0] * b[1] + data[1] * b[2] + data[2] * b[3] + data[3] * b[4] + data[4] * b[5] + data[5] * b[6];
+    res[1] = -data[3] * b[7] - data[4] * b[3] + data[5] * b[2];
+    res[2] = data[3] * b[3] - data[4] * b[7] - data[5] * b[1];
+    res[3] = -data[3] * b[2] + data[4] * b[1] - data[5] * b[7];
+    return res;
+}
 // Oneblade
 [[nodiscard]] MultiVector OneBlade::operator| (const MultiVector& b) const
 {
@@ -828,18 +1119,30 @@ return res;
 {
     return data[1] * b[1] + data[2] * b[2] + data[3] * b[3];
 };
-[[nodiscard]] MultiVector OneBlade::operator| (const Motor& b) const
+[[nodiscard]] Flector OneBlade::operator| (const Motor& b) const
 {
-    MultiVector res{};
-    res[1] = data[0] * b[0] + data[1] * b[1] + data[2] * b[2] + data[3] * b[3];
-    res[2] = data[1] * b[0] + data[2] * b[6] - data[3] * b[5];
-    res[3] = data[2] * b[0] - data[1] * b[6] + data[3] * b[4];
-    res[4] = data[3] * b[0] + data[1] * b[5] - data[2] * b[4];
-    res[13] = -data[3] * b[7];
-    res[12] = -data[2] * b[7];
-    res[11] = -data[1] * b[7];
+    Flector res{};
+    res[0] = data[0] * b[0] - data[1] * b[1] - data[2] * b[2] - data[3] * b[3];
+    res[1] = data[1] * b[0] - data[2] * b[6] + data[3] * b[5];
+    res[2] = data[1] * b[6] + data[2] * b[0] - data[3] * b[4];
+    res[3] = -data[1] * b[5] + data[2] * b[4] + data[3] * b[0];
+    res[4] = data[1] * b[7];
+    res[5] = data[2] * b[7];
+    res[6] = data[3] * b[7];
     return res;
-};
+}
+[[nodiscard]] Motor OneBlade::operator| (const Flector& b) const
+{
+    Motor res{};
+    res[0] = data[1] * b[1] + data[2] * b[2] + data[3] * b[3];
+    res[1] = -data[2] * b[6] + data[3] * b[5];
+    res[2] = data[1] * b[6] - data[3] * b[4];
+    res[3] = -data[1] * b[5] + data[2] * b[4];
+    res[4] = data[1] * b[7];
+    res[5] = data[2] * b[7];
+    res[6] = data[3] * b[7];
+    return res;
+}
 // Motor
 [[nodiscard]] MultiVector Motor::operator| (const MultiVector& b) const
 {
@@ -862,27 +1165,19 @@ return res;
     res[15] = data[0] * b[15];
     return res;
 };
-[[nodiscard]] MultiVector Motor::operator| (const ThreeBlade& b) const
+[[nodiscard]] Flector Motor::operator| (const ThreeBlade& b) const
 {
-    MultiVector res{};
-    res[0] = 0;
-    res[1] = data[6] * b[2] + data[5] * b[1] + data[4] * b[0] + data[7] * b[3];
-    res[2] = - data[4] * b[3];
-    res[3] = - data[5] * b[3];
-    res[4] = - data[6] * b[3];
-    res[5] = 0;
-    res[6] = 0;
-    res[7] = 0;
-    res[8] = 0;
-    res[9] = 0;
-    res[10] = 0;
-    res[13] = data[0] * b[2];
-    res[12] = data[0] * b[1];
-    res[11] = data[0] * b[0];
-    res[14] = data[0] * b[3];
-    res[15] = 0;
+    Flector res{};
+    res[0] = data[4] * b[0] + data[5] * b[1] + data[6] * b[2] - data[7] * b[3];
+    res[1] = -data[4] * b[3];
+    res[2] = -data[5] * b[3];
+    res[3] = -data[6] * b[3];
+    res[4] = data[0] * b[0];
+    res[5] = data[0] * b[1];
+    res[6] = data[0] * b[2];
+    res[7] = data[0] * b[3];
     return res;
-};
+}
 [[nodiscard]] Motor Motor::operator| (const TwoBlade& b) const
 {
     Motor res{};
@@ -896,27 +1191,18 @@ return res;
     res[7] = 0;
     return res;
 };
-[[nodiscard]] MultiVector Motor::operator| (const OneBlade& b) const
+[[nodiscard]] Flector Motor::operator| (const OneBlade& b) const
 {
-    MultiVector res{};
-    res[0] = 0;
-    res[1] = data[0] * b[0] - data[1] * b[1] - data[2] * b[2] - data[3] * b[3];
-    res[2] = data[0] * b[1] - data[6] * b[2] + data[5] * b[3];
-    res[3] = data[6] * b[1] + data[0] * b[2] - data[4] * b[3];
-    res[4] = -data[5] * b[1] + data[4] * b[2] + data[0] * b[3];
-    res[5] = 0;
-    res[6] = 0;
-    res[7] = 0;
-    res[8] = 0;
-    res[9] = 0;
-    res[10] = 0;
-    res[13] = data[7] * b[3];
-    res[12] = data[7] * b[2];
-    res[11] = data[7] * b[1];
-    res[14] = 0;
-    res[15] = 0;
+    Flector res{};
+    res[0] = data[0] * b[0] + data[1] * b[1] + data[2] * b[2] + data[3] * b[3];
+    res[1] = data[0] * b[1] - data[5] * b[3] + data[6] * b[2];
+    res[2] = data[0] * b[2] + data[4] * b[3] - data[6] * b[1];
+    res[3] = data[0] * b[3] - data[4] * b[2] + data[5] * b[1];
+    res[4] = -data[7] * b[1];
+    res[5] = -data[7] * b[2];
+    res[6] = -data[7] * b[3];
     return res;
-};
+}
 [[nodiscard]] Motor Motor::operator| (const Motor& b) const
 {
     Motor res{};
@@ -930,6 +1216,98 @@ return res;
     res[7] = data[0] * b[7];
     return res;
 };
+[[nodiscard]] Flector Motor::operator| (const Flector& b) const
+{
+    Flector res{};
+    res[0] = data[0] * b[0] + data[1] * b[1] + data[2] * b[2] + data[3] * b[3] + data[4] * b[4] + data[5] * b[5] + data[6] * b[6] - data[7] * b[7];
+    res[1] = data[0] * b[1] - data[4] * b[7] - data[5] * b[3] + data[6] * b[2];
+    res[2] = data[0] * b[2] + data[4] * b[3] - data[5] * b[7] - data[6] * b[1];
+    res[3] = data[0] * b[3] - data[4] * b[2] + data[5] * b[1] - data[6] * b[7];
+    res[4] = data[0] * b[4] - data[7] * b[1];
+    res[5] = data[0] * b[5] - data[7] * b[2];
+    res[6] = data[0] * b[6] - data[7] * b[3];
+    res[7] = data[0] * b[7];
+    return res;
+}
+// Flector
+[[nodiscard]] MultiVector Flector::operator| (const MultiVector& b) const
+{
+    MultiVector res{};
+    res[0] = data[1] * b[2] + data[2] * b[3] + data[3] * b[4] - data[7] * b[14];
+    res[1] = data[0] * b[0] - data[1] * b[5] - data[2] * b[6] - data[3] * b[7] + data[4] * b[8] + data[5] * b[9] + data[6] * b[10] + data[7] * b[15];
+    res[2] = data[1] * b[0] - data[2] * b[10] + data[3] * b[9] - data[7] * b[8];
+    res[3] = data[1] * b[10] + data[2] * b[0] - data[3] * b[8] - data[7] * b[9];
+    res[4] = -data[1] * b[9] + data[2] * b[8] + data[3] * b[0] - data[7] * b[10];
+    res[5] = -data[2] * b[13] + data[3] * b[12] + data[5] * b[4] - data[6] * b[3];
+    res[6] = data[1] * b[13] - data[3] * b[11] - data[4] * b[4] + data[6] * b[2];
+    res[7] = -data[1] * b[12] + data[2] * b[11] + data[4] * b[3] - data[5] * b[2];
+    res[8] = data[1] * b[14] + data[7] * b[2];
+    res[9] = data[2] * b[14] + data[7] * b[3];
+    res[10] = data[3] * b[14] + data[7] * b[4];
+    res[11] = data[1] * b[15] + data[4] * b[0];
+    res[12] = data[2] * b[15] + data[5] * b[0];
+    res[13] = data[3] * b[15] + data[6] * b[0];
+    res[14] = data[7] * b[0];
+    return res;
+}
+[[nodiscard]] Motor Flector::operator| (const ThreeBlade& b) const
+{
+    Motor res{};
+    res[0] = -data[7] * b[3];
+    res[1] = -data[2] * b[2] + data[3] * b[1];
+    res[2] = data[1] * b[2] - data[3] * b[0];
+    res[3] = -data[1] * b[1] + data[2] * b[0];
+    res[4] = data[1] * b[3];
+    res[5] = data[2] * b[3];
+    res[6] = data[3] * b[3];
+    return res;
+}
+[[nodiscard]] OneBlade Flector::operator| (const TwoBlade& b) const
+{
+    OneBlade res{};
+    res[0] = -data[1] * b[0] - data[2] * b[1] - data[3] * b[2] + data[4] * b[3] + data[5] * b[4] + data[6] * b[5];
+    res[1] = -data[2] * b[5] + data[3] * b[4] - data[7] * b[3];
+    res[2] = data[1] * b[5] - data[3] * b[3] - data[7] * b[4];
+    res[3] = -data[1] * b[4] + data[2] * b[3] - data[7] * b[5];
+    return res;
+}
+[[nodiscard]] Motor Flector::operator| (const OneBlade& b) const
+{
+    Motor res{};
+    res[0] = data[1] * b[1] + data[2] * b[2] + data[3] * b[3];
+    res[1] = data[5] * b[3] - data[6] * b[2];
+    res[2] = -data[4] * b[3] + data[6] * b[1];
+    res[3] = data[4] * b[2] - data[5] * b[1];
+    res[4] = data[7] * b[1];
+    res[5] = data[7] * b[2];
+    res[6] = data[7] * b[3];
+    return res;
+}
+[[nodiscard]] Flector Flector::operator| (const Motor& b) const
+{
+    Flector res{};
+    res[0] = data[0] * b[0] - data[1] * b[1] - data[2] * b[2] - data[3] * b[3] + data[4] * b[4] + data[5] * b[5] + data[6] * b[6] + data[7] * b[7];
+    res[1] = data[1] * b[0] - data[2] * b[6] + data[3] * b[5] - data[7] * b[4];
+    res[2] = data[1] * b[6] + data[2] * b[0] - data[3] * b[4] - data[7] * b[5];
+    res[3] = -data[1] * b[5] + data[2] * b[4] + data[3] * b[0] - data[7] * b[6];
+    res[4] = data[1] * b[7] + data[4] * b[0];
+    res[5] = data[2] * b[7] + data[5] * b[0];
+    res[6] = data[3] * b[7] + data[6] * b[0];
+    res[7] = data[7] * b[0];
+    return res;
+}
+[[nodiscard]] Motor Flector::operator| (const Flector& b) const
+{
+    Motor res{};
+    res[0] = data[1] * b[1] + data[2] * b[2] + data[3] * b[3] - data[7] * b[7];
+    res[1] = -data[2] * b[6] + data[3] * b[5] + data[5] * b[3] - data[6] * b[2];
+    res[2] = data[1] * b[6] - data[3] * b[4] - data[4] * b[3] + data[6] * b[1];
+    res[3] = -data[1] * b[5] + data[2] * b[4] + data[4] * b[2] - data[5] * b[1];
+    res[4] = data[1] * b[7] + data[7] * b[1];
+    res[5] = data[2] * b[7] + data[7] * b[2];
+    res[6] = data[3] * b[7] + data[7] * b[3];
+    return res;
+}
 
 // Outer Product
 
@@ -1039,6 +1417,26 @@ return res;
     res[15] = b[7] * data[0] + b[4] * data[5] + b[5] * data[6] + b[6] * data[7] + b[3] * data[10] + b[2] * data[9] + b[1] * data[8] + b[0] * data[15];
     return res;
 }
+[[nodiscard]] MultiVector MultiVector::operator^(const Flector& b) const
+{
+    MultiVector res{};
+    res[1] = data[0] * b[0];
+    res[2] = data[0] * b[1];
+    res[3] = data[0] * b[2];
+    res[4] = data[0] * b[3];
+    res[5] = data[1] * b[1] - data[2] * b[0];
+    res[6] = data[1] * b[2] - data[3] * b[0];
+    res[7] = data[1] * b[3] - data[4] * b[0];
+    res[8] = data[3] * b[3] - data[4] * b[2];
+    res[9] = -data[2] * b[3] + data[4] * b[1];
+    res[10] = data[2] * b[2] - data[3] * b[1];
+    res[11] = data[0] * b[4] - data[6] * b[3] + data[7] * b[2] - data[8] * b[0];
+    res[12] = data[0] * b[5] + data[5] * b[3] - data[7] * b[1] - data[9] * b[0];
+    res[13] = data[0] * b[6] - data[5] * b[2] + data[6] * b[1] - data[10] * b[0];
+    res[14] = data[0] * b[7] + data[8] * b[1] + data[9] * b[2] + data[10] * b[3];
+    res[15] = data[1] * b[7] + data[2] * b[4] + data[3] * b[5] + data[4] * b[6] - data[11] * b[1] - data[12] * b[2] - data[13] * b[3] - data[14] * b[0];
+    return res;
+}
 // ThreeBlade
 [[nodiscard]] MultiVector ThreeBlade::operator^(const MultiVector& b) const
 {
@@ -1082,6 +1480,10 @@ return res;
     res[3] = data[3] * b[0];
     return res;
 }
+[[nodiscard]] float ThreeBlade::operator^(const Flector& b) const
+{
+    return -data[0] * b[1] - data[1] * b[2] - data[2] * b[3] - data[3] * b[0];
+}
 // TwoBlade
 [[nodiscard]] MultiVector TwoBlade::operator^(const MultiVector& b) const
 {
@@ -1108,11 +1510,9 @@ return res;
 {
     return GANull{};
 }
-[[nodiscard]] MultiVector TwoBlade::operator ^ (const TwoBlade& b) const
+[[nodiscard]] float TwoBlade::operator^(const TwoBlade& b) const
 {
-    MultiVector res{};
-    res[15] = data[0] + b[4] * data[1] + b[5] * data[2] + b[2] * data[5] + b[1] * data[4] + b[0] * data[3];
-    return res;
+    return data[0] * b[3] + data[1] * b[4] + data[2] * b[5] + data[3] * b[0] + data[4] * b[1] + data[5] * b[2];
 }
 [[nodiscard]] ThreeBlade TwoBlade::operator^(const OneBlade& b) const
 {
@@ -1136,6 +1536,15 @@ return res;
     res[7] = data[3] * b[1] + data[4] * b[2] + data[5] * b[3] + data[2] * b[6] + data[1] * b[5] + data[0] * b[4];
     return res;
 }
+[[nodiscard]] ThreeBlade TwoBlade::operator^(const Flector& b) const
+{
+    ThreeBlade res{};
+    res[0] = -data[1] * b[3] + data[2] * b[2] - data[3] * b[0];
+    res[1] = data[0] * b[3] - data[2] * b[1] - data[4] * b[0];
+    res[2] = -data[0] * b[2] + data[1] * b[1] - data[5] * b[0];
+    res[3] = data[3] * b[1] + data[4] * b[2] + data[5] * b[3];
+    return res;
+}
 // Oneblade
 [[nodiscard]] MultiVector OneBlade::operator^(const MultiVector& b) const
 {
@@ -1158,26 +1567,9 @@ return res;
     res[15] = b[14] * data[0] + b[11] * data[1] + b[12] * data[2] + b[13] * data[3];
     return res;
 }
-[[nodiscard]] MultiVector OneBlade::operator^(const ThreeBlade& b) const
+[[nodiscard]] float OneBlade::operator^(const ThreeBlade& b) const
 {
-    MultiVector res{};
-    res[0] = 0;
-    res[1] = 0;
-    res[2] = 0;
-    res[3] = 0;
-    res[4] = 0;
-    res[5] = 0;
-    res[6] = 0;
-    res[7] = 0;
-    res[10] = 0;
-    res[9] = 0;
-    res[8] = 0;
-    res[13] = 0;
-    res[12] = 0;
-    res[11] = 0;
-    res[14] = 0;
-    res[15] = -data[3] * b[2] - data[2] * b[1] - data[1] * b[0] - data[0] * b[3];
-    return res;
+    return data[0] * b[3] + data[1] * b[0] + data[2] * b[1] + data[3] * b[2];
 }
 [[nodiscard]] ThreeBlade OneBlade::operator^ (const TwoBlade& b) const
 {
@@ -1199,25 +1591,29 @@ return res;
     res[3] = b[3] * data[2] - b[2] * data[3];
     return res;
 }
-[[nodiscard]] MultiVector OneBlade::operator^(const Motor& b) const
+[[nodiscard]] Flector OneBlade::operator^(const Motor& b) const
 {
-    MultiVector res{};
-    res[0] = 0;
-    res[1] = data[0] * b[0];
-    res[2] = data[1] * b[0];
-    res[3] = data[2] * b[0];
-    res[4] = data[3] * b[0];
-    res[5] = 0;
-    res[6] = 0;
-    res[7] = 0;
-    res[10] = 0;
-    res[9] = 0;
-    res[8] = 0;
-    res[13] = -data[2] * b[1] + data[1] * b[2] - data[0] * b[6];
-    res[12] = data[3] * b[1] - data[1] * b[3] - data[0] * b[5];
-    res[11] = -data[3] * b[2] + data[2] * b[3] - data[0] * b[3];
-    res[14] = data[3] * b[6] + data[2] * b[5] + data[1] * b[3];
-    res[15] = 0;
+    Flector res{};
+    res[0] = data[0] * b[0];
+    res[1] = data[1] * b[0];
+    res[2] = data[2] * b[0];
+    res[3] = data[3] * b[0];
+    res[4] = -data[0] * b[4] + data[2] * b[3] - data[3] * b[2];
+    res[5] = -data[0] * b[5] - data[1] * b[3] + data[3] * b[1];
+    res[6] = -data[0] * b[6] + data[1] * b[2] - data[2] * b[1];
+    res[7] = data[1] * b[4] + data[2] * b[5] + data[3] * b[6];
+    return res;
+}
+[[nodiscard]] Motor OneBlade::operator^(const Flector& b) const
+{
+    Motor res{};
+    res[1] = data[0] * b[1] - data[1] * b[0];
+    res[2] = data[0] * b[2] - data[2] * b[0];
+    res[3] = data[0] * b[3] - data[3] * b[0];
+    res[4] = data[2] * b[3] - data[3] * b[2];
+    res[5] = -data[1] * b[3] + data[3] * b[1];
+    res[6] = data[1] * b[2] - data[2] * b[1];
+    res[7] = data[0] * b[7] + data[1] * b[4] + data[2] * b[5] + data[3] * b[6];
     return res;
 }
 // Motor
@@ -1264,46 +1660,114 @@ return res;
     res[7] = data[4] * b[0] + data[5] * b[1] + data[6] * b[2] + data[3] * b[5] + data[2] * b[4] + data[1] * b[3];
     return res;
 }
-[[nodiscard]] MultiVector Motor::operator^(const OneBlade& b) const
+[[nodiscard]] Flector Motor::operator^(const OneBlade& b) const
+{
+    Flector res{};
+    res[0] = data[0] * b[0];
+    res[1] = data[0] * b[1];
+    res[2] = data[0] * b[2];
+    res[3] = data[0] * b[3];
+    res[4] = -data[2] * b[3] + data[3] * b[2] - data[4] * b[0];
+    res[5] = data[1] * b[3] - data[3] * b[1] - data[5] * b[0];
+    res[6] = -data[1] * b[2] + data[2] * b[1] - data[6] * b[0];
+    res[7] = data[4] * b[1] + data[5] * b[2] + data[6] * b[3];
+    return res;
+}
+[[nodiscard]] Motor Motor::operator^(const Motor& b) const
+{
+    Motor res{};
+    res[0] = data[0] * b[0];
+    res[1] = data[0] * b[1] + data[1] * b[0];
+    res[2] = data[0] * b[2] + data[2] * b[0];
+    res[3] = data[0] * b[3] + data[3] * b[0];
+    res[4] = data[0] * b[4] + data[4] * b[0];
+    res[5] = data[0] * b[5] + data[5] * b[0];
+    res[6] = data[0] * b[6] + data[6] * b[0];
+    res[7] = data[0] * b[7] + data[1] * b[4] + data[2] * b[5] + data[3] * b[6] + data[4] * b[1] + data[5] * b[2] + data[6] * b[3] + data[7] * b[0];
+    return res;
+}
+[[nodiscard]] Flector Motor::operator^(const Flector& b) const
+{
+    Flector res{};
+    res[0] = data[0] * b[0];
+    res[1] = data[0] * b[1];
+    res[2] = data[0] * b[2];
+    res[3] = data[0] * b[3];
+    res[4] = data[0] * b[4] - data[2] * b[3] + data[3] * b[2] - data[4] * b[0];
+    res[5] = data[0] * b[5] + data[1] * b[3] - data[3] * b[1] - data[5] * b[0];
+    res[6] = data[0] * b[6] - data[1] * b[2] + data[2] * b[1] - data[6] * b[0];
+    res[7] = data[0] * b[7] + data[4] * b[1] + data[5] * b[2] + data[6] * b[3];
+    return res;
+}
+// Flector
+[[nodiscard]] MultiVector Flector::operator^(const MultiVector& b) const
 {
     MultiVector res{};
-    res[0] = 0;
     res[1] = data[0] * b[0];
-    res[2] = data[0] * b[1];
-    res[3] = data[0] * b[2];
-    res[4] = data[0] * b[3];
-    res[5] = 0;
-    res[6] = 0;
-    res[7] = 0;
-    res[10] = 0;
-    res[9] = 0;
-    res[8] = 0;
-    res[13] = -data[6] * b[0];
-    res[12] = -data[5] * b[0];
-    res[11] = -data[4] * b[0];
-    res[14] = data[4] * b[1] + data[5] * b[2] + data[6] * b[3];
-    res[15] = 0;
+    res[2] = data[1] * b[0];
+    res[3] = data[2] * b[0];
+    res[4] = data[3] * b[0];
+    res[5] = data[0] * b[2] - data[1] * b[1];
+    res[6] = data[0] * b[3] - data[2] * b[1];
+    res[7] = data[0] * b[4] - data[3] * b[1];
+    res[8] = data[2] * b[4] - data[3] * b[3];
+    res[9] = -data[1] * b[4] + data[3] * b[2];
+    res[10] = data[1] * b[3] - data[2] * b[2];
+    res[11] = -data[0] * b[8] + data[2] * b[7] - data[3] * b[6] + data[4] * b[0];
+    res[12] = -data[0] * b[9] - data[1] * b[7] + data[3] * b[5] + data[5] * b[0];
+    res[13] = -data[0] * b[10] + data[1] * b[6] - data[2] * b[5] + data[6] * b[0];
+    res[14] = data[1] * b[8] + data[2] * b[9] + data[3] * b[10] + data[7] * b[0];
+    res[15] = data[0] * b[14] + data[1] * b[11] + data[2] * b[12] + data[3] * b[13] - data[4] * b[2] - data[5] * b[3] - data[6] * b[4] - data[7] * b[1];
     return res;
 }
-[[nodiscard]] MultiVector Motor::operator^(const Motor& b) const
+[[nodiscard]] float Flector::operator^(const ThreeBlade& b) const
 {
-    MultiVector res{};
+    return data[0] * b[3] + data[1] * b[0] + data[2] * b[1] + data[3] * b[2];
+}
+[[nodiscard]] ThreeBlade Flector::operator^(const TwoBlade& b) const
+{
+    ThreeBlade res{};
+    res[0] = -data[0] * b[3] + data[2] * b[2] - data[3] * b[1];
+    res[1] = -data[0] * b[4] - data[1] * b[2] + data[3] * b[0];
+    res[2] = -data[0] * b[5] + data[1] * b[1] - data[2] * b[0];
+    res[3] = data[1] * b[3] + data[2] * b[4] + data[3] * b[5];
+    return res;
+}
+[[nodiscard]] Motor Flector::operator^(const OneBlade& b) const
+{
+    Motor res{};
+    res[1] = data[0] * b[1] - data[1] * b[0];
+    res[2] = data[0] * b[2] - data[2] * b[0];
+    res[3] = data[0] * b[3] - data[3] * b[0];
+    res[4] = data[2] * b[3] - data[3] * b[2];
+    res[5] = -data[1] * b[3] + data[3] * b[1];
+    res[6] = data[1] * b[2] - data[2] * b[1];
+    res[7] = -data[4] * b[1] - data[5] * b[2] - data[6] * b[3] - data[7] * b[0];
+    return res;
+}
+[[nodiscard]] Flector Flector::operator^(const Motor& b) const
+{
+    Flector res{};
     res[0] = data[0] * b[0];
-    res[1] = 0;
-    res[2] = 0;
-    res[3] = 0;
-    res[4] = 0;
-    res[5] = data[1] * b[0] + data[0] * b[1];
-    res[6] = data[2] * b[0] + data[0] * b[2];
-    res[7] = data[3] * b[0] + data[0] * b[3];
-    res[10] = data[6] * b[0] + data[0] * b[6];
-    res[9] = data[5] * b[0] + data[0] * b[5];
-    res[8] = data[4] * b[0] + data[0] * b[4];
-    res[13] = 0;
-    res[12] = 0;
-    res[11] = 0;
-    res[14] = 0;
-    res[15] = data[7] * b[0] + data[4] * b[1] + data[5] * b[2] + data[6] * b[3] + data[3] * b[6] + data[2] * b[5] + data[1] * b[4] + data[0] * b[7];
+    res[1] = data[1] * b[0];
+    res[2] = data[2] * b[0];
+    res[3] = data[3] * b[0];
+    res[4] = -data[0] * b[4] + data[2] * b[3] - data[3] * b[2] + data[4] * b[0];
+    res[5] = -data[0] * b[5] - data[1] * b[3] + data[3] * b[1] + data[5] * b[0];
+    res[6] = -data[0] * b[6] + data[1] * b[2] - data[2] * b[1] + data[6] * b[0];
+    res[7] = data[1] * b[4] + data[2] * b[5] + data[3] * b[6] + data[7] * b[0];
+    return res;
+}
+[[nodiscard]] Motor Flector::operator^(const Flector& b) const
+{
+    Motor res{};
+    res[1] = data[0] * b[1] - data[1] * b[0];
+    res[2] = data[0] * b[2] - data[2] * b[0];
+    res[3] = data[0] * b[3] - data[3] * b[0];
+    res[4] = data[2] * b[3] - data[3] * b[2];
+    res[5] = -data[1] * b[3] + data[3] * b[1];
+    res[6] = data[1] * b[2] - data[2] * b[1];
+    res[7] = data[0] * b[7] + data[1] * b[4] + data[2] * b[5] + data[3] * b[6] - data[4] * b[1] - data[5] * b[2] - data[6] * b[3] - data[7] * b[0];
     return res;
 }
 
@@ -1409,6 +1873,26 @@ return res;
     res[0] = b[0] * data[15] + b[1] * data[8] + b[2] * data[9] + b[3] * data[10] + b[6] * data[7] + b[5] * data[6] + b[4] * data[5] + b[7] * data[0];
     return res;
 }
+[[nodiscard]] MultiVector MultiVector::operator& (const Flector& b) const
+{
+    MultiVector res{};
+    res[0] = data[1] * b[7] + data[2] * b[4] + data[3] * b[5] + data[4] * b[6] - data[11] * b[1] - data[12] * b[2] - data[13] * b[3] - data[14] * b[0];
+    res[1] = -data[5] * b[4] - data[6] * b[5] - data[7] * b[6] + data[15] * b[0];
+    res[2] = data[5] * b[7] + data[9] * b[6] - data[10] * b[5] + data[15] * b[1];
+    res[3] = data[6] * b[7] - data[8] * b[6] + data[10] * b[4] + data[15] * b[2];
+    res[4] = data[7] * b[7] + data[8] * b[5] - data[9] * b[4] + data[15] * b[3];
+    res[5] = data[12] * b[6] - data[13] * b[5];
+    res[6] = -data[11] * b[6] + data[13] * b[4];
+    res[7] = data[11] * b[5] - data[12] * b[4];
+    res[8] = -data[11] * b[7] + data[14] * b[4];
+    res[9] = -data[12] * b[7] + data[14] * b[5];
+    res[10] = -data[13] * b[7] + data[14] * b[6];
+    res[11] = data[15] * b[4];
+    res[12] = data[15] * b[5];
+    res[13] = data[15] * b[6];
+    res[14] = data[15] * b[7];
+    return res;
+}
 // ThreeBlade
 [[nodiscard]] MultiVector ThreeBlade::operator& (const MultiVector& b) const
 {
@@ -1455,25 +1939,29 @@ return res;
 {
     return data[2] * b[3] + data[1] * b[2] + data[0] * b[1] + data[3] * b[0];
 }
-[[nodiscard]] MultiVector ThreeBlade::operator& (const Motor& b) const
+[[nodiscard]] Flector ThreeBlade::operator& (const Motor& b) const
 {
-    MultiVector res{};
-    res[15] = 0;
-    res[14] = data[3] * b[7];
-    res[11] = data[0] * b[7];
-    res[12] = data[1] * b[7];
-    res[13] = data[2] * b[7];
-    res[8] = 0;
-    res[9] = 0;
-    res[10] = 0;
-    res[7] = 0;
-    res[6] = 0;
-    res[5] =0;
-    res[4] = data[1] * b[4] - data[0] * b[5] + data[3] * b[3];
-    res[3] = -data[2] * b[4] + data[0] * b[6] + data[3] * b[2];
-    res[2] = data[2] * b[5] - data[1] * b[6] + data[3] * b[1];
-    res[1] = -data[2] * b[3] - data[1] * b[2] - data[0] * b[1];
-    res[0] = 0;
+    Flector res{};
+    res[0] = -data[0] * b[1] - data[1] * b[2] - data[2] * b[3];
+    res[1] = -data[1] * b[6] + data[2] * b[5] + data[3] * b[1];
+    res[2] = data[0] * b[6] - data[2] * b[4] + data[3] * b[2];
+    res[3] = -data[0] * b[5] + data[1] * b[4] + data[3] * b[3];
+    res[4] = data[0] * b[7];
+    res[5] = data[1] * b[7];
+    res[6] = data[2] * b[7];
+    res[7] = data[3] * b[7];
+    return res;
+}
+[[nodiscard]] Motor ThreeBlade::operator& (const Flector& b) const
+{
+    Motor res{};
+    res[0] = -data[0] * b[1] - data[1] * b[2] - data[2] * b[3] - data[3] * b[0];
+    res[1] = data[1] * b[6] - data[2] * b[5];
+    res[2] = -data[0] * b[6] + data[2] * b[4];
+    res[3] = data[0] * b[5] - data[1] * b[4];
+    res[4] = -data[0] * b[7] + data[3] * b[4];
+    res[5] = -data[1] * b[7] + data[3] * b[5];
+    res[6] = -data[2] * b[7] + data[3] * b[6];
     return res;
 }
 // TwoBlade
@@ -1515,25 +2003,25 @@ return res;
 {
     return GANull{};
 }
-[[nodiscard]] MultiVector TwoBlade::operator& (const Motor& b) const
+[[nodiscard]] Motor TwoBlade::operator& (const Motor& b) const
 {
-    MultiVector res{};
-    res[15] = 0;
-    res[14] = 0;
-    res[11] = 0;
-    res[12] = 0;
-    res[13] = 0;
-    res[8] = b[7] * data[3];
-    res[9] = b[7] * data[4];
-    res[10] = b[7] * data[5];
-    res[7] = b[7] * data[2];
-    res[6] = b[7] * data[1];
-    res[5] = b[7] * data[0];
-    res[4] = 0;
-    res[3] = 0;
-    res[2] = 0;
-    res[1] = 0;
-    res[0] = b[1] * data[3] + b[2] * data[4] + b[3] * data[5] + b[6] * data[2] + b[5] * data[1] + b[4] * data[0];
+    Motor res{};
+    res[0] = data[0] * b[4] + data[1] * b[5] + data[2] * b[6] + data[3] * b[1] + data[4] * b[2] + data[5] * b[3];
+    res[1] = data[0] * b[7];
+    res[2] = data[1] * b[7];
+    res[3] = data[2] * b[7];
+    res[4] = data[3] * b[7];
+    res[5] = data[4] * b[7];
+    res[6] = data[5] * b[7];
+    return res;
+}
+[[nodiscard]] OneBlade TwoBlade::operator& (const Flector& b) const
+{
+    OneBlade res{};
+    res[0] = -data[0] * b[4] - data[1] * b[5] - data[2] * b[6];
+    res[1] = data[0] * b[7] + data[4] * b[6] - data[5] * b[5];
+    res[2] = data[1] * b[7] - data[3] * b[6] + data[5] * b[4];
+    res[3] = data[2] * b[7] + data[3] * b[5] - data[4] * b[4];
     return res;
 }
 // Oneblade
@@ -1579,6 +2067,10 @@ return res;
     res[0] = b[7] * data[0];
     return res;
 }
+[[nodiscard]] float OneBlade::operator& (const Flector& b) const
+{
+    return data[0] * b[7] + data[1] * b[4] + data[2] * b[5] + data[3] * b[6];
+}
 // Motor
 [[nodiscard]] MultiVector Motor::operator& (const MultiVector& b) const
 {
@@ -1601,25 +2093,17 @@ return res;
     res[0] = b[0] * data[7] + b[5] * data[4] + b[6] * data[5] + b[7] * data[6] + b[10] * data[3] + b[9] * data[2] + b[8] * data[1] + b[15] * data[0];
     return res;
 }
-[[nodiscard]] MultiVector Motor::operator& (const ThreeBlade& b) const
+[[nodiscard]] Flector Motor::operator& (const ThreeBlade& b) const
 {
-    MultiVector res{};
-    res[15] = 0;
-    res[14] = b[3] * data[7];
-    res[11] = b[0] * data[7];
-    res[12] = b[1] * data[7];
-    res[13] = b[2] * data[7];
-    res[8] = 0;
-    res[9] = 0;
-    res[10] = 0;
-    res[7] = 0;
-    res[6] = 0;
-    res[5] = 0;
-    res[4] = b[12] * data[4] - b[0] * data[5] + b[3] * data[3];
-    res[3] = - b[2] * data[4] + b[0] * data[6] + b[3] * data[2];
-    res[2] = b[2] * data[5] - b[12] * data[6] + b[3] * data[1];
-    res[1] = - b[2] * data[3] - b[12] * data[2] - b[0] * data[1];
-    res[0] = b[15] * data[0];
+    Flector res{};
+    res[0] = -data[1] * b[0] - data[2] * b[1] - data[3] * b[2];
+    res[1] = data[1] * b[3] + data[5] * b[2] - data[6] * b[1];
+    res[2] = data[2] * b[3] - data[4] * b[2] + data[6] * b[0];
+    res[3] = data[3] * b[3] + data[4] * b[1] - data[5] * b[0];
+    res[4] = data[7] * b[0];
+    res[5] = data[7] * b[1];
+    res[6] = data[7] * b[2];
+    res[7] = data[7] * b[3];
     return res;
 }
 [[nodiscard]] Motor Motor::operator& (const TwoBlade& b) const
@@ -1657,6 +2141,591 @@ return res;
     res[0] = b[0] * data[7] + b[1] * data[4] + b[2] * data[5] + b[3] * data[6] + b[6] * data[3] + b[5] * data[2] + b[4] * data[1] + b[15] * data[0];
     return res;
 }
+[[nodiscard]] Flector Motor::operator& (const Flector& b) const
+{
+    Flector res{};
+    res[0] = -data[1] * b[4] - data[2] * b[5] - data[3] * b[6] + data[7] * b[0];
+    res[1] = data[1] * b[7] + data[5] * b[6] - data[6] * b[5] + data[7] * b[1];
+    res[2] = data[2] * b[7] - data[4] * b[6] + data[6] * b[4] + data[7] * b[2];
+    res[3] = data[3] * b[7] + data[4] * b[5] - data[5] * b[4] + data[7] * b[3];
+    res[4] = data[7] * b[4];
+    res[5] = data[7] * b[5];
+    res[6] = data[7] * b[6];
+    res[7] = data[7] * b[7];
+    return res;
+}
+// Flector
+[[nodiscard]] MultiVector Flector::operator& (const MultiVector& b) const
+{
+    MultiVector res{};
+    res[0] = data[0] * b[14] + data[1] * b[11] + data[2] * b[12] + data[3] * b[13] - data[4] * b[2] - data[5] * b[3] - data[6] * b[4] - data[7] * b[1];
+    res[1] = data[0] * b[15] - data[4] * b[5] - data[5] * b[6] - data[6] * b[7];
+    res[2] = data[1] * b[15] - data[5] * b[10] + data[6] * b[9] + data[7] * b[5];
+    res[3] = data[2] * b[15] + data[4] * b[10] - data[6] * b[8] + data[7] * b[6];
+    res[4] = data[3] * b[15] - data[4] * b[9] + data[5] * b[8] + data[7] * b[7];
+    res[5] = data[5] * b[13] - data[6] * b[12];
+    res[6] = -data[4] * b[13] + data[6] * b[11];
+    res[7] = data[4] * b[12] - data[5] * b[11];
+    res[8] = -data[4] * b[14] + data[7] * b[11];
+    res[9] = -data[5] * b[14] + data[7] * b[12];
+    res[10] = -data[6] * b[14] + data[7] * b[13];
+    res[11] = data[4] * b[15];
+    res[12] = data[5] * b[15];
+    res[13] = data[6] * b[15];
+    res[14] = data[7] * b[15];
+    return res;
+}
+[[nodiscard]] Motor Flector::operator& (const ThreeBlade& b) const
+{
+    Motor res{};
+    res[0] = data[0] * b[3] + data[1] * b[0] + data[2] * b[1] + data[3] * b[2];
+    res[1] = data[5] * b[2] - data[6] * b[1];
+    res[2] = -data[4] * b[2] + data[6] * b[0];
+    res[3] = data[4] * b[1] - data[5] * b[0];
+    res[4] = -data[4] * b[3] + data[7] * b[0];
+    res[5] = -data[5] * b[3] + data[7] * b[1];
+    res[6] = -data[6] * b[3] + data[7] * b[2];
+    return res;
+}
+[[nodiscard]] OneBlade Flector::operator& (const TwoBlade& b) const
+{
+    OneBlade res{};
+    res[0] = -data[4] * b[0] - data[5] * b[1] - data[6] * b[2];
+    res[1] = -data[5] * b[5] + data[6] * b[4] + data[7] * b[0];
+    res[2] = data[4] * b[5] - data[6] * b[3] + data[7] * b[1];
+    res[3] = -data[4] * b[4] + data[5] * b[3] + data[7] * b[2];
+    return res;
+}
+[[nodiscard]] float Flector::operator& (const OneBlade& b) const
+{
+    return -data[4] * b[1] - data[5] * b[2] - data[6] * b[3] - data[7] * b[0];
+}
+[[nodiscard]] Flector Flector::operator& (const Motor& b) const
+{
+    Flector res{};
+    res[0] = data[0] * b[7] - data[4] * b[1] - data[5] * b[2] - data[6] * b[3];
+    res[1] = data[1] * b[7] - data[5] * b[6] + data[6] * b[5] + data[7] * b[1];
+    res[2] = data[2] * b[7] + data[4] * b[6] - data[6] * b[4] + data[7] * b[2];
+    res[3] = data[3] * b[7] - data[4] * b[5] + data[5] * b[4] + data[7] * b[3];
+    res[4] = data[4] * b[7];
+    res[5] = data[5] * b[7];
+    res[6] = data[6] * b[7];
+    res[7] = data[7] * b[7];
+    return res;
+}
+[[nodiscard]] Motor Flector::operator& (const Flector& b) const
+{
+    Motor res{};
+    res[0] = data[0] * b[7] + data[1] * b[4] + data[2] * b[5] + data[3] * b[6] - data[4] * b[1] - data[5] * b[2] - data[6] * b[3] - data[7] * b[0];
+    res[1] = data[5] * b[6] - data[6] * b[5];
+    res[2] = -data[4] * b[6] + data[6] * b[4];
+    res[3] = data[4] * b[5] - data[5] * b[4];
+    res[4] = -data[4] * b[7] + data[7] * b[4];
+    res[5] = -data[5] * b[7] + data[7] * b[5];
+    res[6] = -data[6] * b[7] + data[7] * b[6];
+    return res;
+}
+
+// Sandwich product
+
+// ThreeBlade
+[[nodiscard]] ThreeBlade ThreeBlade::Sandwich(const ThreeBlade& b) const
+{
+    Motor left{};
+    left[0] = -data[3] * b[3];
+    left[1] = data[0] * b[3] - data[3] * b[0];
+    left[2] = data[1] * b[3] - data[3] * b[1];
+    left[3] = data[2] * b[3] - data[3] * b[2];
+    const ThreeBlade right{ ~(*this) };
+    ThreeBlade res{};
+    res[0] = left[0] * right[0] - left[1] * right[3];
+    res[1] = left[0] * right[1] - left[2] * right[3];
+    res[2] = left[0] * right[2] - left[3] * right[3];
+    res[3] = left[0] * right[3];
+    return res;
+}
+[[nodiscard]] TwoBlade ThreeBlade::Sandwich(const TwoBlade& b) const
+{
+    Flector left{};
+    left[0] = data[0] * b[3] + data[1] * b[4] + data[2] * b[5];
+    left[1] = -data[3] * b[3];
+    left[2] = -data[3] * b[4];
+    left[3] = -data[3] * b[5];
+    left[4] = -data[1] * b[5] + data[2] * b[4] + data[3] * b[0];
+    left[5] = data[0] * b[5] - data[2] * b[3] + data[3] * b[1];
+    left[6] = -data[0] * b[4] + data[1] * b[3] + data[3] * b[2];
+    const ThreeBlade right{ ~(*this) };
+    TwoBlade res{};
+    res[0] = -left[2] * right[2] + left[3] * right[1] + left[4] * right[3];
+    res[1] = left[1] * right[2] - left[3] * right[0] + left[5] * right[3];
+    res[2] = -left[1] * right[1] + left[2] * right[0] + left[6] * right[3];
+    res[3] = left[1] * right[3];
+    res[4] = left[2] * right[3];
+    res[5] = left[3] * right[3];
+    return res;
+}
+[[nodiscard]] OneBlade ThreeBlade::Sandwich(const OneBlade& b) const
+{
+    Motor left{};
+    left[1] = data[1] * b[3] - data[2] * b[2];
+    left[2] = -data[0] * b[3] + data[2] * b[1];
+    left[3] = data[0] * b[2] - data[1] * b[1];
+    left[4] = data[3] * b[1];
+    left[5] = data[3] * b[2];
+    left[6] = data[3] * b[3];
+    left[7] = -data[0] * b[1] - data[1] * b[2] - data[2] * b[3] - data[3] * b[0];
+    const ThreeBlade right{ ~(*this) };
+    OneBlade res{};
+    res[0] = left[4] * right[0] + left[5] * right[1] + left[6] * right[2] - left[7] * right[3];
+    res[1] = -left[4] * right[3];
+    res[2] = -left[5] * right[3];
+    res[3] = -left[6] * right[3];
+    return res;
+}
+[[nodiscard]] Motor ThreeBlade::Sandwich(const Motor& b) const
+{
+    Flector left{};
+    left[0] = data[0] * b[4] + data[1] * b[5] + data[2] * b[6] + data[3] * b[7];
+    left[1] = -data[3] * b[4];
+    left[2] = -data[3] * b[5];
+    left[3] = -data[3] * b[6];
+    left[4] = data[0] * b[0] - data[1] * b[6] + data[2] * b[5] + data[3] * b[1];
+    left[5] = data[0] * b[6] + data[1] * b[0] - data[2] * b[4] + data[3] * b[2];
+    left[6] = -data[0] * b[5] + data[1] * b[4] + data[2] * b[0] + data[3] * b[3];
+    left[7] = data[3] * b[0];
+    const ThreeBlade right{ ~(*this) };
+    Motor res{};
+    res[0] = -left[7] * right[3];
+    res[1] = -left[2] * right[2] + left[3] * right[1] + left[4] * right[3] - left[7] * right[0];
+    res[2] = left[1] * right[2] - left[3] * right[0] + left[5] * right[3] - left[7] * right[1];
+    res[3] = -left[1] * right[1] + left[2] * right[0] + left[6] * right[3] - left[7] * right[2];
+    res[4] = left[1] * right[3];
+    res[5] = left[2] * right[3];
+    res[6] = left[3] * right[3];
+    res[7] = left[0] * right[3] + left[1] * right[0] + left[2] * right[1] + left[3] * right[2];
+    return res;
+}
+[[nodiscard]] Flector ThreeBlade::Sandwich(const Flector& b) const
+{
+    Motor left{};
+    left[0] = -data[3] * b[7];
+    left[1] = data[0] * b[7] + data[1] * b[3] - data[2] * b[2] - data[3] * b[4];
+    left[2] = -data[0] * b[3] + data[1] * b[7] + data[2] * b[1] - data[3] * b[5];
+    left[3] = data[0] * b[2] - data[1] * b[1] + data[2] * b[7] - data[3] * b[6];
+    left[4] = data[3] * b[1];
+    left[5] = data[3] * b[2];
+    left[6] = data[3] * b[3];
+    left[7] = -data[0] * b[1] - data[1] * b[2] - data[2] * b[3] - data[3] * b[0];
+    const ThreeBlade right{ ~(*this) };
+    Flector res{};
+    res[0] = left[4] * right[0] + left[5] * right[1] + left[6] * right[2] - left[7] * right[3];
+    res[1] = -left[4] * right[3];
+    res[2] = -left[5] * right[3];
+    res[3] = -left[6] * right[3];
+    res[4] = left[0] * right[0] - left[1] * right[3] - left[5] * right[2] + left[6] * right[1];
+    res[5] = left[0] * right[1] - left[2] * right[3] + left[4] * right[2] - left[6] * right[0];
+    res[6] = left[0] * right[2] - left[3] * right[3] - left[4] * right[1] + left[5] * right[0];
+    res[7] = left[0] * right[3];
+    return res;
+}
+// OneBlade
+[[nodiscard]] ThreeBlade OneBlade::Sandwich(const ThreeBlade& b) const
+{
+    Motor left{};
+    left[1] = -data[2] * b[2] + data[3] * b[1];
+    left[2] = data[1] * b[2] - data[3] * b[0];
+    left[3] = -data[1] * b[1] + data[2] * b[0];
+    left[4] = data[1] * b[3];
+    left[5] = data[2] * b[3];
+    left[6] = data[3] * b[3];
+    left[7] = data[0] * b[3] + data[1] * b[0] + data[2] * b[1] + data[3] * b[2];
+    const OneBlade right{ ~(*this) };
+    ThreeBlade res{};
+    res[0] = -left[2] * right[3] + left[3] * right[2] - left[4] * right[0] - left[7] * right[1];
+    res[1] = left[1] * right[3] - left[3] * right[1] - left[5] * right[0] - left[7] * right[2];
+    res[2] = -left[1] * right[2] + left[2] * right[1] - left[6] * right[0] - left[7] * right[3];
+    res[3] = left[4] * right[1] + left[5] * right[2] + left[6] * right[3];
+    return res;
+}
+[[nodiscard]] TwoBlade OneBlade::Sandwich(const TwoBlade& b) const
+{
+    Flector left{};
+    left[0] = -data[1] * b[0] - data[2] * b[1] - data[3] * b[2];
+    left[1] = -data[2] * b[5] + data[3] * b[4];
+    left[2] = data[1] * b[5] - data[3] * b[3];
+    left[3] = -data[1] * b[4] + data[2] * b[3];
+    left[4] = -data[0] * b[3] + data[2] * b[2] - data[3] * b[1];
+    left[5] = -data[0] * b[4] - data[1] * b[2] + data[3] * b[0];
+    left[6] = -data[0] * b[5] + data[1] * b[1] - data[2] * b[0];
+    left[7] = data[1] * b[3] + data[2] * b[4] + data[3] * b[5];
+    const OneBlade right{ ~(*this) };
+    TwoBlade res{};
+    res[0] = left[0] * right[1] - left[1] * right[0] + left[5] * right[3] - left[6] * right[2];
+    res[1] = left[0] * right[2] - left[2] * right[0] - left[4] * right[3] + left[6] * right[1];
+    res[2] = left[0] * right[3] - left[3] * right[0] + left[4] * right[2] - left[5] * right[1];
+    res[3] = left[2] * right[3] - left[3] * right[2] + left[7] * right[1];
+    res[4] = -left[1] * right[3] + left[3] * right[1] + left[7] * right[2];
+    res[5] = left[1] * right[2] - left[2] * right[1] + left[7] * right[3];
+    return res;
+}
+[[nodiscard]] OneBlade OneBlade::Sandwich(const OneBlade& b) const
+{
+    Motor left{};
+    left[0] = data[1] * b[1] + data[2] * b[2] + data[3] * b[3];
+    left[1] = data[0] * b[1] - data[1] * b[0];
+    left[2] = data[0] * b[2] - data[2] * b[0];
+    left[3] = data[0] * b[3] - data[3] * b[0];
+    left[4] = data[2] * b[3] - data[3] * b[2];
+    left[5] = -data[1] * b[3] + data[3] * b[1];
+    left[6] = data[1] * b[2] - data[2] * b[1];
+    const OneBlade right{ ~(*this) };
+    OneBlade res{};
+    res[0] = left[0] * right[0] + left[1] * right[1] + left[2] * right[2] + left[3] * right[3];
+    res[1] = left[0] * right[1] - left[5] * right[3] + left[6] * right[2];
+    res[2] = left[0] * right[2] + left[4] * right[3] - left[6] * right[1];
+    res[3] = left[0] * right[3] - left[4] * right[2] + left[5] * right[1];
+    return res;
+}
+[[nodiscard]] Motor OneBlade::Sandwich(const Motor& b) const
+{
+    Flector left{};
+    left[0] = data[0] * b[0] - data[1] * b[1] - data[2] * b[2] - data[3] * b[3];
+    left[1] = data[1] * b[0] - data[2] * b[6] + data[3] * b[5];
+    left[2] = data[1] * b[6] + data[2] * b[0] - data[3] * b[4];
+    left[3] = -data[1] * b[5] + data[2] * b[4] + data[3] * b[0];
+    left[4] = -data[0] * b[4] + data[1] * b[7] + data[2] * b[3] - data[3] * b[2];
+    left[5] = -data[0] * b[5] - data[1] * b[3] + data[2] * b[7] + data[3] * b[1];
+    left[6] = -data[0] * b[6] + data[1] * b[2] - data[2] * b[1] + data[3] * b[7];
+    left[7] = data[1] * b[4] + data[2] * b[5] + data[3] * b[6];
+    const OneBlade right{ ~(*this) };
+    Motor res{};
+    res[0] = left[1] * right[1] + left[2] * right[2] + left[3] * right[3];
+    res[1] = left[0] * right[1] - left[1] * right[0] + left[5] * right[3] - left[6] * right[2];
+    res[2] = left[0] * right[2] - left[2] * right[0] - left[4] * right[3] + left[6] * right[1];
+    res[3] = left[0] * right[3] - left[3] * right[0] + left[4] * right[2] - left[5] * right[1];
+    res[4] = left[2] * right[3] - left[3] * right[2] + left[7] * right[1];
+    res[5] = -left[1] * right[3] + left[3] * right[1] + left[7] * right[2];
+    res[6] = left[1] * right[2] - left[2] * right[1] + left[7] * right[3];
+    res[7] = -left[4] * right[1] - left[5] * right[2] - left[6] * right[3] - left[7] * right[0];
+    return res;
+}
+[[nodiscard]] Flector OneBlade::Sandwich(const Flector& b) const
+{
+    Motor left{};
+    left[0] = data[1] * b[1] + data[2] * b[2] + data[3] * b[3];
+    left[1] = data[0] * b[1] - data[1] * b[0] - data[2] * b[6] + data[3] * b[5];
+    left[2] = data[0] * b[2] + data[1] * b[6] - data[2] * b[0] - data[3] * b[4];
+    left[3] = data[0] * b[3] - data[1] * b[5] + data[2] * b[4] - data[3] * b[0];
+    left[4] = data[1] * b[7] + data[2] * b[3] - data[3] * b[2];
+    left[5] = -data[1] * b[3] + data[2] * b[7] + data[3] * b[1];
+    left[6] = data[1] * b[2] - data[2] * b[1] + data[3] * b[7];
+    left[7] = data[0] * b[7] + data[1] * b[4] + data[2] * b[5] + data[3] * b[6];
+    const OneBlade right{ ~(*this) };
+    Flector res{};
+    res[0] = left[0] * right[0] + left[1] * right[1] + left[2] * right[2] + left[3] * right[3];
+    res[1] = left[0] * right[1] - left[5] * right[3] + left[6] * right[2];
+    res[2] = left[0] * right[2] + left[4] * right[3] - left[6] * right[1];
+    res[3] = left[0] * right[3] - left[4] * right[2] + left[5] * right[1];
+    res[4] = -left[2] * right[3] + left[3] * right[2] - left[4] * right[0] - left[7] * right[1];
+    res[5] = left[1] * right[3] - left[3] * right[1] - left[5] * right[0] - left[7] * right[2];
+    res[6] = -left[1] * right[2] + left[2] * right[1] - left[6] * right[0] - left[7] * right[3];
+    res[7] = left[4] * right[1] + left[5] * right[2] + left[6] * right[3];
+    return res;
+}
+// TwoBlade
+[[nodiscard]] ThreeBlade TwoBlade::Sandwich(const ThreeBlade& b) const
+{
+    Flector left{};
+    left[0] = data[3] * b[0] + data[4] * b[1] + data[5] * b[2];
+    left[1] = -data[3] * b[3];
+    left[2] = -data[4] * b[3];
+    left[3] = -data[5] * b[3];
+    left[4] = -data[0] * b[3] - data[4] * b[2] + data[5] * b[1];
+    left[5] = -data[1] * b[3] + data[3] * b[2] - data[5] * b[0];
+    left[6] = -data[2] * b[3] - data[3] * b[1] + data[4] * b[0];
+    const TwoBlade right{ ~(*this) };
+    ThreeBlade res{};
+    res[0] = -left[0] * right[3] + left[2] * right[2] - left[3] * right[1] - left[5] * right[5] + left[6] * right[4];
+    res[1] = -left[0] * right[4] - left[1] * right[2] + left[3] * right[0] + left[4] * right[5] - left[6] * right[3];
+    res[2] = -left[0] * right[5] + left[1] * right[1] - left[2] * right[0] - left[4] * right[4] + left[5] * right[3];
+    res[3] = left[1] * right[3] + left[2] * right[4] + left[3] * right[5];
+    return res;
+}
+[[nodiscard]] TwoBlade TwoBlade::Sandwich(const TwoBlade& b) const
+{
+    Motor left{};
+    left[0] = -data[3] * b[3] - data[4] * b[4] - data[5] * b[5];
+    left[1] = -data[1] * b[5] + data[2] * b[4] - data[4] * b[2] + data[5] * b[1];
+    left[2] = data[0] * b[5] - data[2] * b[3] + data[3] * b[2] - data[5] * b[0];
+    left[3] = -data[0] * b[4] + data[1] * b[3] - data[3] * b[1] + data[4] * b[0];
+    left[4] = -data[4] * b[5] + data[5] * b[4];
+    left[5] = data[3] * b[5] - data[5] * b[3];
+    left[6] = -data[3] * b[4] + data[4] * b[3];
+    left[7] = data[0] * b[3] + data[1] * b[4] + data[2] * b[5] + data[3] * b[0] + data[4] * b[1] + data[5] * b[2];
+    const TwoBlade right{ ~(*this) };
+    TwoBlade res{};
+    res[0] = left[0] * right[0] - left[2] * right[5] + left[3] * right[4] - left[5] * right[2] + left[6] * right[1] - left[7] * right[3];
+    res[1] = left[0] * right[1] + left[1] * right[5] - left[3] * right[3] + left[4] * right[2] - left[6] * right[0] - left[7] * right[4];
+    res[2] = left[0] * right[2] - left[1] * right[4] + left[2] * right[3] - left[4] * right[1] + left[5] * right[0] - left[7] * right[5];
+    res[3] = left[0] * right[3] - left[5] * right[5] + left[6] * right[4];
+    res[4] = left[0] * right[4] + left[4] * right[5] - left[6] * right[3];
+    res[5] = left[0] * right[5] - left[4] * right[4] + left[5] * right[3];
+    return res;
+}
+[[nodiscard]] OneBlade TwoBlade::Sandwich(const OneBlade& b) const
+{
+    Flector left{};
+    left[0] = data[0] * b[1] + data[1] * b[2] + data[2] * b[3];
+    left[1] = -data[4] * b[3] + data[5] * b[2];
+    left[2] = data[3] * b[3] - data[5] * b[1];
+    left[3] = -data[3] * b[2] + data[4] * b[1];
+    left[4] = -data[1] * b[3] + data[2] * b[2] - data[3] * b[0];
+    left[5] = data[0] * b[3] - data[2] * b[1] - data[4] * b[0];
+    left[6] = -data[0] * b[2] + data[1] * b[1] - data[5] * b[0];
+    left[7] = data[3] * b[1] + data[4] * b[2] + data[5] * b[3];
+    const TwoBlade right{ ~(*this) };
+    OneBlade res{};
+    res[0] = -left[1] * right[0] - left[2] * right[1] - left[3] * right[2] + left[4] * right[3] + left[5] * right[4] + left[6] * right[5];
+    res[1] = -left[2] * right[5] + left[3] * right[4] - left[7] * right[3];
+    res[2] = left[1] * right[5] - left[3] * right[3] - left[7] * right[4];
+    res[3] = -left[1] * right[4] + left[2] * right[3] - left[7] * right[5];
+    return res;
+}
+[[nodiscard]] Motor TwoBlade::Sandwich(const Motor& b) const
+{
+    Motor left{};
+    left[0] = -data[3] * b[4] - data[4] * b[5] - data[5] * b[6];
+    left[1] = data[0] * b[0] - data[1] * b[6] + data[2] * b[5] - data[3] * b[7] - data[4] * b[3] + data[5] * b[2];
+    left[2] = data[0] * b[6] + data[1] * b[0] - data[2] * b[4] + data[3] * b[3] - data[4] * b[7] - data[5] * b[1];
+    left[3] = -data[0] * b[5] + data[1] * b[4] + data[2] * b[0] - data[3] * b[2] + data[4] * b[1] - data[5] * b[7];
+    left[4] = data[3] * b[0] - data[4] * b[6] + data[5] * b[5];
+    left[5] = data[3] * b[6] + data[4] * b[0] - data[5] * b[4];
+    left[6] = -data[3] * b[5] + data[4] * b[4] + data[5] * b[0];
+    left[7] = data[0] * b[4] + data[1] * b[5] + data[2] * b[6] + data[3] * b[1] + data[4] * b[2] + data[5] * b[3];
+    const TwoBlade right{ ~(*this) };
+    Motor res{};
+    res[0] = -left[4] * right[3] - left[5] * right[4] - left[6] * right[5];
+    res[1] = left[0] * right[0] - left[2] * right[5] + left[3] * right[4] - left[5] * right[2] + left[6] * right[1] - left[7] * right[3];
+    res[2] = left[0] * right[1] + left[1] * right[5] - left[3] * right[3] + left[4] * right[2] - left[6] * right[0] - left[7] * right[4];
+    res[3] = left[0] * right[2] - left[1] * right[4] + left[2] * right[3] - left[4] * right[1] + left[5] * right[0] - left[7] * right[5];
+    res[4] = left[0] * right[3] - left[5] * right[5] + left[6] * right[4];
+    res[5] = left[0] * right[4] + left[4] * right[5] - left[6] * right[3];
+    res[6] = left[0] * right[5] - left[4] * right[4] + left[5] * right[3];
+    res[7] = left[1] * right[3] + left[2] * right[4] + left[3] * right[5] + left[4] * right[0] + left[5] * right[1] + left[6] * right[2];
+    return res;
+}
+// Motor
+[[nodiscard]] ThreeBlade Motor::Sandwich(const ThreeBlade& b) const
+{
+    Flector left{};
+    left[0] = data[4] * b[0] + data[5] * b[1] + data[6] * b[2] - data[7] * b[3];
+    left[1] = -data[4] * b[3];
+    left[2] = -data[5] * b[3];
+    left[3] = -data[6] * b[3];
+    left[4] = data[0] * b[0] - data[1] * b[3] - data[5] * b[2] + data[6] * b[1];
+    left[5] = data[0] * b[1] - data[2] * b[3] + data[4] * b[2] - data[6] * b[0];
+    left[6] = data[0] * b[2] - data[3] * b[3] - data[4] * b[1] + data[5] * b[0];
+    left[7] = data[0] * b[3];
+    const Motor right{ ~(*this) };
+    ThreeBlade res{};
+    res[0] = -left[0] * right[4] + left[1] * right[7] + left[2] * right[3] - left[3] * right[2] + left[4] * right[0] - left[5] * right[6] + left[6] * right[5] + left[7] * right[1];
+    res[1] = -left[0] * right[5] - left[1] * right[3] + left[2] * right[7] + left[3] * right[1] + left[4] * right[6] + left[5] * right[0] - left[6] * right[4] + left[7] * right[2];
+    res[2] = -left[0] * right[6] + left[1] * right[2] - left[2] * right[1] + left[3] * right[7] - left[4] * right[5] + left[5] * right[4] + left[6] * right[0] + left[7] * right[3];
+    res[3] = left[1] * right[4] + left[2] * right[5] + left[3] * right[6] + left[7] * right[0];
+    return res;
+}
+[[nodiscard]] TwoBlade Motor::Sandwich(const TwoBlade& b) const
+{
+    Motor left{};
+    left[0] = -data[4] * b[3] - data[5] * b[4] - data[6] * b[5];
+    left[1] = data[0] * b[0] - data[2] * b[5] + data[3] * b[4] - data[5] * b[2] + data[6] * b[1] - data[7] * b[3];
+    left[2] = data[0] * b[1] + data[1] * b[5] - data[3] * b[3] + data[4] * b[2] - data[6] * b[0] - data[7] * b[4];
+    left[3] = data[0] * b[2] - data[1] * b[4] + data[2] * b[3] - data[4] * b[1] + data[5] * b[0] - data[7] * b[5];
+    left[4] = data[0] * b[3] - data[5] * b[5] + data[6] * b[4];
+    left[5] = data[0] * b[4] + data[4] * b[5] - data[6] * b[3];
+    left[6] = data[0] * b[5] - data[4] * b[4] + data[5] * b[3];
+    left[7] = data[1] * b[3] + data[2] * b[4] + data[3] * b[5] + data[4] * b[0] + data[5] * b[1] + data[6] * b[2];
+    const Motor right{ ~(*this) };
+    TwoBlade res{};
+    res[0] = left[0] * right[1] + left[1] * right[0] - left[2] * right[6] + left[3] * right[5] - left[4] * right[7] - left[5] * right[3] + left[6] * right[2] - left[7] * right[4];
+    res[1] = left[0] * right[2] + left[1] * right[6] + left[2] * right[0] - left[3] * right[4] + left[4] * right[3] - left[5] * right[7] - left[6] * right[1] - left[7] * right[5];
+    res[2] = left[0] * right[3] - left[1] * right[5] + left[2] * right[4] + left[3] * right[0] - left[4] * right[2] + left[5] * right[1] - left[6] * right[7] - left[7] * right[6];
+    res[3] = left[0] * right[4] + left[4] * right[0] - left[5] * right[6] + left[6] * right[5];
+    res[4] = left[0] * right[5] + left[4] * right[6] + left[5] * right[0] - left[6] * right[4];
+    res[5] = left[0] * right[6] - left[4] * right[5] + left[5] * right[4] + left[6] * right[0];
+    return res;
+}
+[[nodiscard]] OneBlade Motor::Sandwich(const OneBlade& b) const
+{
+    Flector left{};
+    left[0] = data[0] * b[0] + data[1] * b[1] + data[2] * b[2] + data[3] * b[3];
+    left[1] = data[0] * b[1] - data[5] * b[3] + data[6] * b[2];
+    left[2] = data[0] * b[2] + data[4] * b[3] - data[6] * b[1];
+    left[3] = data[0] * b[3] - data[4] * b[2] + data[5] * b[1];
+    left[4] = -data[2] * b[3] + data[3] * b[2] - data[4] * b[0] - data[7] * b[1];
+    left[5] = data[1] * b[3] - data[3] * b[1] - data[5] * b[0] - data[7] * b[2];
+    left[6] = -data[1] * b[2] + data[2] * b[1] - data[6] * b[0] - data[7] * b[3];
+    left[7] = data[4] * b[1] + data[5] * b[2] + data[6] * b[3];
+    const Motor right{ ~(*this) };
+    OneBlade res{};
+    res[0] = left[0] * right[0] - left[1] * right[1] - left[2] * right[2] - left[3] * right[3] + left[4] * right[4] + left[5] * right[5] + left[6] * right[6] + left[7] * right[7];
+    res[1] = left[1] * right[0] - left[2] * right[6] + left[3] * right[5] - left[7] * right[4];
+    res[2] = left[1] * right[6] + left[2] * right[0] - left[3] * right[4] - left[7] * right[5];
+    res[3] = -left[1] * right[5] + left[2] * right[4] + left[3] * right[0] - left[7] * right[6];
+    return res;
+}
+[[nodiscard]] Motor Motor::Sandwich(const Motor& b) const
+{
+    Motor left{};
+    left[0] = data[0] * b[0] - data[4] * b[4] - data[5] * b[5] - data[6] * b[6];
+    left[1] = data[0] * b[1] + data[1] * b[0] - data[2] * b[6] + data[3] * b[5] - data[4] * b[7] - data[5] * b[3] + data[6] * b[2] - data[7] * b[4];
+    left[2] = data[0] * b[2] + data[1] * b[6] + data[2] * b[0] - data[3] * b[4] + data[4] * b[3] - data[5] * b[7] - data[6] * b[1] - data[7] * b[5];
+    left[3] = data[0] * b[3] - data[1] * b[5] + data[2] * b[4] + data[3] * b[0] - data[4] * b[2] + data[5] * b[1] - data[6] * b[7] - data[7] * b[6];
+    left[4] = data[0] * b[4] + data[4] * b[0] - data[5] * b[6] + data[6] * b[5];
+    left[5] = data[0] * b[5] + data[4] * b[6] + data[5] * b[0] - data[6] * b[4];
+    left[6] = data[0] * b[6] - data[4] * b[5] + data[5] * b[4] + data[6] * b[0];
+    left[7] = data[0] * b[7] + data[1] * b[4] + data[2] * b[5] + data[3] * b[6] + data[4] * b[1] + data[5] * b[2] + data[6] * b[3] + data[7] * b[0];
+    const Motor right{ ~(*this) };
+    Motor res{};
+    res[0] = left[0] * right[0] - left[4] * right[4] - left[5] * right[5] - left[6] * right[6];
+    res[1] = left[0] * right[1] + left[1] * right[0] - left[2] * right[6] + left[3] * right[5] - left[4] * right[7] - left[5] * right[3] + left[6] * right[2] - left[7] * right[4];
+    res[2] = left[0] * right[2] + left[1] * right[6] + left[2] * right[0] - left[3] * right[4] + left[4] * right[3] - left[5] * right[7] - left[6] * right[1] - left[7] * right[5];
+    res[3] = left[0] * right[3] - left[1] * right[5] + left[2] * right[4] + left[3] * right[0] - left[4] * right[2] + left[5] * right[1] - left[6] * right[7] - left[7] * right[6];
+    res[4] = left[0] * right[4] + left[4] * right[0] - left[5] * right[6] + left[6] * right[5];
+    res[5] = left[0] * right[5] + left[4] * right[6] + left[5] * right[0] - left[6] * right[4];
+    res[6] = left[0] * right[6] - left[4] * right[5] + left[5] * right[4] + left[6] * right[0];
+    res[7] = left[0] * right[7] + left[1] * right[4] + left[2] * right[5] + left[3] * right[6] + left[4] * right[1] + left[5] * right[2] + left[6] * right[3] + left[7] * right[0];
+    return res;
+}
+[[nodiscard]] Flector Motor::Sandwich(const Flector& b) const
+{
+    Flector left{};
+    left[0] = data[0] * b[0] + data[1] * b[1] + data[2] * b[2] + data[3] * b[3] + data[4] * b[4] + data[5] * b[5] + data[6] * b[6] - data[7] * b[7];
+    left[1] = data[0] * b[1] - data[4] * b[7] - data[5] * b[3] + data[6] * b[2];
+    left[2] = data[0] * b[2] + data[4] * b[3] - data[5] * b[7] - data[6] * b[1];
+    left[3] = data[0] * b[3] - data[4] * b[2] + data[5] * b[1] - data[6] * b[7];
+    left[4] = data[0] * b[4] - data[1] * b[7] - data[2] * b[3] + data[3] * b[2] - data[4] * b[0] - data[5] * b[6] + data[6] * b[5] - data[7] * b[1];
+    left[5] = data[0] * b[5] + data[1] * b[3] - data[2] * b[7] - data[3] * b[1] + data[4] * b[6] - data[5] * b[0] - data[6] * b[4] - data[7] * b[2];
+    left[6] = data[0] * b[6] - data[1] * b[2] + data[2] * b[1] - data[3] * b[7] - data[4] * b[5] + data[5] * b[4] - data[6] * b[0] - data[7] * b[3];
+    left[7] = data[0] * b[7] + data[4] * b[1] + data[5] * b[2] + data[6] * b[3];
+    const Motor right{ ~(*this) };
+    Flector res{};
+    res[0] = left[0] * right[0] - left[1] * right[1] - left[2] * right[2] - left[3] * right[3] + left[4] * right[4] + left[5] * right[5] + left[6] * right[6] + left[7] * right[7];
+    res[1] = left[1] * right[0] - left[2] * right[6] + left[3] * right[5] - left[7] * right[4];
+    res[2] = left[1] * right[6] + left[2] * right[0] - left[3] * right[4] - left[7] * right[5];
+    res[3] = -left[1] * right[5] + left[2] * right[4] + left[3] * right[0] - left[7] * right[6];
+    res[4] = -left[0] * right[4] + left[1] * right[7] + left[2] * right[3] - left[3] * right[2] + left[4] * right[0] - left[5] * right[6] + left[6] * right[5] + left[7] * right[1];
+    res[5] = -left[0] * right[5] - left[1] * right[3] + left[2] * right[7] + left[3] * right[1] + left[4] * right[6] + left[5] * right[0] - left[6] * right[4] + left[7] * right[2];
+    res[6] = -left[0] * right[6] + left[1] * right[2] - left[2] * right[1] + left[3] * right[7] - left[4] * right[5] + left[5] * right[4] + left[6] * right[0] + left[7] * right[3];
+    res[7] = left[1] * right[4] + left[2] * right[5] + left[3] * right[6] + left[7] * right[0];
+    return res;
+}
+// Flector
+[[nodiscard]] ThreeBlade Flector::Sandwich(const ThreeBlade& b) const
+{
+    Motor left{};
+    left[0] = -data[7] * b[3];
+    left[1] = -data[2] * b[2] + data[3] * b[1] + data[4] * b[3] - data[7] * b[0];
+    left[2] = data[1] * b[2] - data[3] * b[0] + data[5] * b[3] - data[7] * b[1];
+    left[3] = -data[1] * b[1] + data[2] * b[0] + data[6] * b[3] - data[7] * b[2];
+    left[4] = data[1] * b[3];
+    left[5] = data[2] * b[3];
+    left[6] = data[3] * b[3];
+    left[7] = data[0] * b[3] + data[1] * b[0] + data[2] * b[1] + data[3] * b[2];
+    const Flector right{ ~(*this) };
+    ThreeBlade res{};
+    res[0] = left[0] * right[4] - left[1] * right[7] - left[2] * right[3] + left[3] * right[2] - left[4] * right[0] - left[5] * right[6] + left[6] * right[5] - left[7] * right[1];
+    res[1] = left[0] * right[5] + left[1] * right[3] - left[2] * right[7] - left[3] * right[1] + left[4] * right[6] - left[5] * right[0] - left[6] * right[4] - left[7] * right[2];
+    res[2] = left[0] * right[6] - left[1] * right[2] + left[2] * right[1] - left[3] * right[7] - left[4] * right[5] + left[5] * right[4] - left[6] * right[0] - left[7] * right[3];
+    res[3] = left[0] * right[7] + left[4] * right[1] + left[5] * right[2] + left[6] * right[3];
+    return res;
+}
+[[nodiscard]] TwoBlade Flector::Sandwich(const TwoBlade& b) const
+{
+    Flector left{};
+    left[0] = -data[1] * b[0] - data[2] * b[1] - data[3] * b[2] + data[4] * b[3] + data[5] * b[4] + data[6] * b[5];
+    left[1] = -data[2] * b[5] + data[3] * b[4] - data[7] * b[3];
+    left[2] = data[1] * b[5] - data[3] * b[3] - data[7] * b[4];
+    left[3] = -data[1] * b[4] + data[2] * b[3] - data[7] * b[5];
+    left[4] = -data[0] * b[3] + data[2] * b[2] - data[3] * b[1] - data[5] * b[5] + data[6] * b[4] + data[7] * b[0];
+    left[5] = -data[0] * b[4] - data[1] * b[2] + data[3] * b[0] + data[4] * b[5] - data[6] * b[3] + data[7] * b[1];
+    left[6] = -data[0] * b[5] + data[1] * b[1] - data[2] * b[0] - data[4] * b[4] + data[5] * b[3] + data[7] * b[2];
+    left[7] = data[1] * b[3] + data[2] * b[4] + data[3] * b[5];
+    const Flector right{ ~(*this) };
+    TwoBlade res{};
+    res[0] = left[0] * right[1] - left[1] * right[0] - left[2] * right[6] + left[3] * right[5] + left[4] * right[7] + left[5] * right[3] - left[6] * right[2] - left[7] * right[4];
+    res[1] = left[0] * right[2] + left[1] * right[6] - left[2] * right[0] - left[3] * right[4] - left[4] * right[3] + left[5] * right[7] + left[6] * right[1] - left[7] * right[5];
+    res[2] = left[0] * right[3] - left[1] * right[5] + left[2] * right[4] - left[3] * right[0] + left[4] * right[2] - left[5] * right[1] + left[6] * right[7] - left[7] * right[6];
+    res[3] = left[1] * right[7] + left[2] * right[3] - left[3] * right[2] + left[7] * right[1];
+    res[4] = -left[1] * right[3] + left[2] * right[7] + left[3] * right[1] + left[7] * right[2];
+    res[5] = left[1] * right[2] - left[2] * right[1] + left[3] * right[7] + left[7] * right[3];
+    return res;
+}
+[[nodiscard]] OneBlade Flector::Sandwich(const OneBlade& b) const
+{
+    Motor left{};
+    left[0] = data[1] * b[1] + data[2] * b[2] + data[3] * b[3];
+    left[1] = data[0] * b[1] - data[1] * b[0] + data[5] * b[3] - data[6] * b[2];
+    left[2] = data[0] * b[2] - data[2] * b[0] - data[4] * b[3] + data[6] * b[1];
+    left[3] = data[0] * b[3] - data[3] * b[0] + data[4] * b[2] - data[5] * b[1];
+    left[4] = data[2] * b[3] - data[3] * b[2] + data[7] * b[1];
+    left[5] = -data[1] * b[3] + data[3] * b[1] + data[7] * b[2];
+    left[6] = data[1] * b[2] - data[2] * b[1] + data[7] * b[3];
+    left[7] = -data[4] * b[1] - data[5] * b[2] - data[6] * b[3] - data[7] * b[0];
+    const Flector right{ ~(*this) };
+    OneBlade res{};
+    res[0] = left[0] * right[0] + left[1] * right[1] + left[2] * right[2] + left[3] * right[3] + left[4] * right[4] + left[5] * right[5] + left[6] * right[6] - left[7] * right[7];
+    res[1] = left[0] * right[1] - left[4] * right[7] - left[5] * right[3] + left[6] * right[2];
+    res[2] = left[0] * right[2] + left[4] * right[3] - left[5] * right[7] - left[6] * right[1];
+    res[3] = left[0] * right[3] - left[4] * right[2] + left[5] * right[1] - left[6] * right[7];
+    return res;
+}
+[[nodiscard]] Motor Flector::Sandwich(const Motor& b) const
+{
+    Flector left{};
+    left[0] = data[0] * b[0] - data[1] * b[1] - data[2] * b[2] - data[3] * b[3] + data[4] * b[4] + data[5] * b[5] + data[6] * b[6] + data[7] * b[7];
+    left[1] = data[1] * b[0] - data[2] * b[6] + data[3] * b[5] - data[7] * b[4];
+    left[2] = data[1] * b[6] + data[2] * b[0] - data[3] * b[4] - data[7] * b[5];
+    left[3] = -data[1] * b[5] + data[2] * b[4] + data[3] * b[0] - data[7] * b[6];
+    left[4] = -data[0] * b[4] + data[1] * b[7] + data[2] * b[3] - data[3] * b[2] + data[4] * b[0] - data[5] * b[6] + data[6] * b[5] + data[7] * b[1];
+    left[5] = -data[0] * b[5] - data[1] * b[3] + data[2] * b[7] + data[3] * b[1] + data[4] * b[6] + data[5] * b[0] - data[6] * b[4] + data[7] * b[2];
+    left[6] = -data[0] * b[6] + data[1] * b[2] - data[2] * b[1] + data[3] * b[7] - data[4] * b[5] + data[5] * b[4] + data[6] * b[0] + data[7] * b[3];
+    left[7] = data[1] * b[4] + data[2] * b[5] + data[3] * b[6] + data[7] * b[0];
+    const Flector right{ ~(*this) };
+    Motor res{};
+    res[0] = left[1] * right[1] + left[2] * right[2] + left[3] * right[3] - left[7] * right[7];
+    res[1] = left[0] * right[1] - left[1] * right[0] - left[2] * right[6] + left[3] * right[5] + left[4] * right[7] + left[5] * right[3] - left[6] * right[2] - left[7] * right[4];
+    res[2] = left[0] * right[2] + left[1] * right[6] - left[2] * right[0] - left[3] * right[4] - left[4] * right[3] + left[5] * right[7] + left[6] * right[1] - left[7] * right[5];
+    res[3] = left[0] * right[3] - left[1] * right[5] + left[2] * right[4] - left[3] * right[0] + left[4] * right[2] - left[5] * right[1] + left[6] * right[7] - left[7] * right[6];
+    res[4] = left[1] * right[7] + left[2] * right[3] - left[3] * right[2] + left[7] * right[1];
+    res[5] = -left[1] * right[3] + left[2] * right[7] + left[3] * right[1] + left[7] * right[2];
+    res[6] = left[1] * right[2] - left[2] * right[1] + left[3] * right[7] + left[7] * right[3];
+    res[7] = left[0] * right[7] + left[1] * right[4] + left[2] * right[5] + left[3] * right[6] - left[4] * right[1] - left[5] * right[2] - left[6] * right[3] - left[7] * right[0];
+    return res;
+}
+[[nodiscard]] Flector Flector::Sandwich(const Flector& b) const
+{
+    Motor left{};
+    left[0] = data[1] * b[1] + data[2] * b[2] + data[3] * b[3] - data[7] * b[7];
+    left[1] = data[0] * b[1] - data[1] * b[0] - data[2] * b[6] + data[3] * b[5] + data[4] * b[7] + data[5] * b[3] - data[6] * b[2] - data[7] * b[4];
+    left[2] = data[0] * b[2] + data[1] * b[6] - data[2] * b[0] - data[3] * b[4] - data[4] * b[3] + data[5] * b[7] + data[6] * b[1] - data[7] * b[5];
+    left[3] = data[0] * b[3] - data[1] * b[5] + data[2] * b[4] - data[3] * b[0] + data[4] * b[2] - data[5] * b[1] + data[6] * b[7] - data[7] * b[6];
+    left[4] = data[1] * b[7] + data[2] * b[3] - data[3] * b[2] + data[7] * b[1];
+    left[5] = -data[1] * b[3] + data[2] * b[7] + data[3] * b[1] + data[7] * b[2];
+    left[6] = data[1] * b[2] - data[2] * b[1] + data[3] * b[7] + data[7] * b[3];
+    left[7] = data[0] * b[7] + data[1] * b[4] + data[2] * b[5] + data[3] * b[6] - data[4] * b[1] - data[5] * b[2] - data[6] * b[3] - data[7] * b[0];
+    const Flector right{ ~(*this) };
+    Flector res{};
+    res[0] = left[0] * right[0] + left[1] * right[1] + left[2] * right[2] + left[3] * right[3] + left[4] * right[4] + left[5] * right[5] + left[6] * right[6] - left[7] * right[7];
+    res[1] = left[0] * right[1] - left[4] * right[7] - left[5] * right[3] + left[6] * right[2];
+    res[2] = left[0] * right[2] + left[4] * right[3] - left[5] * right[7] - left[6] * right[1];
+    res[3] = left[0] * right[3] - left[4] * right[2] + left[5] * right[1] - left[6] * right[7];
+    res[4] = left[0] * right[4] - left[1] * right[7] - left[2] * right[3] + left[3] * right[2] - left[4] * right[0] - left[5] * right[6] + left[6] * right[5] - left[7] * right[1];
+    res[5] = left[0] * right[5] + left[1] * right[3] - left[2] * right[7] - left[3] * right[1] + left[4] * right[6] - left[5] * right[0] - left[6] * right[4] - left[7] * right[2];
+    res[6] = left[0] * right[6] - left[1] * right[2] + left[2] * right[1] - left[3] * right[7] - left[4] * right[5] + left[5] * right[4] - left[6] * right[0] - left[7] * right[3];
+    res[7] = left[0] * right[7] + left[4] * right[1] + left[5] * right[2] + left[6] * right[3];
+    return res;
+}
 
 // Dual operator
 [[nodiscard]] MultiVector MultiVector::operator! () const
@@ -1712,3 +2781,189 @@ return res;
         data[0]
     );
 }
+
+[[nodiscard]] Flector Flector::operator! () const
+{
+    return Flector(
+        data[7],
+        data[4],
+        data[5],
+        data[6],
+        data[1],
+        data[2],
+        data[3],
+        data[0]
+    );
+}
+
+// Batch operations
+
+MotorMatrix::MotorMatrix(const Motor& motor)
+{
+    for (int column{}; column < 4; ++column)
+    {
+        ThreeBlade basis{ 0, 0, 0, 0 };
+        basis[column] = 1;
+        const ThreeBlade transformed{ motor.Sandwich(basis) };
+        for (int row{}; row < 4; ++row)
+        {
+            columns[column * 4 + row] = transformed[row];
+        }
+    }
+}
+
+[[nodiscard]] ThreeBlade MotorMatrix::Apply(const ThreeBlade& point) const
+{
+    ThreeBlade res{};
+    for (int row{}; row < 4; ++row)
+    {
+        res[row] = columns[row] * point[0] + columns[4 + row] * point[1] + columns[8 + row] * point[2] + columns[12 + row] * point[3];
+    }
+    return res;
+}
+
+void GABatch::Transform(const Motor& motor, std::span<const ThreeBlade> points, std::span<ThreeBlade> result)
+{
+    Transform(MotorMatrix{ motor }, points, result);
+}
+
+void GABatch::Transform(const MotorMatrix& matrix, std::span<const ThreeBlade> points, std::span<ThreeBlade> result)
+{
+    const size_t count{ std::min(points.size(), result.size()) };
+#ifdef FLYFISH_SSE
+    // a point is one register, so every point is four broadcasts against the columns
+    const float* pColumns{ matrix.GetColumns().data() };
+    const __m128 column0{ _mm_load_ps(pColumns) };
+    const __m128 column1{ _mm_load_ps(pColumns + 4) };
+    const __m128 column2{ _mm_load_ps(pColumns + 8) };
+    const __m128 column3{ _mm_load_ps(pColumns + 12) };
+    for (size_t idx{}; idx < count; ++idx)
+    {
+        const __m128 point{ _mm_loadu_ps(&points[idx][0]) };
+        __m128 res{ _mm_mul_ps(column0, _mm_shuffle_ps(point, point, _MM_SHUFFLE(0, 0, 0, 0))) };
+        res = _mm_add_ps(res, _mm_mul_ps(column1, _mm_shuffle_ps(point, point, _MM_SHUFFLE(1, 1, 1, 1))));
+        res = _mm_add_ps(res, _mm_mul_ps(column2, _mm_shuffle_ps(point, point, _MM_SHUFFLE(2, 2, 2, 2))));
+        res = _mm_add_ps(res, _mm_mul_ps(column3, _mm_shuffle_ps(point, point, _MM_SHUFFLE(3, 3, 3, 3))));
+        _mm_storeu_ps(&result[idx][0], res);
+    }
+#else
+    for (size_t idx{}; idx < count; ++idx)
+    {
+        result[idx] = matrix.Apply(points[idx]);
+    }
+#endif
+}
+
+void GABatch::Join(const ThreeBlade& point, std::span<const ThreeBlade> points, std::span<TwoBlade> lines)
+{
+    const size_t count{ std::min(points.size(), lines.size()) };
+    for (size_t idx{}; idx < count; ++idx)
+    {
+        lines[idx] = point & points[idx];
+    }
+}
+
+void GABatch::Join(std::span<const ThreeBlade> first, std::span<const ThreeBlade> second, std::span<TwoBlade> lines)
+{
+    const size_t count{ std::min({ first.size(), second.size(), lines.size() }) };
+    for (size_t idx{}; idx < count; ++idx)
+    {
+        lines[idx] = first[idx] & second[idx];
+    }
+}
+
+void GABatch::Join(const TwoBlade& line, std::span<const ThreeBlade> points, std::span<OneBlade> planes)
+{
+    const size_t count{ std::min(points.size(), planes.size()) };
+    for (size_t idx{}; idx < count; ++idx)
+    {
+        planes[idx] = line & points[idx];
+    }
+}
+
+void GABatch::Meet(const OneBlade& plane, std::span<const OneBlade> planes, std::span<TwoBlade> lines)
+{
+    const size_t count{ std::min(planes.size(), lines.size()) };
+    for (size_t idx{}; idx < count; ++idx)
+    {
+        lines[idx] = plane ^ planes[idx];
+    }
+}
+
+void GABatch::Meet(const OneBlade& plane, std::span<const TwoBlade> lines, std::span<ThreeBlade> points)
+{
+    const size_t count{ std::min(lines.size(), points.size()) };
+    for (size_t idx{}; idx < count; ++idx)
+    {
+        points[idx] = plane ^ lines[idx];
+    }
+}
+
+void GABatch::Distance(const ThreeBlade& point, std::span<const ThreeBlade> points, std::span<float> distances)
+{
+    // the euclidean part of point & other is other * w - point * other.w, its length divided by both weights is the distance
+    const size_t count{ std::min(points.size(), distances.size()) };
+    size_t idx{};
+#ifdef FLYFISH_SSE
+    // four points at a time, transposed so every register holds one coordinate of four points
+    const __m128 x{ _mm_set1_ps(point[0]) };
+    const __m128 y{ _mm_set1_ps(point[1]) };
+    const __m128 z{ _mm_set1_ps(point[2]) };
+    const __m128 w{ _mm_set1_ps(point[3]) };
+    for (; idx + 4 <= count; idx += 4)
+    {
+        __m128 otherX{ _mm_loadu_ps(&points[idx][0]) };
+        __m128 otherY{ _mm_loadu_ps(&points[idx + 1][0]) };
+        __m128 otherZ{ _mm_loadu_ps(&points[idx + 2][0]) };
+        __m128 otherW{ _mm_loadu_ps(&points[idx + 3][0]) };
+        _MM_TRANSPOSE4_PS(otherX, otherY, otherZ, otherW);
+
+        const __m128 dx{ _mm_sub_ps(_mm_mul_ps(otherX, w), _mm_mul_ps(x, otherW)) };
+        const __m128 dy{ _mm_sub_ps(_mm_mul_ps(otherY, w), _mm_mul_ps(y, otherW)) };
+        const __m128 dz{ _mm_sub_ps(_mm_mul_ps(otherZ, w), _mm_mul_ps(z, otherW)) };
+        const __m128 lengthSquared{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)) };
+        const __m128 weights{ _mm_mul_ps(w, otherW) };
+        // |weights|, the sign bit cleared
+        const __m128 absWeights{ _mm_andnot_ps(_mm_set1_ps(-0.f), weights) };
+        _mm_storeu_ps(&distances[idx], _mm_div_ps(_mm_sqrt_ps(lengthSquared), absWeights));
+    }
+#endif
+    for (; idx < count; ++idx)
+    {
+        const ThreeBlade& other{ points[idx] };
+        const float dx{ other[0] * point[3] - point[0] * other[3] };
+        const float dy{ other[1] * point[3] - point[1] * other[3] };
+        const float dz{ other[2] * point[3] - point[2] * other[3] };
+        distances[idx] = std::sqrt(dx * dx + dy * dy + dz * dz) / std::fabs(point[3] * other[3]);
+    }
+}
+
+void GABatch::Distance(const OneBlade& plane, std::span<const ThreeBlade> points, std::span<float> distances)
+{
+    // point & plane is the plane equation at the point, scaled by the weights
+    const size_t count{ std::min(points.size(), distances.size()) };
+    const float planeNorm{ plane.Norm() };
+    size_t idx{};
+#ifdef FLYFISH_SSE
+    const __m128 e0{ _mm_set1_ps(plane[0]) };
+    const __m128 e1{ _mm_set1_ps(plane[1]) };
+    const __m128 e2{ _mm_set1_ps(plane[2]) };
+    const __m128 e3{ _mm_set1_ps(plane[3]) };
+    const __m128 norm{ _mm_set1_ps(planeNorm) };
+    for (; idx + 4 <= count; idx += 4)
+    {
+        __m128 x{ _mm_loadu_ps(&points[idx][0]) };
+        __m128 y{ _mm_loadu_ps(&points[idx + 1][0]) };
+        __m128 z{ _mm_loadu_ps(&points[idx + 2][0]) };
+        __m128 w{ _mm_loadu_ps(&points[idx + 3][0]) };
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        const __m128 dot{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1, x), _mm_mul_ps(e2, y)), _mm_add_ps(_mm_mul_ps(e3, z), _mm_mul_ps(e0, w))) };
+        _mm_storeu_ps(&distances[idx], _mm_div_ps(dot, _mm_mul_ps(w, norm)));
+    }
+#endif
+    for (; idx < count; ++idx)
+    {
+        distances[idx] = (points[idx] & plane) / (points[idx][3] * planeNorm);
+    }
+}
@@ -2,12 +2,19 @@
 
 #include <cmath>
 #include <array>
-#include <sstream>
+#include <algorithm>
+#include <charconv>
+#include <ostream>
+#include <span>
+#include <string>
+#include <type_traits>
+#include "FastMath.h"
 
 class OneBlade;
 class TwoBlade;
 class ThreeBlade;
 class Motor;
+class Flector;
 class GANull;
 
 constexpr float DEG_TO_RAD = 3.141592f / 180.0f;
@@ -26,73 +33,75 @@ public:
     inline float& get(size_t index) { return data[index]; }
     inline const float& get(size_t index) const { return data[index]; }
 
-    GAElement(const GAElement& other) noexcept {
-        data = other.data;
-    }
-
-    GAElement(GAElement&& other) noexcept {
-        data = std::move(other.data);
-    }
-
-    GAElement& operator=(const GAElement& other) noexcept {
-        if (this != &other) {
-            data = other.data;
-        }
-        return *this;
-    }
+    // the copy and move operations are left to the compiler, so every element type stays trivially copyable
+    // (vectors of elements are moved around with memcpy instead of per element code)
+    GAElement(const GAElement& other) noexcept = default;
+    GAElement(GAElement&& other) noexcept = default;
+    GAElement& operator=(const GAElement& other) noexcept = default;
+    GAElement& operator=(GAElement&& other) noexcept = default;
 
-    GAElement& operator=(GAElement&& other) noexcept {
-        if (this != &other) {
-            data = std::move(other.data);
-        }
-        return *this;
-    }
+    // longest text Format can write: every component as " - <number>*<name>", or a short name like "GANull"
+    static constexpr size_t MAX_TEXT_LENGTH{ DataSize * 32 + 8 };
 
     friend std::ostream& operator<<(std::ostream& os, const Derived& element) {
-        os << element.toString();
+        // formatted on the stack, so printing an element doesn't allocate
+        char buffer[MAX_TEXT_LENGTH];
+        os.write(buffer, element.Format(buffer, sizeof(buffer)));
         return os;
     }
 
     std::string toString() const {
-        std::ostringstream output;
+        char buffer[MAX_TEXT_LENGTH];
+        return std::string(buffer, static_cast<const Derived&>(*this).Format(buffer, sizeof(buffer)));
+    }
+
+    // writes the element as text into the buffer (numbers like an ostream would print them) and returns the length
+    size_t Format(char* buffer, size_t size) const {
+        char* output = buffer;
+        char* const last = buffer + size;
         const auto& names = Derived::names();
         bool first = true;
 
+        const auto append = [&](const char* text) {
+            while (*text != '\0' && output != last) *output++ = *text++;
+        };
+
         for (size_t i = 0; i < data.size(); ++i) 
         {
             if (std::fabs(data[i]) > 1e-6) 
             {
                 if (!first) 
                 {
-                    output << (data[i] > 0 ? " + " : " - ");
+                    append(data[i] > 0 ? " + " : " - ");
                 }
                 else if (data[i] < 0) 
                 {
-                    output << "-";
+                    append("-");
                 }
                 first = false;
 
                 if (std::fabs(data[i]) != 1) 
                 {
-                    output << std::fabs(data[i]);
-                    if (names[i] != "")
+                    output = std::to_chars(output, last, std::fabs(data[i]), std::chars_format::general, 6).ptr;
+                    if (names[i][0] != '\0')
                     {
-                        output << "*";
+                        append("*");
                     }
                 }
 
-                if (names[i] != "") 
+                if (names[i][0] != '\0') 
                 {                        
-                   output << names[i];
+                   append(names[i]);
                 }
                 else if (std::fabs(data[i]) == 1)
                 {
-                    output << '1';
+                    append("1");
                 }
             }
         }
 
-        return first ? "0" : output.str(); // Return "0" if all coefficients are zero.
+        if (first) append("0"); // Write "0" if all coefficients are zero.
+        return size_t(output - buffer);
     }
 
     // Iterator support
@@ -277,12 +286,12 @@ public:
 
     MultiVector& Normalize()
     {
-        return (*this) /= Norm();
+        return (*this) *= FastMath::InvSqrt(SquaredNorm());
     }
     [[nodiscard]] MultiVector Normalized() const
     {
         MultiVector d{};
-        float mult = 1 / Norm();
+        float mult = FastMath::InvSqrt(SquaredNorm());
         for (size_t idx{}; idx < 16; idx++)
         {
             d[idx] = mult * data[idx];
@@ -298,10 +307,16 @@ public:
     MultiVector& operator=(OneBlade&& b) noexcept;
     MultiVector& operator=(const Motor& b);
     MultiVector& operator=(Motor&& b) noexcept;
+    MultiVector& operator=(const Flector& b);
+    MultiVector& operator=(Flector&& b) noexcept;
 
     [[nodiscard]] float Norm() const
     {
-        return std::sqrt(data[0] * data[0] + data[2] * data[2] + data[3] * data[3] + data[4] * data[4] + data[8] * data[8] + data[9] * data[9] + data[10] * data[10] + data[14] * data[14]);
+        return std::sqrt(SquaredNorm());
+    }
+    [[nodiscard]] float SquaredNorm() const
+    {
+        return data[0] * data[0] + data[2] * data[2] + data[3] * data[3] + data[4] * data[4] + data[8] * data[8] + data[9] * data[9] + data[10] * data[10] + data[14] * data[14];
     }
     [[nodiscard]] float VNorm() const
     {
@@ -312,33 +327,35 @@ public:
     [[nodiscard]] TwoBlade Grade2() const;
     [[nodiscard]] ThreeBlade Grade3() const;
     [[nodiscard]] Motor ToMotor() const;
+    [[nodiscard]] Flector ToFlector() const;
 
     [[nodiscard]] MultiVector operator ~() const{
         float norm{ Norm() };
         float normSquared{ norm };
         return MultiVector(
-            data[0] / normSquared,
-            data[1] / normSquared,
-            data[2] / normSquared,
-            data[3] / normSquared,
-            data[4] / normSquared,
-            -data[5] / normSquared,
-            -data[6] / normSquared,
-            -data[7] / normSquared,
-            -data[8] / normSquared,
-            -data[9] / normSquared,
-            -data[10] / normSquared,
-            -data[11] / normSquared,
-            -data[12] / normSquared,
-            -data[13] / normSquared,
-            -data[14] / normSquared,
-            data[15] / normSquared
+            FastMath::Divide(data[0], normSquared),
+            FastMath::Divide(data[1], normSquared),
+            FastMath::Divide(data[2], normSquared),
+            FastMath::Divide(data[3], normSquared),
+            FastMath::Divide(data[4], normSquared),
+            FastMath::Divide(-data[5], normSquared),
+            FastMath::Divide(-data[6], normSquared),
+            FastMath::Divide(-data[7], normSquared),
+            FastMath::Divide(-data[8], normSquared),
+            FastMath::Divide(-data[9], normSquared),
+            FastMath::Divide(-data[10], normSquared),
+            FastMath::Divide(-data[11], normSquared),
+            FastMath::Divide(-data[12], normSquared),
+            FastMath::Divide(-data[13], normSquared),
+            FastMath::Divide(-data[14], normSquared),
+            FastMath::Divide(data[15], normSquared)
             );
     };
 
     [[nodiscard]] MultiVector operator* (const MultiVector& b) const;
     [[nodiscard]] MultiVector operator* (const ThreeBlade& b) const;
     [[nodiscard]] MultiVector operator* (const Motor& b) const;
+    [[nodiscard]] MultiVector operator* (const Flector& b) const;
     [[nodiscard]] MultiVector operator* (const TwoBlade& b) const;
     [[nodiscard]] MultiVector operator* (const OneBlade& b) const;
 
@@ -347,6 +364,7 @@ public:
     [[nodiscard]] MultiVector operator| (const TwoBlade& b) const;
     [[nodiscard]] MultiVector operator| (const OneBlade& b) const;
     [[nodiscard]] MultiVector operator| (const Motor& b) const;
+    [[nodiscard]] MultiVector operator| (const Flector& b) const;
 
 
     [[nodiscard]] MultiVector operator& (const MultiVector& b) const;
@@ -354,12 +372,14 @@ public:
     [[nodiscard]] MultiVector operator& (const TwoBlade& b) const;
     [[nodiscard]] MultiVector operator& (const OneBlade& b) const;
     [[nodiscard]] MultiVector operator& (const Motor& b) const;
+    [[nodiscard]] MultiVector operator& (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator^(const MultiVector& b) const;
     [[nodiscard]] MultiVector operator^(const ThreeBlade& b) const;
     [[nodiscard]] MultiVector operator^(const TwoBlade& b) const;
     [[nodiscard]] MultiVector operator^(const OneBlade& b) const;
     [[nodiscard]] MultiVector operator^(const Motor& b) const;
+    [[nodiscard]] MultiVector operator^(const Flector& b) const;
 
 
     [[nodiscard]] MultiVector operator! () const;
@@ -400,17 +420,21 @@ public:
 
     [[nodiscard]] float Norm() const
     {
-        return std::sqrt(data[1] * data[1] + data[2] * data[2] + data[3] * data[3]);
+        return std::sqrt(SquaredNorm());
+    }
+    [[nodiscard]] float SquaredNorm() const
+    {
+        return data[1] * data[1] + data[2] * data[2] + data[3] * data[3];
     }
 
     OneBlade& Normalize()
     {
-        return (*this) /= Norm();
+        return (*this) *= FastMath::InvSqrt(SquaredNorm());
     }
     [[nodiscard]] OneBlade Normalized() const
     {
         OneBlade d{};
-        float mult = 1 / Norm();
+        float mult = FastMath::InvSqrt(SquaredNorm());
         for (size_t idx{}; idx < 4; idx++)
         {
             d[idx] = mult * data[idx];
@@ -423,38 +447,49 @@ public:
         float norm{ Norm() };
         float normSquared{ norm * norm };
         return OneBlade(
-            data[0] / normSquared,
-            data[1] / normSquared,
-            data[2] / normSquared,
-            data[3] / normSquared
+            FastMath::Divide(data[0], normSquared),
+            FastMath::Divide(data[1], normSquared),
+            FastMath::Divide(data[2], normSquared),
+            FastMath::Divide(data[3], normSquared)
         );
     }
 
     [[nodiscard]] MultiVector operator* (const MultiVector& b) const;
     [[nodiscard]] Motor operator* (const ThreeBlade& b) const;
-    [[nodiscard]] MultiVector operator* (const TwoBlade& b) const;
+    [[nodiscard]] Flector operator* (const TwoBlade& b) const;
     [[nodiscard]] Motor operator* (const OneBlade& b) const;
-    [[nodiscard]] MultiVector operator* (const Motor& b) const;
+    [[nodiscard]] Flector operator* (const Motor& b) const;
+    [[nodiscard]] Motor operator* (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator& (const MultiVector& b) const;
     [[nodiscard]] float operator& (const ThreeBlade& b) const;
     [[nodiscard]] GANull operator& (const TwoBlade& b) const;
     [[nodiscard]] GANull operator& (const OneBlade& b) const;
     [[nodiscard]] OneBlade operator& (const Motor& b) const;
+    [[nodiscard]] float operator& (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator| (const MultiVector& b) const;
     [[nodiscard]] TwoBlade operator| (const ThreeBlade& b) const;
     [[nodiscard]] OneBlade operator| (const TwoBlade& b) const;
     [[nodiscard]] float operator| (const OneBlade& b) const;
-    [[nodiscard]] MultiVector operator| (const Motor& b) const;
+    [[nodiscard]] Flector operator| (const Motor& b) const;
+    [[nodiscard]] Motor operator| (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator^(const MultiVector& b) const;
-    [[nodiscard]] MultiVector operator^(const ThreeBlade& b) const;
+    [[nodiscard]] float operator^(const ThreeBlade& b) const;
     [[nodiscard]] ThreeBlade operator^ (const TwoBlade& b) const;
     [[nodiscard]] TwoBlade operator^(const OneBlade& b) const;
-    [[nodiscard]] MultiVector operator^(const Motor& b) const;
+    [[nodiscard]] Flector operator^(const Motor& b) const;
+    [[nodiscard]] Motor operator^(const Flector& b) const;
 
 
+    // (*this) * b * ~(*this), b reflected in this plane
+    [[nodiscard]] ThreeBlade Sandwich(const ThreeBlade& b) const;
+    [[nodiscard]] TwoBlade Sandwich(const TwoBlade& b) const;
+    [[nodiscard]] OneBlade Sandwich(const OneBlade& b) const;
+    [[nodiscard]] Motor Sandwich(const Motor& b) const;
+    [[nodiscard]] Flector Sandwich(const Flector& b) const;
+
     [[nodiscard]] ThreeBlade operator! () const;
 };
 
@@ -515,12 +550,12 @@ public:
 
     TwoBlade& Normalize()
     {
-        return (*this) /= Norm();
+        return (*this) *= FastMath::InvSqrt(SquaredNorm());
     }
     [[nodiscard]] TwoBlade Normalized() const
     {
         TwoBlade d{};
-        float mult = 1 / Norm();
+        float mult = FastMath::InvSqrt(SquaredNorm());
         for (size_t idx{}; idx < 6; idx++)
         {
             d[idx] = mult * data[idx];
@@ -530,7 +565,11 @@ public:
 
     [[nodiscard]] float Norm() const
     {
-        return std::sqrt(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+        return std::sqrt(SquaredNorm());
+    }
+    [[nodiscard]] float SquaredNorm() const
+    {
+        return data[3] * data[3] + data[4] * data[4] + data[5] * data[5];
     }
     [[nodiscard]] float VNorm() const
     {
@@ -540,40 +579,50 @@ public:
     [[nodiscard]] TwoBlade operator ~() const {
         float squareNorm{ Norm() * Norm() };
         return TwoBlade(
-            -data[0] / squareNorm,
-            -data[1] / squareNorm,
-            -data[2] / squareNorm,
-            -data[3] / squareNorm,
-            -data[4] / squareNorm,
-            -data[5] / squareNorm
+            FastMath::Divide(-data[0], squareNorm),
+            FastMath::Divide(-data[1], squareNorm),
+            FastMath::Divide(-data[2], squareNorm),
+            FastMath::Divide(-data[3], squareNorm),
+            FastMath::Divide(-data[4], squareNorm),
+            FastMath::Divide(-data[5], squareNorm)
         );
     };
 
     [[nodiscard]] MultiVector operator* (const MultiVector& b) const;
-    [[nodiscard]] MultiVector operator* (const ThreeBlade& b) const;
+    [[nodiscard]] Flector operator* (const ThreeBlade& b) const;
     [[nodiscard]] Motor operator* (const TwoBlade& b) const;
-    [[nodiscard]] MultiVector operator* (const OneBlade& b) const;
+    [[nodiscard]] Flector operator* (const OneBlade& b) const;
     [[nodiscard]] Motor operator* (const Motor& b) const;
+    [[nodiscard]] Flector operator* (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator| (const MultiVector& b) const;
     [[nodiscard]] OneBlade operator| (const ThreeBlade& b) const;
     [[nodiscard]] float operator| (const TwoBlade& b) const;
     [[nodiscard]] OneBlade operator| (const OneBlade& b) const;
     [[nodiscard]] Motor operator| (const Motor& b) const;
+    [[nodiscard]] OneBlade operator| (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator& (const MultiVector& b) const;
     [[nodiscard]] OneBlade operator & (const ThreeBlade& b) const;
     [[nodiscard]] float operator & (const TwoBlade& b) const;
     [[nodiscard]] GANull operator& (const OneBlade& b) const;
-    [[nodiscard]] MultiVector operator& (const Motor& b) const;
+    [[nodiscard]] Motor operator& (const Motor& b) const;
+    [[nodiscard]] OneBlade operator& (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator ^ (const MultiVector& b) const;
     [[nodiscard]] GANull operator ^ (const ThreeBlade& b) const;
-    [[nodiscard]] MultiVector operator ^ (const TwoBlade& b) const;
+    [[nodiscard]] float operator ^ (const TwoBlade& b) const;
     [[nodiscard]] ThreeBlade operator ^ (const OneBlade& b) const;
     [[nodiscard]] Motor operator ^ (const Motor& b) const;
+    [[nodiscard]] ThreeBlade operator ^ (const Flector& b) const;
     
     [[nodiscard]] TwoBlade operator! () const;
+
+    // (*this) * b * ~(*this), b turned half a turn about this line
+    [[nodiscard]] ThreeBlade Sandwich(const ThreeBlade& b) const;
+    [[nodiscard]] TwoBlade Sandwich(const TwoBlade& b) const;
+    [[nodiscard]] OneBlade Sandwich(const OneBlade& b) const;
+    [[nodiscard]] Motor Sandwich(const Motor& b) const;
 };
 
 class ThreeBlade : public GAElement<ThreeBlade, 4>
@@ -647,38 +696,49 @@ public:
         float norm{ Norm() };
         float normSquared{ norm * norm };
         return ThreeBlade(
-            -data[0] / normSquared,
-            -data[1] / normSquared,
-            -data[2] / normSquared,
-            -data[3] / normSquared
+            FastMath::Divide(-data[0], normSquared),
+            FastMath::Divide(-data[1], normSquared),
+            FastMath::Divide(-data[2], normSquared),
+            FastMath::Divide(-data[3], normSquared)
         );
     }
 
     [[nodiscard]] OneBlade operator! () const;
 
+    // (*this) * b * ~(*this), b mirrored through this point
+    [[nodiscard]] ThreeBlade Sandwich(const ThreeBlade& b) const;
+    [[nodiscard]] TwoBlade Sandwich(const TwoBlade& b) const;
+    [[nodiscard]] OneBlade Sandwich(const OneBlade& b) const;
+    [[nodiscard]] Motor Sandwich(const Motor& b) const;
+    [[nodiscard]] Flector Sandwich(const Flector& b) const;
+
     [[nodiscard]] MultiVector operator* (const MultiVector& b) const;
     [[nodiscard]] Motor operator* (const ThreeBlade& b) const;
-    [[nodiscard]] MultiVector operator* (const TwoBlade& b) const;
+    [[nodiscard]] Flector operator* (const TwoBlade& b) const;
     [[nodiscard]] Motor operator* (const OneBlade& b) const;
-    [[nodiscard]] MultiVector operator* (const Motor& b) const;
+    [[nodiscard]] Flector operator* (const Motor& b) const;
+    [[nodiscard]] Motor operator* (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator| (const MultiVector& b) const;
     [[nodiscard]] float operator| (const ThreeBlade& b) const;
     [[nodiscard]] OneBlade operator| (const TwoBlade& b) const;
     [[nodiscard]] TwoBlade operator| (const OneBlade& b) const;
-    [[nodiscard]] OneBlade operator| (const Motor& b) const;
+    [[nodiscard]] Flector operator| (const Motor& b) const;
+    [[nodiscard]] Motor operator| (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator& (const MultiVector& b) const;
     [[nodiscard]] TwoBlade operator& (const ThreeBlade& b) const;
     [[nodiscard]] OneBlade operator& (const TwoBlade& b) const;
     [[nodiscard]] float operator& (const OneBlade& b) const;
-    [[nodiscard]] MultiVector operator& (const Motor& b) const;
+    [[nodiscard]] Flector operator& (const Motor& b) const;
+    [[nodiscard]] Motor operator& (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator^(const MultiVector& b) const;
     [[nodiscard]] GANull operator^(const ThreeBlade& b) const;
     [[nodiscard]] GANull operator^(const TwoBlade& b) const;
     [[nodiscard]] float operator^(const OneBlade& b) const;
     [[nodiscard]] ThreeBlade operator^(const Motor& b) const;
+    [[nodiscard]] float operator^(const Flector& b) const;
 };
 
 class Motor : public GAElement<Motor, 8>
@@ -749,9 +809,9 @@ public:
 
     [[nodiscard]] static Motor Rotation(float angle, const TwoBlade line)
     {
-        float mult{ -sin(angle * DEG_TO_RAD / 2) / line.Norm() };
+        float mult{ -FastMath::Sin(angle * DEG_TO_RAD / 2) / line.Norm() };
         return Motor{
-            cos(angle * DEG_TO_RAD /2),
+            FastMath::Cos(angle * DEG_TO_RAD /2),
             0,
             0,
             0,
@@ -762,14 +822,22 @@ public:
         };
     }
 
+    // Exponential of a bivector, exp(B) = 1 + B + B^2/2! + ...
+    // an ideal bivector gives a translation, a euclidean one a rotation and a mixed one a screw motion
+    [[nodiscard]] static Motor Exp(const TwoBlade& bivector);
+
+    // Inverse of Exp for a normalized motor, so that Exp(motor.Log()) == motor
+    // scaling the result before taking Exp again gives a fraction (or multiple) of the motion
+    [[nodiscard]] TwoBlade Log() const;
+
     Motor& Normalize()
     {
-        return (*this) /= Norm();
+        return (*this) *= FastMath::InvSqrt(SquaredNorm());
     }
     [[nodiscard]] Motor Normalized() const
     {
         Motor d{};
-        float mult = 1 / Norm();
+        float mult = FastMath::InvSqrt(SquaredNorm());
         for (size_t idx{}; idx < 8; idx++)
         {
             d[idx] = mult * data[idx];
@@ -779,7 +847,11 @@ public:
 
     [[nodiscard]] float Norm() const
     {
-        return std::sqrt(data[0] * data[0] + data[4] * data[4] + data[5] * data[5] + data[6] * data[6]);
+        return std::sqrt(SquaredNorm());
+    }
+    [[nodiscard]] float SquaredNorm() const
+    {
+        return data[0] * data[0] + data[4] * data[4] + data[5] * data[5] + data[6] * data[6];
     }
 
     [[nodiscard]] float VNorm() const
@@ -793,40 +865,52 @@ public:
         float norm{ Norm() };
         float normSquared{ norm * norm };
         return Motor(
-            data[0] / normSquared ,
-            -data[1] / normSquared,
-            -data[2] / normSquared,
-            -data[3] / normSquared,
-            -data[4] / normSquared,
-            -data[5] / normSquared,
-            -data[6] / normSquared,
-            data[7] / normSquared
+            FastMath::Divide(data[0], normSquared),
+            FastMath::Divide(-data[1], normSquared),
+            FastMath::Divide(-data[2], normSquared),
+            FastMath::Divide(-data[3], normSquared),
+            FastMath::Divide(-data[4], normSquared),
+            FastMath::Divide(-data[5], normSquared),
+            FastMath::Divide(-data[6], normSquared),
+            FastMath::Divide(data[7], normSquared)
         );
     };
 
     [[nodiscard]] MultiVector operator* (const MultiVector& b) const;
-    [[nodiscard]] MultiVector operator* (const ThreeBlade& b) const;
+    [[nodiscard]] Flector operator* (const ThreeBlade& b) const;
     [[nodiscard]] Motor operator* (const TwoBlade& b) const;
-    [[nodiscard]] MultiVector operator* (const OneBlade& b) const;
+    [[nodiscard]] Flector operator* (const OneBlade& b) const;
     [[nodiscard]] Motor operator* (const Motor& b) const;
+    [[nodiscard]] Flector operator* (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator| (const MultiVector& b) const;
-    [[nodiscard]] MultiVector operator| (const ThreeBlade& b) const;
+    [[nodiscard]] Flector operator| (const ThreeBlade& b) const;
     [[nodiscard]] Motor operator| (const TwoBlade& b) const;
-    [[nodiscard]] MultiVector operator| (const OneBlade& b) const;
+    [[nodiscard]] Flector operator| (const OneBlade& b) const;
     [[nodiscard]] Motor operator| (const Motor& b) const;
+    [[nodiscard]] Flector operator| (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator& (const MultiVector& b) const;
-    [[nodiscard]] MultiVector operator& (const ThreeBlade& b) const;
+    [[nodiscard]] Flector operator& (const ThreeBlade& b) const;
     [[nodiscard]] Motor operator& (const TwoBlade& b) const;
     [[nodiscard]] OneBlade operator& (const OneBlade& b) const;
     [[nodiscard]] Motor operator& (const Motor& b) const;
+    [[nodiscard]] Flector operator& (const Flector& b) const;
 
     [[nodiscard]] MultiVector operator^(const MultiVector& b) const;
     [[nodiscard]] ThreeBlade operator^(const ThreeBlade& b) const;
     [[nodiscard]] Motor operator^(const TwoBlade& b) const;
-    [[nodiscard]] MultiVector operator^(const OneBlade& b) const;
-    [[nodiscard]] MultiVector operator^(const Motor& b) const;
+    [[nodiscard]] Flector operator^(const OneBlade& b) const;
+    [[nodiscard]] Motor operator^(const Motor& b) const;
+    [[nodiscard]] Flector operator^(const Flector& b) const;
+
+    // (*this) * b * ~(*this), b moved by this motor.
+    // A sandwich keeps the grades of b, so only those are computed instead of going through a full product
+    [[nodiscard]] ThreeBlade Sandwich(const ThreeBlade& b) const;
+    [[nodiscard]] TwoBlade Sandwich(const TwoBlade& b) const;
+    [[nodiscard]] OneBlade Sandwich(const OneBlade& b) const;
+    [[nodiscard]] Motor Sandwich(const Motor& b) const;
+    [[nodiscard]] Flector Sandwich(const Flector& b) const;
 
     Motor& operator += (const TwoBlade& b)
     {
@@ -850,6 +934,147 @@ public:
     [[nodiscard]] Motor operator! () const;
 };
 
+// Odd versor: a plane plus a point, what reflections and their combinations with motors (rotoreflections, glide reflections) are.
+// It is the tightest type for the odd products, like a plane times a line or a motor times a point.
+class Flector : public GAElement<Flector, 8>
+{
+public:
+    using GAElement::GAElement;
+    using GAElement::operator*;
+    using GAElement::operator/;
+
+    inline float& e0() { return get(0); }
+    inline float& e1() { return get(1); }
+    inline float& e2() { return get(2); }
+    inline float& e3() { return get(3); }
+    inline float& e032() { return get(4); }
+    inline float& e013() { return get(5); }
+    inline float& e021() { return get(6); }
+    inline float& e123() { return get(7); }
+
+    inline const float& e0() const { return get(0); }
+    inline const float& e1() const { return get(1); }
+    inline const float& e2() const { return get(2); }
+    inline const float& e3() const { return get(3); }
+    inline const float& e032() const { return get(4); }
+    inline const float& e013() const { return get(5); }
+    inline const float& e021() const { return get(6); }
+    inline const float& e123() const { return get(7); }
+
+    [[nodiscard]] Flector() : GAElement()
+    {
+    }
+
+    [[nodiscard]] Flector(float e0, float e1, float e2, float e3, float e032, float e013, float e021, float e123) : GAElement()
+    {
+        data[0] = e0;
+        data[1] = e1;
+        data[2] = e2;
+        data[3] = e3;
+        data[4] = e032;
+        data[5] = e013;
+        data[6] = e021;
+        data[7] = e123;
+    }
+
+    [[nodiscard]] Flector(const OneBlade& plane, const ThreeBlade& point) : GAElement()
+    {
+        for (size_t idx{}; idx < 4; idx++)
+        {
+            data[idx] = plane[idx];
+            data[idx + 4] = point[idx];
+        }
+    }
+
+    static constexpr std::array<const char*, 8> names() {
+        return { "e0", "e1", "e2", "e3", "e032", "e013", "e021", "e123" };
+    }
+
+    Flector& Normalize()
+    {
+        return (*this) *= FastMath::InvSqrt(SquaredNorm());
+    }
+    [[nodiscard]] Flector Normalized() const
+    {
+        Flector d{};
+        float mult = FastMath::InvSqrt(SquaredNorm());
+        for (size_t idx{}; idx < 8; idx++)
+        {
+            d[idx] = mult * data[idx];
+        }
+        return d;
+    }
+
+    [[nodiscard]] float Norm() const
+    {
+        return std::sqrt(SquaredNorm());
+    }
+    [[nodiscard]] float SquaredNorm() const
+    {
+        return data[1] * data[1] + data[2] * data[2] + data[3] * data[3] + data[7] * data[7];
+    }
+
+    [[nodiscard]] float VNorm() const
+    {
+        return std::sqrt(data[0] * data[0] + data[4] * data[4] + data[5] * data[5] + data[6] * data[6]);
+    }
+
+    [[nodiscard]] OneBlade Grade1() const;
+    [[nodiscard]] ThreeBlade Grade3() const;
+
+    [[nodiscard]] Flector operator ~() const {
+        float norm{ Norm() };
+        float normSquared{ norm * norm };
+        return Flector(
+            FastMath::Divide(data[0], normSquared),
+            FastMath::Divide(data[1], normSquared),
+            FastMath::Divide(data[2], normSquared),
+            FastMath::Divide(data[3], normSquared),
+            FastMath::Divide(-data[4], normSquared),
+            FastMath::Divide(-data[5], normSquared),
+            FastMath::Divide(-data[6], normSquared),
+            FastMath::Divide(-data[7], normSquared)
+        );
+    };
+
+    [[nodiscard]] MultiVector operator* (const MultiVector& b) const;
+    [[nodiscard]] Motor operator* (const ThreeBlade& b) const;
+    [[nodiscard]] Flector operator* (const TwoBlade& b) const;
+    [[nodiscard]] Motor operator* (const OneBlade& b) const;
+    [[nodiscard]] Flector operator* (const Motor& b) const;
+    [[nodiscard]] Motor operator* (const Flector& b) const;
+
+    [[nodiscard]] MultiVector operator| (const MultiVector& b) const;
+    [[nodiscard]] Motor operator| (const ThreeBlade& b) const;
+    [[nodiscard]] OneBlade operator| (const TwoBlade& b) const;
+    [[nodiscard]] Motor operator| (const OneBlade& b) const;
+    [[nodiscard]] Flector operator| (const Motor& b) const;
+    [[nodiscard]] Motor operator| (const Flector& b) const;
+
+    [[nodiscard]] MultiVector operator^(const MultiVector& b) const;
+    [[nodiscard]] float operator^(const ThreeBlade& b) const;
+    [[nodiscard]] ThreeBlade operator^(const TwoBlade& b) const;
+    [[nodiscard]] Motor operator^(const OneBlade& b) const;
+    [[nodiscard]] Flector operator^(const Motor& b) const;
+    [[nodiscard]] Motor operator^(const Flector& b) const;
+
+    [[nodiscard]] MultiVector operator& (const MultiVector& b) const;
+    [[nodiscard]] Motor operator& (const ThreeBlade& b) const;
+    [[nodiscard]] OneBlade operator& (const TwoBlade& b) const;
+    [[nodiscard]] float operator& (const OneBlade& b) const;
+    [[nodiscard]] Flector operator& (const Motor& b) const;
+    [[nodiscard]] Motor operator& (const Flector& b) const;
+
+    // (*this) * b * ~(*this), b transformed by this flector
+    [[nodiscard]] ThreeBlade Sandwich(const ThreeBlade& b) const;
+    [[nodiscard]] TwoBlade Sandwich(const TwoBlade& b) const;
+    [[nodiscard]] OneBlade Sandwich(const OneBlade& b) const;
+    [[nodiscard]] Motor Sandwich(const Motor& b) const;
+    [[nodiscard]] Flector Sandwich(const Flector& b) const;
+
+    [[nodiscard]] Flector operator! () const;
+};
+
 class GANull : public GAElement<GANull, 0>
 {
 public:
@@ -857,8 +1082,11 @@ public:
     using GAElement::operator*;
     using GAElement::operator/;
 
-    std::string toString() const {
-        return "GANull";
+    size_t Format(char* buffer, size_t size) const {
+        const char text[]{ "GANull" };
+        const size_t length{ std::min(size, sizeof(text) - 1) };
+        std::copy(text, text + length, buffer);
+        return length;
     }
 
     template <typename Derived>
@@ -903,3 +1131,85 @@ public:
         return GANull{};
     }
 };
+
+// Over-aligned variant of an element, so SIMD code can use aligned loads on it (and on arrays of it)
+template <typename Element, size_t Alignment>
+class alignas(Alignment) Aligned : public Element
+{
+public:
+    using Element::Element;
+
+    Aligned() noexcept : Element()
+    {
+    }
+
+    Aligned(const Element& element) noexcept : Element(element)
+    {
+    }
+};
+
+using AlignedOneBlade = Aligned<OneBlade, 16>;
+using AlignedTwoBlade = Aligned<TwoBlade, 32>;
+using AlignedThreeBlade = Aligned<ThreeBlade, 16>;
+using AlignedMotor = Aligned<Motor, 32>;
+using AlignedFlector = Aligned<Flector, 32>;
+using AlignedMultiVector = Aligned<MultiVector, 32>;
+
+template <typename Element>
+constexpr bool IsFlatElement = std::is_trivially_copyable_v<Element> && std::is_standard_layout_v<Element>;
+
+static_assert(IsFlatElement<MultiVector> && IsFlatElement<OneBlade> && IsFlatElement<TwoBlade>
+    && IsFlatElement<ThreeBlade> && IsFlatElement<Motor> && IsFlatElement<Flector>, "FlyFish elements have to be trivially copyable and standard layout");
+static_assert(IsFlatElement<AlignedOneBlade> && IsFlatElement<AlignedTwoBlade> && IsFlatElement<AlignedThreeBlade>
+    && IsFlatElement<AlignedMotor> && IsFlatElement<AlignedFlector> && IsFlatElement<AlignedMultiVector>, "aligned FlyFish elements have to be trivially copyable and standard layout");
+
+// the elements are plain float arrays, without any padding
+static_assert(sizeof(OneBlade) == 4 * sizeof(float) && sizeof(TwoBlade) == 6 * sizeof(float) && sizeof(ThreeBlade) == 4 * sizeof(float)
+    && sizeof(Motor) == 8 * sizeof(float) && sizeof(Flector) == 8 * sizeof(float) && sizeof(MultiVector) == 16 * sizeof(float), "FlyFish elements must not contain padding");
+
+static_assert(alignof(AlignedOneBlade) == 16 && alignof(AlignedThreeBlade) == 16 && alignof(AlignedTwoBlade) == 32
+    && alignof(AlignedMotor) == 32 && alignof(AlignedFlector) == 32 && alignof(AlignedMultiVector) == 32, "unexpected alignment of the aligned FlyFish elements");
+static_assert(sizeof(AlignedTwoBlade) == 32 && sizeof(AlignedMotor) == 32 && sizeof(AlignedFlector) == 32 && sizeof(AlignedMultiVector) == 64,
+    "aligned FlyFish elements are padded to their alignment");
+
+// The sandwich product motor * point * ~motor as a 4x4 matrix, which it is for every motor since it is linear in the point.
+// Building it costs four sandwich products, applying it 16 multiply-adds, so it pays off from a handful of points on.
+class MotorMatrix
+{
+public:
+    [[nodiscard]] explicit MotorMatrix(const Motor& motor);
+
+    [[nodiscard]] ThreeBlade Apply(const ThreeBlade& point) const;
+
+    // column c holds the transformed basis point c (e032, e013, e021, e123)
+    [[nodiscard]] const std::array<float, 16>& GetColumns() const { return columns; }
+
+private:
+    alignas(16) std::array<float, 16> columns{};
+};
+
+// Bulk versions of the common operations, for the same motor or element against many elements.
+// They write min(input size, output size) results and use SSE where the compiler supports it.
+namespace GABatch
+{
+    // (motor * points[i] * ~motor).Grade3()
+    void Transform(const Motor& motor, std::span<const ThreeBlade> points, std::span<ThreeBlade> result);
+    void Transform(const MotorMatrix& matrix, std::span<const ThreeBlade> points, std::span<ThreeBlade> result);
+
+    // point & points[i], the lines through the point
+    void Join(const ThreeBlade& point, std::span<const ThreeBlade> points, std::span<TwoBlade> lines);
+    // first[i] & second[i]
+    void Join(std::span<const ThreeBlade> first, std::span<const ThreeBlade> second, std::span<TwoBlade> lines);
+    // line & points[i], the planes through the line
+    void Join(const TwoBlade& line, std::span<const ThreeBlade> points, std::span<OneBlade> planes);
+
+    // plane ^ planes[i], where the planes cross the plane
+    void Meet(const OneBlade& plane, std::span<const OneBlade> planes, std::span<TwoBlade> lines);
+    // plane ^ lines[i], where the lines go through the plane
+    void Meet(const OneBlade& plane, std::span<const TwoBlade> lines, std::span<ThreeBlade> points);
+
+    // euclidean distance from the point to points[i], none of the points may be ideal
+    void Distance(const ThreeBlade& point, std::span<const ThreeBlade> points, std::span<float> distances);
+    // signed distance from the plane to points[i], positive on the side the plane faces
+    void Distance(const OneBlade& plane, std::span<const ThreeBlade> points, std::span<float> distances);
+}
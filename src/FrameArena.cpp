@@ -0,0 +1,77 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+
+FrameArena::FrameArena(size_t capacity)
+	: m_pBuffer{ std::make_unique<std::byte[]>(capacity) }
+	, m_capacity{ capacity }
+	, m_offset{ 0 }
+	, m_used{ 0 }
+	, m_peak{ 0 }
+	, m_overflowCount{ 0 }
+	, m_overflowBlocks{}
+{
+}
+
+FrameArena& FrameArena::GetThreadArena()
+{
+	thread_local FrameArena arena{};
+	return arena;
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+	// round the offset up to the alignment (always a power of two)
+	const uintptr_t base{ reinterpret_cast<uintptr_t>(m_pBuffer.get()) };
+	const uintptr_t aligned{ (base + m_offset + alignment - 1) & ~uintptr_t(alignment - 1) };
+	const size_t newOffset{ size_t(aligned - base) + size };
+
+	m_used += size;
+	m_peak = std::max(m_peak, m_used);
+
+	if (newOffset <= m_capacity)
+	{
+		m_offset = newOffset;
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	// doesn't fit anymore, keep it in a separate block that lives until the next reset
+	++m_overflowCount;
+	m_overflowBlocks.push_back(std::make_unique<std::byte[]>(size + alignment));
+	const uintptr_t block{ reinterpret_cast<uintptr_t>(m_overflowBlocks.back().get()) };
+	return reinterpret_cast<void*>((block + alignment - 1) & ~uintptr_t(alignment - 1));
+}
+
+void FrameArena::Reset()
+{
+	if (!m_overflowBlocks.empty())
+	{
+		m_overflowBlocks.clear();
+		// grow once to what this step needed (plus alignment slack), instead of overflowing every step
+		m_capacity = std::max(m_capacity * 2, m_peak + m_peak / 4);
+		m_pBuffer = std::make_unique<std::byte[]>(m_capacity);
+	}
+
+	m_offset = 0;
+	m_used = 0;
+}
+
+size_t FrameArena::GetUsed() const
+{
+	return m_used;
+}
+
+size_t FrameArena::GetCapacity() const
+{
+	return m_capacity;
+}
+
+size_t FrameArena::GetPeak() const
+{
+	return m_peak;
+}
+
+size_t FrameArena::GetOverflowCount() const
+{
+	return m_overflowCount;
+}
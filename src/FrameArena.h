@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Linear (bump) allocator for scratch data that only lives during one simulation step,
+// like contact lists and pocketed balls. Allocating only moves an offset and Reset frees everything at once.
+// Every thread has its own arena (GetThreadArena), so parallel passes never share one.
+class FrameArena final
+{
+public:
+	static constexpr size_t DEFAULT_CAPACITY{ 256 * 1024 };
+
+	explicit FrameArena(size_t capacity = DEFAULT_CAPACITY);
+	FrameArena(const FrameArena& other) = delete;
+	FrameArena& operator=(const FrameArena& other) = delete;
+
+	// the arena of the calling thread, created on first use
+	static FrameArena& GetThreadArena();
+
+	// never returns nullptr, when the buffer is full the memory comes from the heap until the next Reset
+	void* Allocate(size_t size, size_t alignment);
+	// frees everything, a buffer that overflowed grows to the peak usage so the next steps fit in it
+	void Reset();
+
+	size_t GetUsed() const;
+	size_t GetCapacity() const;
+	// most bytes in use at once since the arena was created
+	size_t GetPeak() const;
+	// allocations that didn't fit in the buffer
+	size_t GetOverflowCount() const;
+
+private:
+	std::unique_ptr<std::byte[]> m_pBuffer;
+	size_t m_capacity;
+	size_t m_offset;
+
+	// bytes handed out in the current step, including overflow
+	size_t m_used;
+	size_t m_peak;
+	size_t m_overflowCount;
+	std::vector<std::unique_ptr<std::byte[]>> m_overflowBlocks;
+};
+
+// Lets standard containers allocate from a FrameArena, deallocating does nothing.
+// The container may only be used until the arena is reset.
+template <typename T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(FrameArena& arena = FrameArena::GetThreadArena()) noexcept
+		: m_pArena{ &arena }
+	{
+	}
+	template <typename Other>
+	ArenaAllocator(const ArenaAllocator<Other>& other) noexcept
+		: m_pArena{ other.GetArena() }
+	{
+	}
+
+	T* allocate(size_t count)
+	{
+		return static_cast<T*>(m_pArena->Allocate(count * sizeof(T), alignof(T)));
+	}
+	void deallocate(T*, size_t) noexcept
+	{
+	}
+
+	FrameArena* GetArena() const noexcept
+	{
+		return m_pArena;
+	}
+
+	template <typename Other>
+	bool operator==(const ArenaAllocator<Other>& other) const noexcept
+	{
+		return m_pArena == other.GetArena();
+	}
+	template <typename Other>
+	bool operator!=(const ArenaAllocator<Other>& other) const noexcept
+	{
+		return m_pArena != other.GetArena();
+	}
+
+private:
+	FrameArena* m_pArena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
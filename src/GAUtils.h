@@ -3,19 +3,22 @@
 
 namespace GAUtils
 {
+	// The projections are (a | b) * b, of which only the outer (or inner) part is left:
+	// the other part of the product is always zero, so it isn't computed
+
 	inline ThreeBlade Project(const ThreeBlade& point, const OneBlade& referencePlane)
 	{
-		return ((point | referencePlane) * referencePlane).Grade3();
+		return (point | referencePlane) ^ referencePlane;
 	}
 
 	inline TwoBlade Project(const TwoBlade& line, const ThreeBlade& referencePoint)
 	{
-		return ((line | referencePoint) * referencePoint).Grade2();
+		return (line | referencePoint) | referencePoint;
 	}
 
 	inline ThreeBlade Project(const ThreeBlade& point, const TwoBlade& referenceLine)
 	{
-		return ((point | referenceLine) * referenceLine).Grade3();
+		return (point | referenceLine) ^ referenceLine;
 	}
 
 	inline Motor Reject(const Motor& motor, const TwoBlade& referenceLine)
@@ -3,53 +3,69 @@
 #include <SDL.h>
 #include <SDL_opengl.h>
 #include <SDL_ttf.h>
+#include <charconv>
 #include <chrono>
+#include <sstream>
+#include <thread>
 #include "Game.h"
 #include "utils.h"
 #include "structs.h"
 #include "FlyFish.h"
 
 #include "Ball.h"
-#include "BoundingBox.h"
 #include "GAUtils.h"
 #include "Cue.h"
 #include "Hole.h"
 
+#include "AllocationTracker.h"
+#include "FrameArena.h"
+#include "LatencyTracker.h"
+#include "Log.h"
+#include "ShotRecorder.h"
+#include "TelemetryRecorder.h"
+#include "TableLayout.h"
 #include "Texture.h"
 
-int Game::m_points{ 0 };
+namespace
+{
+	// zoom out when the table doesn't fit in the window, with the same margin around it as below and left of it
+	float GetViewScale(const Window& window, const Rectf& playArea)
+	{
+		return std::min({ 1.f, window.width / (2 * playArea.left + playArea.width), window.height / (2 * playArea.bottom + playArea.height) });
+	}
+
+	// "every core" leaves one to the simulation thread and one to the render thread, so the game keeps its pace while the computer thinks
+	ShotPlanner::Settings GetGamePlannerSettings(ShotPlanner::Settings settings)
+	{
+		if (settings.numThreads <= 0) settings.numThreads = std::max(1, int(std::thread::hardware_concurrency()) - 2);
+		return settings;
+	}
+}
 
-Game::Game(const Window& window)
+Game::Game(const Window& window, const TableLayout& layout)
 	: m_Window{ window }
 	, m_Viewport{ 0,0,window.width,window.height }
 	, m_pWindow{ nullptr }
 	, m_pContext{ nullptr }
 	, m_Initialized{ false }
+	, m_IsVSyncOn{ window.isVSyncOn }
 	, m_MaxElapsedSeconds{ 0.1f }
-	, m_ballsRolling{ false }
-	, m_playArea{ 50.f, 50.f, window.width - 100.f, window.height - 100.f}
-	, m_isFirstShot{ true }
-	, m_pointsOnText{ 0 }
-	, m_hasHitBall{ false }
+	, m_SimulationStepSeconds{ 1.f / 240.f }
+	, m_ViewScale{ GetViewScale(window, layout.playArea) }
+	, m_Quit{ false }
+	, m_IsStatsOverlayOn{ false }
+	, m_StatsTotals{}
+	, m_AllocationReportFrames{ 0 }
+	, m_Simulation{ layout, GetGamePlannerSettings(ShotPlanner::Settings{}) }
 {
 	InitializeGameEngine();
 
-	//m_redBalls.reserve(m_numParticles);
-
-	//for (int idx{}; idx < m_numParticles; ++idx)
-	//{
-	//	ThreeBlade pos1{ float(std::rand() % int(m_Viewport.width)) , float(std::rand() % int(m_Viewport.height)), 0.f, 1.f};
-	//	//TwoBlade moveDirection1{ float(std::rand() % 21 - 10), float(std::rand() % 21 - 10), 0, 0, 0, 0};
-	//	//Motor velocity1{ Motor::Translation(rand() % 100 + 100, moveDirection1)};
-	//	m_redBalls.emplace_back(Ball{ pos1, Motor{} });
-	//}
-	SetupRedBalls();
-	ResetWhiteBall();
-	SetupHoles();
+	CreateScoreGlyphs();
 
-	m_pBoundingBox = std::make_unique<BoundingBox>(m_playArea);
-
-	UpdateScoreText();
+	// start from the real mouse position, after this the mouse is only followed through its events
+	int mouseX{}, mouseY{};
+	SDL_GetMouseState(&mouseX, &mouseY);
+	m_Simulation.SetMouseState(Point2f{ float(mouseX) / m_ViewScale, (m_Viewport.height - mouseY) / m_ViewScale }, false);
 }
 
 Game::~Game()
@@ -57,9 +73,87 @@ Game::~Game()
 	CleanupGameEngine();
 }
 
-void Game::AddPoints(int amount)
+void Game::EnableRecording(const std::string& path)
+{
+	Table& table{ m_Simulation.GetTable() };
+	m_pRecorder = std::make_unique<ShotRecorder>(path, table);
+	if (!m_pRecorder->IsOk())
+	{
+		m_pRecorder.reset();
+		return;
+	}
+	table.SetRecorder(m_pRecorder.get());
+}
+
+void Game::EnableTelemetry(const std::string& path, size_t dataCapacity)
+{
+	m_pTelemetry = std::make_unique<TelemetryRecorder>(path, m_Simulation.GetTable(), dataCapacity);
+	if (!m_pTelemetry->IsOk()) m_pTelemetry.reset();
+	m_Simulation.SetTelemetry(m_pTelemetry.get());
+}
+
+void Game::EnableLatencyMode(const std::string& logPath)
+{
+	m_pLatencyTracker = std::make_unique<LatencyTracker>(logPath);
+	m_Simulation.SetLatencyTracker(m_pLatencyTracker.get());
+	m_LatencyTextTime = std::chrono::steady_clock::now();
+	UpdateLatencyTexts();
+}
+
+void Game::EnableStatsOverlay()
+{
+	m_IsStatsOverlayOn = true;
+	m_StatsTextTime = std::chrono::steady_clock::now();
+}
+
+void Game::EnableComputerPlayer(const ShotPlanner::Settings& settings)
+{
+	m_Simulation.EnableComputerPlayer(GetGamePlannerSettings(settings));
+}
+
+void Game::ToggleVSync()
+{
+	if (SDL_GL_SetSwapInterval(m_IsVSyncOn ? 0 : 1) < 0)
+	{
+		Log::Error("Game::ToggleVSync( ), error when calling SDL_GL_SetSwapInterval: ", SDL_GetError());
+		return;
+	}
+	m_IsVSyncOn = !m_IsVSyncOn;
+}
+
+void Game::UpdateLatencyTexts()
+{
+	const Color4f textColor{ 1, 1, 0.6f, 1 };
+	m_LatencyTexts.clear();
+	m_LatencyTexts.push_back(std::make_unique<Texture>("input latency in ms, p50/p95/p99 (V toggles vsync)", "THEBOLDFONT_FREEVERSION.ttf", 12, textColor));
+	m_LatencyTexts.push_back(std::make_unique<Texture>(m_pLatencyTracker->GetSummary(true), "THEBOLDFONT_FREEVERSION.ttf", 12, textColor));
+	m_LatencyTexts.push_back(std::make_unique<Texture>(m_pLatencyTracker->GetSummary(false), "THEBOLDFONT_FREEVERSION.ttf", 12, textColor));
+}
+
+void Game::UpdateStatsTexts(const GameSnapshot& snapshot, std::chrono::steady_clock::time_point now)
 {
-	m_points += amount;
+	// averages over the steps since the previous update
+	const GameSnapshot::SimulationTotals& totals{ snapshot.totals };
+	const double numSteps{ double(std::max(totals.numSteps - m_StatsTotals.numSteps, uint64_t{ 1 })) };
+	const double elapsedSeconds{ std::chrono::duration<double>(now - m_StatsTextTime).count() };
+	const double stepsPerSecond{ (totals.numSteps - m_StatsTotals.numSteps) / elapsedSeconds };
+
+	std::ostringstream ballsText{};
+	ballsText.precision(3);
+	ballsText << snapshot.balls.size() << " balls, " << stepsPerSecond << " steps/s (" << 100.0 * stepsPerSecond * m_SimulationStepSeconds << "% of real time)";
+	std::ostringstream stepText{};
+	stepText.precision(3);
+	stepText << "step " << 1000.0 * (totals.stepSeconds - m_StatsTotals.stepSeconds) / numSteps << " ms, "
+		<< (totals.numContacts - m_StatsTotals.numContacts) / numSteps << " contacts and "
+		<< (totals.numNewContacts - m_StatsTotals.numNewContacts) / numSteps << " collisions per step";
+
+	const Color4f textColor{ 0.6f, 1, 1, 1 };
+	m_StatsTexts.clear();
+	m_StatsTexts.push_back(std::make_unique<Texture>(ballsText.str(), "THEBOLDFONT_FREEVERSION.ttf", 12, textColor));
+	m_StatsTexts.push_back(std::make_unique<Texture>(stepText.str(), "THEBOLDFONT_FREEVERSION.ttf", 12, textColor));
+
+	m_StatsTotals = totals;
+	m_StatsTextTime = now;
 }
 
 void Game::InitializeGameEngine()
@@ -67,7 +161,7 @@ void Game::InitializeGameEngine()
 	// Initialize SDL
 	if (SDL_Init(SDL_INIT_VIDEO) < 0)
 	{
-		std::cerr << "BaseGame::Initialize( ), error when calling SDL_Init: " << SDL_GetError() << std::endl;
+		Log::Error("BaseGame::Initialize( ), error when calling SDL_Init: ", SDL_GetError());
 		return;
 	}
 
@@ -85,7 +179,7 @@ void Game::InitializeGameEngine()
 		SDL_WINDOW_OPENGL);
 	if (m_pWindow == nullptr)
 	{
-		std::cerr << "BaseGame::Initialize( ), error when calling SDL_CreateWindow: " << SDL_GetError() << std::endl;
+		Log::Error("BaseGame::Initialize( ), error when calling SDL_CreateWindow: ", SDL_GetError());
 		return;
 	}
 
@@ -93,17 +187,17 @@ void Game::InitializeGameEngine()
 	m_pContext = SDL_GL_CreateContext(m_pWindow);
 	if (m_pContext == nullptr)
 	{
-		std::cerr << "BaseGame::Initialize( ), error when calling SDL_GL_CreateContext: " << SDL_GetError() << std::endl;
+		Log::Error("BaseGame::Initialize( ), error when calling SDL_GL_CreateContext: ", SDL_GetError());
 		return;
 	}
 
 	// Set the swap interval for the current OpenGL context,
 	// synchronize it with the vertical retrace
-	if (m_Window.isVSyncOn)
+	if (m_IsVSyncOn)
 	{
 		if (SDL_GL_SetSwapInterval(1) < 0)
 		{
-			std::cerr << "BaseGame::Initialize( ), error when calling SDL_GL_SetSwapInterval: " << SDL_GetError() << std::endl;
+			Log::Error("BaseGame::Initialize( ), error when calling SDL_GL_SetSwapInterval: ", SDL_GetError());
 			return;
 		}
 	}
@@ -134,7 +228,7 @@ void Game::InitializeGameEngine()
 	// Initialize SDL_ttf
 	if (TTF_Init() == -1)
 	{
-		std::cerr << "BaseGame::Initialize( ), error when calling TTF_Init: " << TTF_GetError() << std::endl;
+		Log::Error("BaseGame::Initialize( ), error when calling TTF_Init: ", TTF_GetError());
 		return;
 	}
 
@@ -145,7 +239,7 @@ void Game::Run()
 {
 	if (!m_Initialized)
 	{
-		std::cerr << "BaseGame::Run( ), BaseGame not correctly initialized, unable to run the BaseGame\n";
+		Log::Error("BaseGame::Run( ), BaseGame not correctly initialized, unable to run the BaseGame");
 		std::cin.get();
 		return;
 	}
@@ -153,14 +247,16 @@ void Game::Run()
 	// Main loop flag
 	bool quit{ false };
 
-	// Set start time
-	std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+	// The simulation runs on its own thread, this thread only handles events and rendering
+	m_Quit = false;
+	std::thread simulationThread{ &Game::RunSimulation, this };
 
 	//The event loop
 	SDL_Event e{};
 	while (!quit)
 	{
 		// Poll next event from queue
+		AllocationTracker::ScopedPhase inputPhase{ AllocationTracker::Phase::Input };
 		while (SDL_PollEvent(&e) != 0)
 		{
 			// Handle the polled event
@@ -192,247 +288,220 @@ void Game::Run()
 
 		if (!quit)
 		{
-			// Get current time
-			std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
-
-			// Calculate elapsed time
-			float elapsedSeconds = std::chrono::duration<float>(t2 - t1).count();
-
-			// Update current time
-			t1 = t2;
+			AllocationTracker::ScopedPhase renderPhase{ AllocationTracker::Phase::Render };
 
-			// Prevent jumps in time caused by break points
-			elapsedSeconds = std::min(elapsedSeconds, m_MaxElapsedSeconds);
-
-			// Call the BaseGame object 's Update function, using time in seconds (!)
-			this->Update(elapsedSeconds);
+			// Take the latest complete snapshot, if the simulation didn't publish a new one the previous one is drawn again
+			const GameSnapshot& snapshot{ m_Simulation.TakeLatestSnapshot() };
 
 			// Draw in the back buffer
-			this->Draw();
+			this->Draw(snapshot);
+
+			if (m_pLatencyTracker) m_pLatencyTracker->MarkDrawn(snapshot.lastInputId, std::chrono::steady_clock::now());
 
 			// Update screen: swap back and front buffer
 			SDL_GL_SwapWindow(m_pWindow);
+
+			// the stats overlay is refreshed as often as the latency overlay
+			if (m_IsStatsOverlayOn)
+			{
+				const std::chrono::steady_clock::time_point now{ std::chrono::steady_clock::now() };
+				if (now - m_StatsTextTime > std::chrono::milliseconds{ 500 }) UpdateStatsTexts(snapshot, now);
+			}
+
+			if (m_pLatencyTracker)
+			{
+				// wait until the frame is really out, otherwise the swap only queues it
+				glFinish();
+				const std::chrono::steady_clock::time_point presentTime{ std::chrono::steady_clock::now() };
+				m_pLatencyTracker->MarkPresented(presentTime, m_IsVSyncOn);
+
+				// refreshing the overlay twice per second is enough to read it
+				if (presentTime - m_LatencyTextTime > std::chrono::milliseconds{ 500 })
+				{
+					UpdateLatencyTexts();
+					m_LatencyTextTime = presentTime;
+				}
+			}
+
+			if constexpr (AllocationTracker::IsEnabled()) ReportAllocations();
 		}
 	}
+
+	m_Quit = true;
+	simulationThread.join();
+
+	if (m_pRecorder) m_pRecorder->Finish(m_Simulation.GetTable());
 }
 
-void Game::CleanupGameEngine()
+void Game::RunSimulation()
 {
-	SDL_GL_DeleteContext(m_pContext);
-
-	SDL_DestroyWindow(m_pWindow);
-	m_pWindow = nullptr;
+	using clock = std::chrono::steady_clock;
+	const auto stepDuration{ std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(m_SimulationStepSeconds)) };
 
-	//Quit SDL subsystems
-	TTF_Quit();
-	SDL_Quit();
+	// Set start time
+	clock::time_point t1 = clock::now();
+	clock::time_point nextStep = t1 + stepDuration;
+	float unsimulatedSeconds{ 0.f };
 
-}
+	while (!m_Quit.load(std::memory_order_relaxed))
+	{
+		// Get current time
+		clock::time_point t2 = clock::now();
 
-void Game::SetupRedBalls()
-{
-	const Point2f startPos{ m_Viewport.width / 3, m_Viewport.height / 2 };
-	const int numColumns{ 5 };
+		// Calculate elapsed time
+		float elapsedSeconds = std::chrono::duration<float>(t2 - t1).count();
 
-	// Create red balls
-	// =========================
-	const float horizontalDst{ Ball::SIZE * std::cosf(M_PI / 6) + 0.1f};
-	const float verticalDst{ Ball::SIZE + 0.1f };
+		// Update current time
+		t1 = t2;
 
-	// pascals formula for the total amount of balls (= 1 + 2 + 3 + ... + numColumns)
-	m_redBalls.reserve((numColumns * (numColumns + 1)) / 2);
+		// Prevent jumps in time caused by break points
+		elapsedSeconds = std::min(elapsedSeconds, m_MaxElapsedSeconds);
 
-	for (int column{}; column < numColumns; ++column)
-	{
-		for (int row{}; row < column + 1; ++row)
+		// Always step with the same time step, so a recorded game replays exactly and its time steps compress well
+		unsimulatedSeconds += elapsedSeconds;
+		while (unsimulatedSeconds >= m_SimulationStepSeconds)
 		{
-			ThreeBlade pos{
-				startPos.x - (column * horizontalDst),
-				startPos.y + (row * verticalDst) - (column * Ball::SIZE / 2),
-				0.f, 1.f
-			};
-			m_redBalls.push_back(Ball{ pos, Motor{1, 0, 0, 0, 0, 0, 0, 0} });
+			m_Simulation.Step(m_SimulationStepSeconds, clock::now());
+			unsimulatedSeconds -= m_SimulationStepSeconds;
 		}
-	}
-}
 
-void Game::ResetWhiteBall()
-{
-	m_pWhiteBall = std::make_unique<Ball>(ThreeBlade{ 2 * m_Viewport.width / 3, m_Viewport.height / 2, 0.f, 1.f }, Motor{ 1, 0, 0, 0, 0, 0, 0, 0 }/*Motor::Translation(500.f, TwoBlade{ -1, 0, 0, 0, 0, 0 })*/, true);
-	
-	// make sure the cue still points to the ball
-	m_pCue = std::make_unique<Cue>(m_pWhiteBall.get());
+		// Hand the new state to the render thread
+		m_Simulation.PublishSnapshot();
+
+		// Wait for the next step, but don't try to catch up when a step took too long
+		std::this_thread::sleep_until(nextStep);
+		nextStep = std::max(nextStep + stepDuration, clock::now());
+	}
 }
 
-void Game::SetupHoles()
+void Game::CleanupGameEngine()
 {
-	m_holes.reserve(6);
+	SDL_GL_DeleteContext(m_pContext);
 
-	// left holes
-	m_holes.push_back(Hole{ ThreeBlade{ m_playArea.left + 12.f, m_playArea.bottom + 12.f, 0, 1 } });
-	m_holes.push_back(Hole{ ThreeBlade{ m_playArea.left + 12.f, m_playArea.bottom + m_playArea.height - 12.f, 0, 1 } });
+	SDL_DestroyWindow(m_pWindow);
+	m_pWindow = nullptr;
 
-	// middle holes
-	m_holes.push_back(Hole{ ThreeBlade{ m_playArea.left + m_playArea.width / 2, m_playArea.bottom + 10.f, 0, 1 } });
-	m_holes.push_back(Hole{ ThreeBlade{ m_playArea.left + m_playArea.width / 2, m_playArea.bottom + m_playArea.height - 10.f, 0, 1 } });
+	//Quit SDL subsystems
+	TTF_Quit();
+	SDL_Quit();
 
-	// right holes
-	m_holes.push_back(Hole{ ThreeBlade{ m_playArea.left + m_playArea.width - 12.f, m_playArea.bottom + 12.f, 0, 1 } });
-	m_holes.push_back(Hole{ ThreeBlade{ m_playArea.left + m_playArea.width - 12.f, m_playArea.bottom + m_playArea.height - 12.f, 0, 1 } });
 }
 
-void Game::CheckBallsRolling()
+void Game::CreateScoreGlyphs()
 {
-	m_ballsRolling = false;
-	for (const Ball& ball : m_redBalls)
-	{
-		m_ballsRolling |= ball.IsMoving();
-	}
-	m_ballsRolling |= m_pWhiteBall->IsMoving();
-
-	if (!m_ballsRolling)
+	// one texture per character a score can have, so a changing score doesn't create textures while playing
+	m_ScoreGlyphs.reserve(sizeof(SCORE_CHARACTERS) - 1);
+	for (size_t idx{}; idx < sizeof(SCORE_CHARACTERS) - 1; ++idx)
 	{
-		// executed when balls stop rolling
-		m_isFirstShot = false;
-
-		// if no red balls have been hit, lose 20 points
-		if (!m_hasHitBall)
+		m_ScoreGlyphs.emplace_back(std::string(1, SCORE_CHARACTERS[idx]), "THEBOLDFONT_FREEVERSION.ttf", 20, Color4f{ 1, 1, 1, 1 });
+		if (!m_ScoreGlyphs.back().IsCreationOk())
 		{
-			AddPoints(-10);
+			Log::Error("Game::CreateScoreGlyphs( ), unable to create the glyph for ", SCORE_CHARACTERS[idx]);
 		}
 	}
 }
 
-bool Game::FallsInHole(const Ball& ball)
+void Game::DrawScore(int points) const
 {
-	for (const Hole& hole : m_holes)
-	{
-		if (hole.FallsIn(ball)) return true;
-	}
-	return false;
-}
+	char text[16]{};
+	const char* const textEnd{ std::to_chars(std::begin(text), std::end(text), points).ptr };
 
-void Game::UpdateScoreText()
-{
-	m_pScoreText = std::make_unique<Texture>(std::to_string(m_points), "THEBOLDFONT_FREEVERSION.ttf", 20, Color4f{ 1, 1, 1, 1 });
-	if (!m_pScoreText->IsCreationOk())
+	float left{ 10.f };
+	for (const char* pCharacter{ text }; pCharacter != textEnd; ++pCharacter)
 	{
-		std::cout << "ERROR loading score text\n";
+		const Texture& glyph{ m_ScoreGlyphs[*pCharacter == '-' ? 10 : *pCharacter - '0'] };
+		if (!glyph.IsCreationOk()) return;
+
+		glyph.Draw(Point2f{ left, m_Viewport.height - 10.f - glyph.GetHeight() });
+		left += glyph.GetWidth();
 	}
-	m_pointsOnText = m_points;
 }
 
-void Game::Update(float elapsedSec)
+void Game::ReportAllocations()
 {
-	if (m_pointsOnText != m_points)
+	using clock = std::chrono::steady_clock;
+	const clock::time_point now{ clock::now() };
+	if (m_AllocationReportFrames++ == 0)
 	{
-		UpdateScoreText();
-	}
-
-	// update white ball
-	m_pWhiteBall->Update(elapsedSec, m_pBoundingBox.get(), m_isFirstShot);
-
-	if (m_redBalls.size() <= 0) return;
-
-	// update red balls
-	for (Ball& particle : m_redBalls)
-	{
-		particle.Update(elapsedSec, m_pBoundingBox.get(), m_isFirstShot);
+		m_AllocationReportTime = now;
+		AllocationTracker::Reset();
+		return;
 	}
+	if (now - m_AllocationReportTime < std::chrono::seconds{ 1 }) return;
 
-	// handle collisions between red balls
-	// only loop over every particle interaction once
-	for (int idx1{}; idx1 < m_redBalls.size() - 1; ++idx1)
-	{
-		for (int idx2{ idx1 + 1 }; idx2 < m_redBalls.size(); ++idx2)
+	// average over the frames since the previous report, through the logger so the render loop doesn't write to the console itself
+	const uint64_t numFrames{ m_AllocationReportFrames - 1 };
+	const auto getAllocations{ [numFrames](AllocationTracker::Phase phase)
 		{
-			m_redBalls[idx1].CheckParticleCollision(m_redBalls[idx2], m_isFirstShot);
-		}
-	}
-
-	// handle collisions between the white ball and red balls
-	for (int idx{}; idx < m_redBalls.size(); ++idx)
-	{
-		if (m_pWhiteBall->CheckParticleCollision(m_redBalls[idx], m_isFirstShot))
+			return double(AllocationTracker::GetCounts(phase).allocations) / numFrames;
+		} };
+	const auto getBytes{ [numFrames](AllocationTracker::Phase phase)
 		{
-			// if there was a collision between the white ball and a red ball, the player doesn't lose points for this
-			m_hasHitBall = true;
-		}
-	}
-
-	// move all red balls that fell into a hole to the back of the list
-	auto removeIt{ std::remove_if(m_redBalls.begin(), m_redBalls.end(),
-		[&](const Ball& ball) { return FallsInHole(ball); }) };
-	// count the points of all removed balls
-	for (auto it{ removeIt }; it != m_redBalls.end(); ++it)
-	{
-		AddPoints(it->GetPoints());
-	}
-	// remove the balls that fell into a hole
-	if (removeIt != m_redBalls.end())
-	{
-		m_redBalls.erase(removeIt);
-	}
+			return AllocationTracker::GetCounts(phase).bytes / numFrames;
+		} };
+	using Phase = AllocationTracker::Phase;
+	Log::Info("allocations per frame (", numFrames, " frames): other ", getAllocations(Phase::Other), " (", getBytes(Phase::Other),
+		" B) input ", getAllocations(Phase::Input), " (", getBytes(Phase::Input),
+		" B) simulation ", getAllocations(Phase::Simulation), " (", getBytes(Phase::Simulation),
+		" B) snapshot ", getAllocations(Phase::Snapshot), " (", getBytes(Phase::Snapshot),
+		" B) render ", getAllocations(Phase::Render), " (", getBytes(Phase::Render), " B)");
+
+	m_AllocationReportFrames = 0;
+}
 
-	// if the white ball fals into a hole, it gets reset back to its starting position
-	if (FallsInHole(*m_pWhiteBall.get()))
-	{
-		ResetWhiteBall();
-		AddPoints(-5);
-	}
+void Game::PushInput(InputEvent::Type type, int x, int y, bool isLeftButtonDown)
+{
+	const std::chrono::steady_clock::time_point timestamp{ std::chrono::steady_clock::now() };
+	const uint32_t id{ m_pLatencyTracker ? m_pLatencyTracker->TagInput(timestamp) : 0 };
 
-	if (m_ballsRolling)
-	{
-		// check if there are no longer balls rolling and the cue can appear again
-		CheckBallsRolling();
-	}
-	else
-	{
-		// update cue
-		int x, y;
-		Uint32 mouseState = SDL_GetMouseState(&x, &y);
-		bool isShooting{ (mouseState & SDL_BUTTON(1)) != 0 };
-		m_pCue->Update(Point2f{ float(x), float(m_Viewport.height - y) }, isShooting);
-		if (isShooting)
-		{
-			if (m_pCue->CheckHitBall())
-			{
-				// executed on hitting ball
-				m_ballsRolling = true;
-				m_hasHitBall = false;
-			}
-		}
-	}
+	// y is already flipped by the event loop, the table can be zoomed out
+	m_Simulation.PushInput(InputEvent{ type, id, Point2f{ float(x) / m_ViewScale, float(y) / m_ViewScale }, isLeftButtonDown, timestamp });
 }
 
-void Game::Draw() const
+void Game::Draw(const GameSnapshot& snapshot) const
 {
 	glClearColor(0.15f, 0.3f, 0.15f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT);
 
+	// scratch data of the previous frame on the render thread, like the ball vertices, is dropped at once
+	FrameArena::GetThreadArena().Reset();
+
+	// the table is zoomed out when it doesn't fit in the window, the overlays are always drawn in pixels
+	glPushMatrix();
+	glScalef(m_ViewScale, m_ViewScale, 1.f);
+
 	// draw game area
 	utils::SetColor(Color4f{ 0.05f, 0.2f, 0.05f, 1.f });
-	utils::FillRect(m_playArea);
+	const Table& table{ m_Simulation.GetTable() };
+	utils::FillRect(table.GetPlayArea());
+	table.GetCushions().Draw();
 
 	// draw holes
-	for (const Hole& hole : m_holes)
+	for (const Hole& hole : table.GetHoles())
 	{
 		hole.Draw();
 	}
 
 	// draw balls
-	for (const Ball& particle : m_redBalls)
-	{
-		particle.Draw();
-	}
-	m_pWhiteBall->Draw();
+	Ball::DrawBatch(snapshot.balls.data(), int(snapshot.balls.size()), m_ViewScale);
 
 	// draw cue
-	if (!m_ballsRolling) m_pCue->Draw();
+	if (snapshot.showCue) Cue::Draw(snapshot.cue);
+
+	glPopMatrix();
 
 	// draw score
-	if (m_pScoreText->IsCreationOk())
+	DrawScore(snapshot.points);
+
+	// draw latency and stats overlays
+	float textBottom{ 5.f };
+	for (const std::vector<std::unique_ptr<Texture>>* pTexts : { &m_LatencyTexts, &m_StatsTexts })
 	{
-		m_pScoreText->Draw(Point2f{ 10.f, m_Viewport.height - 10.f - m_pScoreText->GetHeight() });
+		for (auto it{ pTexts->rbegin() }; it != pTexts->rend(); ++it)
+		{
+			if (!(*it)->IsCreationOk()) continue;
+			(*it)->Draw(Point2f{ 10.f, textBottom });
+			textBottom += (*it)->GetHeight();
+		}
 	}
 }
@@ -2,19 +2,24 @@
 #include "structs.h"
 #include "SDL.h"
 #include "SDL_opengl.h"
+#include "GameSimulation.h"
+#include "GameSnapshot.h"
+#include "InputQueue.h"
+#include "ShotPlanner.h"
+#include <atomic>
 #include <memory>
 #include <vector>
 
-class Ball;
-class BoundingBox;
-class Cue;
-class Hole;
+class LatencyTracker;
+class ShotRecorder;
+class TelemetryRecorder;
 class Texture;
+struct TableLayout;
 
 class Game
 {
 public:
-	explicit Game( const Window& window );
+	Game( const Window& window, const TableLayout& layout );
 	Game( const Game& other ) = delete;
 	Game& operator=( const Game& other ) = delete;
 	Game(Game&& other) = delete;
@@ -24,14 +29,15 @@ public:
 
 	void Run( );
 
-	void Update(float elapsedSec);
-
-	void Draw() const;
+	void Draw(const GameSnapshot& snapshot) const;
 
 	// Event handling
 	void ProcessKeyDownEvent(const SDL_KeyboardEvent& e)
 	{
-
+		// vsync can be switched while measuring latency, so both modes are measured in one session
+		if (m_pLatencyTracker && e.keysym.sym == SDLK_v) ToggleVSync();
+		// the computer takes over the cue, or gives it back
+		if (e.keysym.sym == SDLK_a) m_Simulation.ToggleComputerPlayer();
 	}
 	void ProcessKeyUpEvent(const SDL_KeyboardEvent& e)
 	{
@@ -39,15 +45,15 @@ public:
 	}
 	void ProcessMouseMotionEvent(const SDL_MouseMotionEvent& e)
 	{
-		
+		PushInput(InputEvent::Type::MouseMotion, e.x, e.y, (e.state & SDL_BUTTON_LMASK) != 0);
 	}
 	void ProcessMouseDownEvent(const SDL_MouseButtonEvent& e)
 	{
-		
+		if (e.button == SDL_BUTTON_LEFT) PushInput(InputEvent::Type::MouseDown, e.x, e.y, true);
 	}
 	void ProcessMouseUpEvent(const SDL_MouseButtonEvent& e)
 	{
-		
+		if (e.button == SDL_BUTTON_LEFT) PushInput(InputEvent::Type::MouseUp, e.x, e.y, false);
 	}
 
 	const Rectf& GetViewPort() const
@@ -55,7 +61,21 @@ public:
 		return m_Viewport;
 	}
 
-	static void AddPoints(int amount);
+	// Write the initial table, every time step and every shot to a binary shot log that can be replayed headlessly
+	void EnableRecording(const std::string& path);
+
+	// Write the position, velocity and lives of every ball after every step into a memory-mapped ring file that other processes can tail
+	void EnableTelemetry(const std::string& path, size_t dataCapacity);
+
+	// Tag every input event and report the input to update, draw and present latencies in an overlay and in a log file
+	void EnableLatencyMode(const std::string& logPath);
+
+	// Show the number of balls, the time a simulation step takes and the contacts and collisions per step in an overlay
+	void EnableStatsOverlay();
+
+	// Let the computer play with the given planner settings, A switches between the computer and the mouse at any time.
+	// numThreads 0 leaves two cores to the simulation and render threads instead of taking every core
+	void EnableComputerPlayer(const ShotPlanner::Settings& settings);
 private:
 	// DATA MEMBERS
 	// The window properties
@@ -67,34 +87,57 @@ private:
 	SDL_GLContext m_pContext;
 	// Init info
 	bool m_Initialized;
+	// Current swap interval, starts at the window setting
+	bool m_IsVSyncOn;
 	// Prevent timing jumps when debugging
 	const float m_MaxElapsedSeconds;
+	// Time between two simulation steps on the simulation thread
+	const float m_SimulationStepSeconds;
+	// Pixels per unit, below 1 when the table is zoomed out to fit in the window
+	const float m_ViewScale;
+
+	// Set by the render thread to stop the simulation thread
+	std::atomic<bool> m_Quit;
+
+	// Latency instrumentation, only created in latency mode
+	std::unique_ptr<LatencyTracker> m_pLatencyTracker;
+	std::vector<std::unique_ptr<Texture>> m_LatencyTexts;
+	std::chrono::steady_clock::time_point m_LatencyTextTime;
+
+	// Simulation stats overlay, only filled when it is enabled
+	bool m_IsStatsOverlayOn;
+	std::vector<std::unique_ptr<Texture>> m_StatsTexts;
+	std::chrono::steady_clock::time_point m_StatsTextTime;
+	// totals of the snapshot the overlay was last updated from
+	GameSnapshot::SimulationTotals m_StatsTotals;
 	
 	// FUNCTIONS
 	void InitializeGameEngine( );
 	void CleanupGameEngine( );
 
-	void SetupRedBalls();
-	void ResetWhiteBall();
-	void SetupHoles();
-	void CheckBallsRolling();
-	bool FallsInHole(const Ball& ball);
-	void UpdateScoreText();
+	void RunSimulation();
+
+	void ToggleVSync();
+	// the overlays render new text textures twice per second, which allocates, so they are opt-in and the allocation check leaves them out
+	void UpdateLatencyTexts();
+	void UpdateStatsTexts(const GameSnapshot& snapshot, std::chrono::steady_clock::time_point now);
 
-	static int m_points;
-	int m_pointsOnText;
-	std::unique_ptr<Texture> m_pScoreText;
+	void PushInput(InputEvent::Type type, int x, int y, bool isLeftButtonDown);
 
-	const Rectf m_playArea;
-	std::unique_ptr<BoundingBox> m_pBoundingBox;
-	std::vector<Hole> m_holes;
+	void CreateScoreGlyphs();
+	void DrawScore(int points) const;
 
-	std::vector<Ball> m_redBalls;
-	std::unique_ptr<Ball> m_pWhiteBall;
+	// print the allocations per frame and phase once per second, only in a GEOA_TRACK_ALLOCATIONS build
+	void ReportAllocations();
+	uint64_t m_AllocationReportFrames;
+	std::chrono::steady_clock::time_point m_AllocationReportTime;
 
-	std::unique_ptr<Cue> m_pCue;
+	// characters a score is drawn with, m_ScoreGlyphs holds a texture for each of them in the same order
+	static constexpr char SCORE_CHARACTERS[]{ "0123456789-" };
+	std::vector<Texture> m_ScoreGlyphs;
 
-	bool m_ballsRolling;
-	bool m_isFirstShot;
-	bool m_hasHitBall;
+	// the balls, the rules, the cue and the computer player, stepped by the simulation thread once the game runs
+	GameSimulation m_Simulation;
+	std::unique_ptr<ShotRecorder> m_pRecorder;
+	std::unique_ptr<TelemetryRecorder> m_pTelemetry;
 };
@@ -0,0 +1,182 @@
+#include "GameSimulation.h"
+#include "AllocationTracker.h"
+#include "Ball.h"
+#include "Cue.h"
+#include "LatencyTracker.h"
+#include "Log.h"
+#include "TableLayout.h"
+#include "TelemetryRecorder.h"
+
+GameSimulation::GameSimulation(const TableLayout& layout, const ShotPlanner::Settings& plannerSettings)
+	: m_table{ layout }
+	, m_pCue{}
+	, m_pTelemetry{ nullptr }
+	, m_pLatencyTracker{ nullptr }
+	, m_LastInputId{ 0 }
+	, m_SimulationTotals{}
+	, m_mousePos{}
+	, m_isLeftButtonDown{ false }
+	, m_lastShotLatencySeconds{ 0.f }
+	, m_IsComputerPlaying{ false }
+	, m_PlannerSettings{ plannerSettings }
+	, m_PlannerRevision{ 0 }
+{
+	m_pCue = std::make_unique<Cue>(m_table.GetWhiteBallPtr());
+
+	// make sure the renderer has a complete snapshot before the first step
+	PublishSnapshot();
+}
+
+GameSimulation::~GameSimulation() = default;
+
+void GameSimulation::PushInput(const InputEvent& event)
+{
+	m_InputQueue.Push(event);
+}
+
+void GameSimulation::SetMouseState(const Point2f& mousePos, bool isLeftButtonDown)
+{
+	m_mousePos = mousePos;
+	m_isLeftButtonDown = isLeftButtonDown;
+}
+
+void GameSimulation::SetTelemetry(TelemetryRecorder* pTelemetry)
+{
+	m_pTelemetry = pTelemetry;
+}
+
+void GameSimulation::SetLatencyTracker(LatencyTracker* pLatencyTracker)
+{
+	m_pLatencyTracker = pLatencyTracker;
+}
+
+void GameSimulation::EnableComputerPlayer(const ShotPlanner::Settings& settings)
+{
+	m_PlannerSettings = settings;
+	m_IsComputerPlaying = true;
+}
+
+void GameSimulation::Step(float elapsedSec, std::chrono::steady_clock::time_point now)
+{
+	AllocationTracker::ScopedPhase simulationPhase{ AllocationTracker::Phase::Simulation };
+
+	const std::chrono::steady_clock::time_point stepStart{ std::chrono::steady_clock::now() };
+	m_table.Update(elapsedSec);
+
+	const ContactSolver::Stats& contactStats{ m_table.GetContactStats() };
+	++m_SimulationTotals.numSteps;
+	m_SimulationTotals.stepSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - stepStart).count();
+	m_SimulationTotals.numContacts += contactStats.numContacts;
+	m_SimulationTotals.numNewContacts += contactStats.numNewContacts;
+
+	if (m_pTelemetry) m_pTelemetry->RecordStep(m_table, elapsedSec);
+
+	// update cue
+	ProcessInput(now);
+	if (!m_table.AreBallsRolling())
+	{
+		m_pCue->UpdatePreview(m_table);
+		if (m_IsComputerPlaying) PlayComputerShot();
+	}
+}
+
+void GameSimulation::PublishSnapshot()
+{
+	AllocationTracker::ScopedPhase snapshotPhase{ AllocationTracker::Phase::Snapshot };
+	GameSnapshot& snapshot{ m_Snapshots.GetWriteBuffer() };
+
+	// assign instead of reallocating so the buffer keeps its capacity between steps
+	const std::vector<Ball>& redBalls{ m_table.GetRedBalls() };
+	snapshot.balls.assign(redBalls.begin(), redBalls.end());
+	snapshot.balls.push_back(m_table.GetWhiteBall());
+
+	snapshot.cue = m_pCue->GetSnapshot();
+	snapshot.showCue = !m_table.AreBallsRolling();
+	snapshot.points = m_table.GetPoints();
+	snapshot.lastInputId = m_LastInputId;
+	snapshot.totals = m_SimulationTotals;
+
+	m_Snapshots.Publish();
+}
+
+const GameSnapshot& GameSimulation::TakeLatestSnapshot()
+{
+	m_Snapshots.Update();
+	return m_Snapshots.GetReadBuffer();
+}
+
+void GameSimulation::PlayComputerShot()
+{
+	if (!m_pPlanner) m_pPlanner = std::make_unique<ShotPlanner>(m_table, m_PlannerSettings);
+
+	// the search runs on the planner's threads, the game keeps running until it is done
+	if (!m_pPlanner->IsRunning())
+	{
+		if (!m_pPlanner->Start(m_table))
+		{
+			m_IsComputerPlaying = false;
+			return;
+		}
+		m_PlannerRevision = m_table.GetRevision();
+		return;
+	}
+
+	ShotPlanner::Result result{};
+	if (!m_pPlanner->Poll(result)) return;
+
+	// the player may have shot while the computer was off
+	if (m_PlannerRevision != m_table.GetRevision()) return;
+
+	m_table.ApplyShot(result.shot);
+	Log::Info("Computer shot: ", result.expectedPoints, " points expected over ", m_PlannerSettings.depth, " shots, ",
+		result.numIterations, " searches and ", result.numSimulatedShots,  " simulated shots and ", result.numCachedShots, " from the cache");
+}
+
+void GameSimulation::ProcessInput(std::chrono::steady_clock::time_point now)
+{
+	AllocationTracker::ScopedPhase inputPhase{ AllocationTracker::Phase::Input };
+	bool hasMoved{ false };
+
+	// feed every sample that arrived since the previous step to the cue, in order and at its own time
+	InputEvent e{};
+	while (m_InputQueue.Pop(e))
+	{
+		if (e.id != 0)
+		{
+			if (m_pLatencyTracker) m_pLatencyTracker->MarkUpdated(e.id, std::chrono::steady_clock::now());
+			m_LastInputId = e.id;
+		}
+
+		m_mousePos = e.pos;
+		m_isLeftButtonDown = e.isLeftButtonDown;
+
+		// samples that arrive while the balls are rolling only update the mouse state
+		if (m_table.AreBallsRolling()) continue;
+
+		UpdateCue(e.pos, e.isLeftButtonDown, e.timestamp, now);
+		hasMoved = true;
+	}
+
+	// without new samples the mouse stood still, keep the cue attached to the (possibly moved) white ball
+	if (!hasMoved && !m_table.AreBallsRolling())
+	{
+		UpdateCue(m_mousePos, m_isLeftButtonDown, now, now);
+	}
+}
+
+void GameSimulation::UpdateCue(const Point2f& mousePos, bool isShooting, std::chrono::steady_clock::time_point timestamp, std::chrono::steady_clock::time_point now)
+{
+	m_pCue->Update(mousePos, isShooting, timestamp);
+	if (isShooting && !m_IsComputerPlaying)
+	{
+		Motor shot{};
+		if (m_pCue->CheckHitBall(shot))
+		{
+			// executed on hitting ball
+			m_table.ApplyShot(shot);
+
+			m_lastShotLatencySeconds = std::chrono::duration<float>(now - timestamp).count();
+			Log::Info("Shot latency: ", m_lastShotLatencySeconds * 1000.f, " ms");
+		}
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "structs.h"
+#include "GameSnapshot.h"
+#include "InputQueue.h"
+#include "ShotPlanner.h"
+#include "Table.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+class Cue;
+class LatencyTracker;
+class TelemetryRecorder;
+struct TableLayout;
+
+// Everything the game does on its simulation thread, without a window: the fixed time step, the input it consumes,
+// the cue or the computer player, and the snapshots it hands to the renderer.
+// Game runs it on its own thread, the allocation check runs the same steps headlessly.
+class GameSimulation final
+{
+public:
+	GameSimulation(const TableLayout& layout, const ShotPlanner::Settings& plannerSettings);
+	GameSimulation(const GameSimulation& other) = delete;
+	GameSimulation& operator=(const GameSimulation& other) = delete;
+	~GameSimulation();
+
+	// Producer side, called by the event loop with the mouse position already in table units
+	void PushInput(const InputEvent& event);
+
+	// One fixed step: the table, the telemetry, the input that arrived since the previous step and then the cue or the computer.
+	// now is the time on the input's clock, the game passes the steady clock and a scripted session its own
+	void Step(float elapsedSec, std::chrono::steady_clock::time_point now);
+
+	// Hand the state after the latest step to the renderer
+	void PublishSnapshot();
+
+	// Renderer side, the latest complete snapshot, the previous one again when nothing new was published
+	const GameSnapshot& TakeLatestSnapshot();
+
+	// Only touched by the simulation thread once the game runs, except the play area, cushions and holes which don't change
+	Table& GetTable()
+	{
+		return m_table;
+	}
+	const Table& GetTable() const
+	{
+		return m_table;
+	}
+
+	// mouse state used until the first input event arrives
+	void SetMouseState(const Point2f& mousePos, bool isLeftButtonDown);
+
+	// optional instrumentation, owned by the caller
+	void SetTelemetry(TelemetryRecorder* pTelemetry);
+	void SetLatencyTracker(LatencyTracker* pLatencyTracker);
+
+	// The computer takes over the cue with the given planner settings, can be switched from any thread
+	void EnableComputerPlayer(const ShotPlanner::Settings& settings);
+	void ToggleComputerPlayer()
+	{
+		m_IsComputerPlaying = !m_IsComputerPlaying;
+	}
+
+private:
+	Table m_table;
+	std::unique_ptr<Cue> m_pCue;
+
+	// Hands every input event from the event loop to the simulation thread
+	InputQueue m_InputQueue;
+	// Hands the latest simulation state from the simulation thread to the render thread
+	TripleBuffer<GameSnapshot> m_Snapshots;
+
+	TelemetryRecorder* m_pTelemetry;
+	LatencyTracker* m_pLatencyTracker;
+	// tag of the last input consumed by the simulation
+	uint32_t m_LastInputId;
+	// updated every step, the stats overlay shows them
+	GameSnapshot::SimulationTotals m_SimulationTotals;
+
+	// latest mouse state seen by the simulation
+	Point2f m_mousePos;
+	bool m_isLeftButtonDown;
+	// time between the input sample that hit the ball and the hit being applied
+	float m_lastShotLatencySeconds;
+
+	// computer player, switched by the event loop and played by the simulation thread,
+	// the planner is created the first time the computer plays
+	std::atomic<bool> m_IsComputerPlaying;
+	ShotPlanner::Settings m_PlannerSettings;
+	std::unique_ptr<ShotPlanner> m_pPlanner;
+	// table revision the running search started from, a search for an older table is thrown away
+	uint32_t m_PlannerRevision;
+
+	void ProcessInput(std::chrono::steady_clock::time_point now);
+	void UpdateCue(const Point2f& mousePos, bool isShooting, std::chrono::steady_clock::time_point timestamp, std::chrono::steady_clock::time_point now);
+	void PlayComputerShot();
+};
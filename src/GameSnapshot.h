@@ -0,0 +1,27 @@
+#pragma once
+#include "Ball.h"
+#include "Cue.h"
+#include <cstdint>
+#include <vector>
+
+// Immutable copy of everything the renderer needs from one simulation step
+struct GameSnapshot
+{
+	// red balls followed by the white ball
+	std::vector<Ball> balls;
+	Cue::Snapshot cue;
+	bool showCue;
+	int points;
+	// tag of the last input event whose effect is in this snapshot
+	uint32_t lastInputId;
+
+	// running totals since the simulation started, the stats overlay shows how much they grew between two snapshots
+	struct SimulationTotals
+	{
+		uint64_t numSteps;
+		double stepSeconds;
+		uint64_t numContacts;
+		uint64_t numNewContacts;
+	};
+	SimulationTotals totals;
+};
@@ -13,6 +13,11 @@ void Hole::Draw() const
 	utils::FillEllipse(m_pos[0], m_pos[1], SIZE / 2, SIZE / 2);
 }
 
+const ThreeBlade& Hole::GetPos() const
+{
+	return m_pos;
+}
+
 bool Hole::FallsIn(const Ball& ball) const
 {
 	// a ball falls in if it touches the center of the hole
@@ -10,6 +10,7 @@ public:
 
 	void Draw() const;
 	bool FallsIn(const Ball& ball) const;
+	const ThreeBlade& GetPos() const;
 private:
 	static constexpr float SIZE{ 30.f };
 
@@ -0,0 +1,38 @@
+#include "InputQueue.h"
+
+InputQueue::InputQueue()
+	: m_events{}
+	, m_head{ 0 }
+	, m_tail{ 0 }
+	, m_droppedCount{ 0 }
+{
+}
+
+bool InputQueue::Push(const InputEvent& event)
+{
+	const size_t tail{ m_tail.load(std::memory_order_relaxed) };
+	if (tail - m_head.load(std::memory_order_acquire) >= CAPACITY)
+	{
+		m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	m_events[tail & (CAPACITY - 1)] = event;
+	m_tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+bool InputQueue::Pop(InputEvent& event)
+{
+	const size_t head{ m_head.load(std::memory_order_relaxed) };
+	if (head == m_tail.load(std::memory_order_acquire)) return false;
+
+	event = m_events[head & (CAPACITY - 1)];
+	m_head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+uint64_t InputQueue::GetDroppedCount() const
+{
+	return m_droppedCount.load(std::memory_order_relaxed);
+}
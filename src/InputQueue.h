@@ -0,0 +1,53 @@
+#pragma once
+#include "structs.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+struct InputEvent
+{
+	enum class Type : uint8_t
+	{
+		MouseMotion,
+		MouseDown,
+		MouseUp
+	};
+
+	Type type;
+	// tag used by the latency instrumentation, 0 when it is off
+	uint32_t id;
+	// mouse position with y pointing up, like the rest of the game
+	Point2f pos;
+	bool isLeftButtonDown;
+	// moment the event was taken from the SDL queue
+	std::chrono::steady_clock::time_point timestamp;
+};
+
+// Lock-free single producer / single consumer queue that carries input events
+// from the event loop to the simulation thread without losing samples in between steps
+class InputQueue final
+{
+public:
+	InputQueue();
+	InputQueue(const InputQueue& other) = delete;
+	InputQueue& operator=(const InputQueue& other) = delete;
+
+	// Producer side, returns false (and drops the event) when the queue is full
+	bool Push(const InputEvent& event);
+	// Consumer side, returns false when there is nothing left to read
+	bool Pop(InputEvent& event);
+
+	uint64_t GetDroppedCount() const;
+
+private:
+	static constexpr size_t CAPACITY{ 512 };
+	static_assert((CAPACITY & (CAPACITY - 1)) == 0, "capacity has to be a power of two");
+
+	std::array<InputEvent, CAPACITY> m_events;
+
+	// read and written by different threads, so keep them on separate cache lines
+	alignas(64) std::atomic<size_t> m_head;
+	alignas(64) std::atomic<size_t> m_tail;
+	std::atomic<uint64_t> m_droppedCount;
+};
@@ -0,0 +1,155 @@
+#include "LatencyTracker.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include "Log.h"
+
+LatencyTracker::LatencyTracker(const std::string& logPath)
+	: m_records{}
+	, m_nextId{ 1 }
+	, m_firstUndrawnId{ 1 }
+	, m_firstUnpresentedId{ 1 }
+	, m_buckets{}
+	, m_log{ logPath }
+{
+	for (Bucket& bucket : m_buckets)
+	{
+		for (std::vector<float>& samples : bucket.samples)
+		{
+			samples.reserve(MAX_SAMPLES);
+		}
+		bucket.nextSample = 0;
+	}
+
+	if (!m_log)
+	{
+		Log::Error("LatencyTracker::LatencyTracker( ), unable to open ", logPath);
+		return;
+	}
+	m_log << "id,vsync,input_to_update_ms,input_to_draw_ms,input_to_present_ms\n";
+}
+
+LatencyTracker::~LatencyTracker()
+{
+	if (!m_log) return;
+
+	m_log << "\n# summary in milliseconds (p50/p95/p99)\n";
+	m_log << "# " << GetSummary(true) << '\n';
+	m_log << "# " << GetSummary(false) << '\n';
+}
+
+uint32_t LatencyTracker::TagInput(clock::time_point timestamp)
+{
+	const uint32_t id{ m_nextId++ };
+	Record& record{ m_records[id % NUM_RECORDS] };
+	record.update.store(0, std::memory_order_relaxed);
+	record.draw.store(0, std::memory_order_relaxed);
+	record.input.store(ToTicks(timestamp), std::memory_order_relaxed);
+	return id;
+}
+
+void LatencyTracker::MarkUpdated(uint32_t id, clock::time_point timestamp)
+{
+	m_records[id % NUM_RECORDS].update.store(ToTicks(timestamp), std::memory_order_relaxed);
+}
+
+void LatencyTracker::MarkDrawn(uint32_t lastId, clock::time_point timestamp)
+{
+	if (lastId < m_firstUndrawnId) return;
+
+	// when the renderer fell behind, the oldest records are already reused
+	const uint32_t firstId{ std::max(m_firstUndrawnId, lastId >= NUM_RECORDS ? lastId - uint32_t(NUM_RECORDS) + 1 : 1u) };
+	const int64_t ticks{ ToTicks(timestamp) };
+	for (uint32_t id{ firstId }; id <= lastId; ++id)
+	{
+		m_records[id % NUM_RECORDS].draw.store(ticks, std::memory_order_relaxed);
+	}
+	m_firstUnpresentedId = std::max(m_firstUnpresentedId, firstId);
+	m_firstUndrawnId = lastId + 1;
+}
+
+void LatencyTracker::MarkPresented(clock::time_point timestamp, bool isVSyncOn)
+{
+	const int64_t presentTicks{ ToTicks(timestamp) };
+	for (uint32_t id{ m_firstUnpresentedId }; id < m_firstUndrawnId; ++id)
+	{
+		const Record& record{ m_records[id % NUM_RECORDS] };
+		const int64_t inputTicks{ record.input.load(std::memory_order_relaxed) };
+		const int64_t updateTicks{ record.update.load(std::memory_order_relaxed) };
+		const int64_t drawTicks{ record.draw.load(std::memory_order_relaxed) };
+
+		// the event was never consumed by the simulation (e.g. it was dropped)
+		if (updateTicks == 0 || drawTicks == 0) continue;
+
+		const float toUpdate{ TicksToMilliseconds(updateTicks - inputTicks) };
+		const float toDraw{ TicksToMilliseconds(drawTicks - inputTicks) };
+		const float toPresent{ TicksToMilliseconds(presentTicks - inputTicks) };
+
+		AddSample(isVSyncOn, Stage::Update, toUpdate);
+		AddSample(isVSyncOn, Stage::Draw, toDraw);
+		AddSample(isVSyncOn, Stage::Present, toPresent);
+
+		if (m_log)
+		{
+			m_log << id << ',' << (isVSyncOn ? 1 : 0) << ',' << toUpdate << ',' << toDraw << ',' << toPresent << '\n';
+		}
+	}
+	m_firstUnpresentedId = m_firstUndrawnId;
+}
+
+LatencyTracker::Percentiles LatencyTracker::GetPercentiles(bool isVSyncOn, Stage stage) const
+{
+	std::vector<float> sorted{ m_buckets[isVSyncOn ? 1 : 0].samples[int(stage)] };
+	if (sorted.empty()) return Percentiles{ 0.f, 0.f, 0.f, 0 };
+
+	std::sort(sorted.begin(), sorted.end());
+	const auto percentile = [&sorted](float fraction)
+	{
+		return sorted[std::min(sorted.size() - 1, size_t(fraction * sorted.size()))];
+	};
+	return Percentiles{ percentile(0.50f), percentile(0.95f), percentile(0.99f), sorted.size() };
+}
+
+std::string LatencyTracker::GetSummary(bool isVSyncOn) const
+{
+	static constexpr std::array<const char*, NUM_STAGES> stageNames{ "update", "draw", "present" };
+
+	std::ostringstream output;
+	output << std::fixed << std::setprecision(1) << "vsync " << (isVSyncOn ? "on " : "off") << ':';
+	for (int stage{}; stage < NUM_STAGES; ++stage)
+	{
+		const Percentiles percentiles{ GetPercentiles(isVSyncOn, Stage(stage)) };
+		output << "  " << stageNames[stage] << ' ' << percentiles.p50 << '/' << percentiles.p95 << '/' << percentiles.p99;
+	}
+	output << "  (" << GetPercentiles(isVSyncOn, Stage::Present).count << " inputs)";
+	return output.str();
+}
+
+int64_t LatencyTracker::ToTicks(clock::time_point timestamp)
+{
+	return timestamp.time_since_epoch().count();
+}
+
+float LatencyTracker::TicksToMilliseconds(int64_t ticks)
+{
+	return std::chrono::duration<float, std::milli>(clock::duration{ ticks }).count();
+}
+
+void LatencyTracker::AddSample(bool isVSyncOn, Stage stage, float milliseconds)
+{
+	Bucket& bucket{ m_buckets[isVSyncOn ? 1 : 0] };
+	std::vector<float>& samples{ bucket.samples[int(stage)] };
+
+	// keep the most recent samples once the bucket is full
+	if (samples.size() < MAX_SAMPLES)
+	{
+		samples.push_back(milliseconds);
+	}
+	else
+	{
+		samples[bucket.nextSample] = milliseconds;
+	}
+
+	// the present stage is added last, so it moves the shared write position
+	if (stage == Stage::Present) bucket.nextSample = (bucket.nextSample + 1) % MAX_SAMPLES;
+}
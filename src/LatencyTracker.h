@@ -0,0 +1,85 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Follows tagged input events through the frame pipeline:
+// the Update that consumed them, the Draw that showed their effect and the swap that presented it.
+// Latencies are kept separately for vsync on and off.
+class LatencyTracker final
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	enum class Stage
+	{
+		Update,
+		Draw,
+		Present
+	};
+	static constexpr int NUM_STAGES{ 3 };
+
+	struct Percentiles
+	{
+		float p50;
+		float p95;
+		float p99;
+		size_t count;
+	};
+
+	explicit LatencyTracker(const std::string& logPath);
+	LatencyTracker(const LatencyTracker& other) = delete;
+	LatencyTracker& operator=(const LatencyTracker& other) = delete;
+	~LatencyTracker();
+
+	// Event loop: start tracking an input event, returns the tag it has to carry
+	uint32_t TagInput(clock::time_point timestamp);
+	// Simulation thread: the input with this tag was consumed by an Update
+	void MarkUpdated(uint32_t id, clock::time_point timestamp);
+	// Render thread: all inputs up to and including this tag are visible in the frame that was just drawn
+	void MarkDrawn(uint32_t lastId, clock::time_point timestamp);
+	// Render thread: the drawn frame was presented
+	void MarkPresented(clock::time_point timestamp, bool isVSyncOn);
+
+	// latencies in milliseconds
+	Percentiles GetPercentiles(bool isVSyncOn, Stage stage) const;
+	std::string GetSummary(bool isVSyncOn) const;
+
+private:
+	static constexpr size_t NUM_RECORDS{ 4096 };
+	static constexpr size_t MAX_SAMPLES{ 20000 };
+
+	// written by different threads, so every time stamp is atomic
+	struct Record
+	{
+		std::atomic<int64_t> input;
+		std::atomic<int64_t> update;
+		std::atomic<int64_t> draw;
+	};
+
+	// last latency samples of one vsync mode, per stage
+	struct Bucket
+	{
+		std::array<std::vector<float>, NUM_STAGES> samples;
+		size_t nextSample;
+	};
+
+	std::array<Record, NUM_RECORDS> m_records;
+	uint32_t m_nextId;
+
+	// first tag that was not drawn / presented yet (render thread only)
+	uint32_t m_firstUndrawnId;
+	uint32_t m_firstUnpresentedId;
+
+	std::array<Bucket, 2> m_buckets;
+	std::ofstream m_log;
+
+	static int64_t ToTicks(clock::time_point timestamp);
+	static float TicksToMilliseconds(int64_t ticks);
+
+	void AddSample(bool isVSyncOn, Stage stage, float milliseconds);
+};
@@ -0,0 +1,332 @@
+#include "Log.h"
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr uint32_t RING_SIZE{ 256 };
+	static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "the ring size should be a power of two");
+
+	// a record in an empty ring wakes the writer, this only bounds how late a wake-up that raced with a drain is noticed
+	constexpr std::chrono::milliseconds IDLE_INTERVAL{ 100 };
+
+	// Written by one thread and read by the writer. Head and tail live on their own cache lines,
+	// so the logging thread and the writer don't invalidate each other's line on every record.
+	struct Ring final
+	{
+		alignas(64) std::atomic<uint32_t> head{};
+		alignas(64) std::atomic<uint32_t> tail{};
+		alignas(64) std::atomic<bool> isOwned{};
+		std::array<Log::Record, RING_SIZE> records{};
+	};
+
+	// Rings are never freed while the program runs: a thread that ends gives its ring back and the next new thread reuses it
+	std::mutex g_RingsMutex{};
+	std::vector<std::unique_ptr<Ring>> g_Rings{};
+
+	std::atomic<uint64_t> g_NumDropped{};
+	const std::chrono::steady_clock::time_point g_StartTime{ std::chrono::steady_clock::now() };
+
+	// only one thread drains at a time, either the writer or a thread that flushes
+	std::mutex g_DrainMutex{};
+	std::string g_StandardOutput{};
+	std::string g_ErrorOutput{};
+
+	std::mutex g_WriterMutex{};
+	std::condition_variable g_WriterWake{};
+	std::thread g_Writer{};
+	std::atomic<bool> g_IsRunning{};
+	bool g_IsStopping{};
+	bool g_HasRecords{};
+
+	struct RingHandle final
+	{
+		Ring* pRing{};
+
+		~RingHandle()
+		{
+			if (pRing != nullptr) pRing->isOwned.store(false, std::memory_order_release);
+		}
+	};
+	thread_local RingHandle t_Ring{};
+
+	void Drain();
+
+	void RunWriter()
+	{
+		std::unique_lock<std::mutex> lock{ g_WriterMutex };
+		while (!g_IsStopping)
+		{
+			g_WriterWake.wait_for(lock, IDLE_INTERVAL, [] { return g_HasRecords || g_IsStopping; });
+			g_HasRecords = false;
+			lock.unlock();
+			Drain();
+			lock.lock();
+		}
+	}
+
+	void WakeWriter()
+	{
+		{
+			const std::lock_guard<std::mutex> lock{ g_WriterMutex };
+			g_HasRecords = true;
+		}
+		g_WriterWake.notify_one();
+	}
+
+	void StartWriter()
+	{
+		const std::lock_guard<std::mutex> lock{ g_WriterMutex };
+		if (g_IsRunning.load(std::memory_order_relaxed)) return;
+
+		g_IsStopping = false;
+		g_Writer = std::thread{ &RunWriter };
+		g_IsRunning.store(true, std::memory_order_release);
+	}
+
+	Ring& GetRing()
+	{
+		if (t_Ring.pRing != nullptr) return *t_Ring.pRing;
+
+		{
+			const std::lock_guard<std::mutex> lock{ g_RingsMutex };
+			for (const std::unique_ptr<Ring>& pRing : g_Rings)
+			{
+				bool isOwned{ false };
+				if (pRing->isOwned.compare_exchange_strong(isOwned, true, std::memory_order_acquire))
+				{
+					t_Ring.pRing = pRing.get();
+					break;
+				}
+			}
+			if (t_Ring.pRing == nullptr)
+			{
+				g_Rings.push_back(std::make_unique<Ring>());
+				g_Rings.back()->isOwned.store(true, std::memory_order_relaxed);
+				t_Ring.pRing = g_Rings.back().get();
+			}
+		}
+
+		StartWriter();
+		return *t_Ring.pRing;
+	}
+
+	const char* GetLevelName(Log::Level level)
+	{
+		switch (level)
+		{
+		case Log::Level::Debug: return "debug  ";
+		case Log::Level::Info: return "info   ";
+		case Log::Level::Warning: return "warning";
+		case Log::Level::Error: return "error  ";
+		default: return "       ";
+		}
+	}
+
+	template <typename Value>
+	Value ReadValue(const unsigned char*& pInput)
+	{
+		Value value{};
+		std::memcpy(&value, pInput, sizeof(value));
+		pInput += sizeof(value);
+		return value;
+	}
+
+	template <typename Number>
+	void AppendNumber(std::string& output, Number number)
+	{
+		char buffer[32];
+		if constexpr (std::is_floating_point_v<Number>)
+		{
+			// 6 significant digits, like std::cout prints them
+			output.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), number, std::chars_format::general, 6).ptr);
+		}
+		else
+		{
+			output.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), number).ptr);
+		}
+	}
+
+	// "[    1.234 error  ] " followed by the arguments and a newline
+	void FormatRecord(const Log::Record& record, std::string& output)
+	{
+		char buffer[1024];
+
+		const double seconds{ double(record.time) * 1e-9 };
+		const size_t timeLength{ size_t(std::to_chars(buffer, buffer + sizeof(buffer), seconds, std::chars_format::fixed, 3).ptr - buffer) };
+		output += '[';
+		if (timeLength < 9) output.append(9 - timeLength, ' ');
+		output.append(buffer, timeLength);
+		output += ' ';
+		output += GetLevelName(record.level);
+		output += "] ";
+
+		const unsigned char* pInput{ record.payload };
+		const unsigned char* const pEnd{ record.payload + record.size };
+		while (pInput < pEnd)
+		{
+			switch (Log::ArgumentType(*pInput++))
+			{
+			case Log::ArgumentType::Text:
+			{
+				const size_t length{ *pInput++ };
+				output.append(reinterpret_cast<const char*>(pInput), length);
+				pInput += length;
+				break;
+			}
+			case Log::ArgumentType::Char:
+				output += ReadValue<char>(pInput);
+				break;
+			case Log::ArgumentType::Bool:
+				output += ReadValue<bool>(pInput) ? "1" : "0";
+				break;
+			case Log::ArgumentType::Int:
+				AppendNumber(output, ReadValue<int64_t>(pInput));
+				break;
+			case Log::ArgumentType::UInt:
+				AppendNumber(output, ReadValue<uint64_t>(pInput));
+				break;
+			case Log::ArgumentType::Float:
+				AppendNumber(output, ReadValue<float>(pInput));
+				break;
+			case Log::ArgumentType::Double:
+				AppendNumber(output, ReadValue<double>(pInput));
+				break;
+			case Log::ArgumentType::Element:
+			{
+				const Log::FormatFunction format{ ReadValue<Log::FormatFunction>(pInput) };
+				const size_t size{ *pInput++ };
+				output.append(buffer, format(pInput, buffer, sizeof(buffer)));
+				pInput += size;
+				break;
+			}
+			default:
+				// a corrupt record, nothing after this can be trusted
+				pInput = pEnd;
+				break;
+			}
+		}
+
+		if (record.isTruncated) output += " (truncated)";
+		output += '\n';
+	}
+
+	// Writes every record that is in the rings, oldest first when several threads logged
+	void Drain()
+	{
+		const std::lock_guard<std::mutex> drainLock{ g_DrainMutex };
+
+		g_StandardOutput.clear();
+		g_ErrorOutput.clear();
+
+		{
+			const std::lock_guard<std::mutex> ringsLock{ g_RingsMutex };
+			while (true)
+			{
+				Ring* pOldest{};
+				for (const std::unique_ptr<Ring>& pRing : g_Rings)
+				{
+					const uint32_t tail{ pRing->tail.load(std::memory_order_relaxed) };
+					if (tail == pRing->head.load(std::memory_order_acquire)) continue;
+					if (pOldest == nullptr
+						|| pRing->records[tail % RING_SIZE].time < pOldest->records[pOldest->tail.load(std::memory_order_relaxed) % RING_SIZE].time)
+					{
+						pOldest = pRing.get();
+					}
+				}
+				if (pOldest == nullptr) break;
+
+				const uint32_t tail{ pOldest->tail.load(std::memory_order_relaxed) };
+				const Log::Record& record{ pOldest->records[tail % RING_SIZE] };
+				FormatRecord(record, record.level >= Log::Level::Warning ? g_ErrorOutput : g_StandardOutput);
+				// the slot is only given back after it was formatted
+				pOldest->tail.store(tail + 1, std::memory_order_release);
+			}
+		}
+
+		if (!g_StandardOutput.empty())
+		{
+			std::cout.write(g_StandardOutput.data(), std::streamsize(g_StandardOutput.size()));
+			std::cout.flush();
+		}
+		if (!g_ErrorOutput.empty())
+		{
+			std::cerr.write(g_ErrorOutput.data(), std::streamsize(g_ErrorOutput.size()));
+			std::cerr.flush();
+		}
+	}
+
+	// stops the writer when the program exits, after writing what is left
+	struct Shutdown final
+	{
+		~Shutdown()
+		{
+			Log::Stop();
+		}
+	};
+	Shutdown g_Shutdown{};
+}
+
+void Log::Start()
+{
+	GetRing();
+}
+
+void Log::Flush()
+{
+	Drain();
+}
+
+void Log::Stop()
+{
+	{
+		const std::lock_guard<std::mutex> lock{ g_WriterMutex };
+		if (!g_IsRunning.load(std::memory_order_relaxed) || g_IsStopping) return;
+		g_IsStopping = true;
+	}
+	g_WriterWake.notify_one();
+	g_Writer.join();
+
+	{
+		const std::lock_guard<std::mutex> lock{ g_WriterMutex };
+		g_IsRunning.store(false, std::memory_order_relaxed);
+	}
+	Drain();
+}
+
+uint64_t Log::GetNumDropped()
+{
+	return g_NumDropped.load(std::memory_order_relaxed);
+}
+
+void Log::Push(Record record)
+{
+	Ring& ring{ GetRing() };
+	if (!g_IsRunning.load(std::memory_order_relaxed)) StartWriter();
+
+	record.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_StartTime).count();
+
+	const uint32_t head{ ring.head.load(std::memory_order_relaxed) };
+	const uint32_t tail{ ring.tail.load(std::memory_order_acquire) };
+	if (head - tail == RING_SIZE)
+	{
+		g_NumDropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	ring.records[head % RING_SIZE] = record;
+	ring.head.store(head + 1, std::memory_order_release);
+
+	// the first record in an empty ring wakes the writer, the ones after it are written in the same drain.
+	// A burst that fills half the ring wakes it again in case it is still busy with another ring
+	if (head == tail || head - ring.tail.load(std::memory_order_relaxed) == RING_SIZE / 2) WakeWriter();
+}
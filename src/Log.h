@@ -0,0 +1,218 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+template <typename Derived, int DataSize>
+class GAElement;
+
+// Lowest level that is compiled in, set with cmake -DGEOA_LOG_LEVEL=<level> (0 debug, 1 info, 2 warning, 3 error, 4 nothing)
+#ifndef GEOA_LOG_LEVEL
+#define GEOA_LOG_LEVEL 1
+#endif
+
+// Asynchronous logging that doesn't stall the thread that logs.
+// A call like Log::Error("Texture::CreateFromImage, error when calling IMG_Load: ", SDL_GetError()) copies its arguments
+// as binary values into a record, and appends the record to a ring buffer that belongs to the calling thread, without locks.
+// A background writer takes the records out of every ring, formats them (numbers with std::to_chars) and writes them,
+// it sleeps until a record lands in an empty ring wakes it, which is the only time logging takes a (short) lock.
+// debug and info to stdout, warnings and errors to stderr.
+// When a ring is full the record is dropped and counted instead of waiting for the writer.
+// Levels below GEOA_LOG_LEVEL compile to nothing, only arguments with side effects are still evaluated.
+namespace Log
+{
+	enum class Level : uint8_t
+	{
+		Debug,
+		Info,
+		Warning,
+		Error,
+		Off
+	};
+
+	constexpr Level MIN_LEVEL{ Level(GEOA_LOG_LEVEL) };
+
+	constexpr bool IsCompiledIn(Level level)
+	{
+		return level >= MIN_LEVEL && level != Level::Off;
+	}
+
+	// One log call, the size of four cache lines. Arguments that don't fit are cut off.
+	struct Record
+	{
+		static constexpr size_t PAYLOAD_SIZE{ 240 };
+
+		// nanoseconds since the logger started
+		int64_t time;
+		Level level;
+		uint8_t isTruncated;
+		uint16_t size;
+		// the arguments, each an ArgumentType byte followed by its value
+		unsigned char payload[PAYLOAD_SIZE];
+	};
+	static_assert(sizeof(Record) == 256, "a log record should stay four cache lines");
+
+	enum class ArgumentType : uint8_t
+	{
+		Text,
+		Char,
+		Bool,
+		Int,
+		UInt,
+		Float,
+		Double,
+		Element
+	};
+
+	// writes an element copied into a record as text, returns the length
+	using FormatFunction = size_t(*)(const void* pElement, char* buffer, size_t size);
+
+	// starts the writer and gives the calling thread its ring, so the first log call doesn't allocate
+	void Start();
+	// writes everything that was logged before the call, blocks until it is written
+	void Flush();
+	// flushes and stops the writer, logging afterwards starts it again
+	void Stop();
+	// records that were dropped because a ring was full
+	uint64_t GetNumDropped();
+
+	// stamps the record with the time and appends it to the ring of the calling thread
+	void Push(Record record);
+
+	// copies log arguments into a record
+	class RecordWriter final
+	{
+	public:
+		explicit RecordWriter(Level level)
+			: m_record{}
+		{
+			m_record.level = level;
+		}
+
+		void Append(std::string_view text)
+		{
+			const size_t length{ std::min<size_t>(text.size(), 255) };
+			if (!Reserve(2))
+			{
+				return;
+			}
+			const size_t numCopied{ std::min(length, Record::PAYLOAD_SIZE - m_record.size - 2) };
+			m_record.isTruncated |= uint8_t(numCopied < text.size());
+			m_record.payload[m_record.size++] = uint8_t(ArgumentType::Text);
+			m_record.payload[m_record.size++] = uint8_t(numCopied);
+			std::memcpy(m_record.payload + m_record.size, text.data(), numCopied);
+			m_record.size += uint16_t(numCopied);
+		}
+		void Append(const char* pText)
+		{
+			Append(std::string_view{ pText != nullptr ? pText : "(null)" });
+		}
+		void Append(const std::string& text)
+		{
+			Append(std::string_view{ text });
+		}
+		void Append(char value)
+		{
+			AppendValue(ArgumentType::Char, value);
+		}
+		void Append(bool value)
+		{
+			AppendValue(ArgumentType::Bool, value);
+		}
+		void Append(float value)
+		{
+			AppendValue(ArgumentType::Float, value);
+		}
+		void Append(double value)
+		{
+			AppendValue(ArgumentType::Double, value);
+		}
+		template <typename Integer, std::enable_if_t<std::is_integral_v<Integer>, int> = 0>
+		void Append(Integer value)
+		{
+			if constexpr (std::is_signed_v<Integer>) AppendValue(ArgumentType::Int, int64_t(value));
+			else AppendValue(ArgumentType::UInt, uint64_t(value));
+		}
+		// FlyFish elements are copied as floats and only formatted by the writer
+		template <typename Derived, int DataSize>
+		void Append(const GAElement<Derived, DataSize>& element)
+		{
+			if (!Reserve(1 + sizeof(FormatFunction) + 1 + sizeof(Derived))) return;
+			const FormatFunction format{ &FormatElement<Derived> };
+			m_record.payload[m_record.size++] = uint8_t(ArgumentType::Element);
+			std::memcpy(m_record.payload + m_record.size, &format, sizeof(format));
+			m_record.size += uint16_t(sizeof(format));
+			m_record.payload[m_record.size++] = uint8_t(sizeof(Derived));
+			std::memcpy(m_record.payload + m_record.size, &static_cast<const Derived&>(element), sizeof(Derived));
+			m_record.size += uint16_t(sizeof(Derived));
+		}
+
+		const Record& GetRecord() const
+		{
+			return m_record;
+		}
+
+	private:
+		Record m_record;
+
+		bool Reserve(size_t size)
+		{
+			if (m_record.size + size <= Record::PAYLOAD_SIZE) return true;
+			m_record.isTruncated = 1;
+			return false;
+		}
+
+		template <typename Value>
+		void AppendValue(ArgumentType type, Value value)
+		{
+			if (!Reserve(1 + sizeof(value))) return;
+			m_record.payload[m_record.size++] = uint8_t(type);
+			std::memcpy(m_record.payload + m_record.size, &value, sizeof(value));
+			m_record.size += uint16_t(sizeof(value));
+		}
+
+		template <typename Derived>
+		static size_t FormatElement(const void* pElement, char* buffer, size_t size)
+		{
+			Derived element{};
+			std::memcpy(&element, pElement, sizeof(Derived));
+			return element.Format(buffer, size);
+		}
+	};
+
+	template <Level level, typename... Args>
+	void Write(const Args&... args)
+	{
+		if constexpr (IsCompiledIn(level))
+		{
+			RecordWriter writer{ level };
+			(writer.Append(args), ...);
+			Push(writer.GetRecord());
+		}
+	}
+
+	template <typename... Args>
+	void Debug(const Args&... args)
+	{
+		Write<Level::Debug>(args...);
+	}
+	template <typename... Args>
+	void Info(const Args&... args)
+	{
+		Write<Level::Info>(args...);
+	}
+	template <typename... Args>
+	void Warning(const Args&... args)
+	{
+		Write<Level::Warning>(args...);
+	}
+	template <typename... Args>
+	void Error(const Args&... args)
+	{
+		Write<Level::Error>(args...);
+	}
+}
@@ -0,0 +1,226 @@
+#include "MappedFile.h"
+#include "Log.h"
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& path)
+	: m_pData{ nullptr }
+	, m_size{ 0 }
+	, m_isWritable{ false }
+	, m_fileHandle{ INVALID_HANDLE_VALUE }
+	, m_mappingHandle{ nullptr }
+{
+	// sharing write access allows mapping a file that another process is still writing, like a telemetry ring
+	m_fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_fileHandle == INVALID_HANDLE_VALUE)
+	{
+		Log::Error("MappedFile::MappedFile( ), could not open ", path);
+		return;
+	}
+
+	LARGE_INTEGER size{};
+	GetFileSizeEx(m_fileHandle, &size);
+	m_size = size_t(size.QuadPart);
+	// an empty file can't be mapped, but it is still a valid (empty) file
+	if (m_size == 0) return;
+
+	m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mappingHandle) m_pData = static_cast<uint8_t*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (!m_pData)
+	{
+		Log::Error("MappedFile::MappedFile( ), could not map ", path);
+		Close();
+	}
+}
+
+MappedFile::MappedFile(const std::string& path, size_t size)
+	: m_pData{ nullptr }
+	, m_size{ size }
+	, m_isWritable{ true }
+	, m_fileHandle{ INVALID_HANDLE_VALUE }
+	, m_mappingHandle{ nullptr }
+{
+	// other processes may read the file while it is mapped
+	m_fileHandle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_fileHandle == INVALID_HANDLE_VALUE)
+	{
+		Log::Error("MappedFile::MappedFile( ), could not create ", path);
+		m_size = 0;
+		return;
+	}
+
+	// mapping more than the file holds grows the file to that size
+	const uint64_t mappingSize{ size };
+	m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READWRITE, DWORD(mappingSize >> 32), DWORD(mappingSize & 0xFFFFFFFF), nullptr);
+	if (m_mappingHandle) m_pData = static_cast<uint8_t*>(MapViewOfFile(m_mappingHandle, FILE_MAP_WRITE, 0, 0, 0));
+	if (!m_pData)
+	{
+		Log::Error("MappedFile::MappedFile( ), could not map ", size, " bytes of ", path);
+		Close();
+	}
+}
+
+void MappedFile::Close()
+{
+	if (m_pData) UnmapViewOfFile(m_pData);
+	if (m_mappingHandle) CloseHandle(m_mappingHandle);
+	if (m_fileHandle != INVALID_HANDLE_VALUE) CloseHandle(m_fileHandle);
+	m_pData = nullptr;
+	m_size = 0;
+	m_mappingHandle = nullptr;
+	m_fileHandle = INVALID_HANDLE_VALUE;
+}
+
+bool MappedFile::IsOpen() const
+{
+	return m_fileHandle != INVALID_HANDLE_VALUE;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+	: m_pData{ std::exchange(other.m_pData, nullptr) }
+	, m_size{ std::exchange(other.m_size, 0) }
+	, m_isWritable{ std::exchange(other.m_isWritable, false) }
+	, m_fileHandle{ std::exchange(other.m_fileHandle, INVALID_HANDLE_VALUE) }
+	, m_mappingHandle{ std::exchange(other.m_mappingHandle, nullptr) }
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		m_pData = std::exchange(other.m_pData, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+		m_isWritable = std::exchange(other.m_isWritable, false);
+		m_fileHandle = std::exchange(other.m_fileHandle, INVALID_HANDLE_VALUE);
+		m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+	}
+	return *this;
+}
+#else
+MappedFile::MappedFile(const std::string& path)
+	: m_pData{ nullptr }
+	, m_size{ 0 }
+	, m_isWritable{ false }
+	, m_fileDescriptor{ -1 }
+{
+	m_fileDescriptor = open(path.c_str(), O_RDONLY);
+	if (m_fileDescriptor < 0)
+	{
+		Log::Error("MappedFile::MappedFile( ), could not open ", path);
+		return;
+	}
+
+	struct stat status{};
+	fstat(m_fileDescriptor, &status);
+	m_size = size_t(status.st_size);
+	// an empty file can't be mapped, but it is still a valid (empty) file
+	if (m_size == 0) return;
+
+	void* pMapping{ mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0) };
+	if (pMapping == MAP_FAILED)
+	{
+		Log::Error("MappedFile::MappedFile( ), could not map ", path);
+		Close();
+		return;
+	}
+	m_pData = static_cast<uint8_t*>(pMapping);
+}
+
+MappedFile::MappedFile(const std::string& path, size_t size)
+	: m_pData{ nullptr }
+	, m_size{ size }
+	, m_isWritable{ true }
+	, m_fileDescriptor{ -1 }
+{
+	m_fileDescriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (m_fileDescriptor < 0)
+	{
+		Log::Error("MappedFile::MappedFile( ), could not create ", path);
+		m_size = 0;
+		return;
+	}
+
+	// a shared mapping, so the stores reach the file and other processes see them
+	void* pMapping{ MAP_FAILED };
+	if (ftruncate(m_fileDescriptor, off_t(size)) == 0) pMapping = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fileDescriptor, 0);
+	if (pMapping == MAP_FAILED)
+	{
+		Log::Error("MappedFile::MappedFile( ), could not map ", size, " bytes of ", path);
+		Close();
+		return;
+	}
+	m_pData = static_cast<uint8_t*>(pMapping);
+}
+
+void MappedFile::Close()
+{
+	if (m_pData) munmap(m_pData, m_size);
+	if (m_fileDescriptor >= 0) close(m_fileDescriptor);
+	m_pData = nullptr;
+	m_size = 0;
+	m_fileDescriptor = -1;
+}
+
+bool MappedFile::IsOpen() const
+{
+	return m_fileDescriptor >= 0;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+	: m_pData{ std::exchange(other.m_pData, nullptr) }
+	, m_size{ std::exchange(other.m_size, 0) }
+	, m_isWritable{ std::exchange(other.m_isWritable, false) }
+	, m_fileDescriptor{ std::exchange(other.m_fileDescriptor, -1) }
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		m_pData = std::exchange(other.m_pData, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+		m_isWritable = std::exchange(other.m_isWritable, false);
+		m_fileDescriptor = std::exchange(other.m_fileDescriptor, -1);
+	}
+	return *this;
+}
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+const uint8_t* MappedFile::GetData() const
+{
+	return m_pData;
+}
+
+uint8_t* MappedFile::GetWritableData()
+{
+	return m_isWritable ? m_pData : nullptr;
+}
+
+size_t MappedFile::GetSize() const
+{
+	return m_size;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// A whole file mapped read-only into memory, so binary data can be used in place without reading or copying it,
+// or a new file of a fixed size mapped for writing, where every store goes to the file without a system call
+class MappedFile final
+{
+public:
+	explicit MappedFile(const std::string& path);
+	// creates the file (or replaces an existing one) with the given size, filled with zeros
+	MappedFile(const std::string& path, size_t size);
+	MappedFile(const MappedFile& other) = delete;
+	MappedFile& operator=(const MappedFile& other) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	~MappedFile();
+
+	bool IsOpen() const;
+	const uint8_t* GetData() const;
+	// nullptr when the file was opened read-only
+	uint8_t* GetWritableData();
+	size_t GetSize() const;
+
+private:
+	uint8_t* m_pData;
+	size_t m_size;
+	bool m_isWritable;
+
+	// platform handles, only used to unmap
+#ifdef _WIN32
+	void* m_fileHandle;
+	void* m_mappingHandle;
+#else
+	int m_fileDescriptor;
+#endif
+
+	void Close();
+};
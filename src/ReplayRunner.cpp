@@ -0,0 +1,226 @@
+#include "ReplayRunner.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "Ball.h"
+#include "Log.h"
+#include "Table.h"
+
+ReplayRunner::ReplayRunner(const std::string& path)
+	: m_isLoaded{ false }
+	, m_layout{}
+	, m_points{ 0 }
+	, m_flags{ 0 }
+	, m_hasFinalState{ false }
+	, m_finalPoints{ 0 }
+{
+	m_isLoaded = Load(path);
+	if (!m_isLoaded)
+	{
+		Log::Error("ReplayRunner::ReplayRunner( ), unable to load shot log ", path);
+	}
+}
+
+bool ReplayRunner::IsLoaded() const
+{
+	return m_isLoaded;
+}
+
+ReplayRunner::Result ReplayRunner::Run() const
+{
+	Result result{ false, m_hasFinalState, 0, 0, 0.f, 0, m_finalPoints, 0.0 };
+	if (!m_isLoaded) return result;
+
+	const auto startTime{ std::chrono::steady_clock::now() };
+
+	Table table{ m_layout };
+	table.SetState(std::vector<Ball>(m_balls.begin(), m_balls.end() - 1), m_balls.back(), m_points,
+		(m_flags & ShotLog::FIRST_SHOT) != 0, (m_flags & ShotLog::BALLS_ROLLING) != 0, (m_flags & ShotLog::HAS_HIT_BALL) != 0);
+
+	for (const Record& record : m_records)
+	{
+		if (record.type == ShotLog::RecordType::Shot)
+		{
+			table.ApplyShot(record.shot);
+			++result.numShots;
+			continue;
+		}
+
+		for (uint64_t step{}; step < record.count; ++step)
+		{
+			table.Update(record.elapsedSec);
+		}
+		result.numSteps += record.count;
+	}
+
+	result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	result.points = table.GetPoints();
+
+	if (!m_hasFinalState) return result;
+
+	// verify the final state
+	const std::vector<Ball>& redBalls{ table.GetRedBalls() };
+	if (redBalls.size() + 1 != m_finalPositions.size())
+	{
+		result.maxPositionError = FLT_MAX;
+		return result;
+	}
+
+	const auto positionError = [](const Ball& ball, const ThreeBlade& recorded)
+	{
+		const ThreeBlade& pos{ ball.GetPos() };
+		return std::max(std::hypot(pos[0] - recorded[0], pos[1] - recorded[1]), std::abs(pos[2] - recorded[2]));
+	};
+	for (size_t idx{}; idx < redBalls.size(); ++idx)
+	{
+		result.maxPositionError = std::max(result.maxPositionError, positionError(redBalls[idx], m_finalPositions[idx]));
+	}
+	result.maxPositionError = std::max(result.maxPositionError, positionError(table.GetWhiteBall(), m_finalPositions.back()));
+
+	result.isMatch = result.maxPositionError <= POSITION_TOLERANCE && result.points == m_finalPoints;
+	return result;
+}
+
+bool ReplayRunner::Load(const std::string& path)
+{
+	std::ifstream file{ path, std::ios::binary };
+	if (!file) return false;
+
+	// header
+	char magic[4]{};
+	uint16_t version{}, reserved{};
+	if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, ShotLog::MAGIC, sizeof(magic)) != 0) return false;
+	if (!ShotLog::Read(file, version) || !ShotLog::Read(file, reserved)) return false;
+	if (version < ShotLog::MIN_VERSION || version > ShotLog::VERSION)
+	{
+		Log::Error("ReplayRunner::Load( ), unsupported shot log version ", version);
+		return false;
+	}
+
+	// initial table state
+	Rectf playArea{};
+	if (!ShotLog::Read(file, playArea.left) || !ShotLog::Read(file, playArea.bottom)
+		|| !ShotLog::Read(file, playArea.width) || !ShotLog::Read(file, playArea.height))
+	{
+		return false;
+	}
+	if (version == 1) m_layout = TableLayout::CreateDefault(playArea);
+	else if (!LoadLayout(file, playArea)) return false;
+
+	int32_t points{};
+	uint16_t numRedBalls{};
+	if (!ShotLog::Read(file, points) || !ShotLog::Read(file, m_flags) || !ShotLog::Read(file, numRedBalls))
+	{
+		return false;
+	}
+	m_points = points;
+
+	m_balls.reserve(numRedBalls + 1);
+	for (int idx{}; idx <= numRedBalls; ++idx)
+	{
+		ThreeBlade pos{};
+		Motor velocity{};
+		for (float& value : pos) ShotLog::Read(file, value);
+		for (float& value : velocity) ShotLog::Read(file, value);
+		if (!file) return false;
+
+		Ball ball{ pos, velocity, idx == numRedBalls };
+		ball.SetState(pos, velocity);
+		m_balls.push_back(ball);
+	}
+
+	// records
+	ShotLog::RecordType type{};
+	while (ShotLog::Read(file, type))
+	{
+		switch (type)
+		{
+		case ShotLog::RecordType::Steps:
+		{
+			Record record{ type, 0, 0.f, Motor{} };
+			if (!ShotLog::ReadVarint(file, record.count) || !ShotLog::Read(file, record.elapsedSec)) return false;
+			m_records.push_back(record);
+			break;
+		}
+		case ShotLog::RecordType::Shot:
+		{
+			Record record{ type, 1, 0.f, Motor{} };
+			for (float& value : record.shot) ShotLog::Read(file, value);
+			if (!file) return false;
+			m_records.push_back(record);
+			break;
+		}
+		case ShotLog::RecordType::End:
+		{
+			int32_t finalPoints{};
+			uint16_t numFinalRedBalls{};
+			if (!ShotLog::Read(file, finalPoints) || !ShotLog::Read(file, numFinalRedBalls)) return false;
+			m_finalPoints = finalPoints;
+
+			m_finalPositions.resize(numFinalRedBalls + 1);
+			for (ThreeBlade& pos : m_finalPositions)
+			{
+				ShotLog::Read(file, pos[0]);
+				ShotLog::Read(file, pos[1]);
+				ShotLog::Read(file, pos[2]);
+				pos[3] = 1.f;
+			}
+			if (!file) return false;
+
+			m_hasFinalState = true;
+			return true;
+		}
+		default:
+			Log::Error("ReplayRunner::Load( ), unknown record type ", int(type));
+			return false;
+		}
+	}
+
+	// the game was not finished cleanly, the log can be replayed but not verified
+	return true;
+}
+
+bool ReplayRunner::LoadLayout(std::istream& stream, const Rectf& playArea)
+{
+	m_layout = TableLayout{};
+	m_layout.playArea = playArea;
+
+	uint16_t numCushions{};
+	if (!ShotLog::Read(stream, numCushions)) return false;
+	m_layout.cushions.resize(numCushions);
+	for (CushionSet::Outline& cushion : m_layout.cushions)
+	{
+		uint8_t isClosed{};
+		uint16_t numPoints{};
+		if (!ShotLog::Read(stream, isClosed) || !ShotLog::Read(stream, numPoints)) return false;
+
+		cushion.isClosed = isClosed != 0;
+		cushion.points.resize(numPoints);
+		for (Point2f& point : cushion.points)
+		{
+			ShotLog::Read(stream, point.x);
+			ShotLog::Read(stream, point.y);
+		}
+	}
+
+	uint16_t numPockets{};
+	if (!ShotLog::Read(stream, numPockets)) return false;
+	m_layout.pockets.resize(numPockets);
+	for (Point2f& pocket : m_layout.pockets)
+	{
+		ShotLog::Read(stream, pocket.x);
+		ShotLog::Read(stream, pocket.y);
+	}
+
+	// the balls are replaced by the recorded state, only where the white ball goes back to matters
+	Point2f whiteBallStart{};
+	ShotLog::Read(stream, whiteBallStart.x);
+	ShotLog::Read(stream, whiteBallStart.y);
+	m_layout.balls.push_back(TableLayout::BallSetup{ whiteBallStart, Point2f{ 0.f, 0.f }, Ball::TOT_LIVES, true });
+
+	return bool(stream);
+}
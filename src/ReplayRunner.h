@@ -0,0 +1,67 @@
+#pragma once
+#include "structs.h"
+#include "FlyFish.h"
+#include "ShotLog.h"
+#include "TableLayout.h"
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+class Ball;
+
+// Loads a shot log and re-simulates it headlessly as fast as possible
+class ReplayRunner final
+{
+public:
+	struct Result
+	{
+		// false when the final state differs from the recorded one
+		bool isMatch;
+		bool hasFinalState;
+		uint64_t numSteps;
+		size_t numShots;
+		// largest distance between a replayed and a recorded final position
+		float maxPositionError;
+		int points;
+		int recordedPoints;
+		double wallSeconds;
+	};
+
+	explicit ReplayRunner(const std::string& path);
+
+	bool IsLoaded() const;
+	Result Run() const;
+
+	// positions closer than this count as the same
+	static constexpr float POSITION_TOLERANCE{ 0.01f };
+
+private:
+	struct Record
+	{
+		ShotLog::RecordType type;
+		uint64_t count;
+		float elapsedSec;
+		Motor shot;
+	};
+
+	bool m_isLoaded;
+
+	// the table without its balls, they come from m_balls
+	TableLayout m_layout;
+	int m_points;
+	uint8_t m_flags;
+	// red balls followed by the white ball
+	std::vector<Ball> m_balls;
+
+	std::vector<Record> m_records;
+
+	bool m_hasFinalState;
+	int m_finalPoints;
+	// red balls followed by the white ball, z holds the lives
+	std::vector<ThreeBlade> m_finalPositions;
+
+	bool Load(const std::string& path);
+	// the cushions, pockets and white ball start of a version 2 log
+	bool LoadLayout(std::istream& stream, const Rectf& playArea);
+};
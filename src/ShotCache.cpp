@@ -0,0 +1,198 @@
+#include "ShotCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "TableState.h"
+
+namespace
+{
+	int32_t Quantize(float value, float quantum)
+	{
+		return int32_t(std::lround(value / quantum));
+	}
+
+	// splitmix64 finalizer, every input bit changes about half of the output bits
+	uint64_t Mix(uint64_t value)
+	{
+		value ^= value >> 30;
+		value *= 0xbf58476d1ce4e5b9ull;
+		value ^= value >> 27;
+		value *= 0x94d049bb133111ebull;
+		value ^= value >> 31;
+		return value;
+	}
+
+	uint64_t Combine(uint64_t hash, int32_t value)
+	{
+		return Mix(hash ^ (uint32_t(value) + 0x9e3779b97f4a7c15ull));
+	}
+
+	uint64_t HashBall(uint64_t hash, const Ball& ball)
+	{
+		const ThreeBlade& pos{ ball.GetPos() };
+		const Point2f velocity{ ball.GetLinearVelocity() };
+		hash = Combine(hash, Quantize(pos[0] / pos[3], ShotCache::POSITION_QUANTUM));
+		hash = Combine(hash, Quantize(pos[1] / pos[3], ShotCache::POSITION_QUANTUM));
+		// the lives
+		hash = Combine(hash, int32_t(std::lround(pos[2] / pos[3])));
+		hash = Combine(hash, Quantize(velocity.x, ShotCache::VELOCITY_QUANTUM));
+		hash = Combine(hash, Quantize(velocity.y, ShotCache::VELOCITY_QUANTUM));
+		return hash;
+	}
+
+	uint64_t HashKey(const ShotCache::Key& key)
+	{
+		return Combine(Combine(key.stateHash, key.shotX), key.shotY);
+	}
+}
+
+bool ShotCache::Key::operator==(const Key& other) const
+{
+	return stateHash == other.stateHash && shotX == other.shotX && shotY == other.shotY;
+}
+
+float ShotCache::Stats::GetHitRate() const
+{
+	const uint64_t numLookups{ numHits + numMisses };
+	return numLookups > 0 ? float(double(numHits) / numLookups) : 0.f;
+}
+
+size_t ShotCache::KeyHash::operator()(const Key& key) const
+{
+	return size_t(HashKey(key));
+}
+
+ShotCache::ShotCache(size_t capacity)
+	: m_shardCapacity{ std::max<size_t>(1, (capacity + NUM_SHARDS - 1) / NUM_SHARDS) }
+	, m_pShards{ std::make_unique<Shard[]>(NUM_SHARDS) }
+	, m_numHits{ 0 }
+	, m_numMisses{ 0 }
+	, m_numEvictions{ 0 }
+{
+}
+
+uint64_t ShotCache::HashState(const Table& table)
+{
+	uint64_t hash{ Combine(0, table.IsFirstShot()) };
+	hash = HashBall(hash, table.GetWhiteBall());
+	for (const Ball& ball : table.GetRedBalls())
+	{
+		hash = HashBall(hash, ball);
+	}
+	// two tables that only differ in the number of balls at the end still hash differently
+	return Combine(hash, int32_t(table.GetRedBalls().size()));
+}
+
+ShotCache::Key ShotCache::MakeKey(uint64_t stateHash, const Motor& shot)
+{
+	// the velocity a shot gives a resting ball, see Table::ApplyShot
+	return Key{ stateHash, Quantize(-2.f * shot[1], VELOCITY_QUANTUM), Quantize(-2.f * shot[2], VELOCITY_QUANTUM) };
+}
+
+std::shared_ptr<const ShotCache::Outcome> ShotCache::Find(const Key& key)
+{
+	Shard& shard{ GetShard(key) };
+	const std::lock_guard<std::mutex> lock{ shard.mutex };
+
+	const auto found{ shard.index.find(key) };
+	if (found == shard.index.end())
+	{
+		++m_numMisses;
+		return nullptr;
+	}
+
+	++m_numHits;
+	shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+	return found->second->second;
+}
+
+void ShotCache::Insert(const Key& key, std::shared_ptr<const Outcome> pOutcome)
+{
+	Shard& shard{ GetShard(key) };
+	const std::lock_guard<std::mutex> lock{ shard.mutex };
+
+	const auto found{ shard.index.find(key) };
+	if (found != shard.index.end())
+	{
+		// another thread simulated the same shot at the same time
+		found->second->second = std::move(pOutcome);
+		shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+		return;
+	}
+
+	if (shard.entries.size() >= m_shardCapacity)
+	{
+		shard.index.erase(shard.entries.back().first);
+		shard.entries.pop_back();
+		++m_numEvictions;
+	}
+
+	shard.entries.emplace_front(key, std::move(pOutcome));
+	shard.index.emplace(key, shard.entries.begin());
+}
+
+void ShotCache::Clear()
+{
+	for (size_t idx{}; idx < NUM_SHARDS; ++idx)
+	{
+		Shard& shard{ m_pShards[idx] };
+		const std::lock_guard<std::mutex> lock{ shard.mutex };
+		shard.index.clear();
+		shard.entries.clear();
+	}
+}
+
+ShotCache::Stats ShotCache::GetStats() const
+{
+	Stats stats{ m_numHits, m_numMisses, m_numEvictions, 0 };
+	for (size_t idx{}; idx < NUM_SHARDS; ++idx)
+	{
+		Shard& shard{ m_pShards[idx] };
+		const std::lock_guard<std::mutex> lock{ shard.mutex };
+		stats.numEntries += shard.entries.size();
+	}
+	return stats;
+}
+
+size_t ShotCache::GetCapacity() const
+{
+	return m_shardCapacity * NUM_SHARDS;
+}
+
+std::shared_ptr<const ShotCache::Outcome> ShotCache::CreateOutcome(const Table& table, int pointsBefore, const Table::Fouls& foulsBefore)
+{
+	std::vector<Ball> balls{};
+	balls.reserve(table.GetRedBalls().size() + 1);
+	balls.push_back(table.GetWhiteBall());
+	balls.insert(balls.end(), table.GetRedBalls().begin(), table.GetRedBalls().end());
+
+	const Table::Fouls& fouls{ table.GetFouls() };
+	return std::make_shared<const Outcome>(Outcome{ std::move(balls), table.GetPoints() - pointsBefore,
+		Table::Fouls{ fouls.whiteBallPocketed - foulsBefore.whiteBallPocketed, fouls.noBallHit - foulsBefore.noBallHit },
+		table.AreBallsRolling(), table.IsFirstShot(), table.HasHitBall() });
+}
+
+bool ShotCache::ApplyOutcome(const Outcome& outcome, Table& table, TableState& state)
+{
+	if (outcome.balls.size() > size_t(TableState::MAX_BALLS) + 1) return false;
+
+	const Table::Fouls& fouls{ table.GetFouls() };
+	state.numRedBalls = int(outcome.balls.size()) - 1;
+	state.points = table.GetPoints() + outcome.points;
+	state.whiteBallFouls = fouls.whiteBallPocketed + outcome.fouls.whiteBallPocketed;
+	state.noBallHitFouls = fouls.noBallHit + outcome.fouls.noBallHit;
+	state.ballsRolling = outcome.ballsRolling;
+	state.isFirstShot = outcome.isFirstShot;
+	state.hasHitBall = outcome.hasHitBall;
+
+	std::memcpy(state.whiteBall, outcome.balls.data(), sizeof(Ball));
+	std::memcpy(state.redBalls, outcome.balls.data() + 1, state.numRedBalls * sizeof(Ball));
+	table.Restore(state);
+	return true;
+}
+
+ShotCache::Shard& ShotCache::GetShard(const Key& key) const
+{
+	// the low bits pick the bucket inside the shard
+	return m_pShards[HashKey(key) >> (64 - SHARD_BITS)];
+}
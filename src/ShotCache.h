@@ -0,0 +1,114 @@
+#pragma once
+#include "FlyFish.h"
+#include "Ball.h"
+#include "Table.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct TableState;
+
+// Remembers where the balls ended up after a shot, so the same shot against the same table doesn't have to be simulated again.
+// A table is recognized by a hash of its balls with the positions and velocities rounded to a fine grid,
+// and a shot by its velocity rounded the same way, so a query only hits when the table and the aim are (practically) unchanged.
+// The outcomes depend on the cushions and pockets, so a cache belongs to one table layout.
+// Safe to use from several threads: the entries are spread over shards that each have their own lock,
+// and every shard drops its least recently used entry when it is full.
+class ShotCache final
+{
+public:
+	struct Key
+	{
+		uint64_t stateHash;
+		int32_t shotX;
+		int32_t shotY;
+
+		bool operator==(const Key& other) const;
+	};
+
+	// the table after the shot, relative to the table before it so it applies to any score
+	struct Outcome
+	{
+		// the white ball first, then the red balls that are left in their order
+		std::vector<Ball> balls;
+		// gained by the shot, fouls included
+		int points;
+		// fouls caused by the shot
+		Table::Fouls fouls;
+		bool ballsRolling;
+		bool isFirstShot;
+		bool hasHitBall;
+	};
+
+	struct Stats
+	{
+		uint64_t numHits;
+		uint64_t numMisses;
+		uint64_t numEvictions;
+		size_t numEntries;
+
+		// hits per lookup, 0 before the first lookup
+		float GetHitRate() const;
+	};
+
+	static constexpr size_t DEFAULT_CAPACITY{ 4096 };
+	// in units and units per second, far below anything a player can see or aim
+	static constexpr float POSITION_QUANTUM{ 1.f / 64.f };
+	static constexpr float VELOCITY_QUANTUM{ 1.f / 16.f };
+
+	explicit ShotCache(size_t capacity = DEFAULT_CAPACITY);
+	ShotCache(const ShotCache& other) = delete;
+	ShotCache& operator=(const ShotCache& other) = delete;
+	ShotCache(ShotCache&& other) = delete;
+	ShotCache& operator=(ShotCache&& other) = delete;
+
+	// content hash of the balls, their lives and whether it is the first shot, the score is left out
+	static uint64_t HashState(const Table& table);
+	static Key MakeKey(uint64_t stateHash, const Motor& shot);
+
+	// nullptr when the shot isn't cached, a hit becomes the most recently used entry
+	std::shared_ptr<const Outcome> Find(const Key& key);
+	// replaces an entry with the same key
+	void Insert(const Key& key, std::shared_ptr<const Outcome> pOutcome);
+	void Clear();
+
+	Stats GetStats() const;
+	size_t GetCapacity() const;
+
+	// what the shot did to the table, given the points and fouls from before the shot
+	static std::shared_ptr<const Outcome> CreateOutcome(const Table& table, int pointsBefore, const Table::Fouls& foulsBefore);
+	// puts the table in the state after the shot, state is the scratch buffer for Table::Restore so nothing is allocated.
+	// Returns false and leaves the table alone when the outcome has more red balls than a TableState holds
+	static bool ApplyOutcome(const Outcome& outcome, Table& table, TableState& state);
+
+private:
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const;
+	};
+
+	struct Shard
+	{
+		std::mutex mutex;
+		// most recently used first
+		std::list<std::pair<Key, std::shared_ptr<const Outcome>>> entries;
+		std::unordered_map<Key, std::list<std::pair<Key, std::shared_ptr<const Outcome>>>::iterator, KeyHash> index;
+	};
+
+	// the top bits of the key hash pick the shard, enough shards that the planner's threads rarely wait for each other
+	static constexpr int SHARD_BITS{ 4 };
+	static constexpr size_t NUM_SHARDS{ size_t(1) << SHARD_BITS };
+
+	const size_t m_shardCapacity;
+	std::unique_ptr<Shard[]> m_pShards;
+	std::atomic<uint64_t> m_numHits;
+	std::atomic<uint64_t> m_numMisses;
+	std::atomic<uint64_t> m_numEvictions;
+
+	Shard& GetShard(const Key& key) const;
+};
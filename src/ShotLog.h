@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+// Binary shot log format, all values are stored in the byte order of the machine (little endian on our targets)
+//
+// header:   "GSHL", u16 version, u16 reserved
+// table:    f32 play area (left, bottom, width, height),
+//           u16 cushion outline count, every outline as u8 closed, u16 point count, f32 x, y per point,
+//           u16 pocket count, f32 x, y per pocket, f32 white ball start x, y (only since version 2),
+//           i32 points, u8 flags,
+//           u16 red ball count, then every red ball followed by the white ball as f32 position[4] and f32 velocity[8]
+// records:  u8 type followed by its payload
+//           Steps: varint count, f32 elapsed seconds (a run of equal time steps)
+//           Shot:  f32 motor[8]
+//           End:   i32 points, u16 red ball count, then every red ball followed by the white ball as f32 x, y, lives
+namespace ShotLog
+{
+	constexpr char MAGIC[4]{ 'G', 'S', 'H', 'L' };
+	constexpr uint16_t VERSION{ 2 };
+	// version 1 logs were all played on the default table
+	constexpr uint16_t MIN_VERSION{ 1 };
+
+	enum class RecordType : uint8_t
+	{
+		Steps = 1,
+		Shot = 2,
+		End = 3
+	};
+
+	enum Flags : uint8_t
+	{
+		FIRST_SHOT = 1 << 0,
+		BALLS_ROLLING = 1 << 1,
+		HAS_HIT_BALL = 1 << 2
+	};
+
+	template <typename T>
+	inline void Write(std::ostream& stream, const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	inline bool Read(std::istream& stream, T& value)
+	{
+		return bool(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+
+	// LEB128, 7 bits per byte
+	inline void WriteVarint(std::ostream& stream, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			stream.put(char((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		stream.put(char(value));
+	}
+
+	inline bool ReadVarint(std::istream& stream, uint64_t& value)
+	{
+		value = 0;
+		for (int shift{}; shift < 64; shift += 7)
+		{
+			const int byte{ stream.get() };
+			if (byte == std::istream::traits_type::eof()) return false;
+
+			value |= uint64_t(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) return true;
+		}
+		return false;
+	}
+}
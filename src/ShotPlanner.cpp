@@ -0,0 +1,321 @@
+#include "ShotPlanner.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include "Ball.h"
+#include "Cue.h"
+#include "Hole.h"
+#include "Log.h"
+#include "Table.h"
+#include "TableLayout.h"
+#include "TableState.h"
+
+ShotPlanner::ShotPlanner(const Table& table, const Settings& settings)
+	: m_settings{ settings }
+	, m_rootCandidates{}
+	, m_pRootState{ std::make_unique<TableState>() }
+	, m_pCache{ settings.cacheCapacity > 0 ? std::make_unique<ShotCache>(settings.cacheCapacity) : nullptr }
+	, m_workers{}
+	, m_random{ settings.seed }
+	, m_deadline{}
+	, m_numSearching{ 0 }
+	, m_isRunning{ false }
+	, m_pool{ settings.numThreads }
+{
+	// the balls are replaced by Restore before every search, the tables only need the cushions, the pockets and where the white ball goes back to
+	TableLayout layout{};
+	layout.name = "planner";
+	layout.playArea = table.GetPlayArea();
+	layout.cushions = table.GetCushions().GetOutlines();
+	for (const Hole& hole : table.GetHoles())
+	{
+		layout.pockets.push_back(Point2f{ hole.GetPos()[0] / hole.GetPos()[3], hole.GetPos()[1] / hole.GetPos()[3] });
+	}
+	layout.balls.push_back(TableLayout::BallSetup{ table.GetWhiteBallStart(), Point2f{ 0.f, 0.f }, Ball::TOT_LIVES, true });
+
+	m_workers.resize(m_pool.GetNumThreads());
+	for (Worker& worker : m_workers)
+	{
+		worker.pTable = std::make_unique<Table>(layout);
+		worker.pState = std::make_unique<TableState>();
+	}
+}
+
+ShotPlanner::~ShotPlanner()
+{
+	m_pool.Wait();
+}
+
+bool ShotPlanner::Start(const Table& table)
+{
+	if (m_isRunning) return false;
+	if (!table.Snapshot(*m_pRootState))
+	{
+		Log::Error("ShotPlanner::Start( ), the planner can't search a table with more than ", TableState::MAX_BALLS, " red balls");
+		return false;
+	}
+	m_deadline = std::chrono::steady_clock::now() + m_settings.deadline;
+
+	m_rootCandidates.clear();
+	AddCandidates(table, m_settings.numCandidates, m_random, m_rootCandidates);
+
+	m_isRunning = true;
+	m_numSearching = int(m_workers.size());
+	for (Worker& worker : m_workers)
+	{
+		worker.random.seed(m_random());
+		m_pool.Submit([this, &worker]()
+			{
+				Search(worker);
+				--m_numSearching;
+			});
+	}
+	return true;
+}
+
+bool ShotPlanner::IsRunning() const
+{
+	return m_isRunning;
+}
+
+bool ShotPlanner::Poll(Result& result)
+{
+	if (!m_isRunning || m_numSearching > 0) return false;
+
+	result = MergeTrees();
+	m_isRunning = false;
+	return true;
+}
+
+ShotPlanner::Result ShotPlanner::Plan(const Table& table)
+{
+	Result result{};
+	result.shot = Motor{ 1, 0, 0, 0, 0, 0, 0, 0 };
+	if (!Start(table)) return result;
+
+	m_pool.Wait();
+	Poll(result);
+	return result;
+}
+
+const ShotPlanner::Settings& ShotPlanner::GetSettings() const
+{
+	return m_settings;
+}
+
+ShotCache::Stats ShotPlanner::GetCacheStats() const
+{
+	return m_pCache ? m_pCache->GetStats() : ShotCache::Stats{};
+}
+
+void ShotPlanner::Search(Worker& worker)
+{
+	// node 0 is the root, its children are the shared candidates
+	worker.nodes.clear();
+	worker.nodes.push_back(Node{ Motor{ 1, 0, 0, 0, 0, 0, 0, 0 }, 1, int(m_rootCandidates.size()), 0, 0.0 });
+	for (const Motor& shot : m_rootCandidates)
+	{
+		worker.nodes.push_back(Node{ shot, 0, 0, 0, 0.0 });
+	}
+	worker.isConverged = false;
+	worker.numIterations = 0;
+	worker.numSimulatedShots = 0;
+	worker.numCachedShots = 0;
+
+	while (std::chrono::steady_clock::now() < m_deadline && RunIteration(worker) && !worker.isConverged)
+	{
+		++worker.numIterations;
+	}
+}
+
+bool ShotPlanner::RunIteration(Worker& worker)
+{
+	Table& table{ *worker.pTable };
+	table.Restore(*m_pRootState);
+	const int startPoints{ table.GetPoints() };
+
+	// selection: follow the most promising shots through the part of the tree that is already built
+	worker.path.clear();
+	worker.path.push_back(0);
+	int depth{};
+	while (depth < m_settings.depth)
+	{
+		const int nodeIdx{ worker.path.back() };
+		if (worker.nodes[nodeIdx].numChildren == 0)
+		{
+			// a node gets its shots the second time the search reaches it, so the tree only grows where the search comes back
+			if (worker.nodes[nodeIdx].numVisits == 0) break;
+
+			worker.candidates.clear();
+			AddCandidates(table, m_settings.numCandidates, worker.random, worker.candidates);
+			worker.nodes[nodeIdx].firstChild = int(worker.nodes.size());
+			worker.nodes[nodeIdx].numChildren = int(worker.candidates.size());
+			for (const Motor& shot : worker.candidates)
+			{
+				worker.nodes.push_back(Node{ shot, 0, 0, 0, 0.0 });
+			}
+		}
+
+		const int childIdx{ SelectChild(worker, worker.nodes[nodeIdx]) };
+		if (!SimulateShot(worker, worker.nodes[childIdx].shot)) return false;
+		worker.path.push_back(childIdx);
+		++depth;
+	}
+
+	// rollout: random shots for the rest of the depth
+	while (depth < m_settings.depth)
+	{
+		worker.candidates.clear();
+		AddCandidates(table, 1, worker.random, worker.candidates);
+		if (!SimulateShot(worker, worker.candidates.front())) return false;
+		++depth;
+	}
+
+	// a sequence that ends in a shot played before adds nothing, the tree and so the next selection stay the same
+	if (int(worker.path.size()) == m_settings.depth + 1 && worker.nodes[worker.path.back()].numVisits > 0)
+	{
+		worker.isConverged = true;
+		return true;
+	}
+
+	// the points the whole sequence gained, fouls cost points so they are part of it
+	const double points{ double(table.GetPoints() - startPoints) };
+	for (int nodeIdx : worker.path)
+	{
+		++worker.nodes[nodeIdx].numVisits;
+		worker.nodes[nodeIdx].totalPoints += points;
+	}
+	return true;
+}
+
+bool ShotPlanner::SimulateShot(Worker& worker, const Motor& shot)
+{
+	Table& table{ *worker.pTable };
+
+	// every search replays the shots of the tree from the same table, so most shots outside the rollouts were seen before
+	ShotCache::Key key{};
+	if (m_pCache)
+	{
+		key = ShotCache::MakeKey(ShotCache::HashState(table), shot);
+		const std::shared_ptr<const ShotCache::Outcome> pOutcome{ m_pCache->Find(key) };
+		if (pOutcome && ShotCache::ApplyOutcome(*pOutcome, table, *worker.pState))
+		{
+			++worker.numCachedShots;
+			return true;
+		}
+	}
+
+	++worker.numSimulatedShots;
+	const int pointsBefore{ table.GetPoints() };
+	const Table::Fouls foulsBefore{ table.GetFouls() };
+	table.ApplyShot(shot);
+
+	const int maxSteps{ int(m_settings.maxShotSeconds / m_settings.stepSeconds) };
+	for (int step{}; step < maxSteps && table.AreBallsRolling(); ++step)
+	{
+		// reading the clock costs about as much as a step on a small table, so it is only read now and then
+		if (step % 16 == 0 && std::chrono::steady_clock::now() >= m_deadline) return false;
+		table.Update(m_settings.stepSeconds);
+	}
+
+	if (m_pCache) m_pCache->Insert(key, ShotCache::CreateOutcome(table, pointsBefore, foulsBefore));
+	return true;
+}
+
+void ShotPlanner::AddCandidates(const Table& table, int numCandidates, std::mt19937& random, std::vector<Motor>& candidates) const
+{
+	const ThreeBlade& whitePos{ table.GetWhiteBall().GetPos() };
+	const Point2f white{ whitePos[0] / whitePos[3], whitePos[1] / whitePos[3] };
+	const std::vector<Ball>& redBalls{ table.GetRedBalls() };
+	const std::vector<Hole>& holes{ table.GetHoles() };
+
+	std::uniform_int_distribution<int> kind{ 0, 3 };
+	std::uniform_real_distribution<float> jitter{ -0.02f, 0.02f };
+	std::uniform_real_distribution<float> angle{ 0.f, 2.f * float(M_PI) };
+	std::uniform_real_distribution<float> force{ 0.25f * Cue::MAX_FORCE, Cue::MAX_FORCE };
+	for (int idx{}; idx < numCandidates; ++idx)
+	{
+		float shotAngle{ angle(random) };
+		const int shotKind{ redBalls.empty() ? 3 : kind(random) };
+		if (shotKind < 3)
+		{
+			const ThreeBlade& redPos{ redBalls[std::uniform_int_distribution<size_t>{ 0, redBalls.size() - 1 }(random)].GetPos() };
+			Point2f target{ redPos[0] / redPos[3], redPos[1] / redPos[3] };
+
+			// half of the shots try to pot the ball: aim at the ghost ball, where the white ball has to be
+			// when it touches the red ball to send it straight to a pocket
+			if (shotKind < 2 && !holes.empty())
+			{
+				const ThreeBlade& pocketPos{ holes[std::uniform_int_distribution<size_t>{ 0, holes.size() - 1 }(random)].GetPos() };
+				const float toPocketX{ pocketPos[0] / pocketPos[3] - target.x };
+				const float toPocketY{ pocketPos[1] / pocketPos[3] - target.y };
+				const float toPocketLength{ std::sqrt(toPocketX * toPocketX + toPocketY * toPocketY) };
+				if (toPocketLength > 0.f)
+				{
+					target.x -= toPocketX / toPocketLength * Ball::SIZE;
+					target.y -= toPocketY / toPocketLength * Ball::SIZE;
+				}
+			}
+			shotAngle = std::atan2(target.y - white.y, target.x - white.x) + jitter(random);
+		}
+
+		candidates.push_back(Cue::CreateShot(shotAngle, force(random)));
+	}
+}
+
+int ShotPlanner::SelectChild(const Worker& worker, const Node& node) const
+{
+	// UCB1: every shot is tried once, then the average points plus a bonus for shots that were tried less often
+	const float logVisits{ std::log(float(std::max(node.numVisits, 1))) };
+	int bestIdx{ node.firstChild };
+	float bestScore{ -FLT_MAX };
+	for (int childIdx{ node.firstChild }; childIdx < node.firstChild + node.numChildren; ++childIdx)
+	{
+		const Node& child{ worker.nodes[childIdx] };
+		if (child.numVisits == 0) return childIdx;
+
+		const float score{ float(child.totalPoints / child.numVisits) + m_settings.exploration * std::sqrt(logVisits / child.numVisits) };
+		if (score > bestScore)
+		{
+			bestScore = score;
+			bestIdx = childIdx;
+		}
+	}
+	return bestIdx;
+}
+
+ShotPlanner::Result ShotPlanner::MergeTrees() const
+{
+	// add up the first shots of all trees, they are the same candidates in the same order
+	std::vector<int> numVisits(m_rootCandidates.size());
+	std::vector<double> totalPoints(m_rootCandidates.size());
+	Result result{};
+	for (const Worker& worker : m_workers)
+	{
+		const Node& root{ worker.nodes.front() };
+		for (int idx{}; idx < root.numChildren; ++idx)
+		{
+			numVisits[idx] += worker.nodes[root.firstChild + idx].numVisits;
+			totalPoints[idx] += worker.nodes[root.firstChild + idx].totalPoints;
+		}
+		result.numIterations += worker.numIterations;
+		result.numSimulatedShots += worker.numSimulatedShots;
+		result.numCachedShots += worker.numCachedShots;
+	}
+
+	// the most tried shot is the most reliable one, the average breaks ties
+	size_t bestIdx{};
+	for (size_t idx{ 1 }; idx < numVisits.size(); ++idx)
+	{
+		const bool isMoreVisited{ numVisits[idx] > numVisits[bestIdx] };
+		const bool isBetterTie{ numVisits[idx] == numVisits[bestIdx] && numVisits[idx] > 0
+			&& totalPoints[idx] / numVisits[idx] > totalPoints[bestIdx] / numVisits[bestIdx] };
+		if (isMoreVisited || isBetterTie) bestIdx = idx;
+	}
+
+	result.isFound = !numVisits.empty() && numVisits[bestIdx] > 0;
+	result.shot = m_rootCandidates.empty() ? Motor{ 1, 0, 0, 0, 0, 0, 0, 0 } : m_rootCandidates[bestIdx];
+	result.numVisits = numVisits.empty() ? 0 : numVisits[bestIdx];
+	result.expectedPoints = result.numVisits > 0 ? float(totalPoints[bestIdx] / result.numVisits) : 0.f;
+	return result;
+}
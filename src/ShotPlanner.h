@@ -0,0 +1,137 @@
+#pragma once
+#include "FlyFish.h"
+#include "ShotCache.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+class Table;
+struct TableState;
+
+// Computer player: finds a good shot for the current table with a Monte Carlo tree search.
+// Every shot is a cue angle and force (see Cue::CreateShot), sampled around the white ball: aimed to pot a red ball,
+// straight at a red ball or in a random direction. A shot is tried by simulating it on a private copy of the table
+// until the balls stop, and a sequence of Settings::depth shots is scored with the points the table gives, fouls included.
+// Every thread of the pool searches its own tree from the same candidate first shots (root parallelization),
+// and the first shot tried most often over all trees wins. The search stops at the deadline, so it always answers in time
+// and tries more shots on more cores. Simulating is deterministic, so a tree stops earlier once the most promising
+// sequence consists of shots it already played: that iteration isn't counted, the next ones would be the same.
+class ShotPlanner final
+{
+public:
+	struct Settings
+	{
+		// the search returns its best shot this long after Start
+		std::chrono::milliseconds deadline{ 1000 };
+		// 0 uses every core
+		int numThreads{ 0 };
+		// shots looked ahead, the first one is played
+		int depth{ 2 };
+		// shots tried from every position
+		int numCandidates{ 16 };
+		// UCB1 exploration constant, in points
+		float exploration{ 10.f };
+		// the game's step, so the first shot plays out in the game like it did in the search,
+		// a coarser step searches more shots but the balls end up somewhere else and the plans score about half
+		float stepSeconds{ 1.f / 240.f };
+		// the search stops following a shot after this long, the balls are slow by then and the next shot starts
+		float maxShotSeconds{ 8.f };
+		uint32_t seed{ 1 };
+		// shot outcomes remembered between searches and threads (see ShotCache), 0 simulates every shot
+		size_t cacheCapacity{ ShotCache::DEFAULT_CAPACITY };
+	};
+
+	struct Result
+	{
+		// false when the deadline passed before any shot was simulated, shot is then an untried candidate
+		bool isFound;
+		Motor shot;
+		// average points of the shot sequences that started with this shot
+		float expectedPoints;
+		// shot sequences that started with this shot, and all shot sequences over all threads
+		int numVisits;
+		int numIterations;
+		// single shots simulated over all threads, and the ones answered from the cache instead
+		int numSimulatedShots;
+		int numCachedShots;
+	};
+
+	// the planner simulates on copies of this table, with the same cushions and pockets
+	ShotPlanner(const Table& table, const Settings& settings);
+	ShotPlanner(const ShotPlanner& other) = delete;
+	ShotPlanner& operator=(const ShotPlanner& other) = delete;
+	ShotPlanner(ShotPlanner&& other) = delete;
+	ShotPlanner& operator=(ShotPlanner&& other) = delete;
+	// waits for a running search
+	~ShotPlanner();
+
+	// starts searching from the current state of the table on the thread pool and returns right away,
+	// returns false when a search is still running or the table has more balls than a TableState holds
+	bool Start(const Table& table);
+	bool IsRunning() const;
+	// returns true once the search that was started is done, result then holds the best shot
+	bool Poll(Result& result);
+	// Start and wait for the result
+	Result Plan(const Table& table);
+
+	const Settings& GetSettings() const;
+	// all zero without a cache
+	ShotCache::Stats GetCacheStats() const;
+
+private:
+	struct Node
+	{
+		Motor shot;
+		int firstChild;
+		// 0 until the node is expanded
+		int numChildren;
+		int numVisits;
+		double totalPoints;
+	};
+
+	struct Worker
+	{
+		std::unique_ptr<Table> pTable;
+		// scratch for restoring cached outcomes
+		std::unique_ptr<TableState> pState;
+		std::mt19937 random;
+		std::vector<Node> nodes;
+		// indices of the nodes from the root to the node that is expanded
+		std::vector<int> path;
+		std::vector<Motor> candidates;
+		// set when an iteration only followed shots that were played before, the tree doesn't change then,
+		// so every iteration after it would replay the same sequence
+		bool isConverged;
+		int numIterations;
+		int numSimulatedShots;
+		int numCachedShots;
+	};
+
+	Settings m_settings;
+	// the first shots every tree starts from, so the trees can be merged
+	std::vector<Motor> m_rootCandidates;
+	std::unique_ptr<TableState> m_pRootState;
+	// nullptr when Settings::cacheCapacity is 0
+	std::unique_ptr<ShotCache> m_pCache;
+	std::vector<Worker> m_workers;
+	std::mt19937 m_random;
+	std::chrono::steady_clock::time_point m_deadline;
+	std::atomic<int> m_numSearching;
+	bool m_isRunning;
+	// declared last so its threads are stopped before the workers they use are destroyed
+	ThreadPool m_pool;
+
+	void Search(Worker& worker);
+	// returns false when the deadline passed during the iteration, it then doesn't count
+	bool RunIteration(Worker& worker);
+	// applies the shot and steps until the balls stop, or takes the outcome from the cache,
+	// returns false when the deadline passed first
+	bool SimulateShot(Worker& worker, const Motor& shot);
+	void AddCandidates(const Table& table, int numCandidates, std::mt19937& random, std::vector<Motor>& candidates) const;
+	int SelectChild(const Worker& worker, const Node& node) const;
+	Result MergeTrees() const;
+};
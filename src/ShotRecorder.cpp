@@ -0,0 +1,155 @@
+#include "ShotRecorder.h"
+#include <cstdint>
+#include <iostream>
+#include "Ball.h"
+#include "Hole.h"
+#include "Log.h"
+#include "ShotLog.h"
+#include "Table.h"
+
+namespace
+{
+	void WriteBallState(std::ostream& stream, const Ball& ball)
+	{
+		for (float value : ball.GetPos()) ShotLog::Write(stream, value);
+		for (float value : ball.GetVelocity()) ShotLog::Write(stream, value);
+	}
+
+	void WriteBallPosition(std::ostream& stream, const Ball& ball)
+	{
+		const ThreeBlade& pos{ ball.GetPos() };
+		ShotLog::Write(stream, pos[0]);
+		ShotLog::Write(stream, pos[1]);
+		ShotLog::Write(stream, pos[2]);
+	}
+}
+
+ShotRecorder::ShotRecorder(const std::string& path, const Table& table)
+	: m_file{ path, std::ios::binary }
+	, m_runElapsedSec{ 0.f }
+	, m_runLength{ 0 }
+	, m_isFinished{ false }
+{
+	if (!m_file)
+	{
+		Log::Error("ShotRecorder::ShotRecorder( ), unable to open ", path);
+		return;
+	}
+
+	// the log counts the balls in 16 bits
+	if (table.GetRedBalls().size() > UINT16_MAX)
+	{
+		Log::Error("ShotRecorder::ShotRecorder( ), a shot log can't hold more than ", UINT16_MAX, " red balls");
+		m_file.setstate(std::ios::failbit);
+		return;
+	}
+
+	// header
+	m_file.write(ShotLog::MAGIC, sizeof(ShotLog::MAGIC));
+	ShotLog::Write(m_file, ShotLog::VERSION);
+	ShotLog::Write(m_file, uint16_t{ 0 });
+
+	// initial table state
+	const Rectf& playArea{ table.GetPlayArea() };
+	ShotLog::Write(m_file, playArea.left);
+	ShotLog::Write(m_file, playArea.bottom);
+	ShotLog::Write(m_file, playArea.width);
+	ShotLog::Write(m_file, playArea.height);
+
+	const std::vector<CushionSet::Outline>& cushions{ table.GetCushions().GetOutlines() };
+	ShotLog::Write(m_file, uint16_t(cushions.size()));
+	for (const CushionSet::Outline& cushion : cushions)
+	{
+		ShotLog::Write(m_file, uint8_t(cushion.isClosed));
+		ShotLog::Write(m_file, uint16_t(cushion.points.size()));
+		for (const Point2f& point : cushion.points)
+		{
+			ShotLog::Write(m_file, point.x);
+			ShotLog::Write(m_file, point.y);
+		}
+	}
+
+	ShotLog::Write(m_file, uint16_t(table.GetHoles().size()));
+	for (const Hole& hole : table.GetHoles())
+	{
+		ShotLog::Write(m_file, hole.GetPos()[0] / hole.GetPos()[3]);
+		ShotLog::Write(m_file, hole.GetPos()[1] / hole.GetPos()[3]);
+	}
+	ShotLog::Write(m_file, table.GetWhiteBallStart().x);
+	ShotLog::Write(m_file, table.GetWhiteBallStart().y);
+
+	ShotLog::Write(m_file, int32_t(table.GetPoints()));
+
+	uint8_t flags{};
+	if (table.IsFirstShot()) flags |= ShotLog::FIRST_SHOT;
+	if (table.AreBallsRolling()) flags |= ShotLog::BALLS_ROLLING;
+	if (table.HasHitBall()) flags |= ShotLog::HAS_HIT_BALL;
+	ShotLog::Write(m_file, flags);
+
+	ShotLog::Write(m_file, uint16_t(table.GetRedBalls().size()));
+	for (const Ball& ball : table.GetRedBalls())
+	{
+		WriteBallState(m_file, ball);
+	}
+	WriteBallState(m_file, table.GetWhiteBall());
+}
+
+ShotRecorder::~ShotRecorder()
+{
+	// a log without an end record can still be replayed, it just can't be verified
+	FlushSteps();
+}
+
+bool ShotRecorder::IsOk() const
+{
+	return bool(m_file);
+}
+
+void ShotRecorder::RecordStep(float elapsedSec)
+{
+	if (m_isFinished) return;
+
+	if (m_runLength > 0 && elapsedSec != m_runElapsedSec)
+	{
+		FlushSteps();
+	}
+	m_runElapsedSec = elapsedSec;
+	++m_runLength;
+}
+
+void ShotRecorder::RecordShot(const Motor& shot)
+{
+	if (m_isFinished) return;
+
+	FlushSteps();
+	ShotLog::Write(m_file, ShotLog::RecordType::Shot);
+	for (float value : shot) ShotLog::Write(m_file, value);
+}
+
+void ShotRecorder::Finish(const Table& table)
+{
+	if (m_isFinished) return;
+
+	FlushSteps();
+	ShotLog::Write(m_file, ShotLog::RecordType::End);
+	ShotLog::Write(m_file, int32_t(table.GetPoints()));
+	ShotLog::Write(m_file, uint16_t(table.GetRedBalls().size()));
+	for (const Ball& ball : table.GetRedBalls())
+	{
+		WriteBallPosition(m_file, ball);
+	}
+	WriteBallPosition(m_file, table.GetWhiteBall());
+
+	m_file.flush();
+	m_isFinished = true;
+}
+
+void ShotRecorder::FlushSteps()
+{
+	if (m_runLength == 0) return;
+
+	ShotLog::Write(m_file, ShotLog::RecordType::Steps);
+	ShotLog::WriteVarint(m_file, m_runLength);
+	ShotLog::Write(m_file, m_runElapsedSec);
+	m_runLength = 0;
+}
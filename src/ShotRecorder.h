@@ -0,0 +1,35 @@
+#pragma once
+#include "FlyFish.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+class Table;
+
+// Writes the initial table state, every time step and every shot of a game to a binary shot log (see ShotLog.h)
+class ShotRecorder final
+{
+public:
+	explicit ShotRecorder(const std::string& path, const Table& table);
+	ShotRecorder(const ShotRecorder& other) = delete;
+	ShotRecorder& operator=(const ShotRecorder& other) = delete;
+	~ShotRecorder();
+
+	bool IsOk() const;
+
+	void RecordStep(float elapsedSec);
+	void RecordShot(const Motor& shot);
+	// write the final positions, so a replay can verify it ends up in the same state
+	void Finish(const Table& table);
+
+private:
+	std::ofstream m_file;
+
+	// equal time steps are collected into one record
+	float m_runElapsedSec;
+	uint64_t m_runLength;
+
+	bool m_isFinished;
+
+	void FlushSteps();
+};
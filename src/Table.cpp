@@ -0,0 +1,426 @@
+#include "Table.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "Ball.h"
+#include "FrameArena.h"
+#include "Hole.h"
+#include "ShotRecorder.h"
+#include "TableLayout.h"
+#include "TableState.h"
+
+namespace
+{
+	float GetSpeed(const Ball& ball)
+	{
+		const Point2f velocity{ ball.GetLinearVelocity() };
+		return std::hypot(velocity.x, velocity.y);
+	}
+}
+
+Table::Table(const Rectf& playArea)
+	: Table{ TableLayout::CreateDefault(playArea) }
+{
+}
+
+Table::Table(const TableLayout& layout)
+	: m_playArea{ layout.playArea }
+	, m_cushions{ layout.cushions }
+	, m_whiteBall{ ThreeBlade{}, Motor{}, true }
+	, m_whiteBallStart{}
+	, m_points{ 0 }
+	, m_fouls{}
+	, m_ballsRolling{ false }
+	, m_isFirstShot{ true }
+	, m_hasHitBall{ false }
+	, m_revision{ 0 }
+	, m_pRecorder{ nullptr }
+	, m_contactSolver{}
+	, m_contactStats{}
+	, m_integrator{ Ball::Integrator::Euler }
+{
+	m_holes.reserve(layout.pockets.size());
+	for (const Point2f& pocket : layout.pockets)
+	{
+		m_holes.push_back(Hole{ ThreeBlade{ pocket.x, pocket.y, 0, 1 } });
+	}
+
+	SetupBalls(layout);
+}
+
+Table::~Table() = default;
+
+void Table::Update(float elapsedSec)
+{
+	if (m_pRecorder) m_pRecorder->RecordStep(elapsedSec);
+
+	// resting balls stay where they are, so only a step with rolling balls changes the table
+	if (m_ballsRolling) ++m_revision;
+
+	// a large step could carry a ball through a cushion, past a pocket or through another ball, so the integrators meant for
+	// large steps split the whole step until no ball moves more than its radius at a time. Euler keeps its single step so
+	// recorded shots replay the same
+	int numSubSteps{ 1 };
+	if (m_integrator != Ball::Integrator::Euler)
+	{
+		float maxSpeed{ GetSpeed(m_whiteBall) };
+		for (const Ball& ball : m_redBalls)
+		{
+			maxSpeed = std::max(maxSpeed, GetSpeed(ball));
+		}
+		numSubSteps = std::max(int(std::ceil(maxSpeed * elapsedSec / (Ball::SIZE / 2))), 1);
+	}
+
+	m_contactStats = ContactSolver::Stats{};
+	const float subStepSec{ elapsedSec / numSubSteps };
+	for (int idx{}; idx < numSubSteps; ++idx)
+	{
+		Step(subStepSec);
+	}
+}
+
+void Table::Step(float elapsedSec)
+{
+	// scratch lists of this step live in the arena, everything from the previous step is dropped at once
+	FrameArena& arena{ FrameArena::GetThreadArena() };
+	arena.Reset();
+
+	// update white ball
+	m_whiteBall.Update(elapsedSec, &m_cushions, m_isFirstShot, m_integrator);
+
+	// update red balls, a table without them still checks the pockets and whether the white ball stopped
+	for (Ball& particle : m_redBalls)
+	{
+		particle.Update(elapsedSec, &m_cushions, m_isFirstShot, m_integrator);
+	}
+
+	// solve the collisions between all balls at once
+	ArenaVector<Ball*> balls{ ArenaAllocator<Ball*>{ arena } };
+	balls.reserve(m_redBalls.size() + 1);
+	balls.push_back(&m_whiteBall);
+	for (Ball& ball : m_redBalls)
+	{
+		balls.push_back(&ball);
+	}
+
+	ArenaVector<ContactSolver::ContactEvent> contactEvents{ ArenaAllocator<ContactSolver::ContactEvent>{ arena } };
+	m_contactSolver.Solve(balls.data(), int(balls.size()), elapsedSec, contactEvents);
+	AddContactStats(m_contactSolver.GetStats());
+	for (const ContactSolver::ContactEvent& contactEvent : contactEvents)
+	{
+		OnBallsTouched(*balls[contactEvent.first], *balls[contactEvent.second]);
+	}
+
+	// collect the red balls that fell into a hole
+	ArenaVector<int> pocketed{ ArenaAllocator<int>{ arena } };
+	for (int idx{}; idx < m_redBalls.size(); ++idx)
+	{
+		if (FallsInHole(m_redBalls[idx])) pocketed.push_back(idx);
+	}
+
+	if (!pocketed.empty())
+	{
+		// count the points of all pocketed balls
+		for (int idx : pocketed)
+		{
+			AddPoints(m_redBalls[idx].GetPoints());
+		}
+
+		// remove them, keeping the order of the other balls
+		size_t pocketedIdx{};
+		size_t keptCount{};
+		for (int idx{}; idx < m_redBalls.size(); ++idx)
+		{
+			if (pocketedIdx < pocketed.size() && pocketed[pocketedIdx] == idx)
+			{
+				++pocketedIdx;
+				continue;
+			}
+			m_redBalls[keptCount++] = m_redBalls[idx];
+		}
+		m_redBalls.erase(m_redBalls.begin() + keptCount, m_redBalls.end());
+	}
+
+	// if the white ball fals into a hole, it gets reset back to its starting position
+	if (FallsInHole(m_whiteBall))
+	{
+		ResetWhiteBall();
+		AddPoints(-5);
+		++m_fouls.whiteBallPocketed;
+	}
+
+	if (m_ballsRolling)
+	{
+		// check if there are no longer balls rolling and the cue can appear again
+		CheckBallsRolling();
+	}
+}
+
+void Table::ApplyShot(const Motor& shot)
+{
+	if (m_pRecorder) m_pRecorder->RecordShot(shot);
+
+	m_whiteBall.ApplyForce(shot);
+
+	m_ballsRolling = true;
+	m_hasHitBall = false;
+	++m_revision;
+}
+
+void Table::SetState(const std::vector<Ball>& redBalls, const Ball& whiteBall, int points, bool isFirstShot, bool ballsRolling, bool hasHitBall)
+{
+	m_redBalls = redBalls;
+	m_whiteBall = whiteBall;
+	m_points = points;
+	m_fouls = Fouls{};
+	m_isFirstShot = isFirstShot;
+	m_ballsRolling = ballsRolling;
+	m_hasHitBall = hasHitBall;
+	++m_revision;
+
+	AssignIds();
+	m_contactSolver.ClearCache();
+}
+
+bool Table::Snapshot(TableState& state) const
+{
+	if (m_redBalls.size() > TableState::MAX_BALLS) return false;
+
+	state.numRedBalls = int(m_redBalls.size());
+	state.points = m_points;
+	state.whiteBallFouls = m_fouls.whiteBallPocketed;
+	state.noBallHitFouls = m_fouls.noBallHit;
+	state.ballsRolling = m_ballsRolling;
+	state.isFirstShot = m_isFirstShot;
+	state.hasHitBall = m_hasHitBall;
+
+	std::memcpy(state.whiteBall, &m_whiteBall, sizeof(Ball));
+	std::memcpy(state.redBalls, m_redBalls.data(), state.numRedBalls * sizeof(Ball));
+	return true;
+}
+
+void Table::Restore(const TableState& state)
+{
+	// shrinking or growing within the capacity doesn't allocate
+	m_redBalls.resize(state.numRedBalls, m_whiteBall);
+	std::memcpy(m_redBalls.data(), state.redBalls, state.numRedBalls * sizeof(Ball));
+	std::memcpy(&m_whiteBall, state.whiteBall, sizeof(Ball));
+
+	m_points = state.points;
+	m_fouls = Fouls{ state.whiteBallFouls, state.noBallHitFouls };
+	m_ballsRolling = state.ballsRolling;
+	m_isFirstShot = state.isFirstShot;
+	m_hasHitBall = state.hasHitBall;
+	++m_revision;
+
+	// the cached impulses belong to the state the table was in before
+	m_contactSolver.ClearCache();
+}
+
+bool Table::AreBallsRolling() const
+{
+	return m_ballsRolling;
+}
+
+bool Table::IsFirstShot() const
+{
+	return m_isFirstShot;
+}
+
+bool Table::HasHitBall() const
+{
+	return m_hasHitBall;
+}
+
+int Table::GetPoints() const
+{
+	return m_points;
+}
+
+const Table::Fouls& Table::GetFouls() const
+{
+	return m_fouls;
+}
+
+uint32_t Table::GetRevision() const
+{
+	return m_revision;
+}
+
+const Rectf& Table::GetPlayArea() const
+{
+	return m_playArea;
+}
+
+const CushionSet& Table::GetCushions() const
+{
+	return m_cushions;
+}
+
+const std::vector<Hole>& Table::GetHoles() const
+{
+	return m_holes;
+}
+
+const std::vector<Ball>& Table::GetRedBalls() const
+{
+	return m_redBalls;
+}
+
+const Ball& Table::GetWhiteBall() const
+{
+	return m_whiteBall;
+}
+
+Ball* Table::GetWhiteBallPtr()
+{
+	return &m_whiteBall;
+}
+
+const Point2f& Table::GetWhiteBallStart() const
+{
+	return m_whiteBallStart;
+}
+
+void Table::SetRecorder(ShotRecorder* pRecorder)
+{
+	m_pRecorder = pRecorder;
+}
+
+void Table::SetSolverSettings(const ContactSolver::Settings& settings)
+{
+	m_contactSolver.SetSettings(settings);
+}
+
+void Table::AddContactStats(const ContactSolver::Stats& stats)
+{
+	m_contactStats.numContacts += stats.numContacts;
+	m_contactStats.numNewContacts += stats.numNewContacts;
+	m_contactStats.numWarmStarted += stats.numWarmStarted;
+	m_contactStats.maxOverlap = std::max(m_contactStats.maxOverlap, stats.maxOverlap);
+	m_contactStats.maxApproachSpeed = std::max(m_contactStats.maxApproachSpeed, stats.maxApproachSpeed);
+	m_contactStats.momentumChange = std::max(m_contactStats.momentumChange, stats.momentumChange);
+}
+
+const ContactSolver::Stats& Table::GetContactStats() const
+{
+	return m_contactStats;
+}
+
+const ContactSolver& Table::GetContactSolver() const
+{
+	return m_contactSolver;
+}
+
+void Table::SetIntegrator(Ball::Integrator integrator)
+{
+	m_integrator = integrator;
+}
+
+Ball::Integrator Table::GetIntegrator() const
+{
+	return m_integrator;
+}
+
+void Table::SetupBalls(const TableLayout& layout)
+{
+	const TableLayout::BallSetup* pWhiteSetup{ nullptr };
+	m_redBalls.reserve(layout.balls.size());
+	for (const TableLayout::BallSetup& setup : layout.balls)
+	{
+		if (setup.isWhite && !pWhiteSetup)
+		{
+			pWhiteSetup = &setup;
+			continue;
+		}
+
+		// the lives are stored in the z coordinate
+		Ball ball{ ThreeBlade{ setup.pos.x, setup.pos.y, 0.f, 1.f }, Motor{ 1, 0, 0, 0, 0, 0, 0, 0 } };
+		ball.SetState(ThreeBlade{ setup.pos.x, setup.pos.y, float(setup.lives), 1.f }, ball.GetVelocity());
+		ball.SetLinearVelocity(setup.velocity);
+		m_redBalls.push_back(ball);
+	}
+
+	// a layout without a white ball still gets one, in the middle of the play area
+	m_whiteBallStart = pWhiteSetup ? pWhiteSetup->pos : Point2f{ m_playArea.left + m_playArea.width / 2, m_playArea.bottom + m_playArea.height / 2 };
+	ResetWhiteBall();
+	if (pWhiteSetup) m_whiteBall.SetLinearVelocity(pWhiteSetup->velocity);
+
+	// a layout can start with rolling balls
+	for (const Ball& ball : m_redBalls)
+	{
+		m_ballsRolling |= ball.IsMoving();
+	}
+	m_ballsRolling |= m_whiteBall.IsMoving();
+
+	AssignIds();
+}
+
+void Table::ResetWhiteBall()
+{
+	// reset in place, so the cue keeps pointing to the ball
+	m_whiteBall = Ball{ ThreeBlade{ m_whiteBallStart.x, m_whiteBallStart.y, 0.f, 1.f }, Motor{ 1, 0, 0, 0, 0, 0, 0, 0 }, true };
+}
+
+void Table::CheckBallsRolling()
+{
+	m_ballsRolling = false;
+	for (const Ball& ball : m_redBalls)
+	{
+		m_ballsRolling |= ball.IsMoving();
+	}
+	m_ballsRolling |= m_whiteBall.IsMoving();
+
+	if (!m_ballsRolling)
+	{
+		// executed when balls stop rolling
+		m_isFirstShot = false;
+
+		// if no red balls have been hit, lose 20 points
+		if (!m_hasHitBall)
+		{
+			AddPoints(-10);
+			++m_fouls.noBallHit;
+		}
+	}
+}
+
+bool Table::FallsInHole(const Ball& ball) const
+{
+	for (const Hole& hole : m_holes)
+	{
+		if (hole.FallsIn(ball)) return true;
+	}
+	return false;
+}
+
+void Table::OnBallsTouched(Ball& first, Ball& second)
+{
+	// if there was a collision between the white ball and a red ball, the player doesn't lose points for this
+	if (first.IsWhiteBall() || second.IsWhiteBall()) m_hasHitBall = true;
+
+	if (m_isFirstShot) return;
+
+	// Remove 1 live for collisions with a red ball, and 3 for collisions with the white ball
+	if (first.IsWhiteBall()) second.LoseLives(3);
+	else if (second.IsWhiteBall()) first.LoseLives(3);
+	else
+	{
+		first.LoseLives(1);
+		second.LoseLives(1);
+	}
+}
+
+void Table::AssignIds()
+{
+	m_whiteBall.SetId(0);
+	for (size_t idx{}; idx < m_redBalls.size(); ++idx)
+	{
+		m_redBalls[idx].SetId(uint32_t(idx + 1));
+	}
+}
+
+void Table::AddPoints(int amount)
+{
+	m_points += amount;
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "structs.h"
+#include "FlyFish.h"
+#include "Ball.h"
+#include "ContactSolver.h"
+#include "CushionSet.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Hole;
+class ShotRecorder;
+struct TableLayout;
+struct TableState;
+
+// The pool table and its rules, without any window or rendering,
+// so it can be simulated by the game as well as headless
+class Table final
+{
+public:
+	// rule breaks since the start of the game, each one costs points
+	struct Fouls
+	{
+		// the white ball fell into a pocket
+		int whiteBallPocketed;
+		// the balls stopped without the white ball touching a red ball
+		int noBallHit;
+	};
+
+	// the default table (see TableLayout::CreateDefault)
+	explicit Table(const Rectf& playArea);
+	explicit Table(const TableLayout& layout);
+	Table(const Table& other) = delete;
+	Table& operator=(const Table& other) = delete;
+	Table(Table&& other) = delete;
+	Table& operator=(Table&& other) = delete;
+	~Table();
+
+	void Update(float elapsedSec);
+	// hit the white ball with a translation motor, like the cue does
+	void ApplyShot(const Motor& shot);
+
+	// replace all balls and the score, used to start from a recorded state
+	void SetState(const std::vector<Ball>& redBalls, const Ball& whiteBall, int points, bool isFirstShot, bool ballsRolling, bool hasHitBall);
+
+	// copy the whole table state into / out of a flat buffer, without allocating.
+	// Snapshot returns false and leaves the state alone when the table has more red balls than a TableState holds
+	bool Snapshot(TableState& state) const;
+	void Restore(const TableState& state);
+
+	bool AreBallsRolling() const;
+	bool IsFirstShot() const;
+	bool HasHitBall() const;
+	int GetPoints() const;
+	const Fouls& GetFouls() const;
+	// changes every time a ball may have moved, so derived data (like the aim preview) knows when to recompute
+	uint32_t GetRevision() const;
+
+	const Rectf& GetPlayArea() const;
+	const CushionSet& GetCushions() const;
+	const std::vector<Hole>& GetHoles() const;
+	const std::vector<Ball>& GetRedBalls() const;
+	const Ball& GetWhiteBall() const;
+	Ball* GetWhiteBallPtr();
+	const Point2f& GetWhiteBallStart() const;
+
+	// every step and shot is passed to the recorder, pass nullptr to stop recording
+	void SetRecorder(ShotRecorder* pRecorder);
+
+	// how the collisions between balls are solved
+	void SetSolverSettings(const ContactSolver::Settings& settings);
+	const ContactSolver& GetContactSolver() const;
+	// the contacts of the last Update, summed (or the largest) over the steps it was split into
+	const ContactSolver::Stats& GetContactStats() const;
+	// how the balls move during a step, Euler by default so recorded shots replay the same
+	void SetIntegrator(Ball::Integrator integrator);
+	Ball::Integrator GetIntegrator() const;
+
+private:
+	const Rectf m_playArea;
+	const CushionSet m_cushions;
+	std::vector<Hole> m_holes;
+
+	std::vector<Ball> m_redBalls;
+	// stored inline, so the cue's pointer to it stays valid for the whole game
+	Ball m_whiteBall;
+	// where the white ball goes back to when it is pocketed
+	Point2f m_whiteBallStart;
+
+	int m_points;
+	Fouls m_fouls;
+	bool m_ballsRolling;
+	bool m_isFirstShot;
+	bool m_hasHitBall;
+	uint32_t m_revision;
+
+	ShotRecorder* m_pRecorder;
+	ContactSolver m_contactSolver;
+	ContactSolver::Stats m_contactStats;
+	Ball::Integrator m_integrator;
+
+	void SetupBalls(const TableLayout& layout);
+	void ResetWhiteBall();
+	// one (sub-)step of Update: move, cushions, collisions and pockets
+	void Step(float elapsedSec);
+	void AddContactStats(const ContactSolver::Stats& stats);
+	void CheckBallsRolling();
+	bool FallsInHole(const Ball& ball) const;
+	void OnBallsTouched(Ball& first, Ball& second);
+	// white ball 0, red balls from 1 in their order
+	void AssignIds();
+	void AddPoints(int amount);
+};
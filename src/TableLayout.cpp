@@ -0,0 +1,318 @@
+#include "TableLayout.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include "Ball.h"
+#include "Log.h"
+#include "TablePack.h"
+
+namespace
+{
+	// a cushion along every side of the play area
+	CushionSet::Outline CreateBorder(const Rectf& playArea)
+	{
+		return CushionSet::Outline{ {
+			Point2f{ playArea.left, playArea.bottom }, Point2f{ playArea.left + playArea.width, playArea.bottom },
+			Point2f{ playArea.left + playArea.width, playArea.bottom + playArea.height }, Point2f{ playArea.left, playArea.bottom + playArea.height } }, true };
+	}
+}
+
+TableLayout TableLayout::CreateDefault(const Rectf& playArea)
+{
+	TableLayout layout{};
+	layout.name = "default";
+	layout.playArea = playArea;
+	layout.cushions = { CreateBorder(playArea) };
+
+	// left, middle and right pockets
+	layout.pockets = {
+		Point2f{ playArea.left + 12.f, playArea.bottom + 12.f },
+		Point2f{ playArea.left + 12.f, playArea.bottom + playArea.height - 12.f },
+		Point2f{ playArea.left + playArea.width / 2, playArea.bottom + 10.f },
+		Point2f{ playArea.left + playArea.width / 2, playArea.bottom + playArea.height - 10.f },
+		Point2f{ playArea.left + playArea.width - 12.f, playArea.bottom + 12.f },
+		Point2f{ playArea.left + playArea.width - 12.f, playArea.bottom + playArea.height - 12.f } };
+
+	// a rack of red balls pointing to the white ball
+	const Point2f startPos{ playArea.left + playArea.width / 3, playArea.bottom + playArea.height / 2 };
+	const int numColumns{ 5 };
+	const float horizontalDst{ Ball::SIZE * std::cosf(M_PI / 6) + 0.1f };
+	const float verticalDst{ Ball::SIZE + 0.1f };
+
+	// pascals formula for the total amount of balls (= 1 + 2 + 3 + ... + numColumns), plus the white ball
+	layout.balls.reserve((numColumns * (numColumns + 1)) / 2 + 1);
+	for (int column{}; column < numColumns; ++column)
+	{
+		for (int row{}; row < column + 1; ++row)
+		{
+			const Point2f pos{ startPos.x - (column * horizontalDst), startPos.y + (row * verticalDst) - (column * Ball::SIZE / 2) };
+			layout.balls.push_back(BallSetup{ pos, Point2f{ 0.f, 0.f }, Ball::TOT_LIVES, false });
+		}
+	}
+	layout.balls.push_back(BallSetup{ Point2f{ playArea.left + 2 * playArea.width / 3, playArea.bottom + playArea.height / 2 }, Point2f{ 0.f, 0.f }, Ball::TOT_LIVES, true });
+
+	return layout;
+}
+
+TableLayout TableLayout::CreateSandbox(const Rectf& minPlayArea, int numBalls, uint32_t seed)
+{
+	numBalls = std::clamp(numBalls, MIN_SANDBOX_BALLS, MAX_SANDBOX_BALLS);
+
+	// every ball starts somewhere in its own cell of a grid, so no balls overlap,
+	// and there are twice as many cells as balls so the balls are spread randomly over the table
+	const float minCellSize{ Ball::SIZE * 1.5f };
+	const int numCells{ 2 * numBalls };
+	float scale{ std::max(1.f, std::sqrt(numCells * minCellSize * minCellSize / (minPlayArea.width * minPlayArea.height))) };
+	int numColumns{};
+	int numRows{};
+	while (true)
+	{
+		numColumns = int(minPlayArea.width * scale / minCellSize);
+		numRows = int(minPlayArea.height * scale / minCellSize);
+		if (numColumns * numRows >= numCells) break;
+		scale *= 1.01f;
+	}
+
+	TableLayout layout{};
+	layout.name = "sandbox";
+	layout.playArea = Rectf{ minPlayArea.left, minPlayArea.bottom, minPlayArea.width * scale, minPlayArea.height * scale };
+	layout.cushions = { CreateBorder(layout.playArea) };
+
+	const float cellWidth{ layout.playArea.width / numColumns };
+	const float cellHeight{ layout.playArea.height / numRows };
+
+	// the first numBalls cells of a shuffle get a ball
+	std::mt19937 random{ seed };
+	std::vector<int> cells(numColumns * numRows);
+	std::iota(cells.begin(), cells.end(), 0);
+	std::uniform_real_distribution<float> offsetX{ 0.f, cellWidth - Ball::SIZE };
+	std::uniform_real_distribution<float> offsetY{ 0.f, cellHeight - Ball::SIZE };
+	std::uniform_real_distribution<float> angle{ 0.f, 2.f * float(M_PI) };
+	std::uniform_real_distribution<float> speed{ 0.f, MAX_SANDBOX_SPEED };
+
+	layout.balls.reserve(numBalls);
+	for (int idx{}; idx < numBalls; ++idx)
+	{
+		std::swap(cells[idx], cells[std::uniform_int_distribution<int>{ idx, int(cells.size()) - 1 }(random)]);
+		const int column{ cells[idx] % numColumns };
+		const int row{ cells[idx] / numColumns };
+
+		const Point2f pos{ layout.playArea.left + column * cellWidth + Ball::SIZE / 2 + offsetX(random),
+			layout.playArea.bottom + row * cellHeight + Ball::SIZE / 2 + offsetY(random) };
+		const float ballAngle{ angle(random) };
+		const float ballSpeed{ speed(random) };
+		layout.balls.push_back(BallSetup{ pos, Point2f{ std::cos(ballAngle) * ballSpeed, std::sin(ballAngle) * ballSpeed }, Ball::TOT_LIVES, idx == 0 });
+	}
+
+	return layout;
+}
+
+bool TableLayout::ReadText(std::istream& stream, std::vector<TableLayout>& layouts)
+{
+	const size_t firstLayout{ layouts.size() };
+	int lineNumber{};
+	std::string line{};
+	std::string error{};
+	while (error.empty() && std::getline(stream, line))
+	{
+		++lineNumber;
+		const size_t commentStart{ line.find('#') };
+		if (commentStart != std::string::npos) line.erase(commentStart);
+
+		std::istringstream lineStream{ line };
+		std::string keyword{};
+		if (!(lineStream >> keyword)) continue;
+
+		if (keyword == "table")
+		{
+			layouts.push_back(TableLayout{});
+			if (!(lineStream >> layouts.back().name)) error = "table needs a name";
+			continue;
+		}
+		if (layouts.size() == firstLayout)
+		{
+			error = "the file has to start with a table line";
+			continue;
+		}
+
+		TableLayout& layout{ layouts.back() };
+		if (keyword == "play_area")
+		{
+			Rectf& playArea{ layout.playArea };
+			if (!(lineStream >> playArea.left >> playArea.bottom >> playArea.width >> playArea.height)) error = "play_area needs left, bottom, width and height";
+		}
+		else if (keyword == "cushion")
+		{
+			std::string type{};
+			lineStream >> type;
+			if (type != "closed" && type != "open")
+			{
+				error = "cushion has to be closed or open";
+				continue;
+			}
+
+			CushionSet::Outline outline{ {}, type == "closed" };
+			Point2f point{};
+			while (lineStream >> point.x >> point.y)
+			{
+				outline.points.push_back(point);
+			}
+			if (!lineStream.eof() || outline.points.size() < 2) error = "cushion needs at least two x y points";
+			else layout.cushions.push_back(std::move(outline));
+		}
+		else if (keyword == "pocket")
+		{
+			Point2f pocket{};
+			if (!(lineStream >> pocket.x >> pocket.y)) error = "pocket needs x and y";
+			else layout.pockets.push_back(pocket);
+		}
+		else if (keyword == "ball")
+		{
+			BallSetup ball{ Point2f{}, Point2f{ 0.f, 0.f }, Ball::TOT_LIVES, false };
+			if (!(lineStream >> ball.pos.x >> ball.pos.y))
+			{
+				error = "ball needs x and y";
+				continue;
+			}
+
+			std::string attribute{};
+			while (error.empty() && lineStream >> attribute)
+			{
+				if (attribute == "white") ball.isWhite = true;
+				else if (attribute == "lives")
+				{
+					if (!(lineStream >> ball.lives) || ball.lives < 1) error = "lives needs a number above 0";
+				}
+				else if (attribute == "velocity")
+				{
+					if (!(lineStream >> ball.velocity.x >> ball.velocity.y)) error = "velocity needs x and y";
+				}
+				else error = "unknown ball attribute " + attribute;
+			}
+			layout.balls.push_back(ball);
+		}
+		else
+		{
+			error = "unknown keyword " + keyword;
+		}
+	}
+
+	if (error.empty())
+	{
+		// check every layout once it is complete
+		for (size_t idx{ firstLayout }; idx < layouts.size() && error.empty(); ++idx)
+		{
+			if (!layouts[idx].IsValid(error)) error = "table " + layouts[idx].name + ": " + error;
+		}
+		if (error.empty()) return true;
+		Log::Error("TableLayout::ReadText( ), ", error);
+	}
+	else
+	{
+		Log::Error("TableLayout::ReadText( ), line ", lineNumber, ": ", error);
+	}
+
+	layouts.resize(firstLayout);
+	return false;
+}
+
+void TableLayout::WriteText(std::ostream& stream) const
+{
+	// enough digits that every float reads back as the same value, the stream gets its own precision back at the end
+	const std::streamsize oldPrecision{ stream.precision(std::numeric_limits<float>::max_digits10) };
+
+	stream << "table " << name << '\n';
+	stream << "play_area " << playArea.left << ' ' << playArea.bottom << ' ' << playArea.width << ' ' << playArea.height << '\n';
+	for (const CushionSet::Outline& cushion : cushions)
+	{
+		stream << "cushion " << (cushion.isClosed ? "closed" : "open");
+		for (const Point2f& point : cushion.points)
+		{
+			stream << ' ' << point.x << ' ' << point.y;
+		}
+		stream << '\n';
+	}
+	for (const Point2f& pocket : pockets)
+	{
+		stream << "pocket " << pocket.x << ' ' << pocket.y << '\n';
+	}
+	for (const BallSetup& ball : balls)
+	{
+		stream << "ball " << ball.pos.x << ' ' << ball.pos.y;
+		if (ball.isWhite) stream << " white";
+		if (ball.lives != Ball::TOT_LIVES) stream << " lives " << ball.lives;
+		if (ball.velocity.x != 0.f || ball.velocity.y != 0.f) stream << " velocity " << ball.velocity.x << ' ' << ball.velocity.y;
+		stream << '\n';
+	}
+	stream.precision(oldPrecision);
+}
+
+bool TableLayout::Load(const std::string& path, std::vector<TableLayout>& layouts)
+{
+	std::ifstream file{ path, std::ios::binary };
+	if (!file)
+	{
+		Log::Error("TableLayout::Load( ), could not open ", path);
+		return false;
+	}
+
+	char magic[sizeof(TablePack::MAGIC)]{};
+	file.read(magic, sizeof(magic));
+	if (file && std::memcmp(magic, TablePack::MAGIC, sizeof(magic)) == 0)
+	{
+		file.close();
+		const TablePack pack{ path };
+		if (!pack.IsLoaded()) return false;
+
+		const size_t firstLayout{ layouts.size() };
+		layouts.resize(firstLayout + pack.GetNumTables());
+		for (int idx{}; idx < pack.GetNumTables(); ++idx)
+		{
+			if (!pack.GetLayout(idx, layouts[firstLayout + idx]))
+			{
+				layouts.resize(firstLayout);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	file.clear();
+	file.seekg(0);
+	return ReadText(file, layouts);
+}
+
+bool TableLayout::IsValid(std::string& error) const
+{
+	if (playArea.width <= 0.f || playArea.height <= 0.f)
+	{
+		error = "the play area needs a size";
+		return false;
+	}
+
+	int numWhiteBalls{};
+	for (const BallSetup& ball : balls)
+	{
+		if (ball.isWhite) ++numWhiteBalls;
+	}
+	if (numWhiteBalls != 1)
+	{
+		error = "there has to be exactly one white ball";
+		return false;
+	}
+
+	// the balls are told apart by a 32 bit id
+	if (balls.size() > UINT32_MAX)
+	{
+		error = "too many balls";
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "structs.h"
+#include "CushionSet.h"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Everything a table starts with: the play area, the cushions, the pockets and the balls.
+// Layouts are written as text (see ReadText) and can be compiled into a table pack (see TablePack.h)
+// that is memory-mapped, so thousands of them load without parsing.
+struct TableLayout
+{
+	struct BallSetup
+	{
+		Point2f pos;
+		Point2f velocity;
+		int lives;
+		bool isWhite;
+	};
+
+	std::string name;
+	Rectf playArea;
+	std::vector<CushionSet::Outline> cushions;
+	std::vector<Point2f> pockets;
+	// exactly one of them is the white ball, it goes back to its position when it is pocketed
+	std::vector<BallSetup> balls;
+
+	// the classic table: a cushion along every side of the play area, six pockets, a rack of 15 red balls and the white ball
+	static TableLayout CreateDefault(const Rectf& playArea);
+	// a stress test: numBalls (clamped to MIN_SANDBOX_BALLS..MAX_SANDBOX_BALLS) balls at random positions with random velocities and no pockets,
+	// the play area grows from minPlayArea until the balls fill about half of it, the same seed gives the same layout
+	static TableLayout CreateSandbox(const Rectf& minPlayArea, int numBalls, uint32_t seed);
+
+	static constexpr int MIN_SANDBOX_BALLS{ 10 };
+	static constexpr int MAX_SANDBOX_BALLS{ 100000 };
+	// fastest a sandbox ball starts, in pixels per second
+	static constexpr float MAX_SANDBOX_SPEED{ 400.f };
+
+	// Text form, one item per line, # starts a comment, coordinates in pixels with y up:
+	//   table <name>                          starts a new layout, the lines below belong to it
+	//   play_area <left> <bottom> <width> <height>
+	//   cushion closed|open <x> <y> <x> <y> ...   an outline with the play side on the left (see CushionSet)
+	//   pocket <x> <y>
+	//   ball <x> <y> [white] [lives <n>] [velocity <x> <y>]
+	// a file holds any number of layouts, returns false (and prints the line) when one of them is invalid
+	static bool ReadText(std::istream& stream, std::vector<TableLayout>& layouts);
+	void WriteText(std::ostream& stream) const;
+
+	// reads a text file or a table pack, depending on what the file starts with
+	static bool Load(const std::string& path, std::vector<TableLayout>& layouts);
+
+	// a layout needs a play area and exactly one white ball
+	bool IsValid(std::string& error) const;
+};
@@ -0,0 +1,230 @@
+#include "TablePack.h"
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include "Log.h"
+#include "TableLayout.h"
+
+namespace
+{
+	// appends the bytes of a record, the writer only uses 4 byte records so everything stays aligned
+	template <typename T>
+	void Append(std::vector<uint8_t>& buffer, const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % 4 == 0);
+		const size_t offset{ buffer.size() };
+		buffer.resize(offset + sizeof(T));
+		std::memcpy(buffer.data() + offset, &value, sizeof(T));
+	}
+}
+
+TablePack::TablePack(const std::string& path)
+	: m_file{ path }
+	, m_pHeader{ nullptr }
+	, m_pTableOffsets{ nullptr }
+{
+	if (!m_file.IsOpen()) return;
+
+	const uint8_t* pData{ m_file.GetData() };
+	if (m_file.GetSize() < sizeof(Header) || std::memcmp(pData, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		Log::Error("TablePack::TablePack( ), ", path, " is not a table pack");
+		return;
+	}
+
+	const Header* pHeader{ reinterpret_cast<const Header*>(pData) };
+	if (pHeader->version != VERSION)
+	{
+		Log::Error("TablePack::TablePack( ), ", path, " has version ", pHeader->version, ", expected ", VERSION);
+		return;
+	}
+	if (!IsInFile(sizeof(Header), pHeader->numTables, sizeof(uint32_t)))
+	{
+		Log::Error("TablePack::TablePack( ), ", path, " is truncated");
+		return;
+	}
+
+	m_pHeader = pHeader;
+	m_pTableOffsets = reinterpret_cast<const uint32_t*>(pData + sizeof(Header));
+}
+
+bool TablePack::IsLoaded() const
+{
+	return m_pHeader != nullptr;
+}
+
+int TablePack::GetNumTables() const
+{
+	return m_pHeader ? int(m_pHeader->numTables) : 0;
+}
+
+std::string_view TablePack::GetName(int idx) const
+{
+	const TableRecord* pRecord{ GetRecord(idx) };
+	if (!pRecord || !IsInFile(pRecord->nameOffset, pRecord->nameLength, 1)) return std::string_view{};
+
+	return std::string_view{ reinterpret_cast<const char*>(m_file.GetData() + pRecord->nameOffset), pRecord->nameLength };
+}
+
+bool TablePack::GetLayout(int idx, TableLayout& layout) const
+{
+	const TableRecord* pRecord{ GetRecord(idx) };
+	if (!pRecord) return false;
+
+	const TableRecord& record{ *pRecord };
+	if (!IsInFile(record.nameOffset, record.nameLength, 1)
+		|| !IsInFile(record.outlinesOffset, record.numOutlines, sizeof(OutlineRecord))
+		|| !IsInFile(record.pointsOffset, record.numPoints, sizeof(PointRecord))
+		|| !IsInFile(record.pocketsOffset, record.numPockets, sizeof(PointRecord))
+		|| !IsInFile(record.ballsOffset, record.numBalls, sizeof(BallRecord)))
+	{
+		Log::Error("TablePack::GetLayout( ), table ", idx, " doesn't fit in the pack");
+		return false;
+	}
+
+	const uint8_t* pData{ m_file.GetData() };
+	const OutlineRecord* pOutlines{ reinterpret_cast<const OutlineRecord*>(pData + record.outlinesOffset) };
+	const PointRecord* pPoints{ reinterpret_cast<const PointRecord*>(pData + record.pointsOffset) };
+	const PointRecord* pPockets{ reinterpret_cast<const PointRecord*>(pData + record.pocketsOffset) };
+	const BallRecord* pBalls{ reinterpret_cast<const BallRecord*>(pData + record.ballsOffset) };
+
+	layout.name.assign(GetName(idx));
+	layout.playArea = Rectf{ record.playArea[0], record.playArea[1], record.playArea[2], record.playArea[3] };
+
+	layout.cushions.resize(record.numOutlines);
+	for (uint32_t outlineIdx{}; outlineIdx < record.numOutlines; ++outlineIdx)
+	{
+		const OutlineRecord& outline{ pOutlines[outlineIdx] };
+		if (outline.firstPoint > record.numPoints || outline.numPoints > record.numPoints - outline.firstPoint)
+		{
+			Log::Error("TablePack::GetLayout( ), outline ", outlineIdx, " of table ", idx, " has points outside of the table");
+			return false;
+		}
+
+		CushionSet::Outline& cushion{ layout.cushions[outlineIdx] };
+		cushion.isClosed = (outline.flags & CLOSED) != 0;
+		cushion.points.resize(outline.numPoints);
+		for (uint32_t pointIdx{}; pointIdx < outline.numPoints; ++pointIdx)
+		{
+			const PointRecord& point{ pPoints[outline.firstPoint + pointIdx] };
+			cushion.points[pointIdx] = Point2f{ point.x, point.y };
+		}
+	}
+
+	layout.pockets.resize(record.numPockets);
+	for (uint32_t pocketIdx{}; pocketIdx < record.numPockets; ++pocketIdx)
+	{
+		layout.pockets[pocketIdx] = Point2f{ pPockets[pocketIdx].x, pPockets[pocketIdx].y };
+	}
+
+	layout.balls.resize(record.numBalls);
+	for (uint32_t ballIdx{}; ballIdx < record.numBalls; ++ballIdx)
+	{
+		const BallRecord& ball{ pBalls[ballIdx] };
+		layout.balls[ballIdx] = TableLayout::BallSetup{ Point2f{ ball.x, ball.y }, Point2f{ ball.velocityX, ball.velocityY }, ball.lives, (ball.flags & WHITE) != 0 };
+	}
+	return true;
+}
+
+bool TablePack::Write(const std::string& path, const std::vector<TableLayout>& layouts)
+{
+	std::vector<uint8_t> buffer{};
+	Header header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.numTables = uint32_t(layouts.size());
+	Append(buffer, header);
+
+	// the offsets are filled in once every table is written
+	const size_t offsetsStart{ buffer.size() };
+	buffer.resize(offsetsStart + layouts.size() * sizeof(uint32_t));
+
+	for (size_t tableIdx{}; tableIdx < layouts.size(); ++tableIdx)
+	{
+		const TableLayout& layout{ layouts[tableIdx] };
+
+		const uint32_t tableOffset{ uint32_t(buffer.size()) };
+		std::memcpy(buffer.data() + offsetsStart + tableIdx * sizeof(uint32_t), &tableOffset, sizeof(uint32_t));
+
+		uint32_t numPoints{};
+		for (const CushionSet::Outline& cushion : layout.cushions)
+		{
+			numPoints += uint32_t(cushion.points.size());
+		}
+
+		// the arrays follow the table record in this order, the name is padded to keep them aligned
+		TableRecord record{};
+		record.playArea[0] = layout.playArea.left;
+		record.playArea[1] = layout.playArea.bottom;
+		record.playArea[2] = layout.playArea.width;
+		record.playArea[3] = layout.playArea.height;
+		record.nameLength = uint32_t(layout.name.size());
+		record.nameOffset = tableOffset + sizeof(TableRecord);
+		record.numOutlines = uint32_t(layout.cushions.size());
+		record.outlinesOffset = record.nameOffset + (record.nameLength + 3) / 4 * 4;
+		record.numPoints = numPoints;
+		record.pointsOffset = record.outlinesOffset + record.numOutlines * sizeof(OutlineRecord);
+		record.numPockets = uint32_t(layout.pockets.size());
+		record.pocketsOffset = record.pointsOffset + record.numPoints * sizeof(PointRecord);
+		record.numBalls = uint32_t(layout.balls.size());
+		record.ballsOffset = record.pocketsOffset + record.numPockets * sizeof(PointRecord);
+		Append(buffer, record);
+
+		buffer.insert(buffer.end(), layout.name.begin(), layout.name.end());
+		buffer.resize(record.outlinesOffset);
+
+		uint32_t firstPoint{};
+		for (const CushionSet::Outline& cushion : layout.cushions)
+		{
+			Append(buffer, OutlineRecord{ firstPoint, uint32_t(cushion.points.size()), cushion.isClosed ? uint32_t(CLOSED) : 0u });
+			firstPoint += uint32_t(cushion.points.size());
+		}
+		for (const CushionSet::Outline& cushion : layout.cushions)
+		{
+			for (const Point2f& point : cushion.points)
+			{
+				Append(buffer, PointRecord{ point.x, point.y });
+			}
+		}
+		for (const Point2f& pocket : layout.pockets)
+		{
+			Append(buffer, PointRecord{ pocket.x, pocket.y });
+		}
+		for (const TableLayout::BallSetup& ball : layout.balls)
+		{
+			Append(buffer, BallRecord{ ball.pos.x, ball.pos.y, ball.velocity.x, ball.velocity.y, ball.lives, ball.isWhite ? uint32_t(WHITE) : 0u });
+		}
+
+		if (buffer.size() > UINT32_MAX)
+		{
+			Log::Error("TablePack::Write( ), the tables don't fit in a pack of 4 GiB");
+			return false;
+		}
+	}
+
+	std::ofstream file{ path, std::ios::binary };
+	file.write(reinterpret_cast<const char*>(buffer.data()), std::streamsize(buffer.size()));
+	if (!file)
+	{
+		Log::Error("TablePack::Write( ), could not write ", path);
+		return false;
+	}
+	return true;
+}
+
+const TablePack::TableRecord* TablePack::GetRecord(int idx) const
+{
+	if (!m_pHeader || idx < 0 || idx >= GetNumTables()) return nullptr;
+
+	const uint32_t offset{ m_pTableOffsets[idx] };
+	if (offset % 4 != 0 || !IsInFile(offset, 1, sizeof(TableRecord))) return nullptr;
+
+	return reinterpret_cast<const TableRecord*>(m_file.GetData() + offset);
+}
+
+bool TablePack::IsInFile(uint32_t offset, uint32_t count, size_t recordSize) const
+{
+	// the records have to be aligned, and are checked in 64 bit so a corrupt count can't overflow
+	if (recordSize % 4 == 0 && offset % 4 != 0) return false;
+	return uint64_t(offset) + uint64_t(count) * recordSize <= m_file.GetSize();
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.h"
+
+struct TableLayout;
+
+// Binary table pack, compiled table layouts that are used in place after memory-mapping the file.
+// All values are stored in the byte order of the machine (little endian on our targets) and are 4 byte aligned,
+// offsets are in bytes from the start of the file
+//
+// header:   "GTBP", u16 version, u16 reserved, u32 table count, then a u32 offset to every table
+// table:    f32 play area (left, bottom, width, height), u32 name offset, u32 name length,
+//           u32 outline count, u32 outlines offset, u32 point count, u32 points offset,
+//           u32 pocket count, u32 pockets offset, u32 ball count, u32 balls offset
+// outline:  u32 first point (into the points of its table), u32 point count, u32 flags
+// point:    f32 x, y (cushion points and pockets)
+// ball:     f32 x, y, velocity x, velocity y, i32 lives, u32 flags
+class TablePack final
+{
+public:
+	static constexpr char MAGIC[4]{ 'G', 'T', 'B', 'P' };
+	static constexpr uint16_t VERSION{ 1 };
+
+	explicit TablePack(const std::string& path);
+
+	bool IsLoaded() const;
+	int GetNumTables() const;
+	std::string_view GetName(int idx) const;
+	// copy a table out of the pack, reusing the memory the layout already has
+	bool GetLayout(int idx, TableLayout& layout) const;
+
+	static bool Write(const std::string& path, const std::vector<TableLayout>& layouts);
+
+private:
+	enum OutlineFlags : uint32_t
+	{
+		CLOSED = 1 << 0
+	};
+
+	enum BallFlags : uint32_t
+	{
+		WHITE = 1 << 0
+	};
+
+	struct Header
+	{
+		char magic[4];
+		uint16_t version;
+		uint16_t reserved;
+		uint32_t numTables;
+	};
+
+	struct TableRecord
+	{
+		float playArea[4];
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		uint32_t numOutlines;
+		uint32_t outlinesOffset;
+		uint32_t numPoints;
+		uint32_t pointsOffset;
+		uint32_t numPockets;
+		uint32_t pocketsOffset;
+		uint32_t numBalls;
+		uint32_t ballsOffset;
+	};
+
+	struct OutlineRecord
+	{
+		uint32_t firstPoint;
+		uint32_t numPoints;
+		uint32_t flags;
+	};
+
+	struct PointRecord
+	{
+		float x;
+		float y;
+	};
+
+	struct BallRecord
+	{
+		float x;
+		float y;
+		float velocityX;
+		float velocityY;
+		int32_t lives;
+		uint32_t flags;
+	};
+
+	MappedFile m_file;
+	const Header* m_pHeader;
+	const uint32_t* m_pTableOffsets;
+
+	// nullptr when the table doesn't fit in the file
+	const TableRecord* GetRecord(int idx) const;
+	// true when count records of the given size from offset are inside the file
+	bool IsInFile(uint32_t offset, uint32_t count, size_t recordSize) const;
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include "Ball.h"
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<Ball>, "Ball is copied into a TableState with memcpy");
+
+// Flat copy of everything that changes on a table while playing.
+// It holds no pointers or containers, so it can be copied around freely (rollback, undo, shot search).
+struct TableState
+{
+	static constexpr int MAX_BALLS{ 1024 };
+
+	int numRedBalls;
+	int points;
+	// see Table::Fouls
+	int whiteBallFouls;
+	int noBallHitFouls;
+	bool ballsRolling;
+	bool isFirstShot;
+	bool hasHitBall;
+
+	// raw bytes of the Ball objects, only the first numRedBalls red balls are in use
+	alignas(Ball) unsigned char whiteBall[sizeof(Ball)];
+	alignas(Ball) unsigned char redBalls[MAX_BALLS * sizeof(Ball)];
+};
+
+static_assert(std::is_trivially_copyable_v<TableState>, "TableState has to stay a flat memcpy-able struct");
@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Telemetry ring file format, a fixed-size file that is written through a memory mapping while the game runs,
+// all values are stored in the byte order of the machine (little endian on our targets)
+//
+// header:   128 bytes, "GTEL", u16 version, u16 header size, u32 index capacity, u32 reserved,
+//           u64 index offset, u64 data offset, u64 data capacity, f32 play area (left, bottom, width, height), u32 is open, u32 reserved,
+//           then on its own cache line: u64 record count, u64 data bytes taken by the records (both only grow)
+// index:    index capacity entries of u64 sequence, u64 data position, u32 size, u32 ball count,
+//           record n is in entry n % index capacity
+// data:     a ring of data capacity bytes, a record at data position p starts at byte p % data capacity and never wraps,
+//           when it doesn't fit before the end it starts at the beginning of the ring instead
+// records:  u64 step, f64 simulated seconds, f32 elapsed seconds, u32 ball count,
+//           then for the white ball followed by every red ball: u32 id, f32 x, y, lives, velocity x, y
+//
+// The writer invalidates the index entry and takes the bytes first, then stores the record, sets the sequence of the entry
+// and only then increases the record count. A reader that tails the file copies a record and afterwards checks
+// that the writer hasn't come around the ring in the meantime, see CopyRecord.
+namespace TelemetryLog
+{
+	constexpr char MAGIC[4]{ 'G', 'T', 'E', 'L' };
+	constexpr uint16_t VERSION{ 1 };
+
+	struct Header
+	{
+		char magic[4];
+		uint16_t version;
+		uint16_t headerSize;
+		uint32_t indexCapacity;
+		uint32_t reserved;
+		uint64_t indexOffset;
+		uint64_t dataOffset;
+		uint64_t dataCapacity;
+		float playArea[4];
+		// 0 once the writer closed the file
+		std::atomic<uint32_t> isOpen;
+		uint32_t reserved2;
+
+		alignas(64) std::atomic<uint64_t> numRecords;
+		std::atomic<uint64_t> numDataBytes;
+	};
+	static_assert(sizeof(Header) == 128 && std::is_standard_layout_v<Header>, "the header layout is part of the file format");
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "the counters are shared with other processes");
+
+	struct IndexEntry
+	{
+		// written last, INVALID_SEQUENCE while the entry is being changed
+		std::atomic<uint64_t> sequence;
+		uint64_t dataPosition;
+		uint32_t size;
+		uint32_t numBalls;
+	};
+	static_assert(sizeof(IndexEntry) == 24, "the index layout is part of the file format");
+
+	constexpr uint64_t INVALID_SEQUENCE{ UINT64_MAX };
+
+	struct RecordHeader
+	{
+		uint64_t step;
+		double simulatedSeconds;
+		float elapsedSeconds;
+		uint32_t numBalls;
+	};
+	static_assert(sizeof(RecordHeader) == 24, "the record layout is part of the file format");
+
+	struct BallState
+	{
+		uint32_t id;
+		float x;
+		float y;
+		float lives;
+		float velocityX;
+		float velocityY;
+	};
+	static_assert(sizeof(BallState) == 24, "the record layout is part of the file format");
+
+	// copies record number sequence out of a mapped telemetry file,
+	// false when it was already overwritten (or is overwritten while it is copied) or isn't written yet
+	inline bool CopyRecord(const uint8_t* pFile, uint64_t sequence, std::vector<uint8_t>& record)
+	{
+		const Header& header{ *reinterpret_cast<const Header*>(pFile) };
+		if (sequence >= header.numRecords.load(std::memory_order_acquire)) return false;
+
+		const IndexEntry& entry{ reinterpret_cast<const IndexEntry*>(pFile + header.indexOffset)[sequence % header.indexCapacity] };
+		if (entry.sequence.load(std::memory_order_acquire) != sequence) return false;
+		const uint64_t dataPosition{ entry.dataPosition };
+		const uint32_t size{ entry.size };
+		// the writer may be changing the entry right now, so the position and size can belong to different records,
+		// they have to stay inside the ring before anything is copied
+		if (size > header.dataCapacity || dataPosition % header.dataCapacity + size > header.dataCapacity) return false;
+
+		record.resize(size);
+		std::memcpy(record.data(), pFile + header.dataOffset + dataPosition % header.dataCapacity, size);
+
+		// the entry and the bytes are still the ones of this record if the writer didn't come around the ring since
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return entry.sequence.load(std::memory_order_relaxed) == sequence
+			&& header.numDataBytes.load(std::memory_order_relaxed) - dataPosition <= header.dataCapacity;
+	}
+}
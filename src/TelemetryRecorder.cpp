@@ -0,0 +1,139 @@
+#include "TelemetryRecorder.h"
+#include <algorithm>
+#include <new>
+#include "Ball.h"
+#include "Table.h"
+
+namespace
+{
+	constexpr uint64_t INDEX_OFFSET{ sizeof(TelemetryLog::Header) };
+
+	uint64_t GetDataOffset(uint32_t indexCapacity)
+	{
+		// the ring starts on a cache line
+		const uint64_t indexEnd{ INDEX_OFFSET + uint64_t(indexCapacity) * sizeof(TelemetryLog::IndexEntry) };
+		return (indexEnd + 63) / 64 * 64;
+	}
+
+	TelemetryLog::BallState GetBallState(const Ball& ball)
+	{
+		const ThreeBlade& pos{ ball.GetPos() };
+		const Point2f velocity{ ball.GetLinearVelocity() };
+		return TelemetryLog::BallState{ ball.GetId(), pos[0], pos[1], pos[2], velocity.x, velocity.y };
+	}
+}
+
+TelemetryRecorder::TelemetryRecorder(const std::string& path, const Table& table, size_t dataCapacity, uint32_t indexCapacity)
+	: m_file{ path, size_t(GetDataOffset(std::max(indexCapacity, 1u))) + std::max<size_t>(dataCapacity, 64) }
+	, m_pHeader{ nullptr }
+	, m_pIndex{ nullptr }
+	, m_pData{ nullptr }
+	, m_numSteps{ 0 }
+	, m_numRecords{ 0 }
+	, m_numDataBytes{ 0 }
+	, m_numSkipped{ 0 }
+	, m_simulatedSeconds{ 0.0 }
+{
+	uint8_t* pFile{ m_file.GetWritableData() };
+	if (!pFile) return;
+
+	indexCapacity = std::max(indexCapacity, 1u);
+	const uint64_t dataOffset{ GetDataOffset(indexCapacity) };
+
+	// the file starts out as zeros, the header and the index entries are created in place
+	m_pHeader = new (pFile) TelemetryLog::Header{};
+	std::copy(std::begin(TelemetryLog::MAGIC), std::end(TelemetryLog::MAGIC), m_pHeader->magic);
+	m_pHeader->version = TelemetryLog::VERSION;
+	m_pHeader->headerSize = uint16_t(sizeof(TelemetryLog::Header));
+	m_pHeader->indexCapacity = indexCapacity;
+	m_pHeader->indexOffset = INDEX_OFFSET;
+	m_pHeader->dataOffset = dataOffset;
+	m_pHeader->dataCapacity = m_file.GetSize() - dataOffset;
+
+	const Rectf& playArea{ table.GetPlayArea() };
+	m_pHeader->playArea[0] = playArea.left;
+	m_pHeader->playArea[1] = playArea.bottom;
+	m_pHeader->playArea[2] = playArea.width;
+	m_pHeader->playArea[3] = playArea.height;
+
+	m_pIndex = reinterpret_cast<TelemetryLog::IndexEntry*>(pFile + INDEX_OFFSET);
+	for (uint32_t idx{}; idx < indexCapacity; ++idx)
+	{
+		new (m_pIndex + idx) TelemetryLog::IndexEntry{ TelemetryLog::INVALID_SEQUENCE, 0, 0, 0 };
+	}
+	m_pData = pFile + dataOffset;
+
+	m_pHeader->isOpen.store(1, std::memory_order_release);
+}
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+	if (m_pHeader) m_pHeader->isOpen.store(0, std::memory_order_release);
+}
+
+bool TelemetryRecorder::IsOk() const
+{
+	return m_pHeader != nullptr;
+}
+
+void TelemetryRecorder::RecordStep(const Table& table, float elapsedSec)
+{
+	++m_numSteps;
+	m_simulatedSeconds += elapsedSec;
+	if (!m_pHeader) return;
+
+	const std::vector<Ball>& redBalls{ table.GetRedBalls() };
+	const uint64_t dataCapacity{ m_pHeader->dataCapacity };
+	const uint32_t numBalls{ uint32_t(redBalls.size() + 1) };
+	const uint64_t size{ sizeof(TelemetryLog::RecordHeader) + uint64_t(numBalls) * sizeof(TelemetryLog::BallState) };
+	if (size > std::min<uint64_t>(dataCapacity, UINT32_MAX))
+	{
+		++m_numSkipped;
+		return;
+	}
+
+	// a record that doesn't fit before the end of the ring starts at the beginning
+	uint64_t position{ m_numDataBytes };
+	const uint64_t offset{ position % dataCapacity };
+	if (offset + size > dataCapacity) position += dataCapacity - offset;
+
+	// readers that still copy the entry or the bytes that get overwritten will see it
+	TelemetryLog::IndexEntry& entry{ m_pIndex[m_numRecords % m_pHeader->indexCapacity] };
+	entry.sequence.store(TelemetryLog::INVALID_SEQUENCE, std::memory_order_relaxed);
+	m_numDataBytes = position + size;
+	m_pHeader->numDataBytes.store(m_numDataBytes, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	uint8_t* pRecord{ m_pData + position % dataCapacity };
+	const TelemetryLog::RecordHeader recordHeader{ m_numSteps, m_simulatedSeconds, elapsedSec, numBalls };
+	std::memcpy(pRecord, &recordHeader, sizeof(recordHeader));
+	pRecord += sizeof(recordHeader);
+
+	const TelemetryLog::BallState whiteBall{ GetBallState(table.GetWhiteBall()) };
+	std::memcpy(pRecord, &whiteBall, sizeof(whiteBall));
+	pRecord += sizeof(whiteBall);
+	for (const Ball& ball : redBalls)
+	{
+		const TelemetryLog::BallState state{ GetBallState(ball) };
+		std::memcpy(pRecord, &state, sizeof(state));
+		pRecord += sizeof(state);
+	}
+
+	entry.dataPosition = position;
+	entry.size = uint32_t(size);
+	entry.numBalls = numBalls;
+	entry.sequence.store(m_numRecords, std::memory_order_release);
+
+	++m_numRecords;
+	m_pHeader->numRecords.store(m_numRecords, std::memory_order_release);
+}
+
+uint64_t TelemetryRecorder::GetNumRecords() const
+{
+	return m_numRecords;
+}
+
+uint64_t TelemetryRecorder::GetNumSkipped() const
+{
+	return m_numSkipped;
+}
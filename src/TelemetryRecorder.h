@@ -0,0 +1,44 @@
+#pragma once
+#include "MappedFile.h"
+#include "TelemetryLog.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class Table;
+
+// Writes the position, velocity and lives of every ball after every step into a memory-mapped ring file (see TelemetryLog.h),
+// so other processes can follow a running game. A step is a few plain stores into the mapping, the operating system
+// writes the pages back to the file in the background
+class TelemetryRecorder final
+{
+public:
+	static constexpr size_t DEFAULT_DATA_CAPACITY{ size_t(64) << 20 };
+	static constexpr uint32_t DEFAULT_INDEX_CAPACITY{ 1 << 16 };
+
+	TelemetryRecorder(const std::string& path, const Table& table, size_t dataCapacity = DEFAULT_DATA_CAPACITY, uint32_t indexCapacity = DEFAULT_INDEX_CAPACITY);
+	TelemetryRecorder(const TelemetryRecorder& other) = delete;
+	TelemetryRecorder& operator=(const TelemetryRecorder& other) = delete;
+	// marks the file as closed, so a reader knows no more records come
+	~TelemetryRecorder();
+
+	bool IsOk() const;
+
+	void RecordStep(const Table& table, float elapsedSec);
+
+	uint64_t GetNumRecords() const;
+	// steps with more balls than fit in the whole ring, they are left out
+	uint64_t GetNumSkipped() const;
+
+private:
+	MappedFile m_file;
+	TelemetryLog::Header* m_pHeader;
+	TelemetryLog::IndexEntry* m_pIndex;
+	uint8_t* m_pData;
+
+	uint64_t m_numSteps;
+	uint64_t m_numRecords;
+	uint64_t m_numDataBytes;
+	uint64_t m_numSkipped;
+	double m_simulatedSeconds;
+};
@@ -1,5 +1,5 @@
-#include <iostream>
 #include <string>
+#include "Log.h"
 #include "Texture.h"
 
 
@@ -67,7 +67,7 @@ void Texture::CreateFromImage( const std::string& path )
 	SDL_Surface* pLoadedSurface = IMG_Load(path.c_str());
 	if (pLoadedSurface == nullptr)
 	{
-		std::cerr << "Texture::CreateFromImage, error when calling IMG_Load: " << SDL_GetError() << std::endl;
+		Log::Error("Texture::CreateFromImage, error when calling IMG_Load: ", SDL_GetError());
 		m_CreationOk = false;
 		return;
 	}
@@ -87,7 +87,7 @@ void Texture::CreateFromString( const std::string& text, const std::string& font
 	pFont = TTF_OpenFont( fontPath.c_str( ), ptSize );
 	if(pFont == nullptr )
 	{
-		std::cerr << "Texture::CreateFromString, error when calling TTF_OpenFont: " << TTF_GetError( ) << std::endl;
+		Log::Error("Texture::CreateFromString, error when calling TTF_OpenFont: ", TTF_GetError());
 		m_CreationOk = false;
 		return;
 	}
@@ -102,7 +102,7 @@ void Texture::CreateFromString( const std::string& text, TTF_Font *pFont, const
 	m_CreationOk = true;
 	if ( pFont == nullptr )
 	{
-		std::cerr << "Texture::CreateFromString, invalid TTF_Font pointer\n" ;
+		Log::Error("Texture::CreateFromString, invalid TTF_Font pointer");
 		m_CreationOk = false;
 		return;
 	}
@@ -117,7 +117,7 @@ void Texture::CreateFromString( const std::string& text, TTF_Font *pFont, const
 	SDL_Surface* pLoadedSurface = TTF_RenderText_Blended( pFont, text.c_str( ), textColor );
 	if ( pLoadedSurface == nullptr )
 	{
-		std::cerr << "Texture::CreateFromString, error when calling TTF_RenderText_Blended: " << TTF_GetError( ) << std::endl;
+		Log::Error("Texture::CreateFromString, error when calling TTF_RenderText_Blended: ", TTF_GetError());
 		m_CreationOk = false;
 		return;
 	}
@@ -162,7 +162,7 @@ void Texture::CreateFromSurface( SDL_Surface* pSurface )
 		}
 		break;
 	default:
-		std::cerr << "Texture::CreateFromSurface, unknow pixel format, BytesPerPixel: " << pSurface->format->BytesPerPixel << "\nUse 32 bit or 24 bit images.\n";
+		Log::Error("Texture::CreateFromSurface, unknow pixel format, BytesPerPixel: ", pSurface->format->BytesPerPixel, ", use 32 bit or 24 bit images.");
 		m_CreationOk = false;
 		return;
 	}
@@ -179,9 +179,9 @@ void Texture::CreateFromSurface( SDL_Surface* pSurface )
 	GLenum e = glGetError();
 	if (e != GL_NO_ERROR)
 	{
-		std::cerr << "Texture::CreateFromSurface, error binding textures, Error id = " << e << '\n';
-		std::cerr << "Can happen if a texture is created before performing the initialization code (e.g. a static Texture object).\n";
-		std::cerr << "There might be a white rectangle instead of the image.\n";
+		Log::Error("Texture::CreateFromSurface, error binding textures, Error id = ", e);
+		Log::Error("Can happen if a texture is created before performing the initialization code (e.g. a static Texture object).");
+		Log::Error("There might be a white rectangle instead of the image.");
 	}
 
 	// Specify the texture's data.  
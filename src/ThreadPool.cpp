@@ -0,0 +1,72 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int numThreads)
+	: m_threads{}
+	, m_numRunning{ 0 }
+	, m_isStopping{ false }
+{
+	if (numThreads <= 0) numThreads = std::max(1, int(std::thread::hardware_concurrency()));
+
+	m_threads.reserve(numThreads);
+	for (int idx{}; idx < numThreads; ++idx)
+	{
+		m_threads.emplace_back(&ThreadPool::RunWorker, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		const std::lock_guard<std::mutex> lock{ m_mutex };
+		m_isStopping = true;
+	}
+	m_hasTask.notify_all();
+
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+	{
+		const std::lock_guard<std::mutex> lock{ m_mutex };
+		m_tasks.push_back(std::move(task));
+	}
+	m_hasTask.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+	std::unique_lock<std::mutex> lock{ m_mutex };
+	m_isIdle.wait(lock, [this]() { return m_tasks.empty() && m_numRunning == 0; });
+}
+
+int ThreadPool::GetNumThreads() const
+{
+	return int(m_threads.size());
+}
+
+void ThreadPool::RunWorker()
+{
+	std::unique_lock<std::mutex> lock{ m_mutex };
+	while (true)
+	{
+		m_hasTask.wait(lock, [this]() { return m_isStopping || !m_tasks.empty(); });
+		// the queue is emptied before stopping, so no submitted task is lost
+		if (m_tasks.empty()) return;
+
+		std::function<void()> task{ std::move(m_tasks.front()) };
+		m_tasks.pop_front();
+		++m_numRunning;
+
+		lock.unlock();
+		task();
+		lock.lock();
+
+		--m_numRunning;
+		if (m_tasks.empty() && m_numRunning == 0) m_isIdle.notify_all();
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads that run submitted tasks in the order they were submitted.
+// The threads are started once and wait for work, so short searches don't pay for starting threads.
+class ThreadPool final
+{
+public:
+	// 0 starts a thread for every core
+	explicit ThreadPool(int numThreads = 0);
+	ThreadPool(const ThreadPool& other) = delete;
+	ThreadPool& operator=(const ThreadPool& other) = delete;
+	ThreadPool(ThreadPool&& other) = delete;
+	ThreadPool& operator=(ThreadPool&& other) = delete;
+	// finishes the tasks that were already submitted
+	~ThreadPool();
+
+	void Submit(std::function<void()> task);
+	// blocks until every submitted task has finished
+	void Wait();
+
+	int GetNumThreads() const;
+
+private:
+	std::vector<std::thread> m_threads;
+
+	std::mutex m_mutex;
+	std::condition_variable m_hasTask;
+	std::condition_variable m_isIdle;
+	std::deque<std::function<void()>> m_tasks;
+	// tasks taken from the queue that are still running
+	int m_numRunning;
+	bool m_isStopping;
+
+	void RunWorker();
+};
@@ -0,0 +1,528 @@
+#include "TrajectoryCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "Ball.h"
+#include "Log.h"
+#include "Table.h"
+
+namespace
+{
+	enum class StepType : uint8_t
+	{
+		Keyframe = 0,
+		Delta = 1,
+		Repeat = 2
+	};
+
+	constexpr size_t HEADER_SIZE{ 4 + 2 + 2 + 4 * 4 + 4 };
+	constexpr size_t FOOTER_SIZE{ 8 };
+	// the encoder hands its bytes to the stream in blocks of this size
+	constexpr size_t BLOCK_SIZE{ 1 << 16 };
+
+	template <typename T>
+	void Put(std::vector<uint8_t>& bytes, const T& value)
+	{
+		const size_t offset{ bytes.size() };
+		bytes.resize(offset + sizeof(T));
+		std::memcpy(bytes.data() + offset, &value, sizeof(T));
+	}
+
+	// LEB128, 7 bits per byte
+	void PutVarint(std::vector<uint8_t>& bytes, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			bytes.push_back(uint8_t((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		bytes.push_back(uint8_t(value));
+	}
+
+	// small negative and positive numbers both become small unsigned ones: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+	uint64_t ZigZag(int64_t value)
+	{
+		return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+	}
+
+	int64_t UnZigZag(uint64_t value)
+	{
+		return int64_t(value >> 1) ^ -int64_t(value & 1);
+	}
+
+	int32_t QuantizeValue(float value)
+	{
+		// llrint rounds to the nearest with a single instruction, NaN and huge values end up at the limits
+		constexpr float LIMIT{ 2147483520.f };
+		if (!(std::fabs(value) < LIMIT)) return value > 0.f ? std::numeric_limits<int32_t>::max() : std::numeric_limits<int32_t>::min();
+		return int32_t(std::llrint(value));
+	}
+}
+
+TrajectoryEncoder::TrajectoryEncoder(std::ostream& stream, const Rectf& playArea, uint32_t keyframeInterval)
+	: m_stream{ stream }
+	, m_block{}
+	, m_numWrittenBytes{ 0 }
+	, m_playArea{ playArea }
+	, m_positionScaleX{ TrajectoryCodec::POSITION_STEPS / playArea.width }
+	, m_positionScaleY{ TrajectoryCodec::POSITION_STEPS / playArea.height }
+	, m_keyframeInterval{ std::max(keyframeInterval, 1u) }
+	, m_numSteps{ 0 }
+	, m_numPendingRepeats{ 0 }
+	, m_isFinished{ false }
+{
+	m_block.reserve(BLOCK_SIZE + 1024);
+	m_block.insert(m_block.end(), std::begin(TrajectoryCodec::MAGIC), std::end(TrajectoryCodec::MAGIC));
+	Put(m_block, TrajectoryCodec::VERSION);
+	Put(m_block, uint16_t{ 0 });
+	Put(m_block, playArea.left);
+	Put(m_block, playArea.bottom);
+	Put(m_block, playArea.width);
+	Put(m_block, playArea.height);
+	Put(m_block, m_keyframeInterval);
+}
+
+TrajectoryEncoder::~TrajectoryEncoder()
+{
+	Finish();
+}
+
+void TrajectoryEncoder::AddStep(const Table& table)
+{
+	const auto toSample{ [](const Ball& ball)
+		{
+			const ThreeBlade& pos{ ball.GetPos() };
+			const Point2f velocity{ ball.GetLinearVelocity() };
+			return TrajectoryCodec::Sample{ ball.GetId(), pos[0], pos[1], pos[2], velocity.x, velocity.y };
+		} };
+
+	m_samples.clear();
+	m_samples.push_back(toSample(table.GetWhiteBall()));
+	for (const Ball& ball : table.GetRedBalls())
+	{
+		m_samples.push_back(toSample(ball));
+	}
+	AddStep(m_samples.data(), m_samples.size());
+}
+
+void TrajectoryEncoder::AddStep(const TrajectoryCodec::Sample* pSamples, size_t numSamples)
+{
+	if (m_isFinished) return;
+
+	Quantize(pSamples, numSamples);
+	if (!m_keyframes.empty() && HasSameBalls())
+	{
+		// what every ball did differently from the prediction
+		m_residuals.resize(m_balls.size() * TrajectoryCodec::NUM_VALUES);
+		m_isPredicted.resize(m_balls.size());
+		bool isAllPredicted{ true };
+		for (size_t idx{}; idx < m_balls.size(); ++idx)
+		{
+			const TrajectoryCodec::QuantizedBall& ball{ m_balls[idx] };
+			TrajectoryCodec::QuantizedBall& nextBall{ m_nextBalls[idx] };
+			int32_t* pResiduals{ m_residuals.data() + idx * TrajectoryCodec::NUM_VALUES };
+			int32_t anyResidual{};
+			for (int valueIdx{}; valueIdx < TrajectoryCodec::NUM_VALUES; ++valueIdx)
+			{
+				// in 32 bit wrap-around arithmetic, which the decoder repeats
+				nextBall.deltas[valueIdx] = int32_t(uint32_t(nextBall.values[valueIdx]) - uint32_t(ball.values[valueIdx]));
+				pResiduals[valueIdx] = int32_t(uint32_t(nextBall.deltas[valueIdx]) - uint32_t(ball.deltas[valueIdx]));
+				anyResidual |= pResiduals[valueIdx];
+			}
+
+			const bool isPredicted{ anyResidual == 0 };
+			m_isPredicted[idx] = uint8_t(isPredicted);
+			isAllPredicted &= isPredicted;
+		}
+
+		if (isAllPredicted)
+		{
+			++m_numPendingRepeats;
+			m_balls.swap(m_nextBalls);
+			++m_numSteps;
+			return;
+		}
+
+		if (m_numSteps - m_keyframes.back().step < m_keyframeInterval)
+		{
+			FlushRepeats();
+			WriteDelta();
+			++m_numSteps;
+			FlushBlock();
+			return;
+		}
+	}
+
+	FlushRepeats();
+	WriteKeyframe();
+	++m_numSteps;
+	FlushBlock();
+}
+
+void TrajectoryEncoder::Finish()
+{
+	if (m_isFinished) return;
+
+	FlushRepeats();
+	const uint64_t indexOffset{ GetNumBytes() };
+	PutVarint(m_block, m_numSteps);
+	PutVarint(m_block, m_keyframes.size());
+	Keyframe previous{ 0, 0 };
+	for (const Keyframe& keyframe : m_keyframes)
+	{
+		PutVarint(m_block, keyframe.step - previous.step);
+		PutVarint(m_block, keyframe.offset - previous.offset);
+		previous = keyframe;
+	}
+	Put(m_block, indexOffset);
+
+	m_stream.write(reinterpret_cast<const char*>(m_block.data()), std::streamsize(m_block.size()));
+	m_numWrittenBytes += m_block.size();
+	m_block.clear();
+	m_stream.flush();
+	m_isFinished = true;
+}
+
+uint64_t TrajectoryEncoder::GetNumSteps() const
+{
+	return m_numSteps;
+}
+
+uint64_t TrajectoryEncoder::GetNumKeyframes() const
+{
+	return m_keyframes.size();
+}
+
+uint64_t TrajectoryEncoder::GetNumBytes() const
+{
+	return m_numWrittenBytes + m_block.size();
+}
+
+void TrajectoryEncoder::Quantize(const TrajectoryCodec::Sample* pSamples, size_t numSamples)
+{
+	m_nextBalls.resize(numSamples);
+	for (size_t idx{}; idx < numSamples; ++idx)
+	{
+		const TrajectoryCodec::Sample& sample{ pSamples[idx] };
+		TrajectoryCodec::QuantizedBall& ball{ m_nextBalls[idx] };
+		ball.id = sample.id;
+		ball.values[0] = QuantizeValue((sample.x - m_playArea.left) * m_positionScaleX);
+		ball.values[1] = QuantizeValue((sample.y - m_playArea.bottom) * m_positionScaleY);
+		ball.values[2] = QuantizeValue(sample.lives);
+		ball.values[3] = QuantizeValue(sample.velocityX * TrajectoryCodec::VELOCITY_STEPS_PER_UNIT);
+		ball.values[4] = QuantizeValue(sample.velocityY * TrajectoryCodec::VELOCITY_STEPS_PER_UNIT);
+	}
+}
+
+bool TrajectoryEncoder::HasSameBalls() const
+{
+	if (m_balls.size() != m_nextBalls.size()) return false;
+	for (size_t idx{}; idx < m_balls.size(); ++idx)
+	{
+		if (m_balls[idx].id != m_nextBalls[idx].id) return false;
+	}
+	return true;
+}
+
+void TrajectoryEncoder::WriteKeyframe()
+{
+	m_keyframes.push_back(Keyframe{ m_numSteps, GetNumBytes() });
+
+	PutVarint(m_block, uint64_t(StepType::Keyframe));
+	PutVarint(m_block, m_nextBalls.size());
+	int64_t previousId{ -1 };
+	for (TrajectoryCodec::QuantizedBall& ball : m_nextBalls)
+	{
+		PutVarint(m_block, ZigZag(int64_t(ball.id) - previousId - 1));
+		previousId = ball.id;
+		for (int32_t value : ball.values)
+		{
+			PutVarint(m_block, ZigZag(value));
+		}
+		// the decoder can't know how the balls moved before the keyframe
+		std::fill(std::begin(ball.deltas), std::end(ball.deltas), 0);
+	}
+	m_balls.swap(m_nextBalls);
+}
+
+void TrajectoryEncoder::WriteDelta()
+{
+	PutVarint(m_block, uint64_t(StepType::Delta));
+	size_t idx{};
+	while (idx < m_balls.size())
+	{
+		const size_t predictedStart{ idx };
+		while (idx < m_balls.size() && m_isPredicted[idx]) ++idx;
+		const size_t otherStart{ idx };
+		while (idx < m_balls.size() && !m_isPredicted[idx]) ++idx;
+
+		PutVarint(m_block, otherStart - predictedStart);
+		PutVarint(m_block, idx - otherStart);
+		const int32_t* const pEnd{ m_residuals.data() + idx * TrajectoryCodec::NUM_VALUES };
+		for (const int32_t* pResidual{ m_residuals.data() + otherStart * TrajectoryCodec::NUM_VALUES }; pResidual != pEnd; ++pResidual)
+		{
+			PutVarint(m_block, ZigZag(*pResidual));
+		}
+	}
+	m_balls.swap(m_nextBalls);
+}
+
+void TrajectoryEncoder::FlushRepeats()
+{
+	if (m_numPendingRepeats == 0) return;
+
+	PutVarint(m_block, (m_numPendingRepeats << 2) | uint64_t(StepType::Repeat));
+	m_numPendingRepeats = 0;
+}
+
+void TrajectoryEncoder::FlushBlock()
+{
+	if (m_block.size() < BLOCK_SIZE) return;
+
+	m_stream.write(reinterpret_cast<const char*>(m_block.data()), std::streamsize(m_block.size()));
+	m_numWrittenBytes += m_block.size();
+	m_block.clear();
+}
+
+TrajectoryDecoder::TrajectoryDecoder(const uint8_t* pData, size_t size)
+	: m_pData{ pData }
+	, m_size{ size }
+	, m_isOk{ false }
+	, m_playArea{}
+	, m_positionStepX{ 0.f }
+	, m_positionStepY{ 0.f }
+	, m_numSteps{ 0 }
+	, m_stepsEnd{ 0 }
+	, m_position{ HEADER_SIZE }
+	, m_nextStep{ 0 }
+	, m_numPendingRepeats{ 0 }
+{
+	uint16_t version{};
+	if (size >= HEADER_SIZE + FOOTER_SIZE) std::memcpy(&version, pData + 4, sizeof(version));
+	if (size < HEADER_SIZE + FOOTER_SIZE || std::memcmp(pData, TrajectoryCodec::MAGIC, sizeof(TrajectoryCodec::MAGIC)) != 0
+		|| version != TrajectoryCodec::VERSION)
+	{
+		Log::Error("TrajectoryDecoder::TrajectoryDecoder( ), the data isn't a trajectory stream of version ", TrajectoryCodec::VERSION);
+		return;
+	}
+
+	std::memcpy(&m_playArea.left, pData + 8, sizeof(float));
+	std::memcpy(&m_playArea.bottom, pData + 12, sizeof(float));
+	std::memcpy(&m_playArea.width, pData + 16, sizeof(float));
+	std::memcpy(&m_playArea.height, pData + 20, sizeof(float));
+	m_positionStepX = m_playArea.width / TrajectoryCodec::POSITION_STEPS;
+	m_positionStepY = m_playArea.height / TrajectoryCodec::POSITION_STEPS;
+
+	// the index at the end tells where the steps end and where every keyframe starts
+	uint64_t indexOffset{};
+	std::memcpy(&indexOffset, pData + size - FOOTER_SIZE, sizeof(indexOffset));
+	if (indexOffset < HEADER_SIZE || indexOffset > size - FOOTER_SIZE)
+	{
+		Log::Error("TrajectoryDecoder::TrajectoryDecoder( ), the stream is truncated");
+		return;
+	}
+
+	m_position = size_t(indexOffset);
+	m_stepsEnd = size - FOOTER_SIZE;
+	uint64_t numKeyframes{};
+	bool isIndexOk{ ReadVarint(m_numSteps) && ReadVarint(numKeyframes) && numKeyframes <= m_numSteps };
+	Keyframe keyframe{ 0, 0 };
+	for (uint64_t idx{}; isIndexOk && idx < numKeyframes; ++idx)
+	{
+		uint64_t stepDifference{};
+		uint64_t offsetDifference{};
+		isIndexOk = ReadVarint(stepDifference) && ReadVarint(offsetDifference);
+		keyframe.step += stepDifference;
+		keyframe.offset += offsetDifference;
+		isIndexOk &= keyframe.offset >= HEADER_SIZE && keyframe.offset < indexOffset && keyframe.step < m_numSteps;
+		m_keyframes.push_back(keyframe);
+	}
+	if (!isIndexOk || (m_numSteps > 0 && (m_keyframes.empty() || m_keyframes.front().step != 0)))
+	{
+		Log::Error("TrajectoryDecoder::TrajectoryDecoder( ), the keyframe index is damaged");
+		return;
+	}
+
+	m_stepsEnd = indexOffset;
+	m_position = HEADER_SIZE;
+	m_isOk = true;
+}
+
+bool TrajectoryDecoder::IsOk() const
+{
+	return m_isOk;
+}
+
+uint64_t TrajectoryDecoder::GetNumSteps() const
+{
+	return m_numSteps;
+}
+
+const Rectf& TrajectoryDecoder::GetPlayArea() const
+{
+	return m_playArea;
+}
+
+bool TrajectoryDecoder::NextStep(std::vector<TrajectoryCodec::Sample>& samples)
+{
+	if (!m_isOk || m_nextStep >= m_numSteps) return false;
+
+	if (m_numPendingRepeats > 0) Repeat(1);
+	else if (!DecodeStep()) return false;
+	++m_nextStep;
+
+	samples.resize(m_balls.size());
+	for (size_t idx{}; idx < m_balls.size(); ++idx)
+	{
+		const TrajectoryCodec::QuantizedBall& ball{ m_balls[idx] };
+		samples[idx] = TrajectoryCodec::Sample{ ball.id, m_playArea.left + ball.values[0] * m_positionStepX, m_playArea.bottom + ball.values[1] * m_positionStepY,
+			float(ball.values[2]), ball.values[3] / TrajectoryCodec::VELOCITY_STEPS_PER_UNIT, ball.values[4] / TrajectoryCodec::VELOCITY_STEPS_PER_UNIT };
+	}
+	return true;
+}
+
+bool TrajectoryDecoder::Seek(uint64_t step)
+{
+	if (!m_isOk || step > m_numSteps) return false;
+
+	// restart at the last keyframe before the step, unless decoding on from here is as close
+	const auto keyframe{ std::upper_bound(m_keyframes.begin(), m_keyframes.end(), step,
+		[](uint64_t value, const Keyframe& keyframe) { return value < keyframe.step; }) };
+	if (keyframe != m_keyframes.begin() && (step < m_nextStep || std::prev(keyframe)->step > m_nextStep))
+	{
+		m_position = size_t(std::prev(keyframe)->offset);
+		m_nextStep = std::prev(keyframe)->step;
+		m_numPendingRepeats = 0;
+	}
+
+	while (m_nextStep < step)
+	{
+		if (m_numPendingRepeats > 0)
+		{
+			const uint64_t numSteps{ std::min(m_numPendingRepeats, step - m_nextStep) };
+			Repeat(numSteps);
+			m_nextStep += numSteps;
+			continue;
+		}
+		if (!DecodeStep()) return false;
+		++m_nextStep;
+	}
+	return true;
+}
+
+bool TrajectoryDecoder::DecodeStep()
+{
+	uint64_t tag{};
+	if (!ReadVarint(tag))
+	{
+		m_isOk = false;
+		return false;
+	}
+
+	switch (StepType(tag & 3))
+	{
+	case StepType::Keyframe:
+	{
+		uint64_t numBalls{};
+		bool isOk{ ReadVarint(numBalls) && m_position <= m_stepsEnd && numBalls <= m_stepsEnd - m_position };
+		if (isOk) m_balls.resize(size_t(numBalls));
+		int64_t previousId{ -1 };
+		for (size_t idx{}; isOk && idx < m_balls.size(); ++idx)
+		{
+			TrajectoryCodec::QuantizedBall& ball{ m_balls[idx] };
+			int64_t id{};
+			isOk = ReadZigZag(id);
+			previousId += id + 1;
+			ball.id = uint32_t(previousId);
+			for (int32_t& value : ball.values)
+			{
+				int64_t decoded{};
+				isOk &= ReadZigZag(decoded);
+				value = int32_t(decoded);
+			}
+			std::fill(std::begin(ball.deltas), std::end(ball.deltas), 0);
+		}
+		m_isOk = isOk;
+		return isOk;
+	}
+	case StepType::Delta:
+	{
+		size_t idx{};
+		bool isOk{ true };
+		while (isOk && idx < m_balls.size())
+		{
+			uint64_t numPredicted{};
+			uint64_t numOther{};
+			isOk = ReadVarint(numPredicted) && ReadVarint(numOther) && numPredicted + numOther <= m_balls.size() - idx;
+			if (!isOk) break;
+
+			for (const size_t predictedEnd{ idx + size_t(numPredicted) }; idx < predictedEnd; ++idx)
+			{
+				TrajectoryCodec::QuantizedBall& ball{ m_balls[idx] };
+				for (int valueIdx{}; valueIdx < TrajectoryCodec::NUM_VALUES; ++valueIdx)
+				{
+					ball.values[valueIdx] = int32_t(uint32_t(ball.values[valueIdx]) + uint32_t(ball.deltas[valueIdx]));
+				}
+			}
+			for (const size_t otherEnd{ idx + size_t(numOther) }; isOk && idx < otherEnd; ++idx)
+			{
+				TrajectoryCodec::QuantizedBall& ball{ m_balls[idx] };
+				for (int valueIdx{}; valueIdx < TrajectoryCodec::NUM_VALUES; ++valueIdx)
+				{
+					int64_t residual{};
+					isOk &= ReadZigZag(residual);
+					ball.deltas[valueIdx] = int32_t(uint32_t(ball.deltas[valueIdx]) + uint32_t(residual));
+					ball.values[valueIdx] = int32_t(uint32_t(ball.values[valueIdx]) + uint32_t(ball.deltas[valueIdx]));
+				}
+			}
+		}
+		m_isOk = isOk;
+		return isOk;
+	}
+	case StepType::Repeat:
+		m_numPendingRepeats = tag >> 2;
+		if (m_numPendingRepeats == 0)
+		{
+			m_isOk = false;
+			return false;
+		}
+		Repeat(1);
+		return true;
+	default:
+		m_isOk = false;
+		return false;
+	}
+}
+
+void TrajectoryDecoder::Repeat(uint64_t numSteps)
+{
+	m_numPendingRepeats -= numSteps;
+	for (TrajectoryCodec::QuantizedBall& ball : m_balls)
+	{
+		for (int valueIdx{}; valueIdx < TrajectoryCodec::NUM_VALUES; ++valueIdx)
+		{
+			ball.values[valueIdx] = int32_t(uint32_t(ball.values[valueIdx]) + uint32_t(ball.deltas[valueIdx]) * uint32_t(numSteps));
+		}
+	}
+}
+
+bool TrajectoryDecoder::ReadVarint(uint64_t& value)
+{
+	value = 0;
+	for (int shift{}; shift < 64 && m_position < m_stepsEnd; shift += 7)
+	{
+		const uint8_t byte{ m_pData[m_position++] };
+		value |= uint64_t(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) return true;
+	}
+	return false;
+}
+
+bool TrajectoryDecoder::ReadZigZag(int64_t& value)
+{
+	uint64_t encoded{};
+	if (!ReadVarint(encoded)) return false;
+	value = UnZigZag(encoded);
+	return true;
+}
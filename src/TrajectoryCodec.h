@@ -0,0 +1,162 @@
+#pragma once
+#include "structs.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+class Table;
+
+// Compact archive format for simulated trajectories, every ball in every step, all values are stored in the byte order
+// of the machine (little endian on our targets). Positions are quantized to 1/65536 of the play area, velocities to 1/64 unit per second
+// and lives to whole numbers, which is far below what can be seen.
+//
+// header:   "GTRJ", u16 version, u16 reserved, f32 play area (left, bottom, width, height), u32 keyframe interval
+// steps:    varint tag, the low 2 bits are the type
+//           Keyframe (0): varint ball count, then per ball varint id (difference to the previous id minus one), zigzag x, y, lives, velocity x, y
+//           Delta (1):    the same balls as the step before in the same order, as runs until every ball is covered:
+//                         varint count of predicted balls, varint count of other balls, then per other ball zigzag residuals x, y, lives, velocity x, y.
+//                         Every value is predicted to change as much as in the step before (not at all after a keyframe),
+//                         so rolling balls that slow down evenly cost little as well
+//           Repeat (2):   tag >> 2 steps in which every ball did what was predicted, like resting balls do
+// index:    varint step count, varint keyframe count, then per keyframe varint step and varint byte offset, both as difference to the previous keyframe
+// footer:   u64 byte offset of the index
+//
+// A keyframe is written when the balls change (one is pocketed) or when a step needs data and the last keyframe is
+// at least the keyframe interval of steps ago, so a decoder can start at any keyframe. Varints are LEB128, 7 bits per byte.
+namespace TrajectoryCodec
+{
+	constexpr char MAGIC[4]{ 'G', 'T', 'R', 'J' };
+	constexpr uint16_t VERSION{ 1 };
+	constexpr uint32_t DEFAULT_KEYFRAME_INTERVAL{ 240 };
+
+	constexpr float POSITION_STEPS{ 65536.f };
+	constexpr float VELOCITY_STEPS_PER_UNIT{ 64.f };
+
+	// one ball in one step, the same values as in a telemetry record
+	struct Sample
+	{
+		uint32_t id;
+		float x;
+		float y;
+		float lives;
+		float velocityX;
+		float velocityY;
+	};
+
+	// x, y, lives, velocity x, velocity y
+	constexpr int NUM_VALUES{ 5 };
+
+	// a ball as it is encoded, and how much every value changed in the step before, which predicts the next step
+	struct QuantizedBall
+	{
+		uint32_t id;
+		int32_t values[NUM_VALUES];
+		int32_t deltas[NUM_VALUES];
+	};
+}
+
+// Encodes one step after the other and writes the bytes to the stream in blocks
+class TrajectoryEncoder final
+{
+public:
+	TrajectoryEncoder(std::ostream& stream, const Rectf& playArea, uint32_t keyframeInterval = TrajectoryCodec::DEFAULT_KEYFRAME_INTERVAL);
+	TrajectoryEncoder(const TrajectoryEncoder& other) = delete;
+	TrajectoryEncoder& operator=(const TrajectoryEncoder& other) = delete;
+	// finishes the stream if Finish wasn't called
+	~TrajectoryEncoder();
+
+	// the white ball followed by the red balls
+	void AddStep(const Table& table);
+	void AddStep(const TrajectoryCodec::Sample* pSamples, size_t numSamples);
+	// writes the keyframe index and the footer, steps added afterwards are ignored
+	void Finish();
+
+	uint64_t GetNumSteps() const;
+	uint64_t GetNumKeyframes() const;
+	// bytes written so far, including the ones still waiting in the block
+	uint64_t GetNumBytes() const;
+
+private:
+	struct Keyframe
+	{
+		uint64_t step;
+		uint64_t offset;
+	};
+
+	std::ostream& m_stream;
+	std::vector<uint8_t> m_block;
+	uint64_t m_numWrittenBytes;
+
+	Rectf m_playArea;
+	float m_positionScaleX;
+	float m_positionScaleY;
+	uint32_t m_keyframeInterval;
+
+	std::vector<TrajectoryCodec::QuantizedBall> m_balls;
+	std::vector<TrajectoryCodec::QuantizedBall> m_nextBalls;
+	// residuals of the step being encoded, NUM_VALUES per ball, and whether all of a ball are 0
+	std::vector<int32_t> m_residuals;
+	std::vector<uint8_t> m_isPredicted;
+	std::vector<TrajectoryCodec::Sample> m_samples;
+
+	std::vector<Keyframe> m_keyframes;
+	uint64_t m_numSteps;
+	uint64_t m_numPendingRepeats;
+	bool m_isFinished;
+
+	void Quantize(const TrajectoryCodec::Sample* pSamples, size_t numSamples);
+	bool HasSameBalls() const;
+	void WriteKeyframe();
+	void WriteDelta();
+	void FlushRepeats();
+	void FlushBlock();
+};
+
+// Decodes a whole encoded stream in memory (for example a MappedFile), one step after the other or from any step on
+class TrajectoryDecoder final
+{
+public:
+	TrajectoryDecoder(const uint8_t* pData, size_t size);
+
+	// false when the data isn't a complete trajectory stream of this version, or a step couldn't be decoded
+	bool IsOk() const;
+	uint64_t GetNumSteps() const;
+	const Rectf& GetPlayArea() const;
+
+	// decodes the next step, false after the last one
+	bool NextStep(std::vector<TrajectoryCodec::Sample>& samples);
+	// continues at the given step, decoding from the keyframe before it
+	bool Seek(uint64_t step);
+
+private:
+	struct Keyframe
+	{
+		uint64_t step;
+		uint64_t offset;
+	};
+
+	const uint8_t* m_pData;
+	size_t m_size;
+	bool m_isOk;
+
+	Rectf m_playArea;
+	float m_positionStepX;
+	float m_positionStepY;
+
+	std::vector<Keyframe> m_keyframes;
+	uint64_t m_numSteps;
+	// reads stop here, at the footer while the index is parsed and at the index afterwards
+	uint64_t m_stepsEnd;
+
+	size_t m_position;
+	uint64_t m_nextStep;
+	uint64_t m_numPendingRepeats;
+	std::vector<TrajectoryCodec::QuantizedBall> m_balls;
+
+	// applies the next step to m_balls
+	bool DecodeStep();
+	void Repeat(uint64_t numSteps);
+	bool ReadVarint(uint64_t& value);
+	bool ReadZigZag(int64_t& value);
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single producer / single consumer triple buffer.
+// The writer always has a private buffer to fill, the reader always has a private buffer to read,
+// and the third buffer is swapped between them through one atomic index. Neither side ever waits on the other.
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() = default;
+	TripleBuffer(const TripleBuffer& other) = delete;
+	TripleBuffer& operator=(const TripleBuffer& other) = delete;
+
+	// Writer side: the buffer to fill, it may still contain the data of an older publish
+	T& GetWriteBuffer()
+	{
+		return m_slots[m_writeIdx].value;
+	}
+
+	// Writer side: hand the filled buffer to the reader and take the spare one back
+	void Publish()
+	{
+		const uint8_t prev{ m_sharedIdx.exchange(uint8_t(m_writeIdx | DIRTY_BIT), std::memory_order_acq_rel) };
+		m_writeIdx = prev & INDEX_MASK;
+	}
+
+	// Reader side: swap in the latest published buffer, returns false if nothing new was published
+	bool Update()
+	{
+		if ((m_sharedIdx.load(std::memory_order_relaxed) & DIRTY_BIT) == 0) return false;
+
+		const uint8_t prev{ m_sharedIdx.exchange(m_readIdx, std::memory_order_acq_rel) };
+		m_readIdx = prev & INDEX_MASK;
+		return true;
+	}
+
+	// Reader side: the latest complete buffer
+	const T& GetReadBuffer() const
+	{
+		return m_slots[m_readIdx].value;
+	}
+
+private:
+	static constexpr uint8_t DIRTY_BIT{ 0x4 };
+	static constexpr uint8_t INDEX_MASK{ 0x3 };
+
+	// keep every buffer on its own cache line so both threads don't fight over the same line
+	struct alignas(64) Slot
+	{
+		T value{};
+	};
+
+	std::array<Slot, 3> m_slots{};
+	uint8_t m_writeIdx{ 0 };
+	std::atomic<uint8_t> m_sharedIdx{ 1 };
+	uint8_t m_readIdx{ 2 };
+};
@@ -1,16 +1,338 @@
 #include "SDL.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AccuracyReport.h"
+#include "AllocationCheck.h"
+#include "BatchRunner.h"
+#include "Benchmarks.h"
 #include "Game.h"
+#include "Log.h"
+#include "MappedFile.h"
+#include "ReplayRunner.h"
+#include "ShotPlanner.h"
+#include "TableLayout.h"
+#include "TablePack.h"
+#include "TelemetryLog.h"
+#include "TelemetryRecorder.h"
+
+namespace
+{
+	// re-simulate a shot log headlessly and check it ends in the recorded state
+	int RunReplay(const std::string& path, int repeat)
+	{
+		const ReplayRunner runner{ path };
+		if (!runner.IsLoaded()) return 1;
+
+		bool isMatch{ true };
+		for (int run{}; run < repeat; ++run)
+		{
+			const ReplayRunner::Result result{ runner.Run() };
+			std::cout << "replay " << run + 1 << '/' << repeat << ": " << result.numSteps << " steps, " << result.numShots << " shots in "
+				<< result.wallSeconds * 1000.0 << " ms (" << result.numSteps / std::max(result.wallSeconds, 1e-9) << " steps/s), points "
+				<< result.points;
+
+			if (result.hasFinalState)
+			{
+				std::cout << " (recorded " << result.recordedPoints << "), max position error " << result.maxPositionError
+					<< (result.isMatch ? " -> MATCH\n" : " -> MISMATCH\n");
+				isMatch &= result.isMatch;
+			}
+			else
+			{
+				std::cout << ", log has no final state to verify against\n";
+			}
+		}
+		return isMatch ? 0 : 1;
+	}
+
+	// read table layouts from text files or packs and write them all into one pack
+	int CompileTables(const std::vector<std::string>& inputPaths, const std::string& packPath)
+	{
+		std::vector<TableLayout> layouts{};
+		for (const std::string& path : inputPaths)
+		{
+			if (!TableLayout::Load(path, layouts)) return 1;
+		}
+
+		if (!TablePack::Write(packPath, layouts)) return 1;
+		std::cout << "compiled " << layouts.size() << " tables into " << packPath << '\n';
+		return 0;
+	}
+
+	// simulate every scenario in a directory, json when the output file ends in .json or .jsonl and csv otherwise
+	int RunBatch(const std::string& directory, const std::string& outPath, int numThreads, const BatchRunner::Settings& settings)
+	{
+		const BatchRunner runner{ directory, settings };
+		if (!runner.IsLoaded()) return 1;
+
+		const std::string extension{ std::filesystem::path{ outPath }.extension().string() };
+		const bool isJson{ extension == ".json" || extension == ".jsonl" };
+		const BatchRunner::Format format{ isJson ? BatchRunner::Format::JsonLines : BatchRunner::Format::Csv };
+		if (outPath.empty()) return runner.Run(std::cout, format, numThreads) == 0 ? 0 : 1;
+
+		std::ofstream file{ outPath };
+		if (!file)
+		{
+			std::cerr << "could not open " << outPath << '\n';
+			return 1;
+		}
+		return runner.Run(file, format, numThreads) == 0 ? 0 : 1;
+	}
+
+	// print every record a running game writes to its telemetry file, starting at the newest one, until the game closes the file
+	int TailTelemetry(const std::string& path)
+	{
+		const MappedFile file{ path };
+		if (!file.IsOpen()) return 1;
+
+		const uint64_t fileSize{ file.GetSize() };
+		if (fileSize < sizeof(TelemetryLog::Header))
+		{
+			std::cerr << path << " is too small to be a telemetry file\n";
+			return 1;
+		}
+
+		const uint8_t* pFile{ file.GetData() };
+		const TelemetryLog::Header& header{ *reinterpret_cast<const TelemetryLog::Header*>(pFile) };
+		if (!std::equal(std::begin(TelemetryLog::MAGIC), std::end(TelemetryLog::MAGIC), header.magic) || header.version != TelemetryLog::VERSION
+			|| header.indexCapacity == 0 || header.indexOffset > fileSize
+			|| header.indexCapacity > (fileSize - header.indexOffset) / sizeof(TelemetryLog::IndexEntry)
+			|| header.dataCapacity == 0 || header.dataOffset > fileSize || header.dataCapacity > fileSize - header.dataOffset)
+		{
+			std::cerr << path << " is not a telemetry file of this version\n";
+			return 1;
+		}
+
+		std::vector<uint8_t> record{};
+		uint64_t sequence{ header.numRecords.load(std::memory_order_acquire) };
+		if (sequence > 0) --sequence;
+		uint64_t numPrinted{};
+		uint64_t numLost{};
+		while (true)
+		{
+			if (sequence >= header.numRecords.load(std::memory_order_acquire))
+			{
+				// the last records may be written just before the file is closed
+				if (header.isOpen.load(std::memory_order_acquire) == 0 && sequence >= header.numRecords.load(std::memory_order_acquire)) break;
+				std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+				continue;
+			}
+
+			if (!TelemetryLog::CopyRecord(pFile, sequence++, record))
+			{
+				++numLost;
+				continue;
+			}
+
+			TelemetryLog::RecordHeader recordHeader{};
+			std::memcpy(&recordHeader, record.data(), sizeof(recordHeader));
+			TelemetryLog::BallState whiteBall{};
+			std::memcpy(&whiteBall, record.data() + sizeof(recordHeader), sizeof(whiteBall));
+			std::cout << "step " << recordHeader.step << " at " << recordHeader.simulatedSeconds << " s: " << recordHeader.numBalls
+				<< " balls, white ball at " << whiteBall.x << ' ' << whiteBall.y << " moving " << whiteBall.velocityX << ' ' << whiteBall.velocityY << '\n';
+			++numPrinted;
+		}
+
+		std::cout << numPrinted << " records, " << numLost << " overwritten before they could be read\n";
+		return 0;
+	}
+}
 
 int main(int argv, char** args)
 {
 	srand(static_cast<unsigned int>(time(nullptr)));
 
+	// --latency [log file]: measure input to photon latency
+	// --record <shot log>: record the game
+	// --replay <shot log> [--repeat <count>]: re-simulate a recorded game without opening a window
+	// --benchmark <name>: run a micro benchmark without opening a window (see Benchmarks.h)
+	// --alloc-check [frames]: play a scripted session headlessly and fail if it allocates after warming up
+	// --table <file> [index]: play a table from a layout text file or table pack instead of the default table
+	// --compile-tables <file>... <pack>: compile layout files into one table pack
+	// --sandbox [count]: a stress test with count balls (10 to 100000, 1000 by default) at random positions and velocities, and a stats overlay
+	// --computer [deadline ms]: the computer plays, A switches between the computer and the mouse (see ShotPlanner.h)
+	// --batch <directory> [--out <file>] [--threads <count>] [--step-rate <steps per second>] [--integrator <euler|midpoint|exact>]:
+	//     simulate every scenario file in a directory on all cores (see BatchRunner.h)
+	// --telemetry [file] [MB]: write every ball after every step into a memory-mapped ring file (see TelemetryLog.h)
+	// --tail-telemetry <file>: print the records a running game writes to its telemetry file
+	// --accuracy <reference file>: the exact build writes the outcome of the canned shots, a GEOA_FAST_MATH build compares against it (see AccuracyReport.h)
+	bool isLatencyMode{ false };
+	std::string latencyLogPath{ "latency.csv" };
+	std::string recordPath{};
+	std::string replayPath{};
+	int replayRepeat{ 1 };
+	std::string benchmarkName{};
+	int allocCheckFrames{ 0 };
+	std::string tablePath{};
+	int tableIndex{ 0 };
+	std::vector<std::string> compilePaths{};
+	std::string batchPath{};
+	std::string batchOutPath{};
+	int batchThreads{ 0 };
+	BatchRunner::Settings batchSettings{ BatchRunner::STEP_SECONDS, Ball::Integrator::Euler };
+	int sandboxBalls{ 0 };
+	int computerDeadline{ 0 };
+	std::string accuracyPath{};
+	std::string telemetryPath{};
+	size_t telemetryCapacity{ TelemetryRecorder::DEFAULT_DATA_CAPACITY };
+	std::string tailTelemetryPath{};
+	for (int idx{ 1 }; idx < argv; ++idx)
+	{
+		const std::string arg{ args[idx] };
+		const bool hasValue{ idx + 1 < argv && args[idx + 1][0] != '-' };
+		if (arg == "--latency")
+		{
+			isLatencyMode = true;
+			if (hasValue) latencyLogPath = args[++idx];
+		}
+		else if (arg == "--record" && hasValue)
+		{
+			recordPath = args[++idx];
+		}
+		else if (arg == "--replay" && hasValue)
+		{
+			replayPath = args[++idx];
+		}
+		else if (arg == "--benchmark" && hasValue)
+		{
+			benchmarkName = args[++idx];
+		}
+		else if (arg == "--alloc-check")
+		{
+			allocCheckFrames = hasValue ? std::max(1, std::stoi(args[++idx])) : 10000;
+		}
+		else if (arg == "--repeat" && hasValue)
+		{
+			replayRepeat = std::max(1, std::stoi(args[++idx]));
+		}
+		else if (arg == "--table" && hasValue)
+		{
+			tablePath = args[++idx];
+			if (idx + 1 < argv && args[idx + 1][0] != '-') tableIndex = std::max(0, std::stoi(args[++idx]));
+		}
+		else if (arg == "--compile-tables")
+		{
+			while (idx + 1 < argv && args[idx + 1][0] != '-') compilePaths.push_back(args[++idx]);
+		}
+		else if (arg == "--sandbox")
+		{
+			sandboxBalls = hasValue ? std::stoi(args[++idx]) : 1000;
+			sandboxBalls = std::clamp(sandboxBalls, TableLayout::MIN_SANDBOX_BALLS, TableLayout::MAX_SANDBOX_BALLS);
+		}
+		else if (arg == "--computer")
+		{
+			computerDeadline = hasValue ? std::max(1, std::stoi(args[++idx])) : int(ShotPlanner::Settings{}.deadline.count());
+		}
+		else if (arg == "--batch" && hasValue)
+		{
+			batchPath = args[++idx];
+		}
+		else if (arg == "--out" && hasValue)
+		{
+			batchOutPath = args[++idx];
+		}
+		else if (arg == "--threads" && hasValue)
+		{
+			batchThreads = std::max(1, std::stoi(args[++idx]));
+		}
+		else if (arg == "--step-rate" && hasValue)
+		{
+			batchSettings.stepSeconds = 1.f / std::max(1, std::stoi(args[++idx]));
+		}
+		else if (arg == "--integrator" && hasValue)
+		{
+			const std::string name{ args[++idx] };
+			if (name == "euler") batchSettings.integrator = Ball::Integrator::Euler;
+			else if (name == "midpoint") batchSettings.integrator = Ball::Integrator::Midpoint;
+			else if (name == "exact") batchSettings.integrator = Ball::Integrator::ExactDecay;
+			else
+			{
+				std::cerr << "unknown integrator " << name << ", use euler, midpoint or exact\n";
+				return 1;
+			}
+		}
+		else if (arg == "--accuracy" && hasValue)
+		{
+			accuracyPath = args[++idx];
+		}
+		else if (arg == "--telemetry")
+		{
+			telemetryPath = hasValue ? args[++idx] : "telemetry.bin";
+			if (idx + 1 < argv && args[idx + 1][0] != '-') telemetryCapacity = size_t(std::max(1, std::stoi(args[++idx]))) << 20;
+		}
+		else if (arg == "--tail-telemetry" && hasValue)
+		{
+			tailTelemetryPath = args[++idx];
+		}
+	}
+
+	// the writer thread and the ring of this thread are created now, not in the first frame that logs
+	Log::Start();
+
+	if (!replayPath.empty()) return RunReplay(replayPath, replayRepeat);
+	if (!benchmarkName.empty()) return Benchmarks::Run(benchmarkName) ? 0 : 1;
+	if (allocCheckFrames > 0) return AllocationCheck::Run(allocCheckFrames) ? 0 : 1;
+	if (!batchPath.empty()) return RunBatch(batchPath, batchOutPath, batchThreads, batchSettings);
+	if (!accuracyPath.empty()) return AccuracyReport::Run(accuracyPath) ? 0 : 1;
+	if (!tailTelemetryPath.empty()) return TailTelemetry(tailTelemetryPath);
+	if (!compilePaths.empty())
+	{
+		if (compilePaths.size() < 2)
+		{
+			std::cerr << "--compile-tables needs at least one layout file and the pack to write\n";
+			return 1;
+		}
+		const std::string packPath{ compilePaths.back() };
+		compilePaths.pop_back();
+		return CompileTables(compilePaths, packPath);
+	}
+
 	Window window{ "GEOA Project Demo", 940.f , 520.f };
-	Game pGame{ window };
+	std::vector<TableLayout> layouts{};
+	if (!tablePath.empty())
+	{
+		if (!TableLayout::Load(tablePath, layouts)) return 1;
+		if (tableIndex >= int(layouts.size()))
+		{
+			std::cerr << tablePath << " has " << layouts.size() << " tables, there is no table " << tableIndex << '\n';
+			return 1;
+		}
+
+		// make the window big enough for the table, with the same margin as the default table
+		const Rectf& playArea{ layouts[tableIndex].playArea };
+		window.width = std::max(window.width, playArea.left + playArea.width + 50.f);
+		window.height = std::max(window.height, playArea.bottom + playArea.height + 50.f);
+	}
+
+	const Rectf defaultPlayArea{ 50.f, 50.f, window.width - 100.f, window.height - 100.f };
+	if (sandboxBalls > 0)
+	{
+		// always the same seed, so every run is the same scenario, the game zooms out to fit the table
+		layouts = { TableLayout::CreateSandbox(defaultPlayArea, sandboxBalls, 1) };
+		tableIndex = 0;
+	}
+
+	Game pGame{ window, layouts.empty() ? TableLayout::CreateDefault(defaultPlayArea) : layouts[tableIndex] };
+	if (sandboxBalls > 0) pGame.EnableStatsOverlay();
+	if (computerDeadline > 0)
+	{
+		ShotPlanner::Settings plannerSettings{};
+		plannerSettings.deadline = std::chrono::milliseconds{ computerDeadline };
+		pGame.EnableComputerPlayer(plannerSettings);
+	}
+	if (isLatencyMode) pGame.EnableLatencyMode(latencyLogPath);
+	if (!recordPath.empty()) pGame.EnableRecording(recordPath);
+	if (!telemetryPath.empty()) pGame.EnableTelemetry(telemetryPath, telemetryCapacity);
 	pGame.Run();
 
 	return 0;
 }
-
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <SDL_opengl.h>
 #include "utils.h"
+#include "FastMath.h"
 
 
 #pragma region OpenGLDrawFunctionality
@@ -144,7 +145,7 @@ void utils::DrawEllipse( float centerX, float centerY, float radX, float radY, f
 		{
 			for (float angle = 0.0; angle < float(2 * g_Pi); angle += dAngle)
 			{
-				glVertex2f(centerX + radX * cos(angle), centerY + radY * sin(angle));
+				glVertex2f(centerX + radX * FastMath::Cos(angle), centerY + radY * FastMath::Sin(angle));
 			}
 		}
 		glEnd();
@@ -172,7 +173,7 @@ void utils::FillEllipse( float centerX, float centerY, float radX, float radY )
 		{
 			for (float angle = 0.0; angle < float(2 * g_Pi); angle += dAngle)
 			{
-				glVertex2f(centerX + radX * cos(angle), centerY + radY * sin(angle));
+				glVertex2f(centerX + radX * FastMath::Cos(angle), centerY + radY * FastMath::Sin(angle));
 			}
 		}
 		glEnd();
@@ -203,9 +204,9 @@ void utils::DrawArc( float centerX, float centerY, float radX, float radY, float
 	{
 		for ( float angle = fromAngle; angle < tillAngle; angle += dAngle )
 		{
-			glVertex2f( centerX + radX * cos( angle ), centerY + radY * sin( angle ) );
+			glVertex2f( centerX + radX * FastMath::Cos( angle ), centerY + radY * FastMath::Sin( angle ) );
 		}
-		glVertex2f( centerX + radX * cos( tillAngle ), centerY + radY * sin( tillAngle ) );
+		glVertex2f( centerX + radX * FastMath::Cos( tillAngle ), centerY + radY * FastMath::Sin( tillAngle ) );
 	}
 	glEnd( );
 
@@ -229,9 +230,9 @@ void utils::FillArc( float centerX, float centerY, float radX, float radY, float
 		glVertex2f( centerX, centerY );
 		for ( float angle = fromAngle; angle < tillAngle; angle += dAngle )
 		{
-			glVertex2f( centerX + radX * cos( angle ), centerY + radY * sin( angle ) );
+			glVertex2f( centerX + radX * FastMath::Cos( angle ), centerY + radY * FastMath::Sin( angle ) );
 		}
-		glVertex2f( centerX + radX * cos( tillAngle ), centerY + radY * sin( tillAngle ) );
+		glVertex2f( centerX + radX * FastMath::Cos( tillAngle ), centerY + radY * FastMath::Sin( tillAngle ) );
 	}
 	glEnd( );
 }